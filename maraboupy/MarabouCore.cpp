@@ -213,7 +213,13 @@ void saveQuery(InputQuery& inputQuery, std::string filename){
     inputQuery.saveQuery(String(filename));
 }
 
+void saveBinaryQuery(InputQuery& inputQuery, std::string filename){
+    inputQuery.saveBinary(String(filename));
+}
+
 InputQuery loadQuery(std::string filename){
+    if (QueryLoader::isBinaryQuery(String(filename)))
+        return QueryLoader::loadBinary(String(filename));
     return QueryLoader::loadQuery(String(filename));
 }
 
@@ -239,13 +245,21 @@ PYBIND11_MODULE(MarabouCore, m) {
     m.def("saveQuery", &saveQuery, R"pbdoc(
         Serializes the inputQuery in the given filename
 
+        Args:
+            inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query to be saved
+            filename (str): Name of file to save query
+        )pbdoc",
+        py::arg("inputQuery"), py::arg("filename"));
+    m.def("saveBinaryQuery", &saveBinaryQuery, R"pbdoc(
+        Serializes the inputQuery in the given filename, in the binary format
+
         Args:
             inputQuery (:class:`~maraboupy.MarabouCore.InputQuery`): Marabou input query to be saved
             filename (str): Name of file to save query
         )pbdoc",
         py::arg("inputQuery"), py::arg("filename"));
     m.def("loadQuery", &loadQuery, R"pbdoc(
-        Loads and returns a serialized InputQuery from the given filename
+        Loads and returns a serialized InputQuery from the given filename, in either the text or the binary format
 
         Args:
             filename (str): Name of file to load into an InputQuery
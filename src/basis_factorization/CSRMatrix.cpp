@@ -28,6 +28,7 @@ CSRMatrix::CSRMatrix()
     , _JA( NULL )
     , _nnz( 0 )
     , _estimatedNnz( 0 )
+    , _allocatedRows( 0 )
 {
 }
 
@@ -39,6 +40,7 @@ CSRMatrix::CSRMatrix( const double *M, unsigned m, unsigned n )
     , _JA( NULL )
     , _nnz( 0 )
     , _estimatedNnz( 0 )
+    , _allocatedRows( 0 )
 {
     initialize( M, m, n );
 }
@@ -77,12 +79,18 @@ void CSRMatrix::initialize( const double *M, unsigned m, unsigned n )
 }
 
 void CSRMatrix::initializeToEmpty( unsigned m, unsigned n )
+{
+    unsigned estimatedNumRowEntries = std::max( 2U, n / ROW_DENSITY_ESTIMATE );
+    initializeToEmpty( m, n, estimatedNumRowEntries * m );
+}
+
+void CSRMatrix::initializeToEmpty( unsigned m, unsigned n, unsigned estimatedNnz )
 {
     _m = m;
     _n = n;
 
-    unsigned estimatedNumRowEntries = std::max( 2U, _n / ROW_DENSITY_ESTIMATE );
-    _estimatedNnz = estimatedNumRowEntries * _m;
+    // Keep room for at least one element
+    _estimatedNnz = std::max( 1U, estimatedNnz );
 
     freeMemoryIfNeeded();
 
@@ -90,7 +98,8 @@ void CSRMatrix::initializeToEmpty( unsigned m, unsigned n )
     if ( !_A )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::A" );
 
-    _IA = new unsigned[_m + 1];
+    _allocatedRows = _m;
+    _IA = new unsigned[_allocatedRows + 1];
     if ( !_IA )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::IA" );
 
@@ -106,8 +115,10 @@ void CSRMatrix::increaseCapacity()
 {
     ASSERT( _m > 0 && _n > 0 );
 
+    // Grow at least geometrically, so that repeated additions of rows
+    // and columns take amortized constant time per entry
     unsigned estimatedNumRowEntries = std::max( 2U, _n / ROW_DENSITY_ESTIMATE );
-    unsigned newEstimatedNnz = _estimatedNnz + ( estimatedNumRowEntries * _m );
+    unsigned newEstimatedNnz = _estimatedNnz + std::max( estimatedNumRowEntries * _m, _estimatedNnz );
 
     double *newA = new double[newEstimatedNnz];
     if ( !newA )
@@ -117,8 +128,8 @@ void CSRMatrix::increaseCapacity()
     if ( !newJA )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::newJA" );
 
-    memcpy( newA, _A, _estimatedNnz * sizeof(double) );
-    memcpy( newJA, _JA, _estimatedNnz * sizeof(unsigned) );
+    memcpy( newA, _A, _nnz * sizeof(double) );
+    memcpy( newJA, _JA, _nnz * sizeof(unsigned) );
 
     delete[] _A;
     delete[] _JA;
@@ -139,10 +150,18 @@ double CSRMatrix::get( unsigned row, unsigned column ) const
 void CSRMatrix::addLastRow( const double *row )
 {
     // Array _IA needs to increase by one
-    unsigned *newIA = new unsigned[_m + 2];
-    memcpy( newIA, _IA, sizeof(unsigned) * ( _m + 1 ) );
-    delete[] _IA;
-    _IA = newIA;
+    if ( _m == _allocatedRows )
+    {
+        unsigned newAllocatedRows = std::max( 2 * _allocatedRows, _allocatedRows + 1 );
+        unsigned *newIA = new unsigned[newAllocatedRows + 1];
+        if ( !newIA )
+            throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::newIA" );
+
+        memcpy( newIA, _IA, sizeof(unsigned) * ( _m + 1 ) );
+        delete[] _IA;
+        _IA = newIA;
+        _allocatedRows = newAllocatedRows;
+    }
 
     // Add the new row
     _IA[_m + 1] = _IA[_m];
@@ -241,27 +260,34 @@ void CSRMatrix::storeIntoOther( SparseMatrix *other ) const
 {
     CSRMatrix *otherCsr = (CSRMatrix *)other;
 
-    otherCsr->freeMemoryIfNeeded();
+    // Reuse the other matrix's arrays if they are large enough
+    if ( !otherCsr->_A || otherCsr->_estimatedNnz < _nnz || otherCsr->_allocatedRows < _m )
+    {
+        otherCsr->freeMemoryIfNeeded();
+
+        otherCsr->_estimatedNnz = _estimatedNnz;
+        otherCsr->_allocatedRows = _allocatedRows;
+
+        otherCsr->_A = new double[_estimatedNnz];
+        if ( !otherCsr->_A )
+            throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::otherCsrA" );
+
+        otherCsr->_IA = new unsigned[_allocatedRows + 1];
+        if ( !otherCsr->_IA )
+            throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::otherCsrIA" );
+
+        otherCsr->_JA = new unsigned[_estimatedNnz];
+        if ( !otherCsr->_JA )
+            throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::otherCsrJA" );
+    }
 
     otherCsr->_m = _m;
     otherCsr->_n = _n;
     otherCsr->_nnz = _nnz;
-    otherCsr->_estimatedNnz = _estimatedNnz;
-
-    otherCsr->_A = new double[_estimatedNnz];
-    if ( !otherCsr->_A )
-        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::otherCsrA" );
-    memcpy( otherCsr->_A, _A, sizeof(double) * _estimatedNnz );
 
-    otherCsr->_IA = new unsigned[_m + 1];
-    if ( !otherCsr->_IA )
-        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::otherCsrIA" );
+    memcpy( otherCsr->_A, _A, sizeof(double) * _nnz );
     memcpy( otherCsr->_IA, _IA, sizeof(unsigned) * ( _m + 1 ) );
-
-    otherCsr->_JA = new unsigned[_estimatedNnz];
-    if ( !otherCsr->_JA )
-        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "CSRMatrix::otherCsrJA" );
-    memcpy( otherCsr->_JA, _JA, sizeof(unsigned) * _estimatedNnz );
+    memcpy( otherCsr->_JA, _JA, sizeof(unsigned) * _nnz );
 }
 
 void CSRMatrix::getRow( unsigned row, SparseUnsortedList *result ) const
@@ -274,7 +300,11 @@ void CSRMatrix::getRow( unsigned row, SparseUnsortedList *result ) const
     */
     result->clear();
     for ( unsigned i = _IA[row]; i < _IA[row + 1]; ++i )
-        result->set( _JA[i], _A[i] );
+    {
+        // The columns of a row are distinct, so no lookup is needed
+        if ( !FloatUtils::isZero( _A[i] ) )
+            result->append( _JA[i], _A[i] );
+    }
 }
 
 void CSRMatrix::getRowDense( unsigned row, double *result ) const
@@ -517,6 +547,22 @@ void CSRMatrix::addEmptyColumn()
     ++_n;
 }
 
+void CSRMatrix::truncate( unsigned m, unsigned n )
+{
+    ASSERT( m <= _m && n <= _n );
+
+    // Rows are stored consecutively, so dropping the last rows
+    // amounts to dropping the tail of _A and _JA
+    _nnz = _IA[m];
+    _m = m;
+    _n = n;
+
+    DEBUG({
+            for ( unsigned i = 0; i < _nnz; ++i )
+                ASSERT( _JA[i] < _n );
+        });
+}
+
 unsigned CSRMatrix::getNnz() const
 {
     return _nnz;
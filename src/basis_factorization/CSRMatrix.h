@@ -54,6 +54,13 @@ public:
     void initialize( const double *M, unsigned m, unsigned n );
     void initializeToEmpty( unsigned m, unsigned n );
 
+    /*
+      Create an empty object with room for the given number of
+      elements, for callers that know the number of non-zeros in
+      advance. The capacity still grows if it is exceeded.
+    */
+    void initializeToEmpty( unsigned m, unsigned n, unsigned estimatedNnz );
+
     /*
       Obtain a single element/row/column of the matrix.
     */
@@ -76,6 +83,13 @@ public:
      */
     void addEmptyColumn();
 
+    /*
+      Shrink the matrix to its top-left m x n block, discarding the
+      last rows and columns. The discarded columns are assumed to
+      have non-zero entries only in the discarded rows.
+    */
+    void truncate( unsigned m, unsigned n );
+
     /*
       A mechanism for storing a set of changes to the matrix,
       and then executing them all at once to reduce overhead
@@ -167,6 +181,12 @@ private:
     */
     unsigned _estimatedNnz;
 
+    /*
+      The number of rows that _IA has room for. It grows geometrically
+      when rows are added.
+    */
+    unsigned _allocatedRows;
+
     /*
       If too many elements are stored for the current
       arrays' capacity, increase their size.
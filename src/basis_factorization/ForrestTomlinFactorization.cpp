@@ -392,6 +392,11 @@ void ForrestTomlinFactorization::forwardTransformation( const double *y, double
         x[i] = _workW[_Q._rowOrdering[i]];
 }
 
+void ForrestTomlinFactorization::forwardTransformation( const double *y, double *x, unsigned numVectors ) const
+{
+    forwardTransformationOneByOne( y, x, _m, numVectors );
+}
+
 void ForrestTomlinFactorization::backwardTransformation( const double *y, double *x ) const
 {
     /*
@@ -60,6 +60,12 @@ public:
     */
     void forwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Perform several forward transformations at once. The vectors are
+      transformed one by one.
+    */
+    void forwardTransformation( const double *y, double *x, unsigned numVectors ) const;
+
     /*
       Perform a forward transformation, i.e. find x such that xB = y.
       Result needs to be of size m.
@@ -16,9 +16,11 @@
 #ifndef __IBasisFactorization_h__
 #define __IBasisFactorization_h__
 
+#include "BasisFactorizationError.h"
+#include "SparseUnsortedList.h"
+
 class SparseColumnsOfBasis;
 class SparseMatrix;
-class SparseUnsortedList;
 class Statistics;
 
 class IBasisFactorization
@@ -73,6 +75,51 @@ public:
     */
     virtual void backwardTransformation( const double *y, double *x ) const = 0;
 
+    /*
+      Sparse variants of the forward and backward transformations, for
+      right hand sides with few non-zero entries (e.g., a column of A or
+      a unit vector). Both y and x are of size m. Factorizations that
+      cannot exploit the sparsity go through the dense transformations.
+    */
+    virtual void forwardTransformation( const SparseUnsortedList &y, SparseUnsortedList &x ) const
+    {
+        unsigned m = y.getSize();
+        double *dense = new double[2 * m];
+        if ( !dense )
+            throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                           "IBasisFactorization::dense" );
+
+        y.toDense( dense );
+        forwardTransformation( dense, dense + m );
+        x.initialize( dense + m, m );
+
+        delete[] dense;
+    }
+
+    virtual void backwardTransformation( const SparseUnsortedList &y, SparseUnsortedList &x ) const
+    {
+        unsigned m = y.getSize();
+        double *dense = new double[2 * m];
+        if ( !dense )
+            throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                           "IBasisFactorization::dense" );
+
+        y.toDense( dense );
+        backwardTransformation( dense, dense + m );
+        x.initialize( dense + m, m );
+
+        delete[] dense;
+    }
+
+    /*
+      Perform several forward transformations at once, i.e. find X such
+      that BX = Y, where X and Y have numVectors columns. Both are
+      stored row by row: entry i of vector r is at index
+      i * numVectors + r. This way, each elimination step of the
+      factorization updates contiguous memory for all the vectors.
+    */
+    virtual void forwardTransformation( const double *y, double *x, unsigned numVectors ) const = 0;
+
     /*
       Store/restore the basis factorization.
     */
@@ -118,6 +165,32 @@ public:
 
 protected:
     const BasisColumnOracle *_basisColumnOracle;
+
+    /*
+      A fallback for factorizations that do not handle multiple right
+      hand sides directly: perform the forward transformations one
+      vector at a time.
+    */
+    void forwardTransformationOneByOne( const double *y, double *x, unsigned m, unsigned numVectors ) const
+    {
+        double *dense = new double[2 * m];
+        if ( !dense )
+            throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                           "IBasisFactorization::dense" );
+
+        for ( unsigned r = 0; r < numVectors; ++r )
+        {
+            for ( unsigned i = 0; i < m; ++i )
+                dense[i] = y[i * numVectors + r];
+
+            forwardTransformation( dense, dense + m );
+
+            for ( unsigned i = 0; i < m; ++i )
+                x[i * numVectors + r] = dense[m + i];
+        }
+
+        delete[] dense;
+    }
 };
 
 #endif // __IBasisFactorization_h__
@@ -129,6 +129,11 @@ void LUFactorization::forwardTransformation( const double *y, double *x ) const
     }
 }
 
+void LUFactorization::forwardTransformation( const double *y, double *x, unsigned numVectors ) const
+{
+    forwardTransformationOneByOne( y, x, _m, numVectors );
+}
+
 void LUFactorization::backwardTransformation( const double *y, double *x ) const
 {
     /*
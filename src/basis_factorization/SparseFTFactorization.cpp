@@ -20,6 +20,8 @@
 #include "MalformedBasisException.h"
 #include "SparseFTFactorization.h"
 
+#include <algorithm>
+
 SparseFTFactorization::SparseFTFactorization( unsigned m, const BasisColumnOracle &basisColumnOracle )
     : IBasisFactorization( basisColumnOracle )
     , _B( m )
@@ -31,6 +33,9 @@ SparseFTFactorization::SparseFTFactorization( unsigned m, const BasisColumnOracl
     , _z2( NULL )
     , _z3( NULL )
     , _z4( NULL )
+    , _sparseWork( NULL )
+    , _sparseIndices( NULL )
+    , _sparseMarked( NULL )
 {
     _z1 = new double[m];
     if ( !_z1 )
@@ -47,6 +52,20 @@ SparseFTFactorization::SparseFTFactorization( unsigned m, const BasisColumnOracl
     _z4 = new double[m];
     if ( !_z4 )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseFTFactorization::z4" );
+
+    _sparseWork = new double[m];
+    if ( !_sparseWork )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseFTFactorization::sparseWork" );
+    std::fill_n( _sparseWork, m, 0.0 );
+
+    _sparseIndices = new unsigned[m];
+    if ( !_sparseIndices )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseFTFactorization::sparseIndices" );
+
+    _sparseMarked = new bool[m];
+    if ( !_sparseMarked )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseFTFactorization::sparseMarked" );
+    std::fill_n( _sparseMarked, m, false );
 }
 
 SparseFTFactorization::~SparseFTFactorization()
@@ -81,6 +100,24 @@ void SparseFTFactorization::freeIfNeeded()
         delete[] _z4;
         _z4 = NULL;
     }
+
+    if ( _sparseWork )
+    {
+        delete[] _sparseWork;
+        _sparseWork = NULL;
+    }
+
+    if ( _sparseIndices )
+    {
+        delete[] _sparseIndices;
+        _sparseIndices = NULL;
+    }
+
+    if ( _sparseMarked )
+    {
+        delete[] _sparseMarked;
+        _sparseMarked = NULL;
+    }
 }
 
 const double *SparseFTFactorization::getBasis() const
@@ -325,6 +362,26 @@ void SparseFTFactorization::forwardTransformation( const double *y, double *x )
     _sparseLUFactors.vForwardTransformation( _z2, x );
 }
 
+void SparseFTFactorization::forwardTransformation( const double *y, double *x, unsigned numVectors ) const
+{
+    /*
+      As in the single vector case, B = FHV
+    */
+    double *work = new double[2 * _m * numVectors];
+    if ( !work )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseFTFactorization::work" );
+
+    double *z1 = work;
+    double *z2 = work + _m * numVectors;
+
+    _sparseLUFactors.fForwardTransformation( y, z1, numVectors );
+    hForwardTransformation( z1, z2, numVectors );
+    _sparseLUFactors.vForwardTransformation( z2, x, numVectors );
+
+    delete[] work;
+}
+
 void SparseFTFactorization::backwardTransformation( const double *y, double *x ) const
 {
     /*
@@ -343,6 +400,77 @@ void SparseFTFactorization::backwardTransformation( const double *y, double *x )
     _sparseLUFactors.fBackwardTransformation( _z2, x );
 }
 
+void SparseFTFactorization::forwardTransformation( const SparseUnsortedList &y, SparseUnsortedList &x ) const
+{
+    if ( !useHypersparseTransformation( y.getNnz() ) )
+    {
+        y.toDense( _sparseWork );
+        forwardTransformation( _sparseWork, _z4 );
+        x.initialize( _z4, _m );
+        std::fill_n( _sparseWork, _m, 0.0 );
+        return;
+    }
+
+    unsigned nnz = 0;
+    for ( const auto &entry : y )
+    {
+        _sparseWork[entry._index] = entry._value;
+        _sparseIndices[nnz++] = entry._index;
+    }
+
+    // Eliminate F, H and V, as in the dense case
+    _sparseLUFactors.fForwardTransformation( _sparseWork, _sparseIndices, nnz );
+    hForwardTransformation( _sparseWork, _sparseIndices, nnz );
+    _sparseLUFactors.vForwardTransformation( _sparseWork, _sparseIndices, nnz );
+
+    extractHypersparseResult( nnz, x );
+}
+
+void SparseFTFactorization::backwardTransformation( const SparseUnsortedList &y, SparseUnsortedList &x ) const
+{
+    if ( !useHypersparseTransformation( y.getNnz() ) )
+    {
+        y.toDense( _sparseWork );
+        backwardTransformation( _sparseWork, _z4 );
+        x.initialize( _z4, _m );
+        std::fill_n( _sparseWork, _m, 0.0 );
+        return;
+    }
+
+    unsigned nnz = 0;
+    for ( const auto &entry : y )
+    {
+        _sparseWork[entry._index] = entry._value;
+        _sparseIndices[nnz++] = entry._index;
+    }
+
+    // Eliminate V, H and F, as in the dense case
+    _sparseLUFactors.vBackwardTransformation( _sparseWork, _sparseIndices, nnz );
+    hBackwardTransformation( _sparseWork, _sparseIndices, nnz );
+    _sparseLUFactors.fBackwardTransformation( _sparseWork, _sparseIndices, nnz );
+
+    extractHypersparseResult( nnz, x );
+}
+
+bool SparseFTFactorization::useHypersparseTransformation( unsigned nnz ) const
+{
+    return nnz <= _m * GlobalConfiguration::HYPERSPARSE_TRANSFORMATION_DENSITY_THRESHOLD;
+}
+
+void SparseFTFactorization::extractHypersparseResult( unsigned nnz, SparseUnsortedList &x ) const
+{
+    x.clear();
+    for ( unsigned i = 0; i < nnz; ++i )
+    {
+        unsigned index = _sparseIndices[i];
+        double value = _sparseWork[index];
+        _sparseWork[index] = 0;
+
+        if ( !FloatUtils::isZero( value ) )
+            x.append( index, value );
+    }
+}
+
 void SparseFTFactorization::clearFactorization()
 {
     List<SparseEtaMatrix *>::iterator it;
@@ -456,6 +584,25 @@ void SparseFTFactorization::hForwardTransformation( const double *y, double *x )
     }
 }
 
+void SparseFTFactorization::hForwardTransformation( const double *y, double *x, unsigned numVectors ) const
+{
+    memcpy( x, y, sizeof(double) * _m * numVectors );
+
+    for ( const auto &eta : _etas )
+    {
+        double *pivotRow = x + eta->_columnIndex * numVectors;
+
+        for ( const auto &entry : eta->_sparseColumn )
+        {
+            const double *entryRow = x + entry._index * numVectors;
+            double value = entry._value;
+
+            for ( unsigned r = 0; r < numVectors; ++r )
+                pivotRow[r] -= value * entryRow[r];
+        }
+    }
+}
+
 void SparseFTFactorization::hBackwardTransformation( const double *y, double *x ) const
 {
     /*
@@ -479,6 +626,65 @@ void SparseFTFactorization::hBackwardTransformation( const double *y, double *x
     }
 }
 
+void SparseFTFactorization::hForwardTransformation( double *x, unsigned *indices, unsigned &nnz ) const
+{
+    /*
+      Each eta only changes the pivot entry, which may thus join the
+      list of non-zero entries
+    */
+    for ( unsigned i = 0; i < nnz; ++i )
+        _sparseMarked[indices[i]] = true;
+
+    for ( const auto &eta : _etas )
+    {
+        unsigned pivotIndex = eta->_columnIndex;
+
+        for ( const auto &entry : eta->_sparseColumn )
+            x[pivotIndex] -= entry._value * x[entry._index];
+
+        if ( !_sparseMarked[pivotIndex] && x[pivotIndex] != 0.0 )
+        {
+            _sparseMarked[pivotIndex] = true;
+            indices[nnz++] = pivotIndex;
+        }
+    }
+
+    for ( unsigned i = 0; i < nnz; ++i )
+        _sparseMarked[indices[i]] = false;
+}
+
+void SparseFTFactorization::hBackwardTransformation( double *x, unsigned *indices, unsigned &nnz ) const
+{
+    /*
+      Each eta changes the entries of its column, using the pivot entry
+    */
+    for ( unsigned i = 0; i < nnz; ++i )
+        _sparseMarked[indices[i]] = true;
+
+    for ( auto eta = _etas.rbegin(); eta != _etas.rend(); ++eta )
+    {
+        unsigned pivotIndex = (*eta)->_columnIndex;
+        double pivotValue = x[pivotIndex];
+        if ( pivotValue == 0.0 )
+            continue;
+
+        for ( const auto &entry : (*eta)->_sparseColumn )
+        {
+            unsigned entryIndex = entry._index;
+            x[entryIndex] -= entry._value * pivotValue;
+
+            if ( !_sparseMarked[entryIndex] )
+            {
+                _sparseMarked[entryIndex] = true;
+                indices[nnz++] = entryIndex;
+            }
+        }
+    }
+
+    for ( unsigned i = 0; i < nnz; ++i )
+        _sparseMarked[indices[i]] = false;
+}
+
 void SparseFTFactorization::fixPForL()
 {
     if ( !_sparseLUFactors._usePForF )
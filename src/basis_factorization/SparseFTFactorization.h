@@ -65,12 +65,27 @@ public:
     */
     void forwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Perform several forward transformations at once, applying each
+      of the F, H and V factors to all the vectors together.
+    */
+    void forwardTransformation( const double *y, double *x, unsigned numVectors ) const;
+
     /*
       Perform a backward transformation, i.e. find x such that x = y * inv(B),
       The solution is found by solving xB = y.
     */
     void backwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Hypersparse variants of the transformations. Each of the F, H and
+      V factors is solved only over the entries reachable from the
+      non-zeros of y, unless y is too dense for this to pay off.
+      Both y and x are of size m.
+    */
+    void forwardTransformation( const SparseUnsortedList &y, SparseUnsortedList &x ) const;
+    void backwardTransformation( const SparseUnsortedList &y, SparseUnsortedList &x ) const;
+
     /*
       Store and restore the basis factorization.
     */
@@ -144,11 +159,40 @@ private:
     double *_z3;
     double *_z4;
 
+    /*
+      Work memory for the hypersparse transformations: a dense vector
+      that is all zeros between transformations, the indices of its
+      non-zero entries, and marks for these indices.
+    */
+    mutable double *_sparseWork;
+    mutable unsigned *_sparseIndices;
+    mutable bool *_sparseMarked;
+
     /*
       Transformations on the H matrix (the list of etas)
     */
     void hForwardTransformation( const double *y, double *x ) const;
     void hBackwardTransformation( const double *y, double *x ) const;
+    void hForwardTransformation( const double *y, double *x, unsigned numVectors ) const;
+
+    /*
+      Hypersparse transformations on the H matrix, in the format of
+      the hypersparse SparseLUFactors transformations
+    */
+    void hForwardTransformation( double *x, unsigned *indices, unsigned &nnz ) const;
+    void hBackwardTransformation( double *x, unsigned *indices, unsigned &nnz ) const;
+
+    /*
+      Returns true iff a right hand side with the given number of
+      non-zero entries should be transformed hypersparsely
+    */
+    bool useHypersparseTransformation( unsigned nnz ) const;
+
+    /*
+      Move the result of a hypersparse transformation from the work
+      memory into x, leaving the work memory zeroed
+    */
+    void extractHypersparseResult( unsigned nnz, SparseUnsortedList &x ) const;
 
     /*
       Free any allocated memory.
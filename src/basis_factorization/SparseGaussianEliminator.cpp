@@ -22,35 +22,74 @@
 #include "MalformedBasisException.h"
 #include "SparseGaussianEliminator.h"
 
+#include <algorithm>
 #include <cstdio>
 
 SparseGaussianEliminator::SparseGaussianEliminator( unsigned m )
     : _m( m )
     , _work( NULL )
-    , _work2( NULL )
+    , _columnMarked( NULL )
     , _statistics( NULL )
-    , _numURowElements( NULL )
-    , _numUColumnElements( NULL )
+    , _numVRowElements( NULL )
+    , _numVColumnElements( NULL )
+    , _rowBucketHead( NULL )
+    , _nextRowInBucket( NULL )
+    , _previousRowInBucket( NULL )
+    , _columnBucketHead( NULL )
+    , _nextColumnInBucket( NULL )
+    , _previousColumnInBucket( NULL )
 {
     _work = new double[_m];
     if ( !_work )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
                                        "SparseGaussianEliminator::work" );
+    std::fill_n( _work, _m, 0.0 );
 
-    _work2 = new double[_m];
-    if ( !_work2 )
+    _columnMarked = new bool[_m];
+    if ( !_columnMarked )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
-                                       "SparseGaussianEliminator::work2" );
+                                       "SparseGaussianEliminator::columnMarked" );
+    std::fill_n( _columnMarked, _m, false );
 
-    _numURowElements = new unsigned[_m];
-    if ( !_numURowElements )
+    _numVRowElements = new unsigned[_m];
+    if ( !_numVRowElements )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
-                                       "SparseGaussianEliminator::numURowElements" );
+                                       "SparseGaussianEliminator::numVRowElements" );
 
-    _numUColumnElements = new unsigned[_m];
-    if ( !_numUColumnElements )
+    _numVColumnElements = new unsigned[_m];
+    if ( !_numVColumnElements )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
-                                       "SparseGaussianEliminator::numUColumnElements" );
+                                       "SparseGaussianEliminator::numVColumnElements" );
+
+    _rowBucketHead = new unsigned[_m + 1];
+    if ( !_rowBucketHead )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::rowBucketHead" );
+
+    _nextRowInBucket = new unsigned[_m];
+    if ( !_nextRowInBucket )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::nextRowInBucket" );
+
+    _previousRowInBucket = new unsigned[_m];
+    if ( !_previousRowInBucket )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::previousRowInBucket" );
+
+    _columnBucketHead = new unsigned[_m + 1];
+    if ( !_columnBucketHead )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::columnBucketHead" );
+
+    _nextColumnInBucket = new unsigned[_m];
+    if ( !_nextColumnInBucket )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::nextColumnInBucket" );
+
+    _previousColumnInBucket = new unsigned[_m];
+    if ( !_previousColumnInBucket )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseGaussianEliminator::previousColumnInBucket" );
 }
 
 SparseGaussianEliminator::~SparseGaussianEliminator()
@@ -61,22 +100,58 @@ SparseGaussianEliminator::~SparseGaussianEliminator()
         _work = NULL;
     }
 
-    if ( _work2 )
+    if ( _columnMarked )
     {
-        delete[] _work2;
-        _work2 = NULL;
+        delete[] _columnMarked;
+        _columnMarked = NULL;
     }
 
-    if ( _numURowElements )
+    if ( _numVRowElements )
     {
-        delete[] _numURowElements;
-        _numURowElements = NULL;
+        delete[] _numVRowElements;
+        _numVRowElements = NULL;
     }
 
-    if ( _numUColumnElements )
+    if ( _numVColumnElements )
     {
-        delete[] _numUColumnElements;
-        _numUColumnElements = NULL;
+        delete[] _numVColumnElements;
+        _numVColumnElements = NULL;
+    }
+
+    if ( _rowBucketHead )
+    {
+        delete[] _rowBucketHead;
+        _rowBucketHead = NULL;
+    }
+
+    if ( _nextRowInBucket )
+    {
+        delete[] _nextRowInBucket;
+        _nextRowInBucket = NULL;
+    }
+
+    if ( _previousRowInBucket )
+    {
+        delete[] _previousRowInBucket;
+        _previousRowInBucket = NULL;
+    }
+
+    if ( _columnBucketHead )
+    {
+        delete[] _columnBucketHead;
+        _columnBucketHead = NULL;
+    }
+
+    if ( _nextColumnInBucket )
+    {
+        delete[] _nextColumnInBucket;
+        _nextColumnInBucket = NULL;
+    }
+
+    if ( _previousColumnInBucket )
+    {
+        delete[] _previousColumnInBucket;
+        _previousColumnInBucket = NULL;
     }
 }
 
@@ -105,7 +180,16 @@ void SparseGaussianEliminator::initializeFactorization( const SparseColumnsOfBas
     _sparseLUFactors->_Q.resetToIdentity();
 
     // Count number of non-zeros in U ( = V )
-    _sparseLUFactors->_V->countElements( _numURowElements, _numUColumnElements );
+    _sparseLUFactors->_V->countElements( _numVRowElements, _numVColumnElements );
+
+    // Initially, all rows and columns are in the active submatrix
+    std::fill_n( _rowBucketHead, _m + 1, _m );
+    std::fill_n( _columnBucketHead, _m + 1, _m );
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        addRowToBucket( i );
+        addColumnToBucket( i );
+    }
 
     // Use same matrix P for L and V
     _sparseLUFactors->_usePForF = false;
@@ -121,16 +205,6 @@ void SparseGaussianEliminator::permute()
 
     _sparseLUFactors->_P.swapColumns( _uPivotRow, _eliminationStep );
     _sparseLUFactors->_Q.swapRows( _uPivotColumn, _eliminationStep );
-
-    // Adjust the element counters
-    unsigned temp;
-    temp = _numURowElements[_uPivotRow];
-    _numURowElements[_uPivotRow] = _numURowElements[_eliminationStep];
-    _numURowElements[_eliminationStep] = temp;
-
-    temp = _numUColumnElements[_uPivotColumn];
-    _numUColumnElements[_uPivotColumn] = _numUColumnElements[_eliminationStep];
-    _numUColumnElements[_eliminationStep] = temp;
 }
 
 void SparseGaussianEliminator::run( const SparseColumnsOfBasis *A, SparseLUFactors *sparseLUFactors )
@@ -214,166 +288,246 @@ void SparseGaussianEliminator::choosePivot()
       equation, and let q_j denote the number of non-zero elements
       in the q'th column.
 
-      We pick a pivot a_ij \neq 0 that minimizes (p_i - 1)(q_i - 1).
+      We pick a pivot a_ij \neq 0 that minimizes (p_i - 1)(q_i - 1),
+      among the elements whose magnitude is within the pivot scale
+      threshold of the largest element in their column.
     */
 
-    const SparseUnsortedArray *sparseRow;
-    const SparseUnsortedArray *sparseColumn;
-    const SparseUnsortedArray::Entry *entry;
-    unsigned nnz;
+    // An empty row or column means that the matrix is singular
+    if ( _rowBucketHead[0] != _m )
+        throw BasisFactorizationError( BasisFactorizationError::GAUSSIAN_ELIMINATION_FAILED,
+                                       "Have a zero row" );
 
-    // If there's a singleton row, use it as the pivot row
-    for ( unsigned i = _eliminationStep; i < _m; ++i )
-    {
-        if ( _numURowElements[i] == 1 )
-        {
-            _uPivotRow = i;
-            _vPivotRow = _sparseLUFactors->_P._columnOrdering[i];
+    if ( _columnBucketHead[0] != _m )
+        throw BasisFactorizationError( BasisFactorizationError::GAUSSIAN_ELIMINATION_FAILED,
+                                       "Have a zero column" );
 
-            // Get the singleton element
-            sparseRow = _sparseLUFactors->_V->getRow( _vPivotRow );
+    if ( chooseSingletonPivot() )
+        return;
 
-            ASSERT( sparseRow->getNnz() == 1U );
+    /*
+      No singletons. Go over the columns and rows in increasing order of
+      their element counts. The search stops when no remaining element
+      can beat the best candidate so far, or after a bounded number of
+      additional rows and columns have been examined.
+
+      Once all columns and rows with count at most c have been examined,
+      any remaining element has a row count and a column count of at
+      least c + 1, and hence a Markowitz cost of at least c * c.
+    */
+    unsigned minimalCost = _m * _m;
+    double absPivotElement = 0.0;
+    bool found = false;
+    unsigned searched = 0;
+    bool done = false;
 
-            entry = sparseRow->getArray();
+    for ( unsigned count = 2; !done && count <= _m - _eliminationStep; ++count )
+    {
+        for ( unsigned vColumn = _columnBucketHead[count];
+              !done && vColumn != _m;
+              vColumn = _nextColumnInBucket[vColumn] )
+        {
+            double maxInColumn = maxInActiveColumn( vColumn );
 
-            _vPivotColumn = entry->_index;
-            _uPivotColumn = _sparseLUFactors->_Q._columnOrdering[_vPivotColumn];
-            _pivotElement = entry->_value;
+            const SparseUnsortedArray *sparseColumn = _sparseLUFactors->_Vt->getRow( vColumn );
+            const SparseUnsortedArray::Entry *entry = sparseColumn->getArray();
+            unsigned nnz = sparseColumn->getNnz();
 
-            SGAUSSIAN_LOG( Stringf( "Choose pivot selected a pivot (singleton row): V[%u,%u] = %lf",
-                          _vPivotRow,
-                          _vPivotColumn,
-                          _pivotElement ).ascii() );
-            return;
-        }
-    }
+            for ( unsigned i = 0; i < nnz; ++i )
+            {
+                // Ignore entries that are not in the active submatrix
+                if ( !isActiveRow( entry[i]._index ) )
+                    continue;
 
-    // If there's a singleton column, use it as the pivot column
-    for ( unsigned i = _eliminationStep; i < _m; ++i )
-    {
-        if ( _numUColumnElements[i] == 1 )
-        {
-            _uPivotColumn = i;
-            _vPivotColumn = _sparseLUFactors->_Q._rowOrdering[i];
+                considerPivotCandidate( entry[i]._index, vColumn, entry[i]._value, maxInColumn,
+                                        minimalCost, absPivotElement, found );
+            }
 
-            // Get the singleton element
-            sparseColumn = _sparseLUFactors->_Vt->getRow( _vPivotColumn );
-            entry = sparseColumn->getArray();
-            nnz = sparseColumn->getNnz();
+            if ( found && ( ++searched >= GlobalConfiguration::GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT ) )
+                done = true;
+        }
 
-            // There may be some elements in higher rows - we need just the one
-            // in the active submatrix.
+        if ( found && minimalCost <= ( count - 1 ) * count )
+            done = true;
 
-            DEBUG( bool found = false; );
+        for ( unsigned vRow = _rowBucketHead[count];
+              !done && vRow != _m;
+              vRow = _nextRowInBucket[vRow] )
+        {
+            const SparseUnsortedArray *sparseRow = _sparseLUFactors->_V->getRow( vRow );
+            const SparseUnsortedArray::Entry *entry = sparseRow->getArray();
+            unsigned nnz = sparseRow->getNnz();
 
             for ( unsigned i = 0; i < nnz; ++i )
             {
-                unsigned vRow = entry[i]._index;
-                unsigned uRow = _sparseLUFactors->_P._rowOrdering[vRow];
-
-                if ( uRow >= _eliminationStep )
-                {
-                    DEBUG( found = true; );
+                // Ignore entries that are not in the active submatrix
+                unsigned vColumn = entry[i]._index;
+                if ( !isActiveColumn( vColumn ) )
+                    continue;
 
-                    _vPivotRow = vRow;
-                    _uPivotRow = uRow;
-                    _pivotElement = entry[i]._value;
-
-                    break;
-                }
+                considerPivotCandidate( vRow, vColumn, entry[i]._value, maxInActiveColumn( vColumn ),
+                                        minimalCost, absPivotElement, found );
             }
 
-            ASSERT( found );
-
-            SGAUSSIAN_LOG( Stringf( "Choose pivot selected a pivot (singleton column): V[%u,%u] = %lf",
-                          _vPivotRow,
-                          _vPivotColumn,
-                          _pivotElement ).ascii() );
-            return;
+            if ( found && ( ++searched >= GlobalConfiguration::GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT ) )
+                done = true;
         }
+
+        if ( found && minimalCost <= count * count )
+            done = true;
     }
 
-    // No singletons, apply the Markowitz rule. Find the element with acceptable
-    // magnitude that has the smallet Markowitz value.
-    // Fail if no elements exists that are within acceptable magnitude
+    if ( !found )
+        throw BasisFactorizationError( BasisFactorizationError::GAUSSIAN_ELIMINATION_FAILED,
+                                       "Couldn't find a pivot" );
 
-    // Todo: more clever heuristics to reduce the search space
-    unsigned minimalCost = _m * _m;
-    _pivotElement = 0.0;
-    double absPivotElement = 0.0;
+    _uPivotRow = _sparseLUFactors->_P._rowOrdering[_vPivotRow];
+    _uPivotColumn = _sparseLUFactors->_Q._columnOrdering[_vPivotColumn];
 
-    bool found = false;
-    for ( unsigned uColumn = _eliminationStep; uColumn < _m; ++uColumn )
+    SGAUSSIAN_LOG( Stringf( "Choose pivot selected a pivot: V[%u,%u] = %lf (cost %u)", _vPivotRow, _vPivotColumn, _pivotElement, minimalCost ).ascii() );
+}
+
+bool SparseGaussianEliminator::chooseSingletonPivot()
+{
+    /*
+      Singletons are eliminated first. A singleton column, e.g. the
+      column of a slack variable, requires no elimination at all.
+    */
+    if ( _columnBucketHead[1] != _m )
     {
-        unsigned vColumn = _sparseLUFactors->_Q._rowOrdering[uColumn];
-        sparseColumn = _sparseLUFactors->_Vt->getRow( vColumn );
+        _vPivotColumn = _columnBucketHead[1];
+        _uPivotColumn = _sparseLUFactors->_Q._columnOrdering[_vPivotColumn];
 
-        double maxInColumn = 0;
-        nnz = sparseColumn->getNnz();
-        entry = sparseColumn->getArray();
+        // There may be some elements in higher rows - we need just the one
+        // in the active submatrix.
+        const SparseUnsortedArray *sparseColumn = _sparseLUFactors->_Vt->getRow( _vPivotColumn );
+        const SparseUnsortedArray::Entry *entry = sparseColumn->getArray();
+        unsigned nnz = sparseColumn->getNnz();
+
+        DEBUG( bool found = false; );
 
         for ( unsigned i = 0; i < nnz; ++i )
         {
-            // Ignore entrying that are not in the active submatrix
-            unsigned vRow = entry[i]._index;
-            unsigned uRow = _sparseLUFactors->_P._rowOrdering[vRow];
-            if ( uRow < _eliminationStep )
-                continue;
-
-            double contender = FloatUtils::abs( entry[i]._value );
-            if ( FloatUtils::gt( contender, maxInColumn ) )
-                maxInColumn = contender;
-        }
+            if ( isActiveRow( entry[i]._index ) )
+            {
+                DEBUG( found = true; );
 
-        if ( FloatUtils::isZero( maxInColumn ) )
-        {
-            throw BasisFactorizationError( BasisFactorizationError::GAUSSIAN_ELIMINATION_FAILED,
-                                           "Have a zero column" );
+                _vPivotRow = entry[i]._index;
+                _uPivotRow = _sparseLUFactors->_P._rowOrdering[_vPivotRow];
+                _pivotElement = entry[i]._value;
+                break;
+            }
         }
 
-        for ( unsigned i = 0; i < nnz; ++i )
-        {
-            unsigned vRow = entry[i]._index;
-            unsigned uRow = _sparseLUFactors->_P._rowOrdering[vRow];
+        ASSERT( found );
+
+        SGAUSSIAN_LOG( Stringf( "Choose pivot selected a pivot (singleton column): V[%u,%u] = %lf",
+                                _vPivotRow,
+                                _vPivotColumn,
+                                _pivotElement ).ascii() );
+        return true;
+    }
 
-            // Ignore entrying that are not in the active submatrix
-            if ( uRow < _eliminationStep )
-                continue;
+    if ( _rowBucketHead[1] != _m )
+    {
+        _vPivotRow = _rowBucketHead[1];
+        _uPivotRow = _sparseLUFactors->_P._rowOrdering[_vPivotRow];
+
+        const SparseUnsortedArray *sparseRow = _sparseLUFactors->_V->getRow( _vPivotRow );
+        const SparseUnsortedArray::Entry *entry = sparseRow->getArray();
+        unsigned nnz = sparseRow->getNnz();
 
-            double contender = entry[i]._value;
-            double absContender = FloatUtils::abs( contender );
+        DEBUG( bool found = false; );
 
-            // Only consider large-enough elements
-            if ( FloatUtils::gt( absContender,
-                                 maxInColumn * GlobalConfiguration::GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD ) )
+        for ( unsigned i = 0; i < nnz; ++i )
+        {
+            if ( isActiveColumn( entry[i]._index ) )
             {
-                unsigned cost = ( _numURowElements[uRow] - 1 ) * ( _numUColumnElements[uColumn] - 1 );
-
-                ASSERT( ( cost != minimalCost ) || found );
-
-                if ( ( cost < minimalCost ) ||
-                     ( ( cost == minimalCost ) && FloatUtils::gt( absContender, absPivotElement ) ) )
-                {
-                    minimalCost = cost;
-                    _uPivotRow = uRow;
-                    _uPivotColumn = uColumn;
-                    _vPivotRow = vRow;
-                    _vPivotColumn = vColumn;
-                    _pivotElement = contender;
-                    absPivotElement = absContender;
-
-                    found = true;
-                }
+                DEBUG( found = true; );
+
+                _vPivotColumn = entry[i]._index;
+                _uPivotColumn = _sparseLUFactors->_Q._columnOrdering[_vPivotColumn];
+                _pivotElement = entry[i]._value;
+                break;
             }
         }
+
+        ASSERT( found );
+
+        SGAUSSIAN_LOG( Stringf( "Choose pivot selected a pivot (singleton row): V[%u,%u] = %lf",
+                                _vPivotRow,
+                                _vPivotColumn,
+                                _pivotElement ).ascii() );
+        return true;
     }
 
-    if ( !found )
+    return false;
+}
+
+void SparseGaussianEliminator::considerPivotCandidate( unsigned vRow,
+                                                       unsigned vColumn,
+                                                       double value,
+                                                       double maxInColumn,
+                                                       unsigned &minimalCost,
+                                                       double &absPivotElement,
+                                                       bool &found )
+{
+    double absValue = FloatUtils::abs( value );
+
+    // Only consider large-enough elements
+    if ( !FloatUtils::gt( absValue,
+                          maxInColumn * GlobalConfiguration::GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD ) )
+        return;
+
+    unsigned cost = ( _numVRowElements[vRow] - 1 ) * ( _numVColumnElements[vColumn] - 1 );
+
+    if ( ( cost < minimalCost ) ||
+         ( ( cost == minimalCost ) && FloatUtils::gt( absValue, absPivotElement ) ) )
+    {
+        minimalCost = cost;
+        _vPivotRow = vRow;
+        _vPivotColumn = vColumn;
+        _pivotElement = value;
+        absPivotElement = absValue;
+
+        found = true;
+    }
+}
+
+double SparseGaussianEliminator::maxInActiveColumn( unsigned vColumn ) const
+{
+    const SparseUnsortedArray *sparseColumn = _sparseLUFactors->_Vt->getRow( vColumn );
+    const SparseUnsortedArray::Entry *entry = sparseColumn->getArray();
+    unsigned nnz = sparseColumn->getNnz();
+
+    double maxInColumn = 0;
+    for ( unsigned i = 0; i < nnz; ++i )
+    {
+        if ( !isActiveRow( entry[i]._index ) )
+            continue;
+
+        double contender = FloatUtils::abs( entry[i]._value );
+        if ( contender > maxInColumn )
+            maxInColumn = contender;
+    }
+
+    if ( FloatUtils::isZero( maxInColumn ) )
+    {
         throw BasisFactorizationError( BasisFactorizationError::GAUSSIAN_ELIMINATION_FAILED,
-                                       "Couldn't find a pivot" );
+                                       "Have a zero column" );
+    }
 
-    SGAUSSIAN_LOG( Stringf( "Choose pivot selected a pivot: V[%u,%u] = %lf (cost %u)", _vPivotRow, _vPivotColumn, _pivotElement, minimalCost ).ascii() );
+    return maxInColumn;
+}
+
+bool SparseGaussianEliminator::isActiveRow( unsigned vRow ) const
+{
+    return _sparseLUFactors->_P._rowOrdering[vRow] >= _eliminationStep;
+}
+
+bool SparseGaussianEliminator::isActiveColumn( unsigned vColumn ) const
+{
+    return _sparseLUFactors->_Q._columnOrdering[vColumn] >= _eliminationStep;
 }
 
 void SparseGaussianEliminator::eliminate()
@@ -383,21 +537,27 @@ void SparseGaussianEliminator::eliminate()
     /*
       Eliminate all entries below the pivot element U[k,k]
       We know that V[_vPivotRow, _vPivotColumn] = U[k,k].
+
+      The pivot row and column are not eliminated per se, but they are
+      excluded from the active submatrix. After the permutation, the
+      active submatrix consists of the U rows and columns past k.
     */
+    removeRowFromBucket( _vPivotRow );
+    removeColumnFromBucket( _vPivotColumn );
 
     // Get the pivot row in dense format, due to repeated access
-    _sparseLUFactors->_V->getRowDense( _vPivotRow, _work );
+    const SparseUnsortedArray *pivotRow = _sparseLUFactors->_V->getRow( _vPivotRow );
+    const SparseUnsortedArray::Entry *pivotEntry = pivotRow->getArray();
+    unsigned pivotRowNnz = pivotRow->getNnz();
 
-    /*
-      The pivot row is not eliminated per se, but it is excluded
-      from the active submatrix, so we adjust the element counters
-    */
-    _numURowElements[_eliminationStep] = 0;
-    for ( unsigned uColumn = _eliminationStep; uColumn < _m; ++uColumn )
+    for ( unsigned i = 0; i < pivotRowNnz; ++i )
     {
-        unsigned vColumn = _sparseLUFactors->_Q._rowOrdering[uColumn];
-        if ( !FloatUtils::isZero( _work[vColumn] ) )
-            --_numUColumnElements[uColumn];
+        unsigned vColumn = pivotEntry[i]._index;
+        if ( vColumn == _vPivotColumn || !isActiveColumn( vColumn ) )
+            continue;
+
+        _work[vColumn] = pivotEntry[i]._value;
+        decrementColumnCount( vColumn );
     }
 
     // Process all rows below the pivot row
@@ -423,66 +583,172 @@ void SparseGaussianEliminator::eliminate()
         */
         double rowMultiplier = - entry[index]._value / _pivotElement;
 
-        // Get the row being eliminated in dense format
-        _sparseLUFactors->_V->getRowDense( vRow, _work2 );
-
         // Eliminate the sub-diagonal entry
-        --_numUColumnElements[_eliminationStep];
-        --_numURowElements[uRow];
         sparseColumn->erase( index );
-        _work2[_vPivotColumn] = 0;
+        eliminateRow( vRow, rowMultiplier );
 
-        // Handle the rest of the row
-        for ( unsigned vColumnIndex = 0; vColumnIndex < _m; ++vColumnIndex )
+        /*
+          Store the row multiplier in matrix F, using F = PLP'.
+          F's rows are ordered same as V's
+        */
+        _sparseLUFactors->_F->set( vRow, fColumn, -rowMultiplier );
+        _sparseLUFactors->_Ft->set( fColumn, vRow, -rowMultiplier );
+    }
+
+    // Clear the dense pivot row
+    for ( unsigned i = 0; i < pivotRowNnz; ++i )
+        _work[pivotEntry[i]._index] = 0;
+
+    // Store the pivot element
+    _sparseLUFactors->_vDiagonalElements[_vPivotRow] = _pivotElement;
+}
+
+void SparseGaussianEliminator::eliminateRow( unsigned vRow, double rowMultiplier )
+{
+    /*
+      Add rowMultiplier times the pivot row to the row. Entries that
+      the row shares with the pivot row are updated in place, and the
+      remaining entries of the pivot row are fill-in.
+    */
+    removeRowFromBucket( vRow );
+
+    SparseUnsortedArray *sparseRow = _sparseLUFactors->_V->getRow( vRow );
+    SparseUnsortedArray::Entry *entry = sparseRow->getArray();
+
+    unsigned index = 0;
+    while ( index < sparseRow->getNnz() )
+    {
+        unsigned vColumn = entry[index]._index;
+
+        if ( vColumn == _vPivotColumn )
         {
-            unsigned uColumnIndex = _sparseLUFactors->_Q._columnOrdering[vColumnIndex];
+            // The eliminated entry
+            sparseRow->erase( index );
+            --_numVRowElements[vRow];
+            continue;
+        }
 
-            // Only care about the active submatirx
-            if ( uColumnIndex <= _eliminationStep )
-                continue;
+        double pivotRowValue = _work[vColumn];
+        if ( pivotRowValue == 0.0 )
+        {
+            // The value does not change
+            ++index;
+            continue;
+        }
 
-            // If the value does not change, skip
-            if ( FloatUtils::isZero( _work[vColumnIndex] ) )
-                continue;
+        _columnMarked[vColumn] = true;
 
-            // Value will change
-            double oldValue = _work2[vColumnIndex];
-            bool wasZero = FloatUtils::isZero( oldValue );
-            double newValue = oldValue + ( rowMultiplier * _work[vColumnIndex] );
-            bool isZero = FloatUtils::isZero( newValue );
+        double newValue = entry[index]._value + ( rowMultiplier * pivotRowValue );
 
-            if ( !wasZero && isZero )
-            {
-                newValue = 0;
-                --_numUColumnElements[uColumnIndex];
-                --_numURowElements[uRow];
-            }
-            else if ( wasZero && !isZero )
-            {
-                ++_numUColumnElements[uColumnIndex];
-                ++_numURowElements[uRow];
-            }
+        // Transposed matrix is updated immediately, too
+        if ( FloatUtils::isZero( newValue ) )
+        {
+            sparseRow->erase( index );
+            _sparseLUFactors->_Vt->set( vColumn, vRow, 0 );
+            --_numVRowElements[vRow];
+            decrementColumnCount( vColumn );
+            continue;
+        }
+
+        entry[index]._value = newValue;
+        _sparseLUFactors->_Vt->set( vColumn, vRow, newValue );
+        ++index;
+    }
 
-            _work2[vColumnIndex] = newValue;
+    // Fill-in: entries of the pivot row that the row does not have
+    const SparseUnsortedArray *pivotRow = _sparseLUFactors->_V->getRow( _vPivotRow );
+    const SparseUnsortedArray::Entry *pivotEntry = pivotRow->getArray();
+    unsigned pivotRowNnz = pivotRow->getNnz();
 
-            // Transposed matrix is updated immediately, regular matrix will
-            // be updated when entire row has been processed
-            if ( newValue != oldValue )
-                _sparseLUFactors->_Vt->set( vColumnIndex, vRow, newValue );
+    for ( unsigned i = 0; i < pivotRowNnz; ++i )
+    {
+        unsigned vColumn = pivotEntry[i]._index;
+        if ( _work[vColumn] == 0.0 )
+            continue;
+
+        if ( _columnMarked[vColumn] )
+        {
+            _columnMarked[vColumn] = false;
+            continue;
         }
 
-        _sparseLUFactors->_V->updateSingleRow( vRow, _work2 );
+        double newValue = rowMultiplier * _work[vColumn];
+        if ( FloatUtils::isZero( newValue ) )
+            continue;
 
-        /*
-          Store the row multiplier in matrix F, using F = PLP'.
-          F's rows are ordered same as V's
-        */
-        _sparseLUFactors->_F->set( vRow, fColumn, -rowMultiplier );
-        _sparseLUFactors->_Ft->set( fColumn, vRow, -rowMultiplier );
+        sparseRow->append( vColumn, newValue );
+        _sparseLUFactors->_Vt->append( vColumn, vRow, newValue );
+        ++_numVRowElements[vRow];
+        incrementColumnCount( vColumn );
     }
 
-    // Store the pivot element
-    _sparseLUFactors->_vDiagonalElements[_vPivotRow] = _pivotElement;
+    addRowToBucket( vRow );
+}
+
+void SparseGaussianEliminator::addRowToBucket( unsigned vRow )
+{
+    unsigned count = _numVRowElements[vRow];
+    unsigned head = _rowBucketHead[count];
+
+    _previousRowInBucket[vRow] = _m;
+    _nextRowInBucket[vRow] = head;
+    if ( head != _m )
+        _previousRowInBucket[head] = vRow;
+    _rowBucketHead[count] = vRow;
+}
+
+void SparseGaussianEliminator::removeRowFromBucket( unsigned vRow )
+{
+    unsigned previous = _previousRowInBucket[vRow];
+    unsigned next = _nextRowInBucket[vRow];
+
+    if ( previous == _m )
+        _rowBucketHead[_numVRowElements[vRow]] = next;
+    else
+        _nextRowInBucket[previous] = next;
+
+    if ( next != _m )
+        _previousRowInBucket[next] = previous;
+}
+
+void SparseGaussianEliminator::addColumnToBucket( unsigned vColumn )
+{
+    unsigned count = _numVColumnElements[vColumn];
+    unsigned head = _columnBucketHead[count];
+
+    _previousColumnInBucket[vColumn] = _m;
+    _nextColumnInBucket[vColumn] = head;
+    if ( head != _m )
+        _previousColumnInBucket[head] = vColumn;
+    _columnBucketHead[count] = vColumn;
+}
+
+void SparseGaussianEliminator::removeColumnFromBucket( unsigned vColumn )
+{
+    unsigned previous = _previousColumnInBucket[vColumn];
+    unsigned next = _nextColumnInBucket[vColumn];
+
+    if ( previous == _m )
+        _columnBucketHead[_numVColumnElements[vColumn]] = next;
+    else
+        _nextColumnInBucket[previous] = next;
+
+    if ( next != _m )
+        _previousColumnInBucket[next] = previous;
+}
+
+void SparseGaussianEliminator::decrementColumnCount( unsigned vColumn )
+{
+    removeColumnFromBucket( vColumn );
+    --_numVColumnElements[vColumn];
+    addColumnToBucket( vColumn );
+}
+
+void SparseGaussianEliminator::incrementColumnCount( unsigned vColumn )
+{
+    removeColumnFromBucket( vColumn );
+    ++_numVColumnElements[vColumn];
+    addColumnToBucket( vColumn );
 }
 
 void SparseGaussianEliminator::setStatistics( Statistics *statistics )
@@ -63,10 +63,12 @@ private:
     SparseLUFactors *_sparseLUFactors;
 
     /*
-      Work memory
+      Work memory: the pivot row in dense format (all zeros between
+      elimination steps), and marks for the columns of the pivot row
+      encountered while eliminating a row
     */
     double *_work;
-    double *_work2;
+    bool *_columnMarked;
 
     /*
       An object for reporting statistics
@@ -74,17 +76,54 @@ private:
     Statistics *_statistics;
 
     /*
-      Information on the number of non-zero elements in
-      every row of the current active submatrix of U
+      The number of non-zero elements in every row and column of the
+      active submatrix, indexed by the rows and columns of V
     */
-    unsigned *_numURowElements;
-    unsigned *_numUColumnElements;
+    unsigned *_numVRowElements;
+    unsigned *_numVColumnElements;
+
+    /*
+      The rows and columns of the active submatrix, bucketed by their
+      number of non-zero elements. Every bucket is a doubly linked
+      list, with _m marking the end of the list.
+    */
+    unsigned *_rowBucketHead;
+    unsigned *_nextRowInBucket;
+    unsigned *_previousRowInBucket;
+    unsigned *_columnBucketHead;
+    unsigned *_nextColumnInBucket;
+    unsigned *_previousColumnInBucket;
 
     void choosePivot();
     void initializeFactorization( const SparseColumnsOfBasis *A, SparseLUFactors *sparseLUFactors );
     void factorize();
     void permute();
     void eliminate();
+
+    /*
+      Helpers for the pivot selection
+    */
+    bool chooseSingletonPivot();
+    void considerPivotCandidate( unsigned vRow, unsigned vColumn, double value, double maxInColumn,
+                                 unsigned &minimalCost, double &absPivotElement, bool &found );
+    double maxInActiveColumn( unsigned vColumn ) const;
+    bool isActiveRow( unsigned vRow ) const;
+    bool isActiveColumn( unsigned vColumn ) const;
+
+    /*
+      Eliminate the pivot column from a row of the active submatrix
+    */
+    void eliminateRow( unsigned vRow, double rowMultiplier );
+
+    /*
+      Maintain the row and column buckets
+    */
+    void addRowToBucket( unsigned vRow );
+    void removeRowFromBucket( unsigned vRow );
+    void addColumnToBucket( unsigned vColumn );
+    void removeColumnFromBucket( unsigned vColumn );
+    void decrementColumnCount( unsigned vColumn );
+    void incrementColumnCount( unsigned vColumn );
 };
 
 #endif // __SparseGaussianEliminator_h__
@@ -123,6 +123,11 @@ void SparseLUFactorization::forwardTransformation( const double *y, double *x )
     }
 }
 
+void SparseLUFactorization::forwardTransformation( const double *y, double *x, unsigned numVectors ) const
+{
+    forwardTransformationOneByOne( y, x, _m, numVectors );
+}
+
 void SparseLUFactorization::backwardTransformation( const double *y, double *x ) const
 {
     /*
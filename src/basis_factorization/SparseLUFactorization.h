@@ -66,6 +66,12 @@ public:
     */
     void forwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Perform several forward transformations at once. The vectors are
+      transformed one by one.
+    */
+    void forwardTransformation( const double *y, double *x, unsigned numVectors ) const;
+
     /*
       Perform a backward transformation, i.e. find x such that x = y * inv(B),
       The solution is found by solving xB = y.
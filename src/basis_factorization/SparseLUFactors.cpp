@@ -19,6 +19,8 @@
 #include "MString.h"
 #include "SparseLUFactors.h"
 
+#include <algorithm>
+
 SparseLUFactors::SparseLUFactors( unsigned m )
     : _m( m )
     , _F( NULL )
@@ -33,6 +35,10 @@ SparseLUFactors::SparseLUFactors( unsigned m )
     , _z( NULL )
     , _workMatrix( NULL )
     , _workVector( NULL )
+    , _reach( NULL )
+    , _dfsStack( NULL )
+    , _dfsPosition( NULL )
+    , _dfsMarked( NULL )
 {
     _F = new SparseUnsortedArrays();
     if ( !_F )
@@ -65,6 +71,23 @@ SparseLUFactors::SparseLUFactors( unsigned m )
     _workVector = new double[m];
     if ( !_workVector )
         throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::workVector" );
+
+    _reach = new unsigned[m];
+    if ( !_reach )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::reach" );
+
+    _dfsStack = new unsigned[m];
+    if ( !_dfsStack )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::dfsStack" );
+
+    _dfsPosition = new unsigned[m];
+    if ( !_dfsPosition )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::dfsPosition" );
+
+    _dfsMarked = new bool[m];
+    if ( !_dfsMarked )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseLUFactors::dfsMarked" );
+    std::fill_n( _dfsMarked, m, false );
 }
 
 SparseLUFactors::~SparseLUFactors()
@@ -116,6 +139,30 @@ SparseLUFactors::~SparseLUFactors()
         delete[] _workVector;
         _workVector = NULL;
     }
+
+    if ( _reach )
+    {
+        delete[] _reach;
+        _reach = NULL;
+    }
+
+    if ( _dfsStack )
+    {
+        delete[] _dfsStack;
+        _dfsStack = NULL;
+    }
+
+    if ( _dfsPosition )
+    {
+        delete[] _dfsPosition;
+        _dfsPosition = NULL;
+    }
+
+    if ( _dfsMarked )
+    {
+        delete[] _dfsMarked;
+        _dfsMarked = NULL;
+    }
 }
 
 void SparseLUFactors::dump() const
@@ -404,6 +451,321 @@ void SparseLUFactors::vBackwardTransformation( const double *y, double *x ) cons
     }
 }
 
+const SparseUnsortedArray *SparseLUFactors::getAdjacentNodes( TransformationType type, unsigned node ) const
+{
+    switch ( type )
+    {
+    case F_FORWARD:
+        // Entry fColumn of x is used to update the entries in column fColumn of F
+        return _Ft->getRow( node );
+
+    case F_BACKWARD:
+        // Entry fRow of x is used to update the entries in row fRow of F
+        return _F->getRow( node );
+
+    case V_FORWARD:
+        // Entry vRow of y determines entry vColumn of x, which is then used to
+        // update the entries in column vColumn of V
+        return _Vt->getRow( _Q._rowOrdering[_P._rowOrdering[node]] );
+
+    case V_BACKWARD:
+        // Entry vColumn of y determines entry vRow of x, which is then used to
+        // update the entries in row vRow of V
+        return _V->getRow( _P._columnOrdering[_Q._columnOrdering[node]] );
+    }
+
+    return NULL;
+}
+
+unsigned SparseLUFactors::computeReach( TransformationType type, const unsigned *indices, unsigned nnz ) const
+{
+    /*
+      A non-recursive depth-first search from each of the indices. A node is
+      placed in _reach once all of its descendants are placed, and _reach is
+      filled from the end, so that it ends up topologically sorted: every node
+      appears before all the nodes that depend on it.
+    */
+    unsigned top = _m;
+
+    for ( unsigned k = 0; k < nnz; ++k )
+    {
+        if ( _dfsMarked[indices[k]] )
+            continue;
+
+        int head = 0;
+        _dfsStack[0] = indices[k];
+        _dfsMarked[indices[k]] = true;
+        _dfsPosition[0] = 0;
+
+        while ( head >= 0 )
+        {
+            unsigned node = _dfsStack[head];
+            const SparseUnsortedArray *adjacent = getAdjacentNodes( type, node );
+            const SparseUnsortedArray::Entry *entry = adjacent->getArray();
+            unsigned adjacentNnz = adjacent->getNnz();
+
+            bool done = true;
+            for ( unsigned i = _dfsPosition[head]; i < adjacentNnz; ++i )
+            {
+                unsigned next = entry[i]._index;
+                if ( _dfsMarked[next] )
+                    continue;
+
+                // Resume from the following entry when we return to this node
+                _dfsPosition[head] = i + 1;
+
+                ++head;
+                _dfsStack[head] = next;
+                _dfsMarked[next] = true;
+                _dfsPosition[head] = 0;
+
+                done = false;
+                break;
+            }
+
+            if ( done )
+            {
+                --head;
+                _reach[--top] = node;
+            }
+        }
+    }
+
+    // Clear the marks for the next search
+    for ( unsigned i = top; i < _m; ++i )
+        _dfsMarked[_reach[i]] = false;
+
+    return top;
+}
+
+void SparseLUFactors::fForwardTransformation( double *x, unsigned *indices, unsigned &nnz ) const
+{
+    /*
+      The same elimination as in the dense fForwardTransformation, but going
+      only over the reachable columns of F, in topological order. Entries of x
+      that are not in the initial pattern are zero, as required.
+    */
+    unsigned top = computeReach( F_FORWARD, indices, nnz );
+
+    nnz = 0;
+    for ( unsigned k = top; k < _m; ++k )
+    {
+        unsigned fColumn = _reach[k];
+        indices[nnz++] = fColumn;
+
+        double xElement = x[fColumn];
+        if ( xElement != 0.0 )
+        {
+            const SparseUnsortedArray *sparseColumn = _Ft->getRow( fColumn );
+            const SparseUnsortedArray::Entry *entry = sparseColumn->getArray();
+            unsigned columnNnz = sparseColumn->getNnz();
+
+            for ( unsigned i = 0; i < columnNnz; ++i )
+                x[entry[i]._index] -= xElement * entry[i]._value;
+        }
+    }
+}
+
+void SparseLUFactors::fBackwardTransformation( double *x, unsigned *indices, unsigned &nnz ) const
+{
+    unsigned top = computeReach( F_BACKWARD, indices, nnz );
+
+    nnz = 0;
+    for ( unsigned k = top; k < _m; ++k )
+    {
+        unsigned fRow = _reach[k];
+        indices[nnz++] = fRow;
+
+        double xElement = x[fRow];
+        if ( xElement != 0.0 )
+        {
+            const SparseUnsortedArray *sparseRow = _F->getRow( fRow );
+            const SparseUnsortedArray::Entry *entry = sparseRow->getArray();
+            unsigned rowNnz = sparseRow->getNnz();
+
+            for ( unsigned i = 0; i < rowNnz; ++i )
+                x[entry[i]._index] -= xElement * entry[i]._value;
+        }
+    }
+}
+
+void SparseLUFactors::vForwardTransformation( double *x, unsigned *indices, unsigned &nnz ) const
+{
+    /*
+      The right hand side is indexed by V rows and the solution by V
+      columns, so the right hand side is moved into the work vector
+      first. Only the reachable entries of the work vector are used.
+    */
+    unsigned top = computeReach( V_FORWARD, indices, nnz );
+
+    for ( unsigned k = top; k < _m; ++k )
+        _workVector[_reach[k]] = 0;
+
+    for ( unsigned k = 0; k < nnz; ++k )
+    {
+        _workVector[indices[k]] = x[indices[k]];
+        x[indices[k]] = 0;
+    }
+
+    nnz = 0;
+    for ( unsigned k = top; k < _m; ++k )
+    {
+        unsigned vRow = _reach[k];
+        unsigned vColumn = _Q._rowOrdering[_P._rowOrdering[vRow]];
+        indices[nnz++] = vColumn;
+
+        double xElement = x[vColumn] = ( _workVector[vRow] / _vDiagonalElements[vRow] );
+        if ( xElement != 0.0 )
+        {
+            const SparseUnsortedArray *sparseColumn = _Vt->getRow( vColumn );
+            const SparseUnsortedArray::Entry *entry = sparseColumn->getArray();
+            unsigned columnNnz = sparseColumn->getNnz();
+
+            for ( unsigned i = 0; i < columnNnz; ++i )
+                _workVector[entry[i]._index] -= xElement * entry[i]._value;
+        }
+    }
+}
+
+void SparseLUFactors::vBackwardTransformation( double *x, unsigned *indices, unsigned &nnz ) const
+{
+    /*
+      As in vForwardTransformation, but the right hand side is indexed
+      by V columns and the solution by V rows.
+    */
+    unsigned top = computeReach( V_BACKWARD, indices, nnz );
+
+    for ( unsigned k = top; k < _m; ++k )
+        _workVector[_reach[k]] = 0;
+
+    for ( unsigned k = 0; k < nnz; ++k )
+    {
+        _workVector[indices[k]] = x[indices[k]];
+        x[indices[k]] = 0;
+    }
+
+    nnz = 0;
+    for ( unsigned k = top; k < _m; ++k )
+    {
+        unsigned vColumn = _reach[k];
+        unsigned vRow = _P._columnOrdering[_Q._columnOrdering[vColumn]];
+        indices[nnz++] = vRow;
+
+        double xElement = x[vRow] = ( _workVector[vColumn] / _vDiagonalElements[vRow] );
+        if ( xElement != 0.0 )
+        {
+            const SparseUnsortedArray *sparseRow = _V->getRow( vRow );
+            const SparseUnsortedArray::Entry *entry = sparseRow->getArray();
+            unsigned rowNnz = sparseRow->getNnz();
+
+            for ( unsigned i = 0; i < rowNnz; ++i )
+                _workVector[entry[i]._index] -= xElement * entry[i]._value;
+        }
+    }
+}
+
+void SparseLUFactors::fForwardTransformation( const double *y, double *x, unsigned numVectors ) const
+{
+    /*
+      Same as the single vector case: each column of F is applied to
+      all the vectors at once.
+    */
+    memcpy( x, y, sizeof(double) * _m * numVectors );
+
+    const PermutationMatrix *p = ( _usePForF ) ? &_PForF : &_P;
+    const SparseUnsortedArray *sparseColumn;
+    const SparseUnsortedArray::Entry *entry;
+    unsigned nnz;
+
+    for ( unsigned lColumn = 0; lColumn < _m; ++lColumn )
+    {
+        unsigned fColumn = p->_columnOrdering[lColumn];
+        const double *xRow = x + fColumn * numVectors;
+
+        bool allZero = true;
+        for ( unsigned r = 0; r < numVectors; ++r )
+        {
+            if ( xRow[r] != 0.0 )
+            {
+                allZero = false;
+                break;
+            }
+        }
+
+        if ( allZero )
+            continue;
+
+        sparseColumn = _Ft->getRow( fColumn );
+        entry = sparseColumn->getArray();
+        nnz = sparseColumn->getNnz();
+
+        for ( unsigned i = 0; i < nnz; ++i )
+        {
+            double *targetRow = x + entry[i]._index * numVectors;
+            double value = entry[i]._value;
+
+            for ( unsigned r = 0; r < numVectors; ++r )
+                targetRow[r] -= xRow[r] * value;
+        }
+    }
+}
+
+void SparseLUFactors::vForwardTransformation( const double *y, double *x, unsigned numVectors ) const
+{
+    /*
+      Same as the single vector case, with a work matrix (indexed by
+      the rows of V) in place of the work vector.
+    */
+    double *work = new double[_m * numVectors];
+    if ( !work )
+        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED,
+                                       "SparseLUFactors::work" );
+
+    memcpy( work, y, sizeof(double) * _m * numVectors );
+
+    const SparseUnsortedArray *sparseColumn;
+    const SparseUnsortedArray::Entry *entry;
+    unsigned nnz;
+
+    for ( int uRow = _m - 1; uRow >= 0; --uRow )
+    {
+        unsigned vRow = _P._columnOrdering[uRow];
+        unsigned vColumn = _Q._rowOrdering[uRow];
+
+        double diagonalElement = _vDiagonalElements[vRow];
+        const double *workRow = work + vRow * numVectors;
+        double *xRow = x + vColumn * numVectors;
+
+        // Set the (final) value of this entry of all the vectors
+        bool allZero = true;
+        for ( unsigned r = 0; r < numVectors; ++r )
+        {
+            xRow[r] = workRow[r] / diagonalElement;
+            if ( xRow[r] != 0.0 )
+                allZero = false;
+        }
+
+        if ( allZero )
+            continue;
+
+        // Eliminate this entry from all other entries
+        sparseColumn = _Vt->getRow( vColumn );
+        entry = sparseColumn->getArray();
+        nnz = sparseColumn->getNnz();
+
+        for ( unsigned i = 0; i < nnz; ++i )
+        {
+            double *targetRow = work + entry[i]._index * numVectors;
+            double value = entry[i]._value;
+
+            for ( unsigned r = 0; r < numVectors; ++r )
+                targetRow[r] -= xRow[r] * value;
+        }
+    }
+
+    delete[] work;
+}
+
 void SparseLUFactors::forwardTransformation( const double *y, double *x ) const
 {
     /*
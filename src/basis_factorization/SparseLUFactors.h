@@ -110,6 +110,31 @@ public:
     void vForwardTransformation( const double *y, double *x ) const;
     void vBackwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Hypersparse variants of the triangular solves. The vector is
+      stored densely in x, and the indices of its non-zero entries are
+      listed in the first nnz entries of indices; all other entries of
+      x must be zero. Only the entries reachable from these indices in
+      the graph of F (or V) are computed, so the cost is proportional
+      to the number of non-zeros involved, rather than to m.
+
+      On exit, x holds the solution and indices/nnz list the entries
+      that may be non-zero. For the V transformations the vector is
+      indexed by V rows on one side and by V columns on the other.
+    */
+    void fForwardTransformation( double *x, unsigned *indices, unsigned &nnz ) const;
+    void fBackwardTransformation( double *x, unsigned *indices, unsigned &nnz ) const;
+    void vForwardTransformation( double *x, unsigned *indices, unsigned &nnz ) const;
+    void vBackwardTransformation( double *x, unsigned *indices, unsigned &nnz ) const;
+
+    /*
+      Variants of the F and V forward transformations for several
+      right hand sides at once. The vectors are stored row by row:
+      entry i of vector r is at index i * numVectors + r.
+    */
+    void fForwardTransformation( const double *y, double *x, unsigned numVectors ) const;
+    void vForwardTransformation( const double *y, double *x, unsigned numVectors ) const;
+
     /*
       Compute the inverse of the factorized basis
     */
@@ -122,6 +147,17 @@ public:
     double *_workMatrix;
     double *_workVector;
 
+    /*
+      Work memory for the hypersparse transformations: the nodes
+      reached by a depth-first search, a search stack with the
+      position reached in each node's adjacency list, and visit marks
+      (which are all false between searches).
+    */
+    unsigned *_reach;
+    unsigned *_dfsStack;
+    unsigned *_dfsPosition;
+    bool *_dfsMarked;
+
     /*
       Clone this SparseLUFactors object into another object
     */
@@ -131,6 +167,30 @@ public:
       For debugging purposes
     */
     void dump() const;
+
+private:
+    /*
+      The matrix graphs traversed by the hypersparse transformations
+    */
+    enum TransformationType {
+        F_FORWARD = 0,
+        F_BACKWARD,
+        V_FORWARD,
+        V_BACKWARD,
+    };
+
+    /*
+      The entries whose values depend on the given node: a column of F,
+      a row of F, or the column/row of V matching a V row/column.
+    */
+    const SparseUnsortedArray *getAdjacentNodes( TransformationType type, unsigned node ) const;
+
+    /*
+      Compute the set of nodes reachable from the given indices. The
+      nodes are stored in _reach[top.._m-1] in topological order, and
+      top is returned.
+    */
+    unsigned computeReach( TransformationType type, const unsigned *indices, unsigned nnz ) const;
 };
 
 #endif // __SparseLUFactors_h__
@@ -52,6 +52,13 @@ public:
      */
     virtual void addEmptyColumn() = 0;
 
+    /*
+      Shrink the matrix to its top-left m x n block, discarding the
+      last rows and columns. The discarded columns are assumed to
+      have non-zero entries only in the discarded rows.
+    */
+    virtual void truncate( unsigned m, unsigned n ) = 0;
+
     /*
       A mechanism for storing a set of changes to the matrix,
       and then executing them all at once to reduce overhead
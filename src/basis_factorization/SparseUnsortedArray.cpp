@@ -135,6 +135,11 @@ const SparseUnsortedArray::Entry *SparseUnsortedArray::getArray() const
     return _array;
 }
 
+SparseUnsortedArray::Entry *SparseUnsortedArray::getArray()
+{
+    return _array;
+}
+
 void SparseUnsortedArray::dump() const
 {
     printf( "\nDumping otherSparseUnsortedList: (nnz = %u)\n", _nnz );
@@ -79,6 +79,12 @@ public:
     Entry getByArrayIndex( unsigned index ) const;
     const Entry *getArray() const;
 
+    /*
+      Direct access to the underlying array, for changing values in
+      place. The array is invalidated by append and set.
+    */
+    Entry *getArray();
+
     /*
       Convert the unsortedList to dense format
     */
@@ -18,29 +18,83 @@
 #include "FloatUtils.h"
 #include "SparseUnsortedList.h"
 
+#include <cstring>
+
 SparseUnsortedList::SparseUnsortedList()
     : _size( 0 )
+    , _array( NULL )
+    , _nnz( 0 )
+    , _allocatedSize( 0 )
 {
 }
 
 SparseUnsortedList::SparseUnsortedList( unsigned size )
     : _size( size )
+    , _array( NULL )
+    , _nnz( 0 )
+    , _allocatedSize( 0 )
 {
 }
 
 SparseUnsortedList::SparseUnsortedList( const double *V, unsigned size )
+    : _size( 0 )
+    , _array( NULL )
+    , _nnz( 0 )
+    , _allocatedSize( 0 )
 {
     initialize( V, size );
 }
 
+SparseUnsortedList::SparseUnsortedList( const SparseUnsortedList &other )
+    : _size( 0 )
+    , _array( NULL )
+    , _nnz( 0 )
+    , _allocatedSize( 0 )
+{
+    other.storeIntoOther( this );
+}
+
 SparseUnsortedList::~SparseUnsortedList()
 {
+    freeMemoryIfNeeded();
+}
+
+void SparseUnsortedList::freeMemoryIfNeeded()
+{
+    if ( _array )
+    {
+        delete[] _array;
+        _array = NULL;
+    }
+
+    _allocatedSize = 0;
+    _nnz = 0;
+}
+
+void SparseUnsortedList::reserve( unsigned capacity )
+{
+    if ( capacity <= _allocatedSize )
+        return;
+
+    unsigned newSize = _allocatedSize > 0 ? _allocatedSize : (unsigned)MINIMAL_CAPACITY;
+    while ( newSize < capacity )
+        newSize *= 2;
+
+    Entry *newArray = new Entry[newSize];
+    if ( _nnz > 0 )
+        memcpy( newArray, _array, sizeof(Entry) * _nnz );
+
+    if ( _array )
+        delete[] _array;
+
+    _array = newArray;
+    _allocatedSize = newSize;
 }
 
 void SparseUnsortedList::initialize( const double *V, unsigned size )
 {
     _size = size;
-    _list.clear();
+    _nnz = 0;
 
     for ( unsigned i = 0; i < _size; ++i )
     {
@@ -48,31 +102,36 @@ void SparseUnsortedList::initialize( const double *V, unsigned size )
         if ( FloatUtils::isZero( V[i] ) )
             continue;
 
-        _list.append( Entry( i, V[i] ) );
+        append( i, V[i] );
     }
 }
 
+void SparseUnsortedList::initializeToEmpty()
+{
+    _nnz = 0;
+}
+
 void SparseUnsortedList::clear()
 {
-    _list.clear();
+    _nnz = 0;
 }
 
 unsigned SparseUnsortedList::getNnz() const
 {
-    return _list.size();
+    return _nnz;
 }
 
 bool SparseUnsortedList::empty() const
 {
-    return _list.empty();
+    return _nnz == 0;
 }
 
 double SparseUnsortedList::get( unsigned entry ) const
 {
-    for ( const auto &listEntry : _list )
+    for ( unsigned i = 0; i < _nnz; ++i )
     {
-        if ( listEntry._index == entry )
-            return listEntry._value;
+        if ( _array[i]._index == entry )
+            return _array[i]._value;
     }
 
     return 0;
@@ -80,8 +139,8 @@ double SparseUnsortedList::get( unsigned entry ) const
 
 void SparseUnsortedList::dump() const
 {
-    printf( "\nDumping sparse unsortedList: (nnz = %u)\n", _list.size() );
-    for ( const auto &entry : _list )
+    printf( "\nDumping sparse unsortedList: (nnz = %u)\n", _nnz );
+    for ( const auto &entry : *this )
         printf( "\tEntry %u: %6.2lf\n", entry._index, entry._value );
     printf( "\n" );
 }
@@ -101,14 +160,14 @@ void SparseUnsortedList::toDense( double *result ) const
 {
     std::fill_n( result, _size, 0 );
 
-    for ( const auto &entry : _list )
-        result[entry._index] = entry._value;
+    for ( unsigned i = 0; i < _nnz; ++i )
+        result[_array[i]._index] = _array[i]._value;
 }
 
 SparseUnsortedList &SparseUnsortedList::operator=( const SparseUnsortedList &other )
 {
-    _size = other._size;
-    _list = other._list;
+    if ( this != &other )
+        other.storeIntoOther( this );
 
     return *this;
 }
@@ -116,27 +175,32 @@ SparseUnsortedList &SparseUnsortedList::operator=( const SparseUnsortedList &oth
 void SparseUnsortedList::storeIntoOther( SparseUnsortedList *other ) const
 {
     other->_size = _size;
-    other->_list = _list;
+    other->_nnz = 0;
+    other->reserve( _nnz );
+
+    if ( _nnz > 0 )
+        memcpy( other->_array, _array, sizeof(Entry) * _nnz );
+    other->_nnz = _nnz;
 }
 
-List<SparseUnsortedList::Entry>::const_iterator SparseUnsortedList::begin() const
+SparseUnsortedList::const_iterator SparseUnsortedList::begin() const
 {
-    return _list.begin();
+    return _array;
 }
 
-List<SparseUnsortedList::Entry>::const_iterator SparseUnsortedList::end() const
+SparseUnsortedList::const_iterator SparseUnsortedList::end() const
 {
-    return _list.end();
+    return _array + _nnz;
 }
 
-List<SparseUnsortedList::Entry>::iterator SparseUnsortedList::begin()
+SparseUnsortedList::iterator SparseUnsortedList::begin()
 {
-    return _list.begin();
+    return _array;
 }
 
-List<SparseUnsortedList::Entry>::iterator SparseUnsortedList::end()
+SparseUnsortedList::iterator SparseUnsortedList::end()
 {
-    return _list.end();
+    return _array + _nnz;
 }
 
 void SparseUnsortedList::set( unsigned index, double value )
@@ -148,7 +212,7 @@ void SparseUnsortedList::set( unsigned index, double value )
         if ( it->_index == index )
         {
             if ( isZero )
-                _list.erase( it );
+                erase( it );
             else
                 it->_value = value;
 
@@ -157,18 +221,22 @@ void SparseUnsortedList::set( unsigned index, double value )
     }
 
     if ( !isZero )
-        _list.append( Entry( index, value ) );
+        append( index, value );
 }
 
 void SparseUnsortedList::append( unsigned index, double value )
 {
-    _list.append( Entry( index, value ) );
+    if ( _nnz == _allocatedSize )
+        reserve( _nnz + 1 );
+
+    _array[_nnz] = Entry( index, value );
+    ++_nnz;
 }
 
 void SparseUnsortedList::addLastEntry( double entry )
 {
     if ( !FloatUtils::isZero( entry ) )
-        _list.append( Entry( _size, entry ) );
+        append( _size, entry );
 
     ++_size;
 }
@@ -178,51 +246,94 @@ void SparseUnsortedList::incrementSize()
     ++_size;
 }
 
+void SparseUnsortedList::truncate( unsigned size )
+{
+    ASSERT( size <= _size );
+
+    // Compact the surviving entries in a single pass
+    unsigned kept = 0;
+    for ( unsigned i = 0; i < _nnz; ++i )
+    {
+        if ( _array[i]._index < size )
+        {
+            _array[kept] = _array[i];
+            ++kept;
+        }
+    }
+
+    _nnz = kept;
+    _size = size;
+}
+
 void SparseUnsortedList::mergeEntries( unsigned source, unsigned target )
 {
-    List<Entry>::iterator sourceIt = _list.end();
-    List<Entry>::iterator targetIt = _list.end();
-    List<Entry>::iterator it;
+    unsigned sourceIndex = _nnz;
+    unsigned targetIndex = _nnz;
 
-    for ( it = _list.begin(); it != _list.end(); ++it )
+    for ( unsigned i = 0; i < _nnz; ++i )
     {
-        if ( it->_index == source )
+        if ( _array[i]._index == source )
         {
-            sourceIt = it;
-            if ( targetIt != _list.end() )
+            sourceIndex = i;
+            if ( targetIndex != _nnz )
                 break;
         }
 
-        if ( it->_index == target )
+        if ( _array[i]._index == target )
         {
-            targetIt = it;
-            if ( sourceIt != _list.end() )
+            targetIndex = i;
+            if ( sourceIndex != _nnz )
                 break;
         }
     }
 
     // If no source entry exists, we are done
-    if ( sourceIt == _list.end() )
+    if ( sourceIndex == _nnz )
         return;
 
     // If no target entry, simply change index on source entry
-    if ( targetIt == _list.end() )
+    if ( targetIndex == _nnz )
     {
-        sourceIt->_index = target;
+        _array[sourceIndex]._index = target;
         return;
     }
 
     // Both source and target entries
-    targetIt->_value += sourceIt->_value;
+    _array[targetIndex]._value += _array[sourceIndex]._value;
+    bool targetIsZero = FloatUtils::isZero( _array[targetIndex]._value );
+
+    erase( _array + sourceIndex );
+    if ( targetIndex > sourceIndex )
+        --targetIndex;
+
+    if ( targetIsZero )
+        erase( _array + targetIndex );
+}
 
-    _list.erase( sourceIt );
-    if ( FloatUtils::isZero( targetIt->_value ) )
-         _list.erase( targetIt );
+SparseUnsortedList::iterator SparseUnsortedList::erase( iterator it )
+{
+    ASSERT( it >= begin() && it < end() );
+
+    unsigned position = it - _array;
+    if ( position + 1 < _nnz )
+        memmove( _array + position, _array + position + 1, sizeof(Entry) * ( _nnz - position - 1 ) );
+    --_nnz;
+
+    return _array + position;
 }
 
-List<SparseUnsortedList::Entry>::iterator SparseUnsortedList::erase( List<SparseUnsortedList::Entry>::iterator it )
+SparseUnsortedList::iterator SparseUnsortedList::erase( iterator first, iterator last )
 {
-    return _list.erase( it );
+    ASSERT( first >= begin() && first <= last && last <= end() );
+
+    unsigned position = first - _array;
+    unsigned removed = last - first;
+    unsigned tail = end() - last;
+    if ( removed > 0 && tail > 0 )
+        memmove( _array + position, last, sizeof(Entry) * tail );
+    _nnz -= removed;
+
+    return _array + position;
 }
 
 unsigned SparseUnsortedList::getSize() const
@@ -24,6 +24,12 @@ class SparseUnsortedList
 public:
     struct Entry
     {
+        Entry()
+            : _index( 0 )
+            , _value( 0 )
+        {
+        }
+
         Entry( unsigned index, double value )
             : _index( index )
             , _value( value )
@@ -34,6 +40,9 @@ public:
         double _value;
     };
 
+    typedef Entry *iterator;
+    typedef const Entry *const_iterator;
+
     /*
       Initialization: the size determines the dimension of the
       underlying storage.
@@ -45,12 +54,13 @@ public:
     ~SparseUnsortedList();
     SparseUnsortedList( unsigned size );
     SparseUnsortedList( const double *V, unsigned size );
+    SparseUnsortedList( const SparseUnsortedList &other );
     void initialize( const double *V, unsigned size );
     void initializeToEmpty();
 
     /*
       Remove the unsortedList's elements, without touching the
-      allocated memory
+      allocated memory. Takes constant time.
     */
     void clear();
 
@@ -84,6 +94,12 @@ public:
     void addLastEntry( double entry );
     void incrementSize();
 
+    /*
+      Decrease the list size, discarding any entries whose index
+      exceeds the new size
+    */
+    void truncate( unsigned size );
+
     /*
       Cloning
     */
@@ -93,15 +109,26 @@ public:
     /*
       Retrieve entries
     */
-    List<Entry>::const_iterator begin() const;
-    List<Entry>::const_iterator end() const;
-    List<Entry>::iterator begin();
-    List<Entry>::iterator end();
+    const_iterator begin() const;
+    const_iterator end() const;
+    iterator begin();
+    iterator end();
 
     /*
-      Erasing an element by iterator
+      Erasing an element by iterator. The order of the remaining
+      elements is kept, and the returned iterator points to the
+      element that followed the erased one. Other iterators past the
+      erased element are invalidated.
     */
-    List<Entry>::iterator erase( List<Entry>::iterator it );
+    iterator erase( iterator it );
+
+    /*
+      Erasing the elements in [first, last), keeping the order of the
+      remaining elements. Erasing a suffix of the list takes constant
+      time, which allows callers to compact the list in place and then
+      drop the tail.
+    */
+    iterator erase( iterator first, iterator last );
 
     /*
       Addes the coefficient for entry 'source' to entry 'target'
@@ -121,8 +148,22 @@ public:
     void dumpDense() const;
 
 private:
+    /*
+      The entries are stored contiguously. The capacity doubles when
+      exhausted, and is never released until destruction, so that
+      clearing and refilling a list does not allocate.
+    */
     unsigned _size;
-    List<Entry> _list;
+    Entry *_array;
+    unsigned _nnz;
+    unsigned _allocatedSize;
+
+    enum {
+        MINIMAL_CAPACITY = 4,
+    };
+
+    void reserve( unsigned capacity );
+    void freeMemoryIfNeeded();
 };
 
 #endif // __SparseUnsortedList_h__
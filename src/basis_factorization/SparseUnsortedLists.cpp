@@ -145,7 +145,11 @@ void SparseUnsortedLists::getColumn( unsigned column, SparseUnsortedList *result
     result->clear();
 
     for ( unsigned i = 0; i < _m; ++i )
-        result->set( i, _rows[i]->get( column ) );
+    {
+        double value = _rows[i]->get( column );
+        if ( !FloatUtils::isZero( value ) )
+            result->append( i, value );
+    }
 }
 
 void SparseUnsortedLists::getColumnDense( unsigned column, double *result ) const
@@ -237,23 +241,28 @@ void SparseUnsortedLists::dumpDense() const
 
 void SparseUnsortedLists::storeIntoOther( SparseUnsortedLists *other ) const
 {
-    other->freeMemoryIfNeeded();
+    // Reuse the other's rows, and their storage, when the dimensions match
+    if ( !other->_rows || other->_m != _m )
+    {
+        other->freeMemoryIfNeeded();
+
+        other->_rows = new SparseUnsortedList *[_m];
+        if ( !other->_rows )
+            throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseUnsortedLists::otherRows" );
+
+        for ( unsigned i = 0; i < _m; ++i )
+        {
+            other->_rows[i] = new SparseUnsortedList;
+            if ( !other->_rows[i] )
+                throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseUnsortedLists::otherRows[i]" );
+        }
+    }
 
     other->_m = _m;
     other->_n = _n;
 
-    other->_rows = new SparseUnsortedList *[_m];
-    if ( !other->_rows )
-        throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseUnsortedLists::otherRows" );
-
     for ( unsigned i = 0; i < _m; ++i )
-    {
-        other->_rows[i] = new SparseUnsortedList;
-        if ( !other->_rows[i] )
-            throw BasisFactorizationError( BasisFactorizationError::ALLOCATION_FAILED, "SparseUnsortedLists::otherRows[i]" );
-
         _rows[i]->storeIntoOther( other->_rows[i] );
-    }
 }
 
 unsigned SparseUnsortedLists::getNnz() const
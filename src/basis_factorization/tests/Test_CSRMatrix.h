@@ -136,6 +136,46 @@ public:
                 TS_ASSERT_EQUALS( csr1.get( i, j ), expected[i*4 + j] );
     }
 
+    void test_truncate()
+    {
+        double M1[] = {
+            0, 0, 0, 0,
+            5, 8, 0, 0,
+            0, 0, 3, 0,
+        };
+
+        CSRMatrix csr1;
+        csr1.initialize( M1, 3, 4 );
+
+        double row4[] = { 1, 2, 0, 0, 1 };
+        double row5[] = { 0, 2, -3, 0, 0, 1 };
+
+        csr1.addEmptyColumn();
+        csr1.addLastRow( row4 );
+        csr1.addEmptyColumn();
+        csr1.addLastRow( row5 );
+
+        TS_ASSERT_EQUALS( csr1.getNnz(), 9U );
+
+        TS_ASSERT_THROWS_NOTHING( csr1.truncate( 4, 5 ) );
+        TS_ASSERT_EQUALS( csr1.getNnz(), 6U );
+        TS_ASSERT_EQUALS( csr1.get( 3, 4 ), 1 );
+
+        TS_ASSERT_THROWS_NOTHING( csr1.truncate( 3, 4 ) );
+        TS_ASSERT_EQUALS( csr1.getNnz(), 3U );
+
+        for ( unsigned i = 0; i < 3; ++i )
+            for ( unsigned j = 0; j < 4; ++j )
+                TS_ASSERT_EQUALS( csr1.get( i, j ), M1[i*4 + j] );
+
+        // The matrix can grow again
+        double row6[] = { 1, 0, 0, 4, 1 };
+        csr1.addEmptyColumn();
+        csr1.addLastRow( row6 );
+        TS_ASSERT_EQUALS( csr1.getNnz(), 6U );
+        TS_ASSERT_EQUALS( csr1.get( 3, 3 ), 4 );
+    }
+
     void test_add_last_column()
     {
         {
@@ -375,6 +375,152 @@ public:
         TS_ASSERT_THROWS_NOTHING( basis.forwardTransformation( a3, d3 ) );
         TS_ASSERT( memcmp( d3other, d3, sizeof(double) * 3 ) );
     }
+
+    void checkSparseTransformations( const SparseFTFactorization &basis, unsigned m, const double *y )
+    {
+        SparseUnsortedList sparseY( y, m );
+        SparseUnsortedList sparseX( m );
+        double *x = new double[m];
+        double *expected = new double[m];
+
+        TS_ASSERT_THROWS_NOTHING( basis.forwardTransformation( sparseY, sparseX ) );
+        TS_ASSERT_THROWS_NOTHING( basis.forwardTransformation( y, expected ) );
+        sparseX.toDense( x );
+        for ( unsigned i = 0; i < m; ++i )
+            TS_ASSERT( FloatUtils::areEqual( x[i], expected[i] ) );
+
+        TS_ASSERT_THROWS_NOTHING( basis.backwardTransformation( sparseY, sparseX ) );
+        TS_ASSERT_THROWS_NOTHING( basis.backwardTransformation( y, expected ) );
+        sparseX.toDense( x );
+        for ( unsigned i = 0; i < m; ++i )
+            TS_ASSERT( FloatUtils::areEqual( x[i], expected[i] ) );
+
+        delete[] expected;
+        delete[] x;
+    }
+
+    void test_hypersparse_transformations()
+    {
+        const unsigned m = 30;
+        SparseFTFactorization basis( m, *oracle );
+
+        // A sparse, strictly diagonally dominant (hence invertible) basis,
+        // whose factors are not triangular without permutations
+        double B[m * m];
+        std::fill_n( B, m * m, 0.0 );
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            B[i * m + i] += 3 + ( i % 3 );
+            B[i * m + ( 7 * i + 3 ) % m] += 1;
+            B[( ( 11 * i + 1 ) % m ) * m + i] += 1;
+        }
+        oracle->storeBasis( m, B );
+        basis.obtainFreshBasis();
+
+        double y[m];
+
+        // Unit vectors and vectors with two non-zeros
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            std::fill_n( y, m, 0.0 );
+            y[i] = 1;
+            checkSparseTransformations( basis, m, y );
+
+            y[( i + 13 ) % m] = -2.5;
+            checkSparseTransformations( basis, m, y );
+        }
+
+        // Replace a few columns, so that the H factor is non-trivial
+        unsigned columns[] = { 2, 9, 17, 25 };
+        double newColumn[m];
+        for ( unsigned column : columns )
+        {
+            for ( unsigned i = 0; i < m; ++i )
+                newColumn[i] = B[i * m + column];
+            newColumn[( column + 13 ) % m] += 0.5;
+
+            TS_ASSERT_THROWS_NOTHING( basis.updateToAdjacentBasis( column, NULL, newColumn ) );
+
+            for ( unsigned i = 0; i < m; ++i )
+            {
+                std::fill_n( y, m, 0.0 );
+                y[i] = 1;
+                checkSparseTransformations( basis, m, y );
+
+                y[( i + 13 ) % m] = -2.5;
+                checkSparseTransformations( basis, m, y );
+            }
+        }
+
+        // A dense right hand side goes through the dense transformations
+        for ( unsigned i = 0; i < m; ++i )
+            y[i] = i + 1;
+        checkSparseTransformations( basis, m, y );
+    }
+
+    void checkMultipleForwardTransformations( const SparseFTFactorization &basis, unsigned m )
+    {
+        const unsigned numVectors = 5;
+
+        // Vectors with different densities, including an all-zero one
+        double y[m * numVectors];
+        std::fill_n( y, m * numVectors, 0.0 );
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            y[i * numVectors + 0] = ( i == 4 ) ? 1 : 0;
+            y[i * numVectors + 1] = i + 1;
+            y[i * numVectors + 2] = ( i % 7 == 0 ) ? -2.5 : 0;
+            y[i * numVectors + 4] = ( i % 2 == 0 ) ? 1 : -1;
+        }
+
+        double x[m * numVectors];
+        TS_ASSERT_THROWS_NOTHING( basis.forwardTransformation( y, x, numVectors ) );
+
+        double singleY[m];
+        double singleX[m];
+        for ( unsigned r = 0; r < numVectors; ++r )
+        {
+            for ( unsigned i = 0; i < m; ++i )
+                singleY[i] = y[i * numVectors + r];
+
+            basis.forwardTransformation( singleY, singleX );
+
+            for ( unsigned i = 0; i < m; ++i )
+                TS_ASSERT( FloatUtils::areEqual( x[i * numVectors + r], singleX[i] ) );
+        }
+    }
+
+    void test_forward_transformation_multiple_vectors()
+    {
+        const unsigned m = 30;
+        SparseFTFactorization basis( m, *oracle );
+
+        double B[m * m];
+        std::fill_n( B, m * m, 0.0 );
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            B[i * m + i] += 3 + ( i % 3 );
+            B[i * m + ( 7 * i + 3 ) % m] += 1;
+            B[( ( 11 * i + 1 ) % m ) * m + i] += 1;
+        }
+        oracle->storeBasis( m, B );
+        basis.obtainFreshBasis();
+
+        checkMultipleForwardTransformations( basis, m );
+
+        // Replace a few columns, so that the H factor is non-trivial
+        unsigned columns[] = { 2, 9, 17, 25 };
+        double newColumn[m];
+        for ( unsigned column : columns )
+        {
+            for ( unsigned i = 0; i < m; ++i )
+                newColumn[i] = B[i * m + column];
+            newColumn[( column + 13 ) % m] += 0.5;
+
+            TS_ASSERT_THROWS_NOTHING( basis.updateToAdjacentBasis( column, NULL, newColumn ) );
+            checkMultipleForwardTransformations( basis, m );
+        }
+    }
 };
 
 //
@@ -334,6 +334,46 @@ public:
             TS_ASSERT_THROWS_NOTHING( delete ge );
         }
     }
+
+    void test_markowitz_ordering_avoids_fill_in()
+    {
+        /*
+          An arrow matrix: a dense first row and column, and a diagonal.
+          Pivoting on the top-left element first would fill in the entire
+          matrix. Pivoting on the diagonal first causes no fill-in at all.
+        */
+        const unsigned m = 10;
+        double A[m * m];
+        std::fill_n( A, m * m, 0.0 );
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            A[i] = 1;
+            A[i * m] = 1;
+            A[i * m + i] = 4 + i;
+        }
+
+        SparseColumnsOfBasis sparseCols( m );
+        basisIntoSparseColumns( A, m, sparseCols );
+
+        SparseLUFactors lu( m );
+        SparseGaussianEliminator ge( m );
+        TS_ASSERT_THROWS_NOTHING( ge.run( &sparseCols, &lu ) );
+
+        double result[m * m];
+        computeMatrixFromFactorization( &lu, result );
+        for ( unsigned i = 0; i < m * m; ++i )
+            TS_ASSERT( FloatUtils::areEqual( A[i], result[i] ) );
+
+        // The first row loses its entries in the eliminated columns, and
+        // nothing else changes
+        TS_ASSERT_EQUALS( lu._V->getNnz(), 2 * m - 1 );
+        TS_ASSERT_EQUALS( lu._Vt->getNnz(), 2 * m - 1 );
+        TS_ASSERT_EQUALS( lu._F->getNnz(), m - 1 );
+
+        // The last pivot is the top-left element
+        TS_ASSERT_EQUALS( lu._P._columnOrdering[m - 1], 0U );
+        TS_ASSERT_EQUALS( lu._Q._rowOrdering[m - 1], 0U );
+    }
 };
 
 //
@@ -174,6 +174,125 @@ public:
 
         TS_ASSERT_EQUALS( v1.getNnz(), 0U );
     }
+
+    void test_truncate()
+    {
+        SparseUnsortedList v1( 5 );
+
+        v1.set( 0, 4 );
+        v1.set( 3, 3 );
+        v1.set( 4, -7 );
+
+        TS_ASSERT_THROWS_NOTHING( v1.truncate( 3 ) );
+
+        TS_ASSERT_EQUALS( v1.getSize(), 3U );
+        TS_ASSERT_EQUALS( v1.getNnz(), 1U );
+        TS_ASSERT_EQUALS( v1.get( 0 ), 4 );
+
+        TS_ASSERT_THROWS_NOTHING( v1.addLastEntry( 2 ) );
+        TS_ASSERT_EQUALS( v1.getSize(), 4U );
+        TS_ASSERT_EQUALS( v1.get( 3 ), 2 );
+    }
+
+    void test_erase_keeps_order()
+    {
+        double dense[8] = {
+            1, 2, 3, 0, 0, 4, 5, 6
+        };
+
+        SparseUnsortedList v1( dense, 8 );
+
+        // Erase the even values while iterating
+        auto it = v1.begin();
+        while ( it != v1.end() )
+        {
+            if ( ( (int)it->_value ) % 2 == 0 )
+                it = v1.erase( it );
+            else
+                ++it;
+        }
+
+        TS_ASSERT_EQUALS( v1.getNnz(), 3U );
+
+        unsigned expectedIndices[3] = { 0, 2, 6 };
+        unsigned i = 0;
+        for ( const auto &entry : v1 )
+        {
+            TS_ASSERT_EQUALS( entry._index, expectedIndices[i] );
+            ++i;
+        }
+    }
+
+    void test_erase_range()
+    {
+        double dense[8] = {
+            1, 2, 3, 0, 0, 4, 5, 6
+        };
+
+        SparseUnsortedList v1( dense, 8 );
+
+        // Erase from the middle
+        auto it = v1.erase( v1.begin() + 1, v1.begin() + 3 );
+        TS_ASSERT_EQUALS( v1.getNnz(), 4U );
+        TS_ASSERT_EQUALS( it->_index, 5U );
+
+        unsigned expectedIndices[4] = { 0, 5, 6, 7 };
+        unsigned i = 0;
+        for ( const auto &entry : v1 )
+        {
+            TS_ASSERT_EQUALS( entry._index, expectedIndices[i] );
+            ++i;
+        }
+
+        // Erase the tail, and an empty range
+        it = v1.erase( v1.begin() + 2, v1.end() );
+        TS_ASSERT_EQUALS( it, v1.end() );
+        TS_ASSERT_EQUALS( v1.getNnz(), 2U );
+
+        TS_ASSERT_THROWS_NOTHING( v1.erase( v1.begin(), v1.begin() ) );
+        TS_ASSERT_EQUALS( v1.getNnz(), 2U );
+        TS_ASSERT_EQUALS( v1.get( 0 ), 1 );
+        TS_ASSERT_EQUALS( v1.get( 5 ), 4 );
+        TS_ASSERT_EQUALS( v1.get( 6 ), 0 );
+    }
+
+    void test_append_and_store_into_other()
+    {
+        SparseUnsortedList v1( 1000 );
+
+        for ( unsigned i = 0; i < 1000; i += 3 )
+            v1.append( i, i + 1 );
+
+        TS_ASSERT_EQUALS( v1.getNnz(), 334U );
+        TS_ASSERT_EQUALS( v1.get( 999 ), 1000 );
+        TS_ASSERT_EQUALS( v1.get( 998 ), 0 );
+
+        // Storing into a larger list and then a smaller one
+        SparseUnsortedList v2( 5 );
+        v2.set( 1, 7 );
+
+        TS_ASSERT_THROWS_NOTHING( v1.storeIntoOther( &v2 ) );
+        TS_ASSERT_EQUALS( v2.getSize(), 1000U );
+        TS_ASSERT_EQUALS( v2.getNnz(), 334U );
+        TS_ASSERT_EQUALS( v2.get( 1 ), 0 );
+        TS_ASSERT_EQUALS( v2.get( 300 ), 301 );
+
+        v1.clear();
+        TS_ASSERT( v1.empty() );
+        TS_ASSERT_EQUALS( v2.getNnz(), 334U );
+
+        v1.append( 4, 2 );
+        TS_ASSERT_THROWS_NOTHING( v1.storeIntoOther( &v2 ) );
+        TS_ASSERT_EQUALS( v2.getNnz(), 1U );
+        TS_ASSERT_EQUALS( v2.get( 4 ), 2 );
+        TS_ASSERT_EQUALS( v2.get( 300 ), 0 );
+
+        // Copy construction
+        SparseUnsortedList v3( v2 );
+        v2.clear();
+        TS_ASSERT_EQUALS( v3.getNnz(), 1U );
+        TS_ASSERT_EQUALS( v3.get( 4 ), 2 );
+    }
 };
 
 //
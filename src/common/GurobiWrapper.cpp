@@ -249,6 +249,11 @@ bool GurobiWrapper::timeout()
     return _model->get( GRB_IntAttr_Status ) == GRB_TIME_LIMIT;
 }
 
+bool GurobiWrapper::numericalFailure()
+{
+    return _model->get( GRB_IntAttr_Status ) == GRB_NUMERIC;
+}
+
 bool GurobiWrapper::haveFeasibleSolution()
 {
     return _model->get( GRB_IntAttr_SolCount ) > 0;
@@ -93,6 +93,9 @@ public:
     // Returns true iff the instance timed out
     bool timeout();
 
+    // Returns true iff the solver failed for numerical reasons
+    bool numericalFailure();
+
     // Returns true iff a feasible solution has been found
     bool haveFeasibleSolution();
 
@@ -125,51 +128,13 @@ private:
 
 #else
 
-#include "MString.h"
-#include "Map.h"
-
-class GurobiWrapper
-{
-public:
-    /*
-      This is a DUMMY class, for compilation purposes when Gurobi is
-      disabled.
-    */
-    enum VariableType {
-        CONTINUOUS = 0,
-        BINARY = 1,
-    };
-
-    struct Term
-    {
-        Term( double, String ) {}
-        Term() {}
-    };
+#include "NativeLPSolver.h"
 
-    GurobiWrapper() {}
-    ~GurobiWrapper() {}
-
-    void addVariable( String, double, double, VariableType type = CONTINUOUS ) { (void)type; }
-    void setLowerBound( String, double ) {};
-    void setUpperBound( String, double ) {};
-    void addLeqConstraint( const List<Term> &, double ) {}
-    void addGeqConstraint( const List<Term> &, double ) {}
-    void addEqConstraint( const List<Term> &, double ) {}
-    void setCost( const List<Term> & ) {}
-    void setObjective( const List<Term> & ) {}
-    void setCutoff( double ) {};
-    void solve() {}
-    void extractSolution( Map<String, double> &, double & ) {}
-    void reset() {}
-    bool optimal() { return true; }
-    bool cutoffOccurred() { return false; };
-    bool infeasbile() { return false; };
-    bool timeout() { return false; };
-    bool haveFeasibleSolution() { return true; };
-    void setTimeLimit( double ) {};
-    double getObjectiveBound() { return 0; };
-    void dump() {}
-};
+/*
+  Without Gurobi, LP and MILP queries are answered by Marabou's native
+  LP solver, which has the same interface.
+*/
+typedef NativeLPSolver GurobiWrapper;
 
 #endif // ENABLE_GUROBI
 
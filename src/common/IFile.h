@@ -16,6 +16,7 @@
 #ifndef __IFile_h__
 #define __IFile_h__
 
+class ConstSimpleData;
 class HeapData;
 class String;
 
@@ -30,6 +31,7 @@ public:
 
     virtual void open( Mode openMode ) = 0;
     virtual void write( const String &line ) = 0;
+    virtual void write( const ConstSimpleData &data ) = 0;
     virtual String readLine( char lineSeparatingChar = '\n' ) = 0;
     virtual void read( HeapData &buffer, unsigned maxReadSize ) = 0;
     virtual void close() = 0;
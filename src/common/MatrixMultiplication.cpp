@@ -31,19 +31,25 @@ void matrixMultiplication( const double *matA, const double *matB, double *matC,
                  columnsA, alpha, matA, columnsA, matB, columnsB, beta, matC, columnsB);
 }
 #else
+#include "VectorizedKernel.h"
+
+VECTORIZED_KERNEL
 void matrixMultiplication( const double *matA, const double *matB, double *matC,
                            unsigned rowsA, unsigned columnsA,
                            unsigned columnsB )
 {
+    // The loops are ordered so that the innermost one runs over
+    // contiguous rows of matB and matC. Each entry of matC still
+    // accumulates its products in increasing order of k.
     for ( unsigned i = 0; i < rowsA; ++i )
     {
-        for ( unsigned j = 0; j < columnsB; ++j )
+        double *rowC = matC + i * columnsB;
+        for ( unsigned k = 0; k < columnsA; ++k )
         {
-            for ( unsigned k = 0; k < columnsA; ++k )
-            {
-                matC[i * columnsB + j] += matA[i * columnsA + k]
-                    * matB[k * columnsB + j];
-            }
+            double a = matA[i * columnsA + k];
+            const double *rowB = matB + k * columnsB;
+            for ( unsigned j = 0; j < columnsB; ++j )
+                rowC[j] += a * rowB[j];
         }
     }
 }
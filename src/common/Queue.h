@@ -35,6 +35,11 @@ public:
         return _container.empty();
     }
 
+    unsigned size() const
+    {
+        return _container.size();
+    }
+
     void clear()
     {
         while ( !empty() )
@@ -27,6 +27,7 @@ Statistics::Statistics()
     , _maxDegradation( 0.0 )
     , _numPrecisionRestorations( 0 )
     , _numSimplexSteps( 0 )
+    , _numDualSimplexSteps( 0 )
     , _timeSimplexStepsMicro( 0 )
     , _timeMainLoopMicro( 0 )
     , _timeConstraintFixingStepsMicro( 0 )
@@ -36,6 +37,9 @@ Statistics::Statistics()
     , _numSplits( 0 )
     , _numPops( 0 )
     , _numVisitedTreeStates( 1 )
+    , _numLearnedClauses( 0 )
+    , _numBackjumpedLevels( 0 )
+    , _numLearnedClauseImpliedSplits( 0 )
     , _numEquations( 0 )
     , _numTableauPivots( 0 )
     , _numTableauDegeneratePivots( 0 )
@@ -48,6 +52,7 @@ Statistics::Statistics()
     , _currentTableauM( 0 )
     , _currentTableauN( 0 )
     , _numTableauBoundHopping( 0 )
+    , _numTableauPassedBreakpoints( 0 )
     , _numTightenedBounds( 0 )
     , _numTighteningsFromSymbolicBoundTightening( 0 )
     , _numRowsExaminedByRowTightener( 0 )
@@ -196,12 +201,14 @@ void Statistics::print()
     printf( "\t--- Engine Statistics ---\n" );
     printf( "\tNumber of main loop iterations: %llu\n"
             "\t\t%llu iterations were simplex steps. Total time: %llu milli. Average: %.2lf milli.\n"
+            "\t\t\tOf which %llu were dual simplex steps\n"
             "\t\t%llu iterations were constraint-fixing steps. "
             "Total time: %llu milli. Average: %.2lf milli\n"
             , _numMainLoopIterations
             , _numSimplexSteps
             , _timeSimplexStepsMicro / 1000
             , printAverage( _timeSimplexStepsMicro / 1000, _numSimplexSteps )
+            , _numDualSimplexSteps
             , _numConstraintFixingSteps
             , _timeConstraintFixingStepsMicro / 1000
             , printAverage( _timeConstraintFixingStepsMicro / 1000, _numConstraintFixingSteps )
@@ -240,6 +247,7 @@ void Statistics::print()
             printAverage( _timePivotsMicro / 1000, _numTableauPivots ) );
 
     printf( "\tTotal number of fake pivots performed: %llu\n", _numTableauBoundHopping );
+    printf( "\tTotal number of breakpoints passed by long steps: %llu\n", _numTableauPassedBreakpoints );
     printf( "\tTotal number of rows added: %llu. Number of merged columns: %llu\n"
             , _numAddedRows
             , _numMergedColumns );
@@ -255,6 +263,10 @@ void Statistics::print()
             , _numPops );
     printf( "\tMax stack depth: %u\n"
             , _maxStackDepth );
+    printf( "\tLearned clauses: %u. Levels skipped by backjumping: %u. Splits implied by learned clauses: %u\n"
+            , _numLearnedClauses
+            , _numBackjumpedLevels
+            , _numLearnedClauseImpliedSplits );
 
     printf( "\t--- Bound Tightening Statistics ---\n" );
     printf( "\tNumber of tightened bounds: %llu.\n", _numTightenedBounds );
@@ -339,6 +351,11 @@ void Statistics::incNumSimplexSteps()
     ++_numSimplexSteps;
 }
 
+void Statistics::incNumDualSimplexSteps()
+{
+    ++_numDualSimplexSteps;
+}
+
 void Statistics::incNumPrecisionRestorations()
 {
     ++_numPrecisionRestorations;
@@ -397,6 +414,21 @@ unsigned Statistics::getNumPops() const
     return _numPops;
 }
 
+void Statistics::incNumLearnedClauses()
+{
+    ++_numLearnedClauses;
+}
+
+void Statistics::addNumBackjumpedLevels( unsigned numLevels )
+{
+    _numBackjumpedLevels += numLevels;
+}
+
+void Statistics::incNumLearnedClauseImpliedSplits()
+{
+    ++_numLearnedClauseImpliedSplits;
+}
+
 void Statistics::incNumAbstractedEquations()
 {
     ++_numEquations;
@@ -412,6 +444,11 @@ void Statistics::incNumTableauBoundHopping()
     ++_numTableauBoundHopping;
 }
 
+void Statistics::addNumTableauPassedBreakpoints( unsigned long long numBreakpoints )
+{
+    _numTableauPassedBreakpoints += numBreakpoints;
+}
+
 void Statistics::incNumTableauDegeneratePivots()
 {
     ++_numTableauDegeneratePivots;
@@ -44,6 +44,7 @@ public:
     */
     void incNumMainLoopIterations();
     void incNumSimplexSteps();
+    void incNumDualSimplexSteps();
     void addTimeMainLoop( unsigned long long time );
     void addTimeSimplexSteps( unsigned long long time );
     void addTimeConstraintFixingSteps( unsigned long long time );
@@ -75,6 +76,7 @@ public:
     */
     void incNumTableauPivots();
     void incNumTableauBoundHopping();
+    void addNumTableauPassedBreakpoints( unsigned long long numBreakpoints );
     void incNumTableauDegeneratePivots();
     void incNumTableauDegeneratePivotsByRequest();
     void incNumSimplexPivotSelectionsIgnoredForStability();
@@ -98,6 +100,9 @@ public:
     void incNumPops();
     void addTimeSmtCore( unsigned long long time );
     void incNumVisitedTreeStates();
+    void incNumLearnedClauses();
+    void addNumBackjumpedLevels( unsigned numLevels );
+    void incNumLearnedClauseImpliedSplits();
     unsigned getMaxStackDepth() const;
     unsigned getNumPops() const;
     unsigned getNumVisitedTreeStates() const;
@@ -178,6 +183,10 @@ private:
     // pivots), performed by the main loop
     unsigned long long _numSimplexSteps;
 
+    // Number of the simplex steps that were dual simplex steps,
+    // performed after bound-only changes
+    unsigned long long _numDualSimplexSteps;
+
     // Total time spent on performing simplex steps, in microseconds
     unsigned long long _timeSimplexStepsMicro;
 
@@ -204,6 +213,13 @@ private:
     // Total number of states in the search tree visited so far
     unsigned _numVisitedTreeStates;
 
+    // Conflict analysis: the number of learned clauses, the number of
+    // stack levels skipped by backjumps, and the number of case splits
+    // implied by learned clauses
+    unsigned _numLearnedClauses;
+    unsigned _numBackjumpedLevels;
+    unsigned _numLearnedClauseImpliedSplits;
+
     // Total abstracted equations in tableau
     unsigned int _numEquations;
 
@@ -243,6 +259,10 @@ private:
     // opposite bound.
     unsigned long long _numTableauBoundHopping;
 
+    // Total number of breakpoints of out-of-bounds basic variables that
+    // were passed by the bound flipping ratio test.
+    unsigned long long _numTableauPassedBreakpoints;
+
     // Total number of all bound tightenings preformed in the tableau.
     // This combines tightenings from all sources: rows, basis, PL constraints, etc.
     unsigned long long _numTightenedBounds;
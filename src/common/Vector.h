@@ -162,6 +162,12 @@ public:
         _container.clear();
     }
 
+    void truncate( unsigned size )
+    {
+        if ( size < _container.size() )
+            _container.erase( _container.begin() + size, _container.end() );
+    }
+
     Vector<T> operator+( const Vector<T> &other )
     {
         Vector<T> output;
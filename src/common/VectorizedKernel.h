@@ -0,0 +1,48 @@
+/*********************                                                        */
+/*! \file VectorizedKernel.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Functions marked VECTORIZED_KERNEL are optimized and auto-vectorized
+ ** regardless of the global optimization level. Floating point traps are
+ ** assumed to be disabled, so that conditional expressions can become
+ ** vector selects. Operations are never reordered and multiplications
+ ** and additions are never contracted into fused multiply-adds, so the
+ ** results are bit-identical to those of the scalar code on every
+ ** target. With GCC on x86-64 Linux they are compiled for AVX-512, AVX2
+ ** and baseline x86-64, and the best version for the running CPU is
+ ** picked at load time. Elsewhere, the marker has no effect.
+ **
+ ** Kernels should be written as simple loops over contiguous arrays,
+ ** without reductions and with branches expressed as conditional
+ ** expressions, so that the compiler can vectorize them.
+ **/
+
+#ifndef __VectorizedKernel_h__
+#define __VectorizedKernel_h__
+
+#if defined( __GNUC__ ) && !defined( __clang__ ) && ( __GNUC__ >= 6 ) && \
+    defined( __x86_64__ ) && defined( __linux__ )
+#define VECTORIZED_KERNEL                                               \
+    __attribute__(( target_clones( "avx512f", "avx2", "default" ),      \
+                    optimize( "O3", "no-trapping-math",                 \
+                              "fp-contract=off" ) ))
+#else
+#define VECTORIZED_KERNEL
+#endif
+
+#endif // __VectorizedKernel_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -17,6 +17,7 @@
 #ifndef __MockFile_h__
 #define __MockFile_h__
 
+#include "ConstSimpleData.h"
 #include "HeapData.h"
 #include "IFile.h"
 #include "MStringf.h"
@@ -65,6 +66,11 @@ public:
         writtenLines += line;
     }
 
+    void write( const ConstSimpleData &data )
+    {
+        writtenLines += String( data.asChar(), data.size() );
+    }
+
     String readLine( char lineSeparatingChar )
     {
         Stringf separatorAsString( "%c", lineSeparatingChar );
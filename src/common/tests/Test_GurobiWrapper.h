@@ -38,7 +38,6 @@ public:
 
     void test_optimize()
     {
-#ifdef ENABLE_GUROBI
         GurobiWrapper gurobi;
 
         gurobi.addVariable( "x", 0, 3 );
@@ -76,10 +75,6 @@ public:
         TS_ASSERT( FloatUtils::areEqual( solution["z"], 0 ) );
 
         TS_ASSERT( FloatUtils::areEqual( costValue, -8 ) );
-
-#else
-        TS_ASSERT( true );
-#endif // ENABLE_GUROBI
     }
 };
 
@@ -18,6 +18,9 @@
 
 #include "MatrixMultiplication.h"
 
+#include <cmath>
+#include <limits>
+
 class MatrixMultiplicationTestSuite : public CxxTest::TestSuite
 {
 public:
@@ -55,6 +58,74 @@ public:
         TS_ASSERT(matC[4] == 23);
         TS_ASSERT(matC[5] == 34);
     }
+
+    void test_non_square_matrices()
+    {
+        double matA[] = {1,0,2,-1,3,0}; // [1,0,2], [-1,3,0]
+        double matB[] = {1,2,3,4,0,-1,5,6,-2,1,0,1}; // [1,2,3,4], [0,-1,5,6], [-2,1,0,1]
+        double matC[8] = {1,1,1,1,1,1,1,1};
+        unsigned rowsA = 2;
+        unsigned columnsA = 3;
+        unsigned columnsB = 4;
+        matrixMultiplication(matA, matB, matC, rowsA, columnsA, columnsB);
+
+        // The product is added to the initial contents of matC
+        TS_ASSERT(matC[0] == -2);
+        TS_ASSERT(matC[1] == 5);
+        TS_ASSERT(matC[2] == 4);
+        TS_ASSERT(matC[3] == 7);
+        TS_ASSERT(matC[4] == 0);
+        TS_ASSERT(matC[5] == -4);
+        TS_ASSERT(matC[6] == 13);
+        TS_ASSERT(matC[7] == 15);
+    }
+
+    void test_infinite_entries()
+    {
+        double inf = std::numeric_limits<double>::infinity();
+        double matA[] = {0,1,2,0}; // [0,1], [2,0]
+        double matB[] = {inf,1,1,-inf}; // [inf,1], [1,-inf]
+        double matC[4] = {0};
+        unsigned rowsA = 2;
+        unsigned columnsA = 2;
+        unsigned columnsB = 2;
+        matrixMultiplication(matA, matB, matC, rowsA, columnsA, columnsB);
+
+        TS_ASSERT(matC[1] == -inf);
+        TS_ASSERT(matC[2] == inf);
+
+#ifndef ENABLE_OPENBLAS
+        // 0 * inf is NaN, as in a plain dot product. BLAS implementations
+        // may skip zero entries, so this only holds for the native kernel
+        TS_ASSERT(std::isnan(matC[0]));
+        TS_ASSERT(std::isnan(matC[3]));
+#endif
+    }
+
+    void test_products_are_not_fused()
+    {
+        // a * b rounds to 1, so the separate multiplication and addition
+        // of a dot product give -1 + a * b = 0, while a fused multiply-add
+        // would keep the exact, non-zero difference. The row is wide
+        // enough to exercise both the vector loop and its remainder.
+        double a = 1.0 + 1.0 / ( 1 << 30 );
+        double b = 1.0 - 1.0 / ( 1 << 30 );
+
+        const unsigned columnsB = 37;
+        double matA[] = {a};
+        double matB[columnsB];
+        double matC[columnsB];
+        for (unsigned j = 0; j < columnsB; ++j)
+        {
+            matB[j] = (j % 2) ? b : -b;
+            matC[j] = (j % 2) ? -1 : 1;
+        }
+
+        matrixMultiplication(matA, matB, matC, 1, 1, columnsB);
+
+        for (unsigned j = 0; j < columnsB; ++j)
+            TS_ASSERT(matC[j] == 0);
+    }
 };
 
 //
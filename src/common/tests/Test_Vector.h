@@ -214,6 +214,26 @@ public:
         TS_ASSERT( vector.exists( 10 ) );
     }
 
+    void test_truncate()
+    {
+        Vector<unsigned> vector;
+
+        vector.append( 5 );
+        vector.append( 10 );
+        vector.append( 15 );
+
+        TS_ASSERT_THROWS_NOTHING( vector.truncate( 5 ) );
+        TS_ASSERT_EQUALS( vector.size(), 3U );
+
+        TS_ASSERT_THROWS_NOTHING( vector.truncate( 1 ) );
+        TS_ASSERT_EQUALS( vector.size(), 1U );
+        TS_ASSERT_EQUALS( vector[0], 5U );
+        TS_ASSERT( !vector.exists( 10 ) );
+
+        TS_ASSERT_THROWS_NOTHING( vector.truncate( 0 ) );
+        TS_ASSERT( vector.empty() );
+    }
+
     void test_concatenation()
     {
         Vector<unsigned> one;
@@ -41,19 +41,27 @@ const unsigned GlobalConfiguration::DEGRADATION_CHECKING_FREQUENCY = 100;
 const double GlobalConfiguration::DEGRADATION_THRESHOLD = 0.1;
 const double GlobalConfiguration::ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD = 0.0001;
 const bool GlobalConfiguration::USE_COLUMN_MERGING_EQUATIONS = false;
+const bool GlobalConfiguration::USE_BOUND_TRAIL_FOR_SMT_STATES = true;
 const double GlobalConfiguration::GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD = 0.1;
+const unsigned GlobalConfiguration::GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT = 4;
+const unsigned GlobalConfiguration::CONSTRAINT_MATRIX_ANALYZER_DENSE_SIZE_LIMIT = 10000;
 const unsigned GlobalConfiguration::MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS = 5;
 const unsigned GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD = 20;
 const DivideStrategy GlobalConfiguration::SPLITTING_HEURISTICS = DivideStrategy::ReLUViolation;
+const bool GlobalConfiguration::USE_CONFLICT_ANALYSIS = true;
+const unsigned GlobalConfiguration::MAX_LEARNED_CLAUSES = 1000;
+const double GlobalConfiguration::CONSTRAINT_ACTIVITY_DECAY = 0.95;
 const unsigned GlobalConfiguration::BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY = 100;
 const unsigned GlobalConfiguration::ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS = 20;
 const double GlobalConfiguration::COST_FUNCTION_ERROR_THRESHOLD = 0.0000000001;
 
 const bool GlobalConfiguration::USE_HARRIS_RATIO_TEST = true;
+const bool GlobalConfiguration::USE_BOUND_FLIPPING_RATIO_TEST = true;
 
 const bool GlobalConfiguration::USE_SYMBOLIC_BOUND_TIGHTENING = false;
 const bool GlobalConfiguration::USE_ARITHMETIC_BOUND_TIGHTENING = true;
 const double GlobalConfiguration::SYMBOLIC_TIGHTENING_ROUNDING_CONSTANT = 0.00000005;
+const unsigned GlobalConfiguration::NETWORK_LEVEL_REASONER_EVALUATION_BLOCK_SIZE = 256;
 
 const bool GlobalConfiguration::PREPROCESS_INPUT_QUERY = true;
 const bool GlobalConfiguration::PREPROCESSOR_ELIMINATE_VARIABLES = true;
@@ -68,6 +76,10 @@ const unsigned GlobalConfiguration::PSE_ITERATIONS_BEFORE_RESET = 1000;
 const double GlobalConfiguration::PSE_GAMMA_ERROR_THRESHOLD = 0.001;
 const double GlobalConfiguration::PSE_GAMMA_UPDATE_TOLERANCE = 0.000000001;
 
+const bool GlobalConfiguration::USE_DUAL_SIMPLEX_AFTER_BOUND_CHANGES = true;
+const unsigned GlobalConfiguration::DUAL_SIMPLEX_MAX_CONSECUTIVE_STEPS = 200;
+const double GlobalConfiguration::DSE_MINIMAL_WEIGHT = 0.000001;
+
 const double GlobalConfiguration::RELU_CONSTRAINT_COMPARISON_TOLERANCE = 0.001;
 const double GlobalConfiguration::ABS_CONSTRAINT_COMPARISON_TOLERANCE = 0.001;
 
@@ -79,15 +91,22 @@ const bool GlobalConfiguration::ONLY_AUX_INITIAL_BASIS = false;
 const GlobalConfiguration::ExplicitBasisBoundTighteningType GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_TYPE =
     GlobalConfiguration::COMPUTE_INVERTED_BASIS_MATRIX;
 const bool GlobalConfiguration::EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION = false;
+const unsigned GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_PANEL_SIZE = 16;
 
 const GlobalConfiguration::MILPSolverBoundTighteningType GlobalConfiguration::MILP_SOLVER_BOUND_TIGHTENING_TYPE =
     GlobalConfiguration::LP_RELAXATION;
 
 const unsigned GlobalConfiguration::MILPSolverTimeoutValueInSeconds = 1;
+const unsigned GlobalConfiguration::MILP_SOLVER_BOUND_TIGHTENING_NUMBER_OF_THREADS = 1;
+
+const unsigned GlobalConfiguration::NATIVE_LP_SOLVER_MAX_ITERATIONS = 100000;
+const unsigned GlobalConfiguration::NATIVE_LP_SOLVER_DEGENERATE_PIVOTS_BEFORE_BLANDS_RULE = 50;
+const double GlobalConfiguration::NATIVE_LP_SOLVER_INTEGRALITY_TOLERANCE = 0.000001;
 
 const unsigned GlobalConfiguration::REFACTORIZATION_THRESHOLD = 100;
 const GlobalConfiguration::BasisFactorizationType GlobalConfiguration::BASIS_FACTORIZATION_TYPE =
     GlobalConfiguration::SPARSE_FORREST_TOMLIN_FACTORIZATION;
+const double GlobalConfiguration::HYPERSPARSE_TRANSFORMATION_DENSITY_THRESHOLD = 0.1;
 
 const unsigned GlobalConfiguration::RUNTIME_ESTIMATE_THRESHOLD = 5;
 
@@ -138,13 +157,20 @@ void GlobalConfiguration::print()
     printf( "  DEGRADATION_THRESHOLD: %.15lf\n", DEGRADATION_THRESHOLD );
     printf( "  ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD: %.15lf\n", ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD );
     printf( "  USE_COLUMN_MERGING_EQUATIONS: %s\n", USE_COLUMN_MERGING_EQUATIONS ? "Yes" : "No" );
+    printf( "  USE_BOUND_TRAIL_FOR_SMT_STATES: %s\n", USE_BOUND_TRAIL_FOR_SMT_STATES ? "Yes" : "No" );
     printf( "  GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD: %.15lf\n", GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD );
+    printf( "  GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT: %u\n", GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT );
+    printf( "  CONSTRAINT_MATRIX_ANALYZER_DENSE_SIZE_LIMIT: %u\n", CONSTRAINT_MATRIX_ANALYZER_DENSE_SIZE_LIMIT );
     printf( "  MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS: %u\n", MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS );
     printf( "  CONSTRAINT_VIOLATION_THRESHOLD: %u\n", CONSTRAINT_VIOLATION_THRESHOLD );
+    printf( "  USE_CONFLICT_ANALYSIS: %s\n", USE_CONFLICT_ANALYSIS ? "Yes" : "No" );
+    printf( "  MAX_LEARNED_CLAUSES: %u\n", MAX_LEARNED_CLAUSES );
+    printf( "  CONSTRAINT_ACTIVITY_DECAY: %.15lf\n", CONSTRAINT_ACTIVITY_DECAY );
     printf( "  BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY: %u\n",
             BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY );
     printf( "  COST_FUNCTION_ERROR_THRESHOLD: %.15lf\n", COST_FUNCTION_ERROR_THRESHOLD );
     printf( "  USE_HARRIS_RATIO_TEST: %s\n", USE_HARRIS_RATIO_TEST ? "Yes" : "No" );
+    printf( "  USE_BOUND_FLIPPING_RATIO_TEST: %s\n", USE_BOUND_FLIPPING_RATIO_TEST ? "Yes" : "No" );
 
     printf( "  PREPROCESS_INPUT_QUERY: %s\n", PREPROCESS_INPUT_QUERY ? "Yes" : "No" );
     printf( "  PREPROCESSOR_ELIMINATE_VARIABLES: %s\n", PREPROCESSOR_ELIMINATE_VARIABLES ? "Yes" : "No" );
@@ -152,6 +178,10 @@ void GlobalConfiguration::print()
             PREPROCESSOR_PL_CONSTRAINTS_ADD_AUX_EQUATIONS ? "Yes" : "No" );
     printf( "  PSE_ITERATIONS_BEFORE_RESET: %u\n", PSE_ITERATIONS_BEFORE_RESET );
     printf( "  PSE_GAMMA_ERROR_THRESHOLD: %.15lf\n", PSE_GAMMA_ERROR_THRESHOLD );
+    printf( "  USE_DUAL_SIMPLEX_AFTER_BOUND_CHANGES: %s\n",
+            USE_DUAL_SIMPLEX_AFTER_BOUND_CHANGES ? "Yes" : "No" );
+    printf( "  DUAL_SIMPLEX_MAX_CONSECUTIVE_STEPS: %u\n", DUAL_SIMPLEX_MAX_CONSECUTIVE_STEPS );
+    printf( "  DSE_MINIMAL_WEIGHT: %.15lf\n", DSE_MINIMAL_WEIGHT );
     printf( "  RELU_CONSTRAINT_COMPARISON_TOLERANCE: %.15lf\n", RELU_CONSTRAINT_COMPARISON_TOLERANCE );
 
     String basisBoundTighteningType;
@@ -173,6 +203,7 @@ void GlobalConfiguration::print()
     printf( "  EXPLICIT_BASIS_BOUND_TIGHTENING_INVERT_BASIS: %s\n", basisBoundTighteningType.ascii() );
     printf( "  EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION: %s\n",
             EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION ? "Yes" : "No" );
+    printf( "  EXPLICIT_BASIS_BOUND_TIGHTENING_PANEL_SIZE: %u\n", EXPLICIT_BASIS_BOUND_TIGHTENING_PANEL_SIZE );
     printf( "  REFACTORIZATION_THRESHOLD: %u\n", REFACTORIZATION_THRESHOLD );
 
     String basisFactorizationType;
@@ -188,6 +219,7 @@ void GlobalConfiguration::print()
         basisFactorizationType = "Unknown";
 
     printf( "  BASIS_FACTORIZATION_TYPE: %s\n", basisFactorizationType.ascii() );
+    printf( "  HYPERSPARSE_TRANSFORMATION_DENSITY_THRESHOLD: %.15lf\n", HYPERSPARSE_TRANSFORMATION_DENSITY_THRESHOLD );
     printf( "****************************\n" );
 }
 
@@ -65,6 +65,10 @@ public:
     // Toggle use of Harris' two-pass ratio test for selecting the leaving variable
     static const bool USE_HARRIS_RATIO_TEST;
 
+    // Toggle use of the long-step (bound flipping) ratio test, which lets the entering
+    // variable pass through several breakpoints of out-of-bounds basic variables
+    static const bool USE_BOUND_FLIPPING_RATIO_TEST;
+
     // Toggle query-preprocessing on/off.
 	static const bool PREPROCESS_INPUT_QUERY;
 
@@ -102,10 +106,23 @@ public:
     // to be merged (instead of a new row added).
     static const bool USE_COLUMN_MERGING_EQUATIONS;
 
+    // If true, the SMT core stores the tableau state before each split as a mark into the tableau's
+    // bound trail, instead of a complete copy of the tableau. Backtracking then undoes only the
+    // changes since the mark. Ignored when column merging is enabled, as merges cannot be undone.
+    static const bool USE_BOUND_TRAIL_FOR_SMT_STATES;
+
     // If a pivot element in a Gaussian elimination iteration is smaller than this threshold times
     // the largest element in the column, the elimination engine will attempt to pick another pivot.
     static const double GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD;
 
+    // After an acceptable pivot has been found, the Markowitz pivot search of the Gaussian
+    // elimination examines at most this many additional rows and columns.
+    static const unsigned GAUSSIAN_ELIMINATION_MARKOWITZ_SEARCH_LIMIT;
+
+    // Sparse constraint matrices with at most this many entries (m times n) are analyzed for
+    // redundant rows using dense Gaussian elimination. Larger ones are analyzed sparsely.
+    static const unsigned CONSTRAINT_MATRIX_ANALYZER_DENSE_SIZE_LIMIT;
+
     // How many potential pivots should the engine inspect (at most) in every simplex iteration?
     static const unsigned MAX_SIMPLEX_PIVOT_SEARCH_ITERATIONS;
 
@@ -114,6 +131,18 @@ public:
 
     static const DivideStrategy SPLITTING_HEURISTICS;
 
+    // Whether the SMT core should analyze conflicts: learn clauses over case splits from
+    // infeasible subproblems, and backjump over splits that did not take part in a conflict
+    static const bool USE_CONFLICT_ANALYSIS;
+
+    // The maximal number of learned clauses kept by the SMT core. Beyond this, the oldest
+    // clauses are forgotten.
+    static const unsigned MAX_LEARNED_CLAUSES;
+
+    // With the Activity splitting heuristics, the factor by which the activities of the
+    // piecewise-linear constraints decay after every conflict
+    static const double CONSTRAINT_ACTIVITY_DECAY;
+
     // How often should we perform full bound tightening, on the entire contraints matrix A.
     static const unsigned BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY;
 
@@ -133,6 +162,17 @@ public:
     // PSE's Gamma function's update tolerance
     static const double PSE_GAMMA_UPDATE_TOLERANCE;
 
+    // Whether the engine should switch to dual simplex steps after bound-only
+    // changes, i.e. after case splits, bound tightenings and restorations
+    static const bool USE_DUAL_SIMPLEX_AFTER_BOUND_CHANGES;
+
+    // After this many consecutive dual simplex steps, the engine gives up on the
+    // dual simplex and hands over to the primal simplex, which guarantees progress
+    static const unsigned DUAL_SIMPLEX_MAX_CONSECUTIVE_STEPS;
+
+    // Dual steepest edge weights are kept above this value, to avoid dividing by zero
+    static const double DSE_MINIMAL_WEIGHT;
+
     // The tolerance for checking whether f = Relu( b )
     static const double RELU_CONSTRAINT_COMPARISON_TOLERANCE;
 
@@ -162,6 +202,10 @@ public:
     // When doing explicit bound tightening, should we repeat until saturation?
     static const bool EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION;
 
+    // When computing the rows of inv(B) * An through transformations, the number of
+    // columns of An that are transformed together
+    static const unsigned EXPLICIT_BASIS_BOUND_TIGHTENING_PANEL_SIZE;
+
     /*
       MILP solver bound tighening options
     */
@@ -182,6 +226,31 @@ public:
     // The timeout value for an individual query of the MILP solver
     static const unsigned MILPSolverTimeoutValueInSeconds;
 
+    // The number of threads that solve the per-neuron LPs of a layer
+    // during LP relaxation bound tightening. With 1 thread, every LP
+    // sees the bounds already found for the earlier neurons of its
+    // layer, and the results are deterministic. With more threads, an
+    // LP may start before the bounds of a neuron solved concurrently
+    // are known, so the bounds depend on thread timing and can be
+    // slightly looser. 0 means one thread per available hardware
+    // thread, divided among the DnC workers in DnC mode.
+    static const unsigned MILP_SOLVER_BOUND_TIGHTENING_NUMBER_OF_THREADS;
+
+    /*
+      Native LP solver options, used for MILP solver bound tightening
+      when Gurobi is not available
+    */
+
+    // The maximal number of simplex iterations for a single LP
+    static const unsigned NATIVE_LP_SOLVER_MAX_ITERATIONS;
+
+    // The number of consecutive degenerate pivots after which the
+    // native LP solver switches to Bland's rule, to avoid cycling
+    static const unsigned NATIVE_LP_SOLVER_DEGENERATE_PIVOTS_BEFORE_BLANDS_RULE;
+
+    // How far from 0 or 1 a binary variable may be and still count as integral
+    static const double NATIVE_LP_SOLVER_INTEGRALITY_TOLERANCE;
+
     /*
       Symbolic bound tightening options
     */
@@ -195,6 +264,10 @@ public:
     // Whether arithmetic bound tightening should be used or not
     static const bool USE_ARITHMETIC_BOUND_TIGHTENING;
 
+    // How many points the network level reasoner pushes through the
+    // network at once when evaluating a batch of inputs
+    static const unsigned NETWORK_LEVEL_REASONER_EVALUATION_BLOCK_SIZE;
+
 
     /*
       Constraint fixing heuristics
@@ -224,6 +297,10 @@ public:
     };
     static const BasisFactorizationType BASIS_FACTORIZATION_TYPE;
 
+    // Sparse right hand sides whose density (non-zeros divided by m) exceeds this
+    // threshold are transformed densely, rather than by a hypersparse solve
+    static const double HYPERSPARSE_TRANSFORMATION_DENSITY_THRESHOLD;
+
     /* In the polarity-based branching heuristics, only this many earliest nodes
        are considered to branch on.
     */
@@ -63,6 +63,12 @@ void OptionParser::initialize()
         ( "query-dump-file",
           boost::program_options::value<std::string>( &((*_stringOptions)[Options::QUERY_DUMP_FILE]) ),
           "Query dump file" )
+        ( "query-dump-binary",
+          boost::program_options::bool_switch( &((*_boolOptions)[Options::QUERY_DUMP_BINARY]) ),
+          "Dump the query in the binary format" )
+        ( "lp-tightening",
+          boost::program_options::bool_switch( &((*_boolOptions)[Options::NATIVE_LP_BOUND_TIGHTENING]) ),
+          "Tighten neuron bounds during the search with the native LP solver (always on with Gurobi)" )
         ( "num-workers",
           boost::program_options::value<int>( &((*_intOptions)[Options::NUM_WORKERS]) ),
           "(DNC) Number of workers" )
@@ -44,6 +44,8 @@ void Options::initializeDefaultValues()
     _boolOptions[DNC_MODE] = false;
     _boolOptions[PREPROCESSOR_PL_CONSTRAINTS_ADD_AUX_EQUATIONS] = false;
     _boolOptions[BERKELEY_FORMAT] = false;
+    _boolOptions[QUERY_DUMP_BINARY] = false;
+    _boolOptions[NATIVE_LP_BOUND_TIGHTENING] = false;
 
     /*
       Int options
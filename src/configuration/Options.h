@@ -42,6 +42,13 @@ public:
 
         // Model format
         BERKELEY_FORMAT,
+
+        // Dump the query in the binary format
+        QUERY_DUMP_BINARY,
+
+        // Tighten neuron bounds during the search with the native LP
+        // solver, when Gurobi is not available
+        NATIVE_LP_BOUND_TIGHTENING,
     };
 
     enum IntOptions {
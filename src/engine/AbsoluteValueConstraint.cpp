@@ -27,6 +27,8 @@ AbsoluteValueConstraint::AbsoluteValueConstraint( unsigned b, unsigned f )
     , _f( f )
     , _haveEliminatedVariables( false )
 {
+    addFixedSlot( _b );
+    addFixedSlot( _f );
     setPhaseStatus( PhaseStatus::PHASE_NOT_FIXED );
 }
 
@@ -282,23 +284,10 @@ void AbsoluteValueConstraint::updateVariableIndex( unsigned oldIndex, unsigned n
             !_upperBounds.exists( newIndex ) &&
             newIndex != _b && newIndex != _f );
 
-    if ( _assignment.exists( oldIndex ) )
-    {
-        _assignment[newIndex] = _assignment.get( oldIndex );
-        _assignment.erase( oldIndex );
-    }
-
-    if ( _lowerBounds.exists( oldIndex ) )
-    {
-        _lowerBounds[newIndex] = _lowerBounds.get( oldIndex );
-        _lowerBounds.erase( oldIndex );
-    }
-
-    if ( _upperBounds.exists( oldIndex ) )
-    {
-        _upperBounds[newIndex] = _upperBounds.get( oldIndex );
-        _upperBounds.erase( oldIndex );
-    }
+    // The fixed slots of the variable move along with it
+    _assignment.renameVariable( oldIndex, newIndex );
+    _lowerBounds.renameVariable( oldIndex, newIndex );
+    _upperBounds.renameVariable( oldIndex, newIndex );
 
     if ( oldIndex == _b )
         _b = newIndex;
@@ -18,41 +18,31 @@
 #include "MarabouError.h"
 
 bool BlandsRule::select( ITableau &tableau,
-                         const List<unsigned> &candidates,
+                         const Vector<unsigned> &candidates,
                          const Set<unsigned> &excluded )
 {
-    List<unsigned> remainingCandidates = candidates;
+    bool found = false;
+    unsigned minIndex = 0;
+    unsigned minVariable = 0;
 
-    List<unsigned>::iterator it = remainingCandidates.begin();
-    while ( it != remainingCandidates.end() )
+    for ( unsigned i = 0; i < candidates.size(); ++i )
     {
-        if ( excluded.exists( *it ) )
-            it = remainingCandidates.erase( it );
-        else
-            ++it;
-    }
-
-    if ( remainingCandidates.empty() )
-        return false;
-
-    it = remainingCandidates.begin();
-    unsigned minIndex = *it;
-    unsigned minVariable = tableau.nonBasicIndexToVariable( minIndex );
+        unsigned candidate = candidates.get( i );
+        if ( excluded.exists( candidate ) )
+            continue;
 
-    ++it;
-    unsigned variable;
-    while ( it != remainingCandidates.end() )
-    {
-        variable = tableau.nonBasicIndexToVariable( *it );
-        if ( variable < minVariable )
+        unsigned variable = tableau.nonBasicIndexToVariable( candidate );
+        if ( !found || variable < minVariable )
         {
-            minIndex = *it;
+            found = true;
+            minIndex = candidate;
             minVariable = variable;
         }
-
-        ++it;
     }
 
+    if ( !found )
+        return false;
+
     tableau.setEnteringVariableIndex( minIndex );
     return true;
 }
@@ -26,7 +26,7 @@ public:
       variable that has the smallest lexicographical index.
     */
     bool select( ITableau &tableau,
-                 const List<unsigned> &candidates,
+                 const Vector<unsigned> &candidates,
                  const Set<unsigned> &excluded );
 };
 
@@ -0,0 +1,199 @@
+/*********************                                                        */
+/*! \file ConstraintActivityHeap.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "ConstraintActivityHeap.h"
+#include "Debug.h"
+#include "GlobalConfiguration.h"
+#include "PiecewiseLinearConstraint.h"
+
+// Activities are rescaled before they can overflow
+static const double ACTIVITY_RESCALE_THRESHOLD = 1e100;
+
+// Marks a constraint that is not in the heap
+static const unsigned NOT_IN_HEAP = (unsigned)-1;
+
+ConstraintActivityHeap::ConstraintActivityHeap()
+    : _increment( 1 )
+{
+}
+
+void ConstraintActivityHeap::initialize( const List<PiecewiseLinearConstraint *> &constraints )
+{
+    _constraints.clear();
+    _activities.clear();
+    _heapPositions.clear();
+    _constraintToId.clear();
+    _variableToIds.clear();
+    _heap.clear();
+    _removed.clear();
+    _increment = 1;
+
+    for ( const auto &constraint : constraints )
+    {
+        unsigned id = _constraints.size();
+        _constraints.append( constraint );
+        _activities.append( 0 );
+        _constraintToId[constraint] = id;
+
+        for ( const auto &variable : constraint->getParticipatingVariables() )
+            _variableToIds[variable].append( id );
+
+        // With equal activities, the heap keeps the original order
+        _heapPositions.append( id );
+        _heap.append( id );
+    }
+}
+
+void ConstraintActivityHeap::bumpConstraint( PiecewiseLinearConstraint *constraint )
+{
+    if ( _constraintToId.exists( constraint ) )
+        bump( _constraintToId[constraint] );
+}
+
+void ConstraintActivityHeap::bumpVariable( unsigned variable )
+{
+    if ( !_variableToIds.exists( variable ) )
+        return;
+
+    for ( const auto &id : _variableToIds[variable] )
+        bump( id );
+}
+
+void ConstraintActivityHeap::bump( unsigned id )
+{
+    _activities[id] += _increment;
+
+    if ( _activities[id] > ACTIVITY_RESCALE_THRESHOLD )
+    {
+        // Scaling all activities by the same factor keeps the heap order
+        for ( unsigned i = 0; i < _activities.size(); ++i )
+            _activities[i] /= ACTIVITY_RESCALE_THRESHOLD;
+        _increment /= ACTIVITY_RESCALE_THRESHOLD;
+    }
+
+    if ( _heapPositions[id] != NOT_IN_HEAP )
+        siftUp( _heapPositions[id] );
+}
+
+void ConstraintActivityHeap::decay()
+{
+    _increment /= GlobalConfiguration::CONSTRAINT_ACTIVITY_DECAY;
+}
+
+PiecewiseLinearConstraint *ConstraintActivityHeap::getMostActiveConstraint()
+{
+    while ( !_heap.empty() )
+    {
+        PiecewiseLinearConstraint *constraint = _constraints[_heap[0]];
+        if ( constraint->isActive() && !constraint->phaseFixed() )
+            return constraint;
+
+        _removed.append( _heap[0] );
+        removeTop();
+    }
+
+    return NULL;
+}
+
+void ConstraintActivityHeap::reinsertRemovedConstraints()
+{
+    for ( const auto &id : _removed )
+        insert( id );
+    _removed.clear();
+}
+
+double ConstraintActivityHeap::getActivity( PiecewiseLinearConstraint *constraint ) const
+{
+    return _activities.get( _constraintToId.get( constraint ) );
+}
+
+unsigned ConstraintActivityHeap::getHeapSize() const
+{
+    return _heap.size();
+}
+
+void ConstraintActivityHeap::insert( unsigned id )
+{
+    ASSERT( _heapPositions[id] == NOT_IN_HEAP );
+
+    _heapPositions[id] = _heap.size();
+    _heap.append( id );
+    siftUp( _heap.size() - 1 );
+}
+
+void ConstraintActivityHeap::removeTop()
+{
+    ASSERT( !_heap.empty() );
+
+    swap( 0, _heap.size() - 1 );
+    _heapPositions[_heap.pop()] = NOT_IN_HEAP;
+
+    if ( !_heap.empty() )
+        siftDown( 0 );
+}
+
+void ConstraintActivityHeap::siftUp( unsigned position )
+{
+    while ( position > 0 )
+    {
+        unsigned parent = ( position - 1 ) / 2;
+        if ( _activities[_heap[parent]] >= _activities[_heap[position]] )
+            break;
+
+        swap( parent, position );
+        position = parent;
+    }
+}
+
+void ConstraintActivityHeap::siftDown( unsigned position )
+{
+    unsigned size = _heap.size();
+    while ( true )
+    {
+        unsigned largest = position;
+        unsigned left = 2 * position + 1;
+        unsigned right = left + 1;
+
+        if ( left < size && _activities[_heap[left]] > _activities[_heap[largest]] )
+            largest = left;
+        if ( right < size && _activities[_heap[right]] > _activities[_heap[largest]] )
+            largest = right;
+
+        if ( largest == position )
+            break;
+
+        swap( position, largest );
+        position = largest;
+    }
+}
+
+void ConstraintActivityHeap::swap( unsigned first, unsigned second )
+{
+    unsigned firstId = _heap[first];
+    unsigned secondId = _heap[second];
+
+    _heap[first] = secondId;
+    _heap[second] = firstId;
+    _heapPositions[secondId] = first;
+    _heapPositions[firstId] = second;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,119 @@
+/*********************                                                        */
+/*! \file ConstraintActivityHeap.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Activity scores for piecewise-linear constraints, in the spirit of
+ ** the VSIDS heuristic of SAT solvers. Constraints over variables that
+ ** take part in conflicts have their activity bumped, and older bumps
+ ** decay, by having each new bump weigh more than the previous ones.
+ ** The constraints are kept in a binary max-heap, so that the most
+ ** active one can be found in logarithmic time.
+
+**/
+
+#ifndef __ConstraintActivityHeap_h__
+#define __ConstraintActivityHeap_h__
+
+#include "List.h"
+#include "Map.h"
+#include "Vector.h"
+
+class PiecewiseLinearConstraint;
+
+class ConstraintActivityHeap
+{
+public:
+    ConstraintActivityHeap();
+
+    /*
+      Start tracking the given constraints, all with zero activity.
+    */
+    void initialize( const List<PiecewiseLinearConstraint *> &constraints );
+
+    /*
+      Bump the activity of a constraint, or of all constraints that
+      the given variable participates in.
+    */
+    void bumpConstraint( PiecewiseLinearConstraint *constraint );
+    void bumpVariable( unsigned variable );
+
+    /*
+      Make all past bumps weigh less than future ones. Should be
+      called once per conflict.
+    */
+    void decay();
+
+    /*
+      Return the most active constraint that is active and whose phase
+      is not fixed, or NULL if there is none. Constraints found to be
+      inactive or fixed on the way are taken out of the heap, until
+      reinsertRemovedConstraints() is called.
+    */
+    PiecewiseLinearConstraint *getMostActiveConstraint();
+
+    /*
+      Put back any constraints that were taken out of the heap, e.g.
+      after backtracking has re-activated them.
+    */
+    void reinsertRemovedConstraints();
+
+    /*
+      For testing purposes.
+    */
+    double getActivity( PiecewiseLinearConstraint *constraint ) const;
+    unsigned getHeapSize() const;
+
+private:
+    /*
+      The tracked constraints, their activities and their positions in
+      the heap, all indexed by a constraint id.
+    */
+    Vector<PiecewiseLinearConstraint *> _constraints;
+    Vector<double> _activities;
+    Vector<unsigned> _heapPositions;
+    Map<PiecewiseLinearConstraint *, unsigned> _constraintToId;
+
+    /*
+      The constraints that each variable participates in.
+    */
+    Map<unsigned, List<unsigned>> _variableToIds;
+
+    /*
+      The heap, storing constraint ids.
+    */
+    Vector<unsigned> _heap;
+
+    /*
+      Constraints taken out of the heap.
+    */
+    List<unsigned> _removed;
+
+    /*
+      The current bump amount.
+    */
+    double _increment;
+
+    void bump( unsigned id );
+    void insert( unsigned id );
+    void removeTop();
+    void siftUp( unsigned position );
+    void siftDown( unsigned position );
+    void swap( unsigned first, unsigned second );
+};
+
+#endif // __ConstraintActivityHeap_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
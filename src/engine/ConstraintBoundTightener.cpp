@@ -121,6 +121,28 @@ void ConstraintBoundTightener::notifyUpperBound( unsigned variable, double bound
     }
 }
 
+void ConstraintBoundTightener::notifyBoundChanges( const unsigned *variables, unsigned count )
+{
+    for ( unsigned i = 0; i < count; ++i )
+    {
+        unsigned variable = variables[i];
+
+        double lb = _tableau.getLowerBound( variable );
+        if ( lb > _lowerBounds[variable] )
+        {
+            _lowerBounds[variable] = lb;
+            _tightenedLower[variable] = false;
+        }
+
+        double ub = _tableau.getUpperBound( variable );
+        if ( ub < _upperBounds[variable] )
+        {
+            _upperBounds[variable] = ub;
+            _tightenedUpper[variable] = false;
+        }
+    }
+}
+
 void ConstraintBoundTightener::notifyDimensionChange( unsigned /* m */ , unsigned /* n */ )
 {
     setDimensions();
@@ -46,6 +46,12 @@ public:
     void notifyLowerBound( unsigned variable, double bound );
     void notifyUpperBound( unsigned variable, double bound );
 
+    /*
+      Batched callback from the Tableau: catch up on the bounds of the
+      given variables.
+    */
+    void notifyBoundChanges( const unsigned *variables, unsigned count );
+
     /*
       Have the Bound Tightener start reporting statistics.
     */
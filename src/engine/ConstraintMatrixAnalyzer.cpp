@@ -14,7 +14,9 @@
  **/
 
 #include "ConstraintMatrixAnalyzer.h"
+#include "Debug.h"
 #include "FloatUtils.h"
+#include "GlobalConfiguration.h"
 #include "List.h"
 #include "MStringf.h"
 
@@ -24,6 +26,15 @@ ConstraintMatrixAnalyzer::ConstraintMatrixAnalyzer()
     , _logging( false )
     , _rowHeaders( NULL )
     , _columnHeaders( NULL )
+    , _sparseRows( NULL )
+    , _rowsOfColumn( NULL )
+    , _numColumnElements( NULL )
+    , _rowEliminated( NULL )
+    , _rowMarked( NULL )
+    , _columnMarked( NULL )
+    , _columnBucketHead( NULL )
+    , _nextColumnInBucket( NULL )
+    , _previousColumnInBucket( NULL )
 {
 }
 
@@ -57,6 +68,60 @@ void ConstraintMatrixAnalyzer::freeMemoryIfNeeded()
         delete[] _columnHeaders;
         _columnHeaders = NULL;
     }
+
+    if ( _sparseRows )
+    {
+        delete[] _sparseRows;
+        _sparseRows = NULL;
+    }
+
+    if ( _rowsOfColumn )
+    {
+        delete[] _rowsOfColumn;
+        _rowsOfColumn = NULL;
+    }
+
+    if ( _numColumnElements )
+    {
+        delete[] _numColumnElements;
+        _numColumnElements = NULL;
+    }
+
+    if ( _rowEliminated )
+    {
+        delete[] _rowEliminated;
+        _rowEliminated = NULL;
+    }
+
+    if ( _rowMarked )
+    {
+        delete[] _rowMarked;
+        _rowMarked = NULL;
+    }
+
+    if ( _columnMarked )
+    {
+        delete[] _columnMarked;
+        _columnMarked = NULL;
+    }
+
+    if ( _columnBucketHead )
+    {
+        delete[] _columnBucketHead;
+        _columnBucketHead = NULL;
+    }
+
+    if ( _nextColumnInBucket )
+    {
+        delete[] _nextColumnInBucket;
+        _nextColumnInBucket = NULL;
+    }
+
+    if ( _previousColumnInBucket )
+    {
+        delete[] _previousColumnInBucket;
+        _previousColumnInBucket = NULL;
+    }
 }
 
 void ConstraintMatrixAnalyzer::analyze( const SparseMatrix *matrix, unsigned m, unsigned n )
@@ -65,6 +130,13 @@ void ConstraintMatrixAnalyzer::analyze( const SparseMatrix *matrix, unsigned m,
 
     _m = m;
     _n = n;
+    _independentColumns.clear();
+
+    if ( (unsigned long long)m * n > GlobalConfiguration::CONSTRAINT_MATRIX_ANALYZER_DENSE_SIZE_LIMIT )
+    {
+        sparseGaussianElimination( matrix );
+        return;
+    }
 
     _matrix = new double[m * n];
     _work = new double[n];
@@ -89,6 +161,7 @@ void ConstraintMatrixAnalyzer::analyze( const double *matrix, unsigned m, unsign
 
     _m = m;
     _n = n;
+    _independentColumns.clear();
 
     _matrix = new double[m * n];
     _work = new double[n];
@@ -168,6 +241,284 @@ void ConstraintMatrixAnalyzer::gaussianElimination()
     dumpMatrix( "Elimination finished" );
 }
 
+void ConstraintMatrixAnalyzer::sparseGaussianElimination( const SparseMatrix *matrix )
+{
+    /*
+      As in the dense case, every elimination step picks a pivot in a
+      new column, until m pivots are found or no non-zero elements are
+      left; the rows without a pivot are the redundant ones. To keep
+      the fill-in low, the pivot is taken from the column with the
+      fewest active elements, and from the sparsest row among those
+      whose element is large enough for stability.
+    */
+    initializeSparseElimination( matrix );
+
+    List<unsigned> pivotRows;
+    Vector<unsigned> columnRows;
+    Vector<double> columnValues;
+
+    _eliminationStep = 0;
+    unsigned pivotRow, pivotColumn;
+    while ( ( _eliminationStep < _m ) && chooseSparsePivot( pivotRow, pivotColumn ) )
+    {
+        removeColumnFromBucket( pivotColumn );
+
+        // Collect the active elements of the pivot column
+        columnRows.clear();
+        columnValues.clear();
+        for ( const auto &row : _rowsOfColumn[pivotColumn] )
+        {
+            if ( _rowEliminated[row] || _rowMarked[row] )
+                continue;
+
+            _rowMarked[row] = true;
+            double value = _sparseRows[row].get( pivotColumn );
+            if ( !FloatUtils::isZero( value ) )
+            {
+                columnRows.append( row );
+                columnValues.append( value );
+            }
+        }
+
+        for ( const auto &row : _rowsOfColumn[pivotColumn] )
+            _rowMarked[row] = false;
+        _rowsOfColumn[pivotColumn].clear();
+
+        double pivotElement = _sparseRows[pivotRow].get( pivotColumn );
+        _rowEliminated[pivotRow] = true;
+
+        // The pivot row leaves the active submatrix. Scatter it into
+        // the work memory, and mark its columns
+        for ( const auto &entry : _sparseRows[pivotRow] )
+        {
+            if ( entry._index == pivotColumn )
+                continue;
+
+            changeColumnCount( entry._index, -1 );
+            _work[entry._index] = entry._value;
+            _columnMarked[entry._index] = true;
+        }
+
+        // Eliminate the pivot column from the other rows
+        for ( unsigned i = 0; i < columnRows.size(); ++i )
+        {
+            if ( columnRows[i] != pivotRow )
+                eliminateSparseRow( columnRows[i], pivotRow, pivotColumn, -columnValues[i] / pivotElement );
+        }
+
+        // Reset the work memory
+        for ( const auto &entry : _sparseRows[pivotRow] )
+        {
+            _work[entry._index] = 0;
+            _columnMarked[entry._index] = false;
+        }
+        _sparseRows[pivotRow].clear();
+
+        pivotRows.append( pivotRow );
+        _independentColumns.append( pivotColumn );
+        ++_eliminationStep;
+    }
+
+    // The pivot rows and columns come first, in elimination order
+    unsigned index = 0;
+    for ( const auto &row : pivotRows )
+        _rowHeaders[index++] = row;
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( !_rowEliminated[i] )
+            _rowHeaders[index++] = i;
+    }
+
+    index = 0;
+    for ( const auto &column : _independentColumns )
+    {
+        _columnHeaders[index++] = column;
+        _columnMarked[column] = true;
+    }
+    for ( unsigned i = 0; i < _n; ++i )
+    {
+        if ( !_columnMarked[i] )
+            _columnHeaders[index++] = i;
+        _columnMarked[i] = false;
+    }
+}
+
+void ConstraintMatrixAnalyzer::initializeSparseElimination( const SparseMatrix *matrix )
+{
+    _work = new double[_n];
+    _rowHeaders = new unsigned[_m];
+    _columnHeaders = new unsigned[_n];
+    _sparseRows = new SparseUnsortedList[_m];
+    _rowsOfColumn = new Vector<unsigned>[_n];
+    _numColumnElements = new unsigned[_n];
+    _rowEliminated = new bool[_m];
+    _rowMarked = new bool[_m];
+    _columnMarked = new bool[_n];
+    _columnBucketHead = new unsigned[_m + 1];
+    _nextColumnInBucket = new unsigned[_n];
+    _previousColumnInBucket = new unsigned[_n];
+
+    std::fill_n( _work, _n, 0 );
+    std::fill_n( _numColumnElements, _n, 0 );
+    std::fill_n( _rowEliminated, _m, false );
+    std::fill_n( _rowMarked, _m, false );
+    std::fill_n( _columnMarked, _n, false );
+    std::fill_n( _columnBucketHead, _m + 1, _n );
+
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        matrix->getRow( i, &_sparseRows[i] );
+        for ( const auto &entry : _sparseRows[i] )
+        {
+            _rowsOfColumn[entry._index].append( i );
+            ++_numColumnElements[entry._index];
+        }
+    }
+
+    for ( unsigned i = 0; i < _n; ++i )
+        addColumnToBucket( i );
+}
+
+bool ConstraintMatrixAnalyzer::chooseSparsePivot( unsigned &pivotRow, unsigned &pivotColumn )
+{
+    // Find the sparsest column that still has active elements
+    unsigned count = 1;
+    while ( ( count <= _m ) && ( _columnBucketHead[count] == _n ) )
+        ++count;
+
+    if ( count > _m )
+        return false;
+
+    pivotColumn = _columnBucketHead[count];
+
+    // Start with the largest element in the column
+    double maxInColumn = 0;
+    for ( const auto &row : _rowsOfColumn[pivotColumn] )
+    {
+        if ( _rowEliminated[row] )
+            continue;
+
+        double absValue = FloatUtils::abs( _sparseRows[row].get( pivotColumn ) );
+        if ( absValue > maxInColumn )
+        {
+            maxInColumn = absValue;
+            pivotRow = row;
+        }
+    }
+
+    ASSERT( maxInColumn > 0 );
+
+    // Among the large enough elements, prefer one in the sparsest row
+    unsigned minimalNnz = _sparseRows[pivotRow].getNnz();
+    for ( const auto &row : _rowsOfColumn[pivotColumn] )
+    {
+        if ( _rowEliminated[row] )
+            continue;
+
+        double absValue = FloatUtils::abs( _sparseRows[row].get( pivotColumn ) );
+        if ( !FloatUtils::gt( absValue,
+                              maxInColumn * GlobalConfiguration::GAUSSIAN_ELIMINATION_PIVOT_SCALE_THRESHOLD ) )
+            continue;
+
+        unsigned nnz = _sparseRows[row].getNnz();
+        if ( nnz < minimalNnz )
+        {
+            minimalNnz = nnz;
+            pivotRow = row;
+        }
+    }
+
+    return true;
+}
+
+void ConstraintMatrixAnalyzer::eliminateSparseRow( unsigned row, unsigned pivotRow, unsigned pivotColumn, double factor )
+{
+    SparseUnsortedList &sparseRow = _sparseRows[row];
+
+    // Update the elements that also appear in the pivot row, and
+    // unmark their columns. Surviving entries are compacted in a
+    // single pass, and the discarded tail is dropped at the end
+    auto write = sparseRow.begin();
+    for ( auto it = sparseRow.begin(); it != sparseRow.end(); ++it )
+    {
+        unsigned column = it->_index;
+        if ( column == pivotColumn )
+            continue;
+
+        if ( _columnMarked[column] )
+        {
+            _columnMarked[column] = false;
+            it->_value += factor * _work[column];
+
+            if ( FloatUtils::isZero( it->_value ) )
+            {
+                // The element has cancelled out
+                changeColumnCount( column, -1 );
+                continue;
+            }
+        }
+
+        *write = *it;
+        ++write;
+    }
+    sparseRow.erase( write, sparseRow.end() );
+
+    // The columns that are still marked are fill-in. Restore the marks
+    // for the next row
+    for ( const auto &entry : _sparseRows[pivotRow] )
+    {
+        unsigned column = entry._index;
+        if ( column == pivotColumn )
+            continue;
+
+        if ( !_columnMarked[column] )
+        {
+            _columnMarked[column] = true;
+            continue;
+        }
+
+        double value = factor * entry._value;
+        if ( !FloatUtils::isZero( value ) )
+        {
+            sparseRow.append( column, value );
+            _rowsOfColumn[column].append( row );
+            changeColumnCount( column, +1 );
+        }
+    }
+}
+
+void ConstraintMatrixAnalyzer::addColumnToBucket( unsigned column )
+{
+    unsigned count = _numColumnElements[column];
+
+    _previousColumnInBucket[column] = _n;
+    _nextColumnInBucket[column] = _columnBucketHead[count];
+    if ( _columnBucketHead[count] != _n )
+        _previousColumnInBucket[_columnBucketHead[count]] = column;
+    _columnBucketHead[count] = column;
+}
+
+void ConstraintMatrixAnalyzer::removeColumnFromBucket( unsigned column )
+{
+    unsigned previous = _previousColumnInBucket[column];
+    unsigned next = _nextColumnInBucket[column];
+
+    if ( previous != _n )
+        _nextColumnInBucket[previous] = next;
+    else
+        _columnBucketHead[_numColumnElements[column]] = next;
+
+    if ( next != _n )
+        _previousColumnInBucket[next] = previous;
+}
+
+void ConstraintMatrixAnalyzer::changeColumnCount( unsigned column, int delta )
+{
+    removeColumnFromBucket( column );
+    _numColumnElements[column] += delta;
+    addColumnToBucket( column );
+}
+
 List<unsigned> ConstraintMatrixAnalyzer::getIndependentColumns() const
 {
     return _independentColumns;
@@ -198,6 +549,8 @@ void ConstraintMatrixAnalyzer::swapColumns( unsigned i, unsigned j )
 
 void ConstraintMatrixAnalyzer::getCanonicalForm( double *matrix )
 {
+    ASSERT( _matrix );
+
     for ( unsigned i = 0; i < _m; ++i )
         for ( unsigned j = 0; j < _n; ++j )
             matrix[i*_n + j] = _matrix[_rowHeaders[i]*_n + _columnHeaders[j]];
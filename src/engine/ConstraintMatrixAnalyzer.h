@@ -19,6 +19,8 @@
 #include "IConstraintMatrixAnalyzer.h"
 #include "List.h"
 #include "SparseMatrix.h"
+#include "SparseUnsortedList.h"
+#include "Vector.h"
 
 class String;
 
@@ -33,6 +35,11 @@ public:
       Analyze the input matrix in order to find its canonical form
       and rank. The matrix is m by n, and is assumed to be in column-
       major format.
+
+      Unless it is tiny, a sparse matrix is analyzed without being
+      made dense, by a sparse elimination whose time and memory are
+      proportional to the fill-in. The canonical form is only
+      available after a dense analysis.
     */
     void analyze( const double *matrix, unsigned m, unsigned n );
     void analyze( const SparseMatrix *matrix, unsigned m, unsigned n );
@@ -57,10 +64,40 @@ private:
     unsigned *_rowHeaders;
     unsigned *_columnHeaders;
 
+    /*
+      Work memory for the sparse elimination: the rows of the matrix,
+      the rows in which each column appears (possibly also rows that
+      have since been eliminated, or in which the entry has cancelled
+      out; these are skipped), and the number of active elements in
+      each column.
+    */
+    SparseUnsortedList *_sparseRows;
+    Vector<unsigned> *_rowsOfColumn;
+    unsigned *_numColumnElements;
+    bool *_rowEliminated;
+    bool *_rowMarked;
+    bool *_columnMarked;
+
+    /*
+      The columns of the active submatrix, bucketed by their number
+      of active elements. Every bucket is a doubly linked list, with
+      _n marking the end of the list.
+    */
+    unsigned *_columnBucketHead;
+    unsigned *_nextColumnInBucket;
+    unsigned *_previousColumnInBucket;
+
     /*
       Helper functions for performing Gaussian elimination.
     */
     void gaussianElimination();
+    void sparseGaussianElimination( const SparseMatrix *matrix );
+    void initializeSparseElimination( const SparseMatrix *matrix );
+    bool chooseSparsePivot( unsigned &pivotRow, unsigned &pivotColumn );
+    void eliminateSparseRow( unsigned row, unsigned pivotRow, unsigned pivotColumn, double factor );
+    void addColumnToBucket( unsigned column );
+    void removeColumnFromBucket( unsigned column );
+    void changeColumnCount( unsigned column, int delta );
     void swapRows( unsigned i, unsigned j );
     void swapColumns( unsigned i, unsigned j );
 
@@ -20,57 +20,52 @@
 #include "MarabouError.h"
 
 bool DantzigsRule::select( ITableau &tableau,
-                           const List<unsigned> &candidates,
+                           const Vector<unsigned> &candidates,
                            const Set<unsigned> &excluded )
 {
-    List<unsigned> remainingCandidates = candidates;
-
-    List<unsigned>::iterator it = remainingCandidates.begin();
-    while ( it != remainingCandidates.end() )
-    {
-        if ( excluded.exists( *it ) )
-            it = remainingCandidates.erase( it );
-        else
-            ++it;
-    }
-
-    if ( remainingCandidates.empty() )
-        return false;
-
     // Dantzig's rule
     const double *costFunction = tableau.getCostFunction();
 
-    unsigned n = tableau.getN();
-    unsigned m = tableau.getM();
-
-    String cost;
-    for ( unsigned i = 0; i < n - m; ++i )
+    if ( GlobalConfiguration::DANTZIGS_RULE_LOGGING )
     {
-        if ( FloatUtils::isZero( costFunction[i] ) )
-            continue;
+        unsigned n = tableau.getN();
+        unsigned m = tableau.getM();
 
-        if ( FloatUtils::isPositive( costFunction[i] ) )
-             cost += "+";
-        cost += Stringf( "%.3lf*nb[%u] ", costFunction[i], i );
+        String cost;
+        for ( unsigned i = 0; i < n - m; ++i )
+        {
+            if ( FloatUtils::isZero( costFunction[i] ) )
+                continue;
+
+            if ( FloatUtils::isPositive( costFunction[i] ) )
+                cost += "+";
+            cost += Stringf( "%.3lf*nb[%u] ", costFunction[i], i );
+        }
+        DANTZIG_LOG( Stringf( "Cost function: %s\n", cost.ascii() ).ascii() );
     }
-    DANTZIG_LOG( Stringf( "Cost function: %s\n", cost.ascii() ).ascii() );
 
-    List<unsigned>::const_iterator candidate = remainingCandidates.begin();
-    unsigned maxIndex = *candidate;
-    double maxValue = FloatUtils::abs( costFunction[maxIndex] );
-    ++candidate;
+    bool found = false;
+    unsigned maxIndex = 0;
+    double maxValue = 0;
 
-    while ( candidate != remainingCandidates.end() )
+    for ( unsigned i = 0; i < candidates.size(); ++i )
     {
-        double contenderValue = FloatUtils::abs( costFunction[*candidate] );
-        if ( FloatUtils::gt( contenderValue, maxValue ) )
+        unsigned candidate = candidates.get( i );
+        if ( excluded.exists( candidate ) )
+            continue;
+
+        double contenderValue = FloatUtils::abs( costFunction[candidate] );
+        if ( !found || FloatUtils::gt( contenderValue, maxValue ) )
         {
-            maxIndex = *candidate;
+            found = true;
+            maxIndex = candidate;
             maxValue = contenderValue;
         }
-        ++candidate;
     }
 
+    if ( !found )
+        return false;
+
     DANTZIG_LOG( Stringf( "Largest coefficient: %.3lf. Corresponding variable: %u\n", maxValue, maxIndex ).ascii() );
 
     tableau.setEnteringVariableIndex( maxIndex );
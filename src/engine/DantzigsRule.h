@@ -30,7 +30,7 @@ public:
       largest coefficient (in absolute value) in the cost function.
     */
     bool select( ITableau &tableau,
-                 const List<unsigned> &candidates,
+                 const Vector<unsigned> &candidates,
                  const Set<unsigned> &excluded );
 };
 
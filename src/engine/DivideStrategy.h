@@ -25,6 +25,7 @@ enum DivideStrategy
     Polarity,      // Pick the ReLU with the polarity closest to 0 among the first K nodes
     EarliestReLU,  // Pick a ReLU that appears in the earliest layer
     ReLUViolation, // Pick the ReLU that has been violated for the most times
+    Activity,      // Pick the constraint that took part in the most (recent) conflicts
 };
 
 #endif // __DivideStrategy_h__
@@ -31,7 +31,7 @@
 #include <cmath>
 #include <thread>
 
-void DnCManager::dncSolve( WorkerQueue *workload, std::shared_ptr<Engine> engine,
+void DnCManager::dncSolve( WorkStealingQueue *workload, std::shared_ptr<Engine> engine,
                            std::unique_ptr<InputQuery> inputQuery,
                            std::atomic_uint &numUnsolvedSubQueries,
                            std::atomic_bool &shouldQuitSolving,
@@ -46,6 +46,7 @@ void DnCManager::dncSolve( WorkerQueue *workload, std::shared_ptr<Engine> engine
     DNC_MANAGER_LOG( Stringf( "Thread #%u on CPU %u", threadId, cpuId ).ascii() );
 
     engine->processInputQuery( *inputQuery, false );
+    engine->setWorkStealingQueue( workload, threadId );
 
     DnCWorker worker( workload, engine, std::ref( numUnsolvedSubQueries ),
                       std::ref( shouldQuitSolving ), threadId, onlineDivides,
@@ -85,13 +86,6 @@ void DnCManager::freeMemoryIfNeeded()
 {
     if ( _workload )
     {
-        SubQuery *subQuery = NULL;
-        while ( !_workload->empty() )
-        {
-            _workload->pop( subQuery );
-            delete subQuery;
-        }
-
         delete _workload;
         _workload = NULL;
     }
@@ -118,26 +112,26 @@ void DnCManager::solve( unsigned timeoutInSeconds )
     for ( unsigned i = 0; i < _numWorkers; ++i )
         quitThreads.append( _engines[i]->getQuitRequested() );
 
-    // Partition the input query into initial subqueries, and place these
-    // queries in the queue
-    _workload = new WorkerQueue( 0 );
-    if ( !_workload )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "DnCManager::workload" );
-
+    // Partition the input query into initial subqueries
     SubQueries subQueries;
     initialDivide( subQueries );
 
     // Create objects shared across workers
     _numUnsolvedSubQueries = subQueries.size();
     std::atomic_bool shouldQuitSolving( false );
-    WorkerQueue *workload = new WorkerQueue( 0 );
+
+    // Deal the initial subqueries out to the workers' deques
+    freeMemoryIfNeeded();
+    _workload = new WorkStealingQueue( _numWorkers, _numUnsolvedSubQueries,
+                                       shouldQuitSolving );
+    if ( !_workload )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "DnCManager::workload" );
+
+    unsigned workerId = 0;
     for ( auto &subQuery : subQueries )
     {
-        if ( !workload->push( subQuery ) )
-        {
-            // This should never happen
-            ASSERT( false );
-        }
+        _workload->push( workerId, subQuery );
+        workerId = ( workerId + 1 ) % _numWorkers;
     }
 
     // Spawn threads and start solving
@@ -147,7 +141,7 @@ void DnCManager::solve( unsigned timeoutInSeconds )
         // Get the processed input query from the base engine
         auto inputQuery = std::unique_ptr<InputQuery>
             ( new InputQuery( *( _baseEngine->getInputQuery() ) ) );
-        threads.push_back( std::thread( dncSolve, workload, _engines[ threadId ],
+        threads.push_back( std::thread( dncSolve, _workload, _engines[ threadId ],
                                         std::move( inputQuery ),
                                         std::ref( _numUnsolvedSubQueries ),
                                         std::ref( shouldQuitSolving ),
@@ -161,7 +155,7 @@ void DnCManager::solve( unsigned timeoutInSeconds )
     {
         updateTimeoutReached( startTime, timeoutInMicroSeconds );
         if ( _timeoutReached )
-            shouldQuitSolving = true;
+            _workload->quit();
         else
             std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
     }
@@ -174,6 +168,9 @@ void DnCManager::solve( unsigned timeoutInSeconds )
     for ( auto &thread : threads )
         thread.join();
 
+    // The queue refers to the quit flag, which goes out of scope
+    freeMemoryIfNeeded();
+
     updateDnCExitCode();
     return;
 }
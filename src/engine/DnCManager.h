@@ -21,6 +21,7 @@
 #include "InputQuery.h"
 #include "SubQuery.h"
 #include "Vector.h"
+#include "WorkStealingQueue.h"
 
 #include <atomic>
 
@@ -81,7 +82,7 @@ private:
     /*
       Create and run a DnCWorker
     */
-    static void dncSolve( WorkerQueue *workload, std::shared_ptr<Engine> engine,
+    static void dncSolve( WorkStealingQueue *workload, std::shared_ptr<Engine> engine,
                           std::unique_ptr<InputQuery> inputQuery,
                           std::atomic_uint &numUnsolvedSubQueries,
                           std::atomic_bool &shouldQuitSolving,
@@ -173,9 +174,9 @@ private:
     DnCExitCode _exitCode;
 
     /*
-      Set of subQueries to be solved by workers
+      Set of subQueries to be solved by workers, kept in per-worker deques
     */
-    WorkerQueue *_workload;
+    WorkStealingQueue *_workload;
 
     /*
       Whether the timeout has been reached
@@ -25,11 +25,9 @@
 #include "SubQuery.h"
 
 #include <atomic>
-#include <chrono>
 #include <cmath>
-#include <thread>
 
-DnCWorker::DnCWorker( WorkerQueue *workload, std::shared_ptr<IEngine> engine,
+DnCWorker::DnCWorker( WorkStealingQueue *workload, std::shared_ptr<IEngine> engine,
                       std::atomic_uint &numUnsolvedSubQueries,
                       std::atomic_bool &shouldQuitSolving,
                       unsigned threadId, unsigned onlineDivides,
@@ -41,12 +39,13 @@ DnCWorker::DnCWorker( WorkerQueue *workload, std::shared_ptr<IEngine> engine,
     , _threadId( threadId )
     , _onlineDivides( onlineDivides )
     , _timeoutFactor( timeoutFactor )
+    , _engineIsAtCachedRegion( false )
 {
     setQueryDivider( divideStrategy );
 
     // Obtain the current state of the engine
     _initialState = std::make_shared<EngineState>();
-    _engine->storeState( *_initialState, true );
+    _engine->storeState( *_initialState, TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE );
 }
 
 void DnCWorker::setQueryDivider( DivideStrategy divideStrategy )
@@ -63,27 +62,25 @@ void DnCWorker::setQueryDivider( DivideStrategy divideStrategy )
 
 void DnCWorker::popOneSubQueryAndSolve()
 {
-    SubQuery *subQuery = NULL;
-    // Boost queue stores the next element into the passed-in pointer
-    // and returns true if the pop is successful (aka, the queue is not empty
-    // in most cases)
-    if ( _workload->pop( subQuery ) )
+    // Blocks until a subQuery is available, and returns NULL once
+    // solving is over
+    SubQuery *subQuery = _workload->pop( _threadId );
+    if ( subQuery )
     {
+        _workload->startSubQuery( _threadId, *subQuery );
+
         String queryId = subQuery->_queryId;
         auto split = std::move( subQuery->_split );
         unsigned timeoutInSeconds = subQuery->_timeoutInSeconds;
 
-        // Reset the engine state
-        _engine->restoreState( *_initialState );
-        _engine->reset();
-
         // TODO: each worker is going to keep a map from *CaseSplit to an
         // object of class DnCStatistics, which contains some basic
         // statistics. The maps are owned by the DnCManager.
 
         // Apply the split and solve
-        _engine->applySplit( *split );
+        prepareEngineForSubQuery( *split );
         _engine->solve( timeoutInSeconds );
+        _engineIsAtCachedRegion = false;
 
         IEngine::ExitCode result = _engine->getExitCode();
         printProgress( queryId, result );
@@ -93,26 +90,63 @@ void DnCWorker::popOneSubQueryAndSolve()
             // If UNSAT, continue to solve
             *_numUnsolvedSubQueries -= 1;
             if ( _numUnsolvedSubQueries->load() == 0 )
-                *_shouldQuitSolving = true;
+                _workload->quit();
             delete subQuery;
         }
         else if ( result == IEngine::TIMEOUT )
         {
-            // If TIMEOUT, split the current input region and add the
-            // new subQueries to the current queue
-            SubQueries subQueries;
-            _queryDivider->createSubQueries( pow( 2, _onlineDivides ),
-                                             queryId, *split,
-                                             (unsigned)timeoutInSeconds *
-                                             _timeoutFactor, subQueries );
-            for ( auto &newSubQuery : subQueries )
+            // If subtrees of the current search were shared, the subtrees
+            // that remain on the stack are all that is left of the region
+            List<PiecewiseLinearCaseSplit> subtrees;
+            if ( _workload->getNumSharedSubtrees( _threadId ) > 0 )
+                _engine->splitOffRemainingSubtrees( subtrees );
+
+            // The new subQueries lie inside the current region, so cache
+            // the state at the root of the current search for them
+            _engine->backtrackToRoot();
+            _cachedRegion = std::make_shared<PiecewiseLinearCaseSplit>( *split );
+            _cachedRegionState = std::make_shared<EngineState>();
+            _engine->storeState( *_cachedRegionState,
+                                 TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE );
+            _engineIsAtCachedRegion = true;
+
+            if ( subtrees.empty() )
             {
-                if ( !_workload->push( std::move( newSubQuery ) ) )
+                // If TIMEOUT, split the current input region and add the
+                // new subQueries to the current queue
+                SubQueries subQueries;
+                _queryDivider->createSubQueries( pow( 2, _onlineDivides ),
+                                                 queryId, *split,
+                                                 (unsigned)timeoutInSeconds *
+                                                 _timeoutFactor, subQueries );
+                for ( auto &newSubQuery : subQueries )
                 {
-                    throw MarabouError( MarabouError::UNSUCCESSFUL_QUEUE_PUSH );
+                    *_numUnsolvedSubQueries += 1;
+                    _workload->push( _threadId, newSubQuery );
                 }
+            }
+            else
+            {
+                // Parts of the current region were given away to other
+                // workers, so only the subtrees left to this worker are
+                // added to the queue
+                unsigned queryIdSuffix = 1;
+                for ( const auto &subtree : subtrees )
+                {
+                    auto newSplit = std::unique_ptr<PiecewiseLinearCaseSplit>
+                        ( new PiecewiseLinearCaseSplit( *split ) );
+                    for ( const auto &bound : subtree.getBoundTightenings() )
+                        newSplit->storeBoundTightening( bound );
+                    for ( const auto &equation : subtree.getEquations() )
+                        newSplit->addEquation( equation );
 
-                *_numUnsolvedSubQueries += 1;
+                    String newQueryId = queryId + Stringf( "-r%u", queryIdSuffix++ );
+                    SubQuery *newSubQuery =
+                        new SubQuery( newQueryId, newSplit,
+                                      (unsigned)timeoutInSeconds * _timeoutFactor );
+                    *_numUnsolvedSubQueries += 1;
+                    _workload->push( _threadId, newSubQuery );
+                }
             }
             *_numUnsolvedSubQueries -= 1;
             delete subQuery;
@@ -129,7 +163,7 @@ void DnCWorker::popOneSubQueryAndSolve()
             // We must set the quit flag to true  if the result is not UNSAT or
             // TIMEOUT. This way, the DnCManager will kill all the DnCWorkers.
 
-            *_shouldQuitSolving = true;
+            _workload->quit();
             if ( result == IEngine::SAT )
             {
                 // case SAT
@@ -151,11 +185,75 @@ void DnCWorker::popOneSubQueryAndSolve()
             }
         }
     }
+}
+
+void DnCWorker::prepareEngineForSubQuery( const PiecewiseLinearCaseSplit &split )
+{
+    PiecewiseLinearCaseSplit difference;
+    if ( _cachedRegion && regionContains( *_cachedRegion, split, difference ) )
+    {
+        // Only the bounds that differ from the cached region are applied
+        if ( !_engineIsAtCachedRegion )
+            _engine->restoreState( *_cachedRegionState );
+        _engine->reset();
+        _engine->applySplit( difference );
+    }
     else
     {
-        // If the queue is empty but the pop fails, wait and retry
-        std::this_thread::sleep_for( std::chrono::milliseconds( 100 ) );
+        _engine->restoreState( *_initialState );
+        _engine->reset();
+        _engine->applySplit( split );
+    }
+}
+
+bool DnCWorker::regionContains( const PiecewiseLinearCaseSplit &region,
+                                const PiecewiseLinearCaseSplit &subRegion,
+                                PiecewiseLinearCaseSplit &difference )
+{
+    const List<Tightening> &bounds = region.getBoundTightenings();
+    const List<Tightening> &subBounds = subRegion.getBoundTightenings();
+
+    for ( const auto &bound : bounds )
+    {
+        bool implied = false;
+        for ( const auto &subBound : subBounds )
+        {
+            if ( subBound._variable != bound._variable || subBound._type != bound._type )
+                continue;
+
+            if ( ( bound._type == Tightening::LB && subBound._value >= bound._value ) ||
+                 ( bound._type == Tightening::UB && subBound._value <= bound._value ) )
+            {
+                implied = true;
+                break;
+            }
+        }
+
+        if ( !implied )
+            return false;
+    }
+
+    const List<Equation> &equations = region.getEquations();
+    const List<Equation> &subEquations = subRegion.getEquations();
+    for ( const auto &equation : equations )
+    {
+        if ( !subEquations.exists( equation ) )
+            return false;
+    }
+
+    for ( const auto &subBound : subBounds )
+    {
+        if ( !bounds.exists( subBound ) )
+            difference.storeBoundTightening( subBound );
     }
+
+    for ( const auto &subEquation : subEquations )
+    {
+        if ( !equations.exists( subEquation ) )
+            difference.addEquation( subEquation );
+    }
+
+    return true;
 }
 
 void DnCWorker::printProgress( String queryId, IEngine::ExitCode result ) const
@@ -20,21 +20,22 @@
 #include "Engine.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "QueryDivider.h"
+#include "WorkStealingQueue.h"
 
 #include <atomic>
 
 class DnCWorker
 {
 public:
-    DnCWorker( WorkerQueue *workload, std::shared_ptr<IEngine> engine,
+    DnCWorker( WorkStealingQueue *workload, std::shared_ptr<IEngine> engine,
                std::atomic_uint &numUnsolvedSubqueries,
                std::atomic_bool &shouldQuitSolving, unsigned threadId,
                unsigned onlineDivides, float timeoutFactor,
                DivideStrategy divideStrategy );
 
     /*
-      Pop one subQuery, solve it and handle the result
-      Return true if the DnCWorker should continue running
+      Pop one subQuery, solve it and handle the result. If no subQuery
+      is available, block until one is pushed or solving is over.
     */
     void popOneSubQueryAndSolve();
 
@@ -44,6 +45,23 @@ private:
     */
     void setQueryDivider( DivideStrategy divideStrategy );
 
+    /*
+      Return true iff the region described by subRegion is contained in
+      the one described by region: each bound of region is implied by a
+      bound of subRegion, and each equation of region appears in
+      subRegion. In that case, store in difference the bounds and
+      equations of subRegion that do not already appear in region.
+    */
+    static bool regionContains( const PiecewiseLinearCaseSplit &region,
+                                const PiecewiseLinearCaseSplit &subRegion,
+                                PiecewiseLinearCaseSplit &difference );
+
+    /*
+      Bring the engine to the root of the given subquery's region,
+      starting from the cached region when possible
+    */
+    void prepareEngineForSubQuery( const PiecewiseLinearCaseSplit &split );
+
     /*
       Convert the exitCode to string
     */
@@ -55,9 +73,9 @@ private:
     void printProgress( String queryId, IEngine::ExitCode result ) const;
 
     /*
-      The queue of subqueries (shared across threads)
+      The per-worker deques of subqueries (shared across threads)
     */
-    WorkerQueue *_workload;
+    WorkStealingQueue *_workload;
     std::shared_ptr<IEngine> _engine;
 
     /*
@@ -80,6 +98,20 @@ private:
     unsigned _threadId;
     unsigned _onlineDivides;
     float _timeoutFactor;
+
+    /*
+      The region of the last subquery that timed out, and the engine
+      state at the root of its search, including the bound tightenings
+      derived there and a warm basis. Subqueries inside this region are
+      solved from that state instead of from the initial state.
+    */
+    std::shared_ptr<PiecewiseLinearCaseSplit> _cachedRegion;
+    std::shared_ptr<EngineState> _cachedRegionState;
+
+    /*
+      Whether the engine is currently at the root of the cached region
+    */
+    bool _engineIsAtCachedRegion;
 };
 
 #endif // __DnCWorker_h__
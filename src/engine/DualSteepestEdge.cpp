@@ -0,0 +1,200 @@
+/*********************                                                        */
+/*! \file DualSteepestEdge.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include "Debug.h"
+#include "DualSteepestEdge.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "ITableau.h"
+#include "MarabouError.h"
+
+#include <algorithm>
+
+DualSteepestEdgeRule::DualSteepestEdgeRule()
+    : _weights( NULL )
+    , _unitVector( NULL )
+    , _rho( NULL )
+    , _tau( NULL )
+    , _m( 0 )
+{
+}
+
+DualSteepestEdgeRule::~DualSteepestEdgeRule()
+{
+    freeIfNeeded();
+}
+
+void DualSteepestEdgeRule::freeIfNeeded()
+{
+    if ( _weights )
+    {
+        delete[] _weights;
+        _weights = NULL;
+    }
+
+    if ( _unitVector )
+    {
+        delete[] _unitVector;
+        _unitVector = NULL;
+    }
+
+    if ( _rho )
+    {
+        delete[] _rho;
+        _rho = NULL;
+    }
+
+    if ( _tau )
+    {
+        delete[] _tau;
+        _tau = NULL;
+    }
+}
+
+void DualSteepestEdgeRule::initialize( const ITableau &tableau )
+{
+    if ( !_weights || _m != tableau.getM() )
+    {
+        freeIfNeeded();
+
+        _m = tableau.getM();
+
+        _weights = new double[_m];
+        if ( !_weights )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "DualSteepestEdgeRule::weights" );
+
+        _unitVector = new double[_m];
+        if ( !_unitVector )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "DualSteepestEdgeRule::unitVector" );
+
+        _rho = new double[_m];
+        if ( !_rho )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "DualSteepestEdgeRule::rho" );
+
+        _tau = new double[_m];
+        if ( !_tau )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "DualSteepestEdgeRule::tau" );
+
+        std::fill_n( _unitVector, _m, 0.0 );
+    }
+
+    /*
+      The exact weights are expensive to compute, so we start from the
+      weights of the slack basis and let the updates refine them.
+    */
+    std::fill_n( _weights, _m, 1.0 );
+}
+
+bool DualSteepestEdgeRule::select( ITableau &tableau )
+{
+    // The tableau might have been resized since we were initialized
+    if ( tableau.getM() != _m )
+        initialize( tableau );
+
+    unsigned best = _m;
+    double bestScore = 0;
+
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( !tableau.basicOutOfBounds( i ) )
+            continue;
+
+        unsigned variable = tableau.basicIndexToVariable( i );
+        double value = tableau.getBasicAssignment( i );
+        double infeasibility = tableau.basicTooLow( i ) ?
+            tableau.getLowerBound( variable ) - value :
+            value - tableau.getUpperBound( variable );
+
+        double score = infeasibility * infeasibility / _weights[i];
+        if ( score > bestScore )
+        {
+            best = i;
+            bestScore = score;
+        }
+    }
+
+    if ( best == _m )
+        return false;
+
+    tableau.setLeavingVariableIndex( best );
+    return true;
+}
+
+void DualSteepestEdgeRule::prePivotHook( const ITableau &tableau )
+{
+    /*
+      Let r be the leaving index and alpha the change column of the
+      entering variable, i.e. alpha = inv(B) * a_q. For the new basis,
+      the rows of the basis inverse are
+
+        row_r' = row_r / alpha_r
+        row_i' = row_i - ( alpha_i / alpha_r ) * row_r
+
+      and so, with rho = row_r and tau = inv(B) * rho, the squared
+      norms are updated as
+
+        w_r' = w_r / alpha_r^2
+        w_i' = w_i - 2 ( alpha_i / alpha_r ) tau_i + ( alpha_i / alpha_r )^2 w_r
+
+      Since rho is computed anyway, w_r is recomputed exactly first.
+    */
+    ASSERT( tableau.getM() == _m );
+
+    unsigned leavingIndex = tableau.getLeavingVariableIndex();
+    const double *changeColumn = tableau.getChangeColumn();
+    double alphaR = changeColumn[leavingIndex];
+
+    if ( FloatUtils::isZero( alphaR ) )
+        return;
+
+    // rho = e_r * inv(B)
+    _unitVector[leavingIndex] = 1;
+    tableau.backwardTransformation( _unitVector, _rho );
+    _unitVector[leavingIndex] = 0;
+
+    double weightR = 0;
+    for ( unsigned i = 0; i < _m; ++i )
+        weightR += _rho[i] * _rho[i];
+
+    // tau = inv(B) * rho
+    tableau.forwardTransformation( _rho, _tau );
+
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( i == leavingIndex || FloatUtils::isZero( changeColumn[i] ) )
+            continue;
+
+        double ratio = changeColumn[i] / alphaR;
+        double weight = _weights[i] - 2 * ratio * _tau[i] + ratio * ratio * weightR;
+
+        // Guard against cancellation errors, as suggested by Forrest and Goldfarb
+        _weights[i] = FloatUtils::max( weight, FloatUtils::max( ratio * ratio, GlobalConfiguration::DSE_MINIMAL_WEIGHT ) );
+    }
+
+    _weights[leavingIndex] = FloatUtils::max( weightR / ( alphaR * alphaR ), GlobalConfiguration::DSE_MINIMAL_WEIGHT );
+}
+
+double DualSteepestEdgeRule::getWeight( unsigned basicIndex ) const
+{
+    return _weights[basicIndex];
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,90 @@
+/*********************                                                        */
+/*! \file DualSteepestEdge.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The dual steepest edge pricing rule, used by the dual simplex to
+ ** pick the leaving variable. Each basic variable's infeasibility is
+ ** weighted by the squared norm of its row of the basis inverse, and
+ ** the weights are updated after every dual pivot, following Forrest
+ ** and Goldfarb.
+
+**/
+
+#ifndef __DualSteepestEdge_h__
+#define __DualSteepestEdge_h__
+
+class ITableau;
+
+class DualSteepestEdgeRule
+{
+public:
+    DualSteepestEdgeRule();
+    ~DualSteepestEdgeRule();
+
+    /*
+      Allocate the data structures according to the size of the
+      tableau, and reset all weights to 1.
+    */
+    void initialize( const ITableau &tableau );
+
+    /*
+      Pick the out-of-bounds basic variable with the largest weighted
+      infeasibility as the leaving variable, and set it in the
+      tableau. Returns false if all basic variables are within their
+      bounds.
+    */
+    bool select( ITableau &tableau );
+
+    /*
+      Update the weights according to the entering and leaving
+      variables. Should be called before the pivot is performed, once
+      the change column has been computed.
+    */
+    void prePivotHook( const ITableau &tableau );
+
+    /*
+      For debugging purposes.
+    */
+    double getWeight( unsigned basicIndex ) const;
+
+private:
+    /*
+      The weights, one per basic index: the squared norms of the rows
+      of the basis inverse.
+    */
+    double *_weights;
+
+    /*
+      Work space.
+    */
+    double *_unitVector;
+    double *_rho;
+    double *_tau;
+
+    /*
+      The number of rows of the tableau.
+    */
+    unsigned _m;
+
+    /*
+      Free all data structures.
+    */
+    void freeIfNeeded();
+};
+
+#endif // __DualSteepestEdge_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
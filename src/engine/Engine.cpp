@@ -15,6 +15,7 @@
  **/
 
 #include "AutoConstraintMatrixAnalyzer.h"
+#include "CSRMatrix.h"
 #include "Debug.h"
 #include "Engine.h"
 #include "EngineState.h"
@@ -28,6 +29,7 @@
 #include "Preprocessor.h"
 #include "TableauRow.h"
 #include "TimeUtils.h"
+#include "WorkStealingQueue.h"
 
 Engine::Engine( unsigned verbosity )
     : _rowBoundTightener( *_tableau )
@@ -40,6 +42,8 @@ Engine::Engine( unsigned verbosity )
     , _basisRestorationPerformed( Engine::NO_RESTORATION_PERFORMED )
     , _costFunctionManager( _tableau )
     , _quitRequested( false )
+    , _workStealingQueue( NULL )
+    , _workerId( 0 )
     , _exitCode( Engine::NOT_DONE )
     , _constraintBoundTightener( *_tableau )
     , _numVisitedStatesAtPreviousRestoration( 0 )
@@ -47,6 +51,9 @@ Engine::Engine( unsigned verbosity )
     , _verbosity( verbosity )
     , _lastNumVisitedStates( 0 )
     , _lastIterationWithProgress( 0 )
+    , _dualSimplexActive( false )
+    , _numDualSimplexSteps( 0 )
+    , _infeasibilityExplained( false )
 {
     _smtCore.setStatistics( &_statistics );
     _tableau->setStatistics( &_statistics );
@@ -94,6 +101,7 @@ bool Engine::solve( unsigned timeoutInSeconds )
 
     updateDirections();
     storeInitialEngineState();
+    _smtCore.clearLearnedClauses();
 
     mainLoopStatistics();
     if ( _verbosity > 0 )
@@ -193,7 +201,6 @@ bool Engine::solve( unsigned timeoutInSeconds )
 
                 n++;
                 if (n % 10 == 0) {
-                    printf("Running milp");
                     performMILPSolverBoundedTightening();
                 }
                 splitJustPerformed = false;
@@ -202,6 +209,7 @@ bool Engine::solve( unsigned timeoutInSeconds )
             if ( !_tableau->allBoundsValid() )
             {
                 // Some variable bounds are invalid, so the query is unsat
+                explainInvalidBounds();
                 throw InfeasibleQueryException();
             }
 
@@ -210,11 +218,14 @@ bool Engine::solve( unsigned timeoutInSeconds )
             {
                 _smtCore.performSplit();
                 splitJustPerformed = true;
+                shareSubtreeIfNeeded();
                 continue;
             }
             if ( allVarsWithinBounds() )
             {
                 // The linear portion of the problem has been solved.
+                _dualSimplexActive = false;
+
                 // Check the status of the PL constraints
                 collectViolatedPlConstraints();
 
@@ -267,7 +278,10 @@ bool Engine::solve( unsigned timeoutInSeconds )
             }
 
             // We have out-of-bounds variables.
-            performSimplexStep();
+            if ( _dualSimplexActive )
+                performDualSimplexStep();
+            else
+                performSimplexStep();
             continue;
         }
         catch ( const MalformedBasisException & )
@@ -301,7 +315,7 @@ bool Engine::solve( unsigned timeoutInSeconds )
         {
             // The current query is unsat, and we need to pop.
             // If we're at level 0, the whole query is unsat.
-            if ( !_smtCore.popSplit() )
+            if ( !backtrackFromConflict() )
             {
                 if ( _verbosity > 0 )
                 {
@@ -417,8 +431,7 @@ void Engine::performSimplexStep()
         });
 
     // Obtain all eligible entering varaibles
-    List<unsigned> enteringVariableCandidates;
-    _tableau->getEntryCandidates( enteringVariableCandidates );
+    _tableau->getEntryCandidates( _enteringVariableCandidates );
 
     unsigned bestLeaving = 0;
     double bestChangeRatio = 0.0;
@@ -434,7 +447,7 @@ void Engine::performSimplexStep()
 
         // Attempt to pick the best entering variable from the available candidates
         if ( !_activeEntryStrategy->select( _tableau,
-                                            enteringVariableCandidates,
+                                            _enteringVariableCandidates,
                                             excludedEnteringVariables ) )
         {
             // No additional candidates can be found.
@@ -506,6 +519,7 @@ void Engine::performSimplexStep()
         else
         {
             // Cost function is fresh --- failure is real.
+            explainSimplexInfeasibility();
             struct timespec end = TimeUtils::sampleMicro();
             _statistics.addTimeSimplexSteps( TimeUtils::timePassed( start, end ) );
             throw InfeasibleQueryException();
@@ -540,6 +554,7 @@ void Engine::performSimplexStep()
     if ( !fakePivot )
     {
         _tableau->computePivotRow();
+        _tableau->flushBoundChanges();
         _rowBoundTightener->examinePivotRow();
     }
 
@@ -552,6 +567,217 @@ void Engine::performSimplexStep()
     _statistics.addTimeSimplexSteps( TimeUtils::timePassed( start, end ) );
 }
 
+void Engine::startDualSimplex()
+{
+    if ( !GlobalConfiguration::USE_DUAL_SIMPLEX_AFTER_BOUND_CHANGES )
+        return;
+
+    if ( _dualSimplexActive )
+        return;
+
+    // Dual pivots do not maintain the cost function
+    _costFunctionManager->invalidateCostFunction();
+    _dualSimplexActive = true;
+    _numDualSimplexSteps = 0;
+    _dualSteepestEdgeRule.initialize( *_tableau );
+}
+
+void Engine::explainSimplexInfeasibility()
+{
+    if ( !needToExplainInfeasibility() )
+        return;
+
+    /*
+      Let f be the sum of the too-high basic variables minus the sum of
+      the too-low ones. The violated bounds give an upper bound on f,
+      which the current value of f exceeds. Expressed over the
+      non-basic variables, the coefficients of f are the reduced costs,
+      and as no non-basic variable can improve f, the bounds blocking
+      them keep f at least at its current value. Together with the
+      equations, these bounds are thus infeasible.
+    */
+    _infeasibilityExplanation.clear();
+
+    unsigned m = _tableau->getM();
+    for ( unsigned i = 0; i < m; ++i )
+    {
+        double basicCost = _costFunctionManager->getBasicCost( i );
+        unsigned variable = _tableau->basicIndexToVariable( i );
+
+        if ( basicCost > 0 )
+            _infeasibilityExplanation.append
+                ( Tightening( variable, _tableau->getUpperBound( variable ), Tightening::UB ) );
+        else if ( basicCost < 0 )
+            _infeasibilityExplanation.append
+                ( Tightening( variable, _tableau->getLowerBound( variable ), Tightening::LB ) );
+    }
+
+    // Even tiny reduced costs count, to stay on the safe side
+    const double *costFunction = _costFunctionManager->getCostFunction();
+    unsigned numNonBasics = _tableau->getN() - m;
+    for ( unsigned i = 0; i < numNonBasics; ++i )
+    {
+        unsigned variable = _tableau->nonBasicIndexToVariable( i );
+
+        if ( costFunction[i] > 0 )
+            _infeasibilityExplanation.append
+                ( Tightening( variable, _tableau->getLowerBound( variable ), Tightening::LB ) );
+        else if ( costFunction[i] < 0 )
+            _infeasibilityExplanation.append
+                ( Tightening( variable, _tableau->getUpperBound( variable ), Tightening::UB ) );
+    }
+
+    _infeasibilityExplained = true;
+}
+
+void Engine::explainInvalidBounds()
+{
+    if ( !needToExplainInfeasibility() )
+        return;
+
+    unsigned n = _tableau->getN();
+    for ( unsigned i = 0; i < n; ++i )
+    {
+        double lb = _tableau->getLowerBound( i );
+        double ub = _tableau->getUpperBound( i );
+
+        if ( FloatUtils::gt( lb, ub ) )
+        {
+            _infeasibilityExplanation.clear();
+            _infeasibilityExplanation.append( Tightening( i, lb, Tightening::LB ) );
+            _infeasibilityExplanation.append( Tightening( i, ub, Tightening::UB ) );
+            _infeasibilityExplained = true;
+            return;
+        }
+    }
+}
+
+bool Engine::needToExplainInfeasibility() const
+{
+    return _smtCore.conflictAnalysisEnabled() ||
+        GlobalConfiguration::SPLITTING_HEURISTICS == DivideStrategy::Activity;
+}
+
+bool Engine::backtrackFromConflict()
+{
+    if ( !_infeasibilityExplained )
+        return _smtCore.popSplit();
+
+    _infeasibilityExplained = false;
+
+    if ( GlobalConfiguration::SPLITTING_HEURISTICS == DivideStrategy::Activity )
+    {
+        for ( const auto &bound : _infeasibilityExplanation )
+            _activityHeap.bumpVariable( bound._variable );
+        _activityHeap.decay();
+    }
+
+    if ( !_smtCore.conflictAnalysisEnabled() )
+    {
+        _infeasibilityExplanation.clear();
+        return _smtCore.popSplit();
+    }
+
+    // Locate the bounds of the explanation on the bound trail
+    Vector<unsigned> positions;
+    _tableau->getBoundTrailPositions( _infeasibilityExplanation, positions );
+
+    List<SmtCore::ConflictBound> explanation;
+    unsigned index = 0;
+    for ( const auto &bound : _infeasibilityExplanation )
+    {
+        explanation.append( SmtCore::ConflictBound( bound, positions[index] ) );
+        ++index;
+    }
+
+    _infeasibilityExplanation.clear();
+    return _smtCore.backjump( explanation );
+}
+
+void Engine::performDualSimplexStep()
+{
+    if ( _numDualSimplexSteps >= GlobalConfiguration::DUAL_SIMPLEX_MAX_CONSECUTIVE_STEPS )
+    {
+        _dualSimplexActive = false;
+        return;
+    }
+
+    // Statistics
+    _statistics.incNumSimplexSteps();
+    _statistics.incNumDualSimplexSteps();
+    struct timespec start = TimeUtils::sampleMicro();
+
+    /*
+      The bounds have changed but the basis has not, so the basis is
+      still dual feasible (trivially so, as the objective is zero), and
+      we can run the dual simplex:
+
+      1. Pick an out-of-bounds basic variable as the leaving variable,
+         according to the dual steepest edge rule.
+      2. Pick the entering variable from the leaving variable's row,
+         using the dual ratio test.
+      3. Pivot, pushing the leaving variable onto its violated bound.
+
+      With a zero objective, the dual simplex has no measure of progress
+      and may cycle, so after too many consecutive dual steps we fall
+      back to the primal simplex.
+    */
+    if ( !_dualSteepestEdgeRule.select( *_tableau ) )
+    {
+        // All basic variables are within bounds, nothing to do
+        _dualSimplexActive = false;
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics.addTimeSimplexSteps( TimeUtils::timePassed( start, end ) );
+        return;
+    }
+
+    _tableau->computePivotRow();
+
+    if ( !_tableau->pickEnteringVariableByDualRatioTest() )
+    {
+        /*
+          No non-basic variable can fix the leaving variable, which
+          usually means that the query is infeasible. The primal
+          simplex, with a freshly computed cost function, makes the
+          final call.
+        */
+        _dualSimplexActive = false;
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics.addTimeSimplexSteps( TimeUtils::timePassed( start, end ) );
+        return;
+    }
+
+    _tableau->computeChangeColumn();
+
+    double pivotEntry = FloatUtils::abs( _tableau->getChangeColumn()[_tableau->getLeavingVariableIndex()] );
+    if ( pivotEntry < GlobalConfiguration::ACCEPTABLE_SIMPLEX_PIVOT_THRESHOLD )
+    {
+        // As in the primal simplex, refresh the basis factorization
+        // and try again if it isn't fresh
+        if ( !_tableau->basisMatrixAvailable() )
+        {
+            _tableau->refreshBasisFactorization();
+            return;
+        }
+
+        _statistics.incNumSimplexUnstablePivots();
+    }
+
+    _tableau->flushBoundChanges();
+    _rowBoundTightener->examinePivotRow();
+
+    // Perform the actual pivot
+    _dualSteepestEdgeRule.prePivotHook( *_tableau );
+    _activeEntryStrategy->prePivotHook( _tableau, false );
+    _tableau->performPivot();
+    _activeEntryStrategy->postPivotHook( _tableau, false );
+
+    ++_numDualSimplexSteps;
+
+    struct timespec end = TimeUtils::sampleMicro();
+    _statistics.addTimeSimplexSteps( TimeUtils::timePassed( start, end ) );
+}
+
 void Engine::fixViolatedPlConstraintIfPossible()
 {
     List<PiecewiseLinearConstraint::Fix> fixes;
@@ -741,17 +967,22 @@ void Engine::storeEquationsInDegradationChecker()
     _degradationChecker.storeEquations( _preprocessedQuery );
 }
 
-double *Engine::createConstraintMatrix()
+void Engine::createConstraintMatrix( CSRMatrix &constraintMatrix )
 {
     const List<Equation> &equations( _preprocessedQuery.getEquations() );
     unsigned m = equations.size();
     unsigned n = _preprocessedQuery.getNumberOfVariables();
 
-    // Step 1: create a constraint matrix from the equations
-    double *constraintMatrix = new double[n*m];
-    if ( !constraintMatrix )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Engine::constraintMatrix" );
-    std::fill_n( constraintMatrix, n*m, 0.0 );
+    /*
+      The matrix is kept sparse, as a dense m x n copy may be very
+      large. Its storage is sized by the number of addends, with room
+      for one more so that inserting them does not trigger a resize
+    */
+    unsigned numAddends = 0;
+    for ( const auto &equation : equations )
+        numAddends += equation._addends.size();
+
+    constraintMatrix.initializeToEmpty( m, n, numAddends + 1 );
 
     unsigned equationIndex = 0;
     for ( const auto &equation : equations )
@@ -763,23 +994,25 @@ double *Engine::createConstraintMatrix()
         }
 
         for ( const auto &addend : equation._addends )
-            constraintMatrix[equationIndex*n + addend._variable] = addend._coefficient;
+            constraintMatrix.commitChange( equationIndex, addend._variable, addend._coefficient );
 
         ++equationIndex;
     }
-
-    return constraintMatrix;
+    constraintMatrix.executeChanges();
 }
 
-void Engine::removeRedundantEquations( const double *constraintMatrix )
+void Engine::removeRedundantEquations()
 {
     const List<Equation> &equations( _preprocessedQuery.getEquations() );
     unsigned m = equations.size();
     unsigned n = _preprocessedQuery.getNumberOfVariables();
 
     // Step 1: analyze the matrix to identify redundant rows
+    CSRMatrix constraintMatrix;
+    createConstraintMatrix( constraintMatrix );
+
     AutoConstraintMatrixAnalyzer analyzer;
-    analyzer->analyze( constraintMatrix, m, n );
+    analyzer->analyze( &constraintMatrix, m, n );
 
     ENGINE_LOG( Stringf( "Number of redundant rows: %u out of %u",
                   analyzer->getRedundantRows().size(), m ).ascii() );
@@ -794,7 +1027,7 @@ void Engine::removeRedundantEquations( const double *constraintMatrix )
     }
 }
 
-void Engine::selectInitialVariablesForBasis( const double *constraintMatrix, List<unsigned> &initialBasis, List<unsigned> &basicRows )
+void Engine::selectInitialVariablesForBasis( const SparseMatrix *constraintMatrix, List<unsigned> &initialBasis, List<unsigned> &basicRows )
 {
     /*
       This method permutes rows and columns in the constraint matrix (prior
@@ -829,21 +1062,39 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix, Lis
     unsigned *columnOrdering = new unsigned[n];
     unsigned *rowOrdering = new unsigned[m];
 
+    // The inverse orderings: the current position of each row and column
+    unsigned *columnPosition = new unsigned[n];
+    unsigned *rowPosition = new unsigned[m];
+
     for ( unsigned i = 0; i < m; ++i )
+    {
         rowOrdering[i] = i;
+        rowPosition[i] = i;
+    }
 
     for ( unsigned i = 0; i < n; ++i )
+    {
         columnOrdering[i] = i;
+        columnPosition[i] = i;
+    }
+
+    // Initialize the counters, and the columns of each row and the
+    // rows of each column
+    Vector<List<unsigned>> columnsOfRow( m );
+    Vector<List<unsigned>> rowsOfColumn( n );
 
-    // Initialize the counters
+    SparseUnsortedList row( n );
     for ( unsigned i = 0; i < m; ++i )
     {
-        for ( unsigned j = 0; j < n; ++j )
+        constraintMatrix->getRow( i, &row );
+        for ( const auto &entry : row )
         {
-            if ( !FloatUtils::isZero( constraintMatrix[i*n + j] ) )
+            if ( !FloatUtils::isZero( entry._value ) )
             {
+                columnsOfRow[i].append( entry._index );
+                rowsOfColumn[entry._index].append( i );
                 ++nnzInRow[i];
-                ++nnzInColumn[j];
+                ++nnzInColumn[entry._index];
             }
         }
     }
@@ -879,36 +1130,40 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix, Lis
             rowOrdering[singletonRow] = rowOrdering[numTriangularRows];
             rowOrdering[numTriangularRows] = temp;
 
+            rowPosition[rowOrdering[singletonRow]] = singletonRow;
+            rowPosition[rowOrdering[numTriangularRows]] = numTriangularRows;
+
             temp = nnzInRow[numTriangularRows];
             nnzInRow[numTriangularRows] = nnzInRow[singletonRow];
             nnzInRow[singletonRow] = temp;
 
             // Find the non-zero entry in the row and swap it to the diagonal
-            DEBUG( bool foundNonZero = false );
-            for ( unsigned i = numTriangularRows; i < n - numExcluded; ++i )
+            unsigned diagonal = n;
+            for ( const auto &column : columnsOfRow[rowOrdering[numTriangularRows]] )
             {
-                if ( !FloatUtils::isZero( constraintMatrix[rowOrdering[numTriangularRows] * n + columnOrdering[i]] ) )
-                {
-                    temp = columnOrdering[i];
-                    columnOrdering[i] = columnOrdering[numTriangularRows];
-                    columnOrdering[numTriangularRows] = temp;
+                unsigned position = columnPosition[column];
+                if ( position >= numTriangularRows && position < n - numExcluded && position < diagonal )
+                    diagonal = position;
+            }
 
-                    temp = nnzInColumn[numTriangularRows];
-                    nnzInColumn[numTriangularRows] = nnzInColumn[i];
-                    nnzInColumn[i] = temp;
+            ASSERT( diagonal < n );
 
-                    DEBUG( foundNonZero = true );
-                    break;
-                }
-            }
+            temp = columnOrdering[diagonal];
+            columnOrdering[diagonal] = columnOrdering[numTriangularRows];
+            columnOrdering[numTriangularRows] = temp;
+
+            columnPosition[columnOrdering[diagonal]] = diagonal;
+            columnPosition[columnOrdering[numTriangularRows]] = numTriangularRows;
 
-            ASSERT( foundNonZero );
+            temp = nnzInColumn[numTriangularRows];
+            nnzInColumn[numTriangularRows] = nnzInColumn[diagonal];
+            nnzInColumn[diagonal] = temp;
 
             // Remove all entries under the diagonal entry from the row counters
-            for ( unsigned i = numTriangularRows + 1; i < m; ++i )
+            for ( const auto &entryRow : rowsOfColumn[columnOrdering[numTriangularRows]] )
             {
-                if ( !FloatUtils::isZero( constraintMatrix[rowOrdering[i] * n + columnOrdering[numTriangularRows]] ) )
-                    --nnzInRow[i];
+                if ( rowPosition[entryRow] > numTriangularRows )
+                    --nnzInRow[rowPosition[entryRow]];
             }
 
             ++numTriangularRows;
@@ -929,18 +1184,22 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix, Lis
             }
 
             // Update the row counters to account for the excluded column
-            for ( unsigned i = numTriangularRows; i < m; ++i )
+            for ( const auto &entryRow : rowsOfColumn[columnOrdering[column]] )
             {
-                double element = constraintMatrix[rowOrdering[i]*n + columnOrdering[column]];
-                if ( !FloatUtils::isZero( element ) )
+                if ( rowPosition[entryRow] >= numTriangularRows )
                 {
-                    ASSERT( nnzInRow[i] > 1 );
-                    --nnzInRow[i];
+                    ASSERT( nnzInRow[rowPosition[entryRow]] > 1 );
+                    --nnzInRow[rowPosition[entryRow]];
                 }
             }
 
+            // Excluded columns are given an out-of-range position
+            columnPosition[columnOrdering[column]] = n;
+
             columnOrdering[column] = columnOrdering[n - 1 - numExcluded];
             nnzInColumn[column] = nnzInColumn[n - 1 - numExcluded];
+            if ( column != n - 1 - numExcluded )
+                columnPosition[columnOrdering[column]] = column;
             ++numExcluded;
         }
     }
@@ -963,6 +1222,8 @@ void Engine::selectInitialVariablesForBasis( const double *constraintMatrix, Lis
     delete[] nnzInColumn;
     delete[] columnOrdering;
     delete[] rowOrdering;
+    delete[] columnPosition;
+    delete[] rowPosition;
 }
 
 void Engine::addAuxiliaryVariables()
@@ -1002,7 +1263,7 @@ void Engine::augmentInitialBasisIfNeeded( List<unsigned> &initialBasis, const Li
     }
 }
 
-void Engine::initializeTableau( const double *constraintMatrix, const List<unsigned> &initialBasis )
+void Engine::initializeTableau( const SparseMatrix *constraintMatrix, const List<unsigned> &initialBasis )
 {
     const List<Equation> &equations( _preprocessedQuery.getEquations() );
     unsigned m = equations.size();
@@ -1028,10 +1289,10 @@ void Engine::initializeTableau( const double *constraintMatrix, const List<unsig
         _tableau->setUpperBound( i, _preprocessedQuery.getUpperBound( i ) );
     }
 
-    _tableau->registerToWatchAllVariables( _rowBoundTightener );
+    _tableau->registerBatchedWatcher( _rowBoundTightener );
     _tableau->registerResizeWatcher( _rowBoundTightener );
 
-    _tableau->registerToWatchAllVariables( _constraintBoundTightener );
+    _tableau->registerBatchedWatcher( _constraintBoundTightener );
     _tableau->registerResizeWatcher( _constraintBoundTightener );
 
     _rowBoundTightener->setDimensions();
@@ -1055,6 +1316,9 @@ void Engine::initializeTableau( const double *constraintMatrix, const List<unsig
     _activeEntryStrategy->initialize( _tableau );
 
     _statistics.setNumPlConstraints( _plConstraints.size() );
+
+    if ( GlobalConfiguration::SPLITTING_HEURISTICS == DivideStrategy::Activity )
+        _activityHeap.initialize( _plConstraints );
 }
 
 void Engine::initializeNetworkLevelReasoning()
@@ -1078,33 +1342,28 @@ bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
         if ( _verbosity > 0 )
             printInputBounds( inputQuery );
 
-        double *constraintMatrix = createConstraintMatrix();
-        removeRedundantEquations( constraintMatrix );
+        removeRedundantEquations();
 
-        // The equations have changed, recreate the constraint matrix
-        delete[] constraintMatrix;
-        constraintMatrix = createConstraintMatrix();
+        CSRMatrix constraintMatrix;
+        createConstraintMatrix( constraintMatrix );
 
         List<unsigned> initialBasis;
         List<unsigned> basicRows;
-        selectInitialVariablesForBasis( constraintMatrix, initialBasis, basicRows );
+        selectInitialVariablesForBasis( &constraintMatrix, initialBasis, basicRows );
         addAuxiliaryVariables();
         augmentInitialBasisIfNeeded( initialBasis, basicRows );
 
         storeEquationsInDegradationChecker();
 
         // The equations have changed, recreate the constraint matrix
-        delete[] constraintMatrix;
-        constraintMatrix = createConstraintMatrix();
+        createConstraintMatrix( constraintMatrix );
 
         initializeNetworkLevelReasoning();
-        initializeTableau( constraintMatrix, initialBasis );
+        initializeTableau( &constraintMatrix, initialBasis );
 
         if ( GlobalConfiguration::WARM_START )
             warmStart();
 
-        delete[] constraintMatrix;
-
 //        performMILPSolverBoundedTightening();
 
         struct timespec end = TimeUtils::sampleMicro();
@@ -1129,7 +1388,9 @@ bool Engine::processInputQuery( InputQuery &inputQuery, bool preprocess )
 
 void Engine::performMILPSolverBoundedTightening()
 {
-    if ( _networkLevelReasoner && Options::get()->gurobiEnabled() )
+    if ( _networkLevelReasoner &&
+         ( Options::get()->gurobiEnabled() ||
+           Options::get()->getBool( Options::NATIVE_LP_BOUND_TIGHTENING ) ) )
     {
         _networkLevelReasoner->obtainCurrentBounds();
 
@@ -1237,15 +1498,12 @@ void Engine::reportPlViolation()
     _smtCore.reportViolatedConstraint( _plConstraintToFix );
 }
 
-void Engine::storeState( EngineState &state, bool storeAlsoTableauState ) const
+void Engine::storeState( EngineState &state, TableauStateStorageLevel level ) const
 {
-    if ( storeAlsoTableauState )
-    {
-        _tableau->storeState( state._tableauState );
-        state._tableauStateIsStored = true;
-    }
-    else
-        state._tableauStateIsStored = false;
+    if ( level != TableauStateStorageLevel::STORE_NONE )
+        _tableau->storeState( state._tableauState, level );
+
+    state._tableauStateStorageLevel = level;
 
     for ( const auto &constraint : _plConstraints )
         state._plConstraintToState[constraint] = constraint->duplicateConstraint();
@@ -1257,7 +1515,7 @@ void Engine::restoreState( const EngineState &state )
 {
     ENGINE_LOG( "Restore state starting" );
 
-    if ( !state._tableauStateIsStored )
+    if ( state._tableauStateStorageLevel == TableauStateStorageLevel::STORE_NONE )
         throw MarabouError( MarabouError::RESTORING_ENGINE_FROM_INVALID_STATE );
 
     ENGINE_LOG( "\tRestoring tableau state" );
@@ -1270,6 +1528,11 @@ void Engine::restoreState( const EngineState &state )
             throw MarabouError( MarabouError::MISSING_PL_CONSTRAINT_STATE );
 
         constraint->restoreState( state._plConstraintToState[constraint] );
+
+        // The tableau keeps its current assignment when restored from
+        // the bound trail, so the stored one may be stale
+        for ( const auto &variable : constraint->getParticipatingVariables() )
+            constraint->notifyVariableValue( variable, _tableau->getValue( variable ) );
     }
 
     _numPlConstraintsDisabledByValidSplits = state._numPlConstraintsDisabledByValidSplits;
@@ -1280,11 +1543,30 @@ void Engine::restoreState( const EngineState &state )
     adjustWorkMemorySize();
     _activeEntryStrategy->resizeHook( _tableau );
     _costFunctionManager->initialize();
+    startDualSimplex();
+
+    // Constraints may have been re-activated by the restoration
+    if ( GlobalConfiguration::SPLITTING_HEURISTICS == DivideStrategy::Activity )
+        _activityHeap.reinsertRemovedConstraints();
 
     // Reset the violation counts in the SMT core
     _smtCore.resetReportedViolations();
 }
 
+void Engine::refreshBoundTrailState( EngineState &state ) const
+{
+    ASSERT( state._tableauStateStorageLevel == TableauStateStorageLevel::STORE_BOUND_TRAIL );
+
+    ASSERT( state._tableauState._m == _tableau->getM() );
+
+    _tableau->storeState( state._tableauState, TableauStateStorageLevel::STORE_BOUND_TRAIL );
+}
+
+void Engine::setBoundTrailRecording( bool record )
+{
+    _tableau->setBoundTrailRecording( record );
+}
+
 void Engine::setNumPlConstraintsDisabledByValidSplits( unsigned numConstraints )
 {
     _numPlConstraintsDisabledByValidSplits = numConstraints;
@@ -1502,38 +1784,57 @@ void Engine::applySplit( const PiecewiseLinearCaseSplit &split )
         }
     }
 
+    startDualSimplex();
+
     DEBUG( _tableau->verifyInvariants() );
     ENGINE_LOG( "Done with split\n" );
 }
 
-void Engine::applyAllRowTightenings()
+bool Engine::applyAllRowTightenings()
 {
     List<Tightening> rowTightenings;
+    _tableau->flushBoundChanges();
     _rowBoundTightener->getRowTightenings( rowTightenings );
 
+    bool tightened = false;
     for ( const auto &tightening : rowTightenings )
-    {
-        if ( tightening._type == Tightening::LB )
-            _tableau->tightenLowerBound( tightening._variable, tightening._value );
-        else
-            _tableau->tightenUpperBound( tightening._variable, tightening._value );
-    }
+        tightened = applyTightening( tightening ) || tightened;
+
+    return tightened;
 }
 
-void Engine::applyAllConstraintTightenings()
+bool Engine::applyAllConstraintTightenings()
 {
     List<Tightening> entailedTightenings;
 
+    _tableau->flushBoundChanges();
     _constraintBoundTightener->getConstraintTightenings( entailedTightenings );
 
+    bool tightened = false;
     for ( const auto &tightening : entailedTightenings )
     {
         _statistics.incNumBoundsProposedByPlConstraints();
+        tightened = applyTightening( tightening ) || tightened;
+    }
 
-        if ( tightening._type == Tightening::LB )
-            _tableau->tightenLowerBound( tightening._variable, tightening._value );
-        else
-            _tableau->tightenUpperBound( tightening._variable, tightening._value );
+    return tightened;
+}
+
+bool Engine::applyTightening( const Tightening &tightening )
+{
+    unsigned variable = tightening._variable;
+
+    if ( tightening._type == Tightening::LB )
+    {
+        double previousBound = _tableau->getLowerBound( variable );
+        _tableau->tightenLowerBound( variable, tightening._value );
+        return _tableau->getLowerBound( variable ) != previousBound;
+    }
+    else
+    {
+        double previousBound = _tableau->getUpperBound( variable );
+        _tableau->tightenUpperBound( variable, tightening._value );
+        return _tableau->getUpperBound( variable ) != previousBound;
     }
 }
 
@@ -1541,8 +1842,11 @@ void Engine::applyAllBoundTightenings()
 {
     struct timespec start = TimeUtils::sampleMicro();
 
-    applyAllRowTightenings();
-    applyAllConstraintTightenings();
+    bool tightened = applyAllRowTightenings();
+    tightened = applyAllConstraintTightenings() || tightened;
+
+    if ( tightened )
+        startDualSimplex();
 
     struct timespec end = TimeUtils::sampleMicro();
     _statistics.addTimeForApplyingStoredTightenings( TimeUtils::timePassed( start, end ) );
@@ -1557,6 +1861,9 @@ bool Engine::applyAllValidConstraintCaseSplits()
         if ( applyValidConstraintCaseSplit( constraint ) )
             appliedSplit = true;
 
+    if ( applyLearnedClauseCaseSplits() )
+        appliedSplit = true;
+
     struct timespec end = TimeUtils::sampleMicro();
     _statistics.addTimeForValidCaseSplit( TimeUtils::timePassed( start, end ) );
 
@@ -1584,6 +1891,29 @@ bool Engine::applyValidConstraintCaseSplit( PiecewiseLinearConstraint *constrain
     return false;
 }
 
+bool Engine::applyLearnedClauseCaseSplits()
+{
+    List<Pair<PiecewiseLinearConstraint *, PiecewiseLinearCaseSplit>> impliedSplits;
+    _smtCore.getImpliedSplitsFromLearnedClauses( impliedSplits );
+
+    for ( auto &impliedSplit : impliedSplits )
+    {
+        PiecewiseLinearConstraint *constraint = impliedSplit.first();
+        if ( !constraint->isActive() )
+            continue;
+
+        ENGINE_LOG( "A learned clause implies a case split" );
+
+        constraint->setActiveConstraint( false );
+        _smtCore.recordImpliedValidSplit( impliedSplit.second() );
+        applySplit( impliedSplit.second() );
+        ++_numPlConstraintsDisabledByValidSplits;
+        _statistics.incNumLearnedClauseImpliedSplits();
+    }
+
+    return !impliedSplits.empty();
+}
+
 bool Engine::shouldCheckDegradation()
 {
     return _statistics.getNumMainLoopIterations() %
@@ -1617,6 +1947,7 @@ void Engine::tightenBoundsOnConstraintMatrix()
     if ( _statistics.getNumMainLoopIterations() %
          GlobalConfiguration::BOUND_TIGHTING_ON_CONSTRAINT_MATRIX_FREQUENCY == 0 )
     {
+        _tableau->flushBoundChanges();
         _rowBoundTightener->examineConstraintMatrix( true );
         _statistics.incNumBoundTighteningOnConstraintMatrix();
     }
@@ -1632,6 +1963,7 @@ void Engine::explicitBasisBoundTightening()
     bool saturation = GlobalConfiguration::EXPLICIT_BOUND_TIGHTENING_UNTIL_SATURATION;
 
     _statistics.incNumBoundTighteningsOnExplicitBasis();
+    _tableau->flushBoundChanges();
 
     switch ( GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_TYPE )
     {
@@ -1778,6 +2110,22 @@ List<unsigned> Engine::getInputVariables() const
     return _preprocessedQuery.getInputVariables();
 }
 
+void Engine::setWorkStealingQueue( WorkStealingQueue *workStealingQueue, unsigned workerId )
+{
+    _workStealingQueue = workStealingQueue;
+    _workerId = workerId;
+}
+
+void Engine::shareSubtreeIfNeeded()
+{
+    if ( !_workStealingQueue || !_workStealingQueue->workersAreStarving() )
+        return;
+
+    PiecewiseLinearCaseSplit subtree;
+    if ( _smtCore.splitOffSubtree( subtree ) )
+        _workStealingQueue->shareSubtree( _workerId, subtree );
+}
+
 void Engine::performSymbolicOrArithmeticBoundTightening()
 {
     if ( ( !GlobalConfiguration::USE_SYMBOLIC_BOUND_TIGHTENING  &&
@@ -1847,6 +2195,32 @@ void Engine::reset()
     resetExitCode();
 }
 
+void Engine::backtrackToRoot()
+{
+    _smtCore.backtrackToRoot();
+}
+
+void Engine::splitOffRemainingSubtrees( List<PiecewiseLinearCaseSplit> &subtrees )
+{
+    PiecewiseLinearCaseSplit subtree;
+    while ( _smtCore.splitOffSubtree( subtree ) )
+    {
+        subtrees.append( subtree );
+        subtree = PiecewiseLinearCaseSplit();
+    }
+
+    List<PiecewiseLinearCaseSplit> currentPath;
+    _smtCore.allSplitsSoFar( currentPath );
+    for ( const auto &split : currentPath )
+    {
+        for ( const auto &bound : split.getBoundTightenings() )
+            subtree.storeBoundTightening( bound );
+        for ( const auto &equation : split.getEquations() )
+            subtree.addEquation( equation );
+    }
+    subtrees.append( subtree );
+}
+
 void Engine::resetStatistics()
 {
     Statistics statistics;
@@ -1871,6 +2245,7 @@ void Engine::resetSmtCore()
 {
     _smtCore.freeMemory();
     _smtCore = SmtCore( this );
+    _tableau->setBoundTrailRecording( false );
 }
 
 void Engine::resetExitCode()
@@ -2019,6 +2394,16 @@ void Engine::updateScores()
 
 PiecewiseLinearConstraint *Engine::pickSplitPLConstraint()
 {
+    if ( GlobalConfiguration::SPLITTING_HEURISTICS == DivideStrategy::Activity )
+    {
+        // Until the first conflict all activities are zero, and the
+        // violation counts are a better guide
+        PiecewiseLinearConstraint *constraint = _activityHeap.getMostActiveConstraint();
+        if ( constraint && FloatUtils::isPositive( _activityHeap.getActivity( constraint ) ) )
+            return constraint;
+        return NULL;
+    }
+
     _candidatePlConstraints.clear();
     ENGINE_LOG( Stringf( "Picking a split PLConstraint..." ).ascii() );
     updateScores();
@@ -22,9 +22,11 @@
 #include "AutoRowBoundTightener.h"
 #include "AutoTableau.h"
 #include "BlandsRule.h"
+#include "ConstraintActivityHeap.h"
 #include "DantzigsRule.h"
 #include "DegradationChecker.h"
 #include "DivideStrategy.h"
+#include "DualSteepestEdge.h"
 #include "IEngine.h"
 #include "InputQuery.h"
 #include "Map.h"
@@ -42,10 +44,13 @@
 
 #define ENGINE_LOG(x, ...) LOG(GlobalConfiguration::ENGINE_LOGGING, "Engine: %s\n", x)
 
+class CSRMatrix;
 class EngineState;
 class InputQuery;
 class PiecewiseLinearConstraint;
+class SparseMatrix;
 class String;
+class WorkStealingQueue;
 
 class Engine : public IEngine, public SignalHandler::Signalable
 {
@@ -76,8 +81,10 @@ public:
     /*
       Methods for storing and restoring the state of the engine.
     */
-    void storeState( EngineState &state, bool storeAlsoTableauState ) const;
+    void storeState( EngineState &state, TableauStateStorageLevel level ) const;
     void restoreState( const EngineState &state );
+    void refreshBoundTrailState( EngineState &state ) const;
+    void setBoundTrailRecording( bool record );
     void setNumPlConstraintsDisabledByValidSplits( unsigned numConstraints );
 
     /*
@@ -104,6 +111,13 @@ public:
     */
     List<unsigned> getInputVariables() const;
 
+    /*
+      In DnC mode, the queue through which this engine's worker obtains
+      subqueries. When other workers run out of work, unexplored
+      subtrees of the search are shared through it.
+    */
+    void setWorkStealingQueue( WorkStealingQueue *workStealingQueue, unsigned workerId );
+
     /*
       Add equations and tightenings from a split.
     */
@@ -115,6 +129,19 @@ public:
     */
     void reset();
 
+    /*
+      Undo all SMT-originating case splits, returning the engine to the
+      root of the previous search. Bound tightenings derived at the
+      root, and the basis found there, are kept.
+    */
+    void backtrackToRoot();
+
+    /*
+      Split off all unexplored subtrees of the SMT stack, the last one
+      being the subtree below the current search path.
+    */
+    void splitOffRemainingSubtrees( List<PiecewiseLinearCaseSplit> &subtrees );
+
     /*
       Reset the statistics object
     */
@@ -194,6 +221,12 @@ private:
     */
     Set<PiecewiseLinearConstraint *> _candidatePlConstraints;
 
+    /*
+      The activities of the PL constraints, used by the Activity
+      splitting heuristics
+    */
+    ConstraintActivityHeap _activityHeap;
+
     /*
       Piecewise linear constraints that are currently violated.
     */
@@ -217,6 +250,17 @@ private:
     AutoProjectedSteepestEdgeRule _projectedSteepestEdgeRule;
     EntrySelectionStrategy *_activeEntryStrategy;
 
+    /*
+      The candidates for entering the basis in the current simplex
+      step. Kept as a member so that its memory is reused across steps.
+    */
+    Vector<unsigned> _enteringVariableCandidates;
+
+    /*
+      Leaving variable selection strategy for the dual simplex.
+    */
+    DualSteepestEdgeRule _dualSteepestEdgeRule;
+
     /*
       Bound tightener.
     */
@@ -278,6 +322,13 @@ private:
     */
     std::atomic_bool _quitRequested;
 
+    /*
+      The DnC work-stealing queue (if any), and the id of this engine's
+      worker.
+    */
+    WorkStealingQueue *_workStealingQueue;
+    unsigned _workerId;
+
     /*
       A code indicating how the run terminated.
     */
@@ -321,12 +372,71 @@ private:
     unsigned _lastNumVisitedStates;
     unsigned long long _lastIterationWithProgress;
 
+    /*
+      After bound-only changes (splits, bound tightenings, restorations)
+      the current basis remains dual feasible, and simplex steps are
+      performed by the dual simplex until all variables are within
+      bounds. _numDualSimplexSteps counts the consecutive dual steps,
+      so that the primal simplex can take over if the dual stalls.
+    */
+    bool _dualSimplexActive;
+    unsigned _numDualSimplexSteps;
+
+    /*
+      When the simplex proves the current subproblem infeasible, the
+      bounds that the proof relies on are stored here, so that the SMT
+      core can analyze the conflict. Infeasibilities detected elsewhere
+      are left unexplained, and lead to a plain pop.
+    */
+    List<Tightening> _infeasibilityExplanation;
+    bool _infeasibilityExplained;
+
+    /*
+      Whether infeasibilities should be explained: needed by conflict
+      analysis and by the Activity splitting heuristics.
+    */
+    bool needToExplainInfeasibility() const;
+
     /*
       Perform a simplex step: compute the cost function, pick the
       entering and leaving variables and perform a pivot.
     */
     void performSimplexStep();
 
+    /*
+      Perform a dual simplex step: pick an out-of-bounds basic
+      variable as the leaving variable, pick the entering variable
+      using the dual ratio test and perform a pivot.
+    */
+    void performDualSimplexStep();
+
+    /*
+      Switch to the dual simplex, following a bound-only change.
+    */
+    void startDualSimplex();
+
+    /*
+      Store the bounds that explain why the simplex cannot make
+      progress: the bounds violated by the out-of-bounds basic variables,
+      and the bounds that block the non-basic variables that the cost
+      function would have changed.
+    */
+    void explainSimplexInfeasibility();
+
+    /*
+      Store the bounds of a variable whose lower bound exceeds its upper
+      bound, if there is one.
+    */
+    void explainInvalidBounds();
+
+    /*
+      Handle an infeasible subproblem: bump the activities of the
+      constraints involved and backjump if the infeasibility was
+      explained, or pop otherwise. Return false if the whole query is
+      infeasible.
+    */
+    bool backtrackFromConflict();
+
     /*
       Perform a constraint-fixing step: select a violated piece-wise
       linear constraint and attempt to fix it.
@@ -371,13 +481,22 @@ private:
 
     /*
       Apply any bound tightenings found by the row tightener.
+      Return true if any bound of the tableau changed.
     */
-    void applyAllRowTightenings();
+    bool applyAllRowTightenings();
 
     /*
       Apply any bound tightenings entailed by the constraints.
+      Return true if any bound of the tableau changed.
+    */
+    bool applyAllConstraintTightenings();
+
+    /*
+      Apply a single tightening to the tableau. Return true if it
+      changed the bound, i.e. if it was tighter than the current bound
+      by more than the comparison tolerance.
     */
-    void applyAllConstraintTightenings();
+    bool applyTightening( const Tightening &tightening );
 
     /*
       Apply all valid case splits proposed by the constraints.
@@ -386,6 +505,12 @@ private:
     bool applyAllValidConstraintCaseSplits();
     bool applyValidConstraintCaseSplit( PiecewiseLinearConstraint *constraint );
 
+    /*
+      Apply the case splits that the clauses learned by the SMT core
+      imply. Return true if such a case split has been applied.
+    */
+    bool applyLearnedClauseCaseSplits();
+
     /*
       Update statitstics, print them if needed.
     */
@@ -436,6 +561,12 @@ private:
     */
     void performSymbolicOrArithmeticBoundTightening();
 
+    /*
+      If other DnC workers are starving, split off the largest
+      unexplored subtree of the SMT stack and share it with them.
+    */
+    void shareSubtreeIfNeeded();
+
     /*
       Check whether a timeout value has been provided and exceeded.
     */
@@ -461,11 +592,11 @@ private:
     void invokePreprocessor( const InputQuery &inputQuery, bool preprocess );
     void printInputBounds( const InputQuery &inputQuery ) const;
     void storeEquationsInDegradationChecker();
-    void removeRedundantEquations( const double *constraintMatrix );
-    void selectInitialVariablesForBasis( const double *constraintMatrix, List<unsigned> &initialBasis, List<unsigned> &basicRows );
-    void initializeTableau( const double *constraintMatrix, const List<unsigned> &initialBasis );
+    void removeRedundantEquations();
+    void selectInitialVariablesForBasis( const SparseMatrix *constraintMatrix, List<unsigned> &initialBasis, List<unsigned> &basicRows );
+    void initializeTableau( const SparseMatrix *constraintMatrix, const List<unsigned> &initialBasis );
     void initializeNetworkLevelReasoning();
-    double *createConstraintMatrix();
+    void createConstraintMatrix( CSRMatrix &constraintMatrix );
     void addAuxiliaryVariables();
     void augmentInitialBasisIfNeeded( List<unsigned> &initialBasis, const List<unsigned> &basicRows );
     void performMILPSolverBoundedTightening();
@@ -16,6 +16,7 @@
 #include "EngineState.h"
 
 EngineState::EngineState()
+    : _tableauStateStorageLevel( TableauStateStorageLevel::STORE_NONE )
 {
 }
 
@@ -30,7 +30,7 @@ public:
     /*
       The state of the tableau
     */
-    bool _tableauStateIsStored;
+    TableauStateStorageLevel _tableauStateStorageLevel;
     TableauState _tableauState;
 
     /*
@@ -16,8 +16,8 @@
 #ifndef __EntrySelectionStrategy_h__
 #define __EntrySelectionStrategy_h__
 
-#include "List.h"
 #include "Set.h"
+#include "Vector.h"
 
 class ITableau;
 class Statistics;
@@ -39,7 +39,7 @@ public:
       a variable from the excluded set.
     */
     virtual bool select( ITableau &tableau,
-                         const List<unsigned> &candidates,
+                         const Vector<unsigned> &candidates,
                          const Set<unsigned> &excluded ) = 0;
 
     /*
@@ -17,6 +17,7 @@
 #define __IEngine_h__
 
 #include "List.h"
+#include "TableauStateStorageLevel.h"
 
 #ifdef _WIN32
 #undef ERROR
@@ -49,8 +50,22 @@ public:
     /*
       Methods for storing and restoring the state of the engine.
     */
-    virtual void storeState( EngineState &state, bool storeAlsoTableauState ) const = 0;
+    virtual void storeState( EngineState &state, TableauStateStorageLevel level ) const = 0;
     virtual void restoreState( const EngineState &state ) = 0;
+
+    /*
+      Re-anchor a state stored as a bound trail mark at the current
+      position of the tableau's trail. This is needed after the tableau
+      has been rebuilt, e.g. during precision restoration.
+    */
+    virtual void refreshBoundTrailState( EngineState &state ) const = 0;
+
+    /*
+      Turn the recording of bound changes in the tableau's trail on or
+      off. The SMT core keeps it on only while its stack holds states
+      stored as trail marks.
+    */
+    virtual void setBoundTrailRecording( bool record ) = 0;
     virtual void setNumPlConstraintsDisabledByValidSplits( unsigned numConstraints ) = 0;
 
     /*
@@ -65,11 +80,19 @@ public:
 
     /*
       Methods for DnC: reset the engine state for re-use,
-      get input variables.
+      return to the root of the previous search, get input variables.
     */
     virtual void reset() = 0;
+    virtual void backtrackToRoot() = 0;
     virtual List<unsigned> getInputVariables() const = 0;
 
+    /*
+      For DnC: remove all unexplored subtrees from the search, including
+      the one below the current search path, and store the splits that
+      lead to each of them.
+    */
+    virtual void splitOffRemainingSubtrees( List<PiecewiseLinearCaseSplit> &subtrees ) = 0;
+
     virtual void updateScores() = 0;
 
     /*
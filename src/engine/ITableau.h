@@ -18,6 +18,8 @@
 
 #include "List.h"
 #include "Set.h"
+#include "TableauStateStorageLevel.h"
+#include "Vector.h"
 
 class EntrySelectionStrategy;
 class Equation;
@@ -29,6 +31,7 @@ class SparseVector;
 class Statistics;
 class TableauRow;
 class TableauState;
+class Tightening;
 
 class ITableau
 {
@@ -71,6 +74,15 @@ public:
         */
         virtual void notifyLowerBound( unsigned /* variable */, double /* bound */ ) {}
         virtual void notifyUpperBound( unsigned /* variable */, double /* bound */ ) {}
+
+        /*
+          Batched watchers receive none of the above. Instead, this
+          callback is invoked when the tableau flushes its pending
+          bound changes, with the variables whose bounds have changed
+          since the previous flush. The new bounds are read from the
+          tableau.
+        */
+        virtual void notifyBoundChanges( const unsigned */* variables */, unsigned /* count */ ) {}
     };
 
     class ResizeWatcher
@@ -84,6 +96,8 @@ public:
     };
 
     virtual void registerToWatchAllVariables( VariableWatcher *watcher ) = 0;
+    virtual void registerBatchedWatcher( VariableWatcher *watcher ) = 0;
+    virtual void flushBoundChanges() = 0;
     virtual void registerToWatchVariable( VariableWatcher *watcher, unsigned variable ) = 0;
     virtual void unregisterToWatchVariable( VariableWatcher *watcher, unsigned variable ) = 0;
 
@@ -95,6 +109,7 @@ public:
 
     virtual void setDimensions( unsigned m, unsigned n ) = 0;
     virtual void setConstraintMatrix( const double *A ) = 0;
+    virtual void setConstraintMatrix( const SparseMatrix *A ) = 0;
     virtual void setRightHandSide( const double *b ) = 0;
     virtual void setRightHandSide( unsigned index, double value ) = 0;
     virtual void markAsBasic( unsigned variable ) = 0;
@@ -122,6 +137,7 @@ public:
     virtual unsigned getEnteringVariableIndex() const = 0;
     virtual void pickLeavingVariable() = 0;
     virtual void pickLeavingVariable( double *d ) = 0;
+    virtual bool pickEnteringVariableByDualRatioTest() = 0;
     virtual unsigned getLeavingVariable() const = 0;
     virtual unsigned getLeavingVariableIndex() const = 0;
     virtual double getChangeRatio() const = 0;
@@ -132,7 +148,7 @@ public:
     virtual bool isBasic( unsigned variable ) const = 0;
     virtual void setNonBasicAssignment( unsigned variable, double value, bool updateBasics ) = 0;
     virtual void computeCostFunction() = 0;
-    virtual void getEntryCandidates( List<unsigned> &candidates ) const = 0;
+    virtual void getEntryCandidates( Vector<unsigned> &candidates ) const = 0;
     virtual const double *getCostFunction() const = 0;
     virtual void computeChangeColumn() = 0;
     virtual const double *getChangeColumn() const = 0;
@@ -159,11 +175,14 @@ public:
     virtual const SparseUnsortedList *getSparseARow( unsigned row ) const = 0;
     virtual const SparseMatrix *getSparseA() const = 0;
     virtual void performDegeneratePivot() = 0;
-    virtual void storeState( TableauState &state ) const = 0;
+    virtual void storeState( TableauState &state, TableauStateStorageLevel level ) const = 0;
     virtual void restoreState( const TableauState &state ) = 0;
+    virtual void getBoundTrailPositions( const List<Tightening> &bounds, Vector<unsigned> &positions ) const = 0;
+    virtual void setBoundTrailRecording( bool record ) = 0;
     virtual void setStatistics( Statistics *statistics ) = 0;
     virtual const double *getRightHandSide() const = 0;
     virtual void forwardTransformation( const double *y, double *x ) const = 0;
+    virtual void forwardTransformation( const double *y, double *x, unsigned numVectors ) const = 0;
     virtual void backwardTransformation( const double *y, double *x ) const = 0;
     virtual double getSumOfInfeasibilities() const = 0;
     virtual BasicAssignmentStatus getBasicAssignmentStatus() const = 0;
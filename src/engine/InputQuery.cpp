@@ -14,12 +14,17 @@
  **/
 
 #include "AutoFile.h"
+#include "BinaryQueryFormat.h"
+#include "ConstSimpleData.h"
 #include "Debug.h"
 #include "FloatUtils.h"
 #include "InputQuery.h"
 #include "MStringf.h"
 #include "MarabouError.h"
 #include "SigmoidConstraint.h"
+#include "Vector.h"
+
+#include <cstring>
 
 #define INPUT_QUERY_LOG( x, ... ) LOG( GlobalConfiguration::INPUT_QUERY_LOGGING, "Preprocessor: %s\n", x )
 
@@ -359,6 +364,114 @@ void InputQuery::saveQuery( const String &fileName )
     queryFile->close();
 }
 
+static void writeBinaryArray( IFile &file, const void *data, unsigned size )
+{
+    static const char padding[BinaryQueryFormat::ALIGNMENT] = { 0 };
+
+    file.write( ConstSimpleData( data, size ) );
+    file.write( ConstSimpleData( padding, BinaryQueryFormat::paddedSize( size ) - size ) );
+}
+
+void InputQuery::saveBinary( const String &fileName )
+{
+    Vector<unsigned> inputVariables;
+    for ( const auto &inVar : getInputVariables() )
+        inputVariables.append( inVar );
+
+    Vector<unsigned> outputVariables;
+    for ( const auto &outVar : getOutputVariables() )
+        outputVariables.append( outVar );
+
+    Vector<unsigned> lowerBoundVariables;
+    Vector<double> lowerBoundValues;
+    for ( const auto &lb : _lowerBounds )
+    {
+        lowerBoundVariables.append( lb.first );
+        lowerBoundValues.append( lb.second );
+    }
+
+    Vector<unsigned> upperBoundVariables;
+    Vector<double> upperBoundValues;
+    for ( const auto &ub : _upperBounds )
+    {
+        upperBoundVariables.append( ub.first );
+        upperBoundValues.append( ub.second );
+    }
+
+    // Equations, with their addends in compressed sparse row form
+    Vector<unsigned> equationTypes;
+    Vector<double> equationScalars;
+    Vector<unsigned> equationFirstAddend;
+    Vector<unsigned> addendVariables;
+    Vector<double> addendCoefficients;
+    equationFirstAddend.append( 0 );
+    for ( const auto &e : _equations )
+    {
+        equationTypes.append( e._type );
+        equationScalars.append( e._scalar );
+        for ( const auto &a : e._addends )
+        {
+            addendVariables.append( a._variable );
+            addendCoefficients.append( a._coefficient );
+        }
+        equationFirstAddend.append( addendVariables.size() );
+    }
+
+    // Constraints, with their participating variables in the same form
+    Vector<unsigned> constraintTypes;
+    Vector<unsigned> constraintFirstVariable;
+    Vector<unsigned> constraintVariables;
+    constraintFirstVariable.append( 0 );
+    for ( const auto &constraint : _plConstraints )
+    {
+        PiecewiseLinearFunctionType type = constraint->getType();
+        if ( type != RELU && type != MAX && type != SIGMOID )
+            throw MarabouError( MarabouError::UNSUPPORTED_PIECEWISE_CONSTRAINT,
+                                Stringf( "Unsupported piecewise constraint: %s\n",
+                                         constraint->serializeToString().ascii() ).ascii() );
+
+        constraintTypes.append( type );
+        for ( const auto &variable : constraint->getParticipatingVariables() )
+            constraintVariables.append( variable );
+        constraintFirstVariable.append( constraintVariables.size() );
+    }
+
+    BinaryQueryFormat::Header header;
+    memset( &header, 0, sizeof(header) );
+    memcpy( header._magic, BinaryQueryFormat::MAGIC, BinaryQueryFormat::MAGIC_SIZE );
+    header._version = BinaryQueryFormat::VERSION;
+    header._numberOfVariables = _numberOfVariables;
+    header._numberOfInputVariables = inputVariables.size();
+    header._numberOfOutputVariables = outputVariables.size();
+    header._numberOfLowerBounds = lowerBoundVariables.size();
+    header._numberOfUpperBounds = upperBoundVariables.size();
+    header._numberOfEquations = equationTypes.size();
+    header._numberOfAddends = addendVariables.size();
+    header._numberOfConstraints = constraintTypes.size();
+    header._numberOfConstraintVariables = constraintVariables.size();
+
+    AutoFile queryFile( fileName );
+    queryFile->open( IFile::MODE_WRITE_TRUNCATE );
+
+    writeBinaryArray( queryFile, &header, sizeof(header) );
+    writeBinaryArray( queryFile, inputVariables.data(), inputVariables.size() * sizeof(unsigned) );
+    writeBinaryArray( queryFile, outputVariables.data(), outputVariables.size() * sizeof(unsigned) );
+    writeBinaryArray( queryFile, lowerBoundVariables.data(), lowerBoundVariables.size() * sizeof(unsigned) );
+    writeBinaryArray( queryFile, lowerBoundValues.data(), lowerBoundValues.size() * sizeof(double) );
+    writeBinaryArray( queryFile, upperBoundVariables.data(), upperBoundVariables.size() * sizeof(unsigned) );
+    writeBinaryArray( queryFile, upperBoundValues.data(), upperBoundValues.size() * sizeof(double) );
+    writeBinaryArray( queryFile, equationTypes.data(), equationTypes.size() * sizeof(unsigned) );
+    writeBinaryArray( queryFile, equationScalars.data(), equationScalars.size() * sizeof(double) );
+    writeBinaryArray( queryFile, equationFirstAddend.data(), equationFirstAddend.size() * sizeof(unsigned) );
+    writeBinaryArray( queryFile, addendVariables.data(), addendVariables.size() * sizeof(unsigned) );
+    writeBinaryArray( queryFile, addendCoefficients.data(), addendCoefficients.size() * sizeof(double) );
+    writeBinaryArray( queryFile, constraintTypes.data(), constraintTypes.size() * sizeof(unsigned) );
+    writeBinaryArray( queryFile, constraintFirstVariable.data(), constraintFirstVariable.size() * sizeof(unsigned) );
+    writeBinaryArray( queryFile, constraintVariables.data(), constraintVariables.size() * sizeof(unsigned) );
+
+    queryFile->close();
+}
+
 void InputQuery::markInputVariable( unsigned variable, unsigned inputIndex )
 {
     _variableToInputIndex[variable] = inputIndex;
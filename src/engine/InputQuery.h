@@ -107,6 +107,13 @@ public:
     */
     void saveQuery( const String &fileName );
 
+    /*
+      Serializes the query to a file in the binary format described in
+      BinaryQueryFormat.h, which can then be loaded using
+      QueryLoader::loadBinary.
+    */
+    void saveBinary( const String &fileName );
+
     /*
       Print input and output bounds
     */
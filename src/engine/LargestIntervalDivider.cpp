@@ -90,6 +90,17 @@ void LargestIntervalDivider::createSubQueries( unsigned numNewSubqueries,
                                                      Tightening::UB ) );
         }
 
+        // Keep the rest of the previous split, so that the new subqueries
+        // do not cover more than the previous region. This matters for
+        // subtrees shared by a worker, whose other parts are solved elsewhere
+        for ( const auto &bound : bounds )
+        {
+            if ( !_inputVariables.exists( bound._variable ) )
+                split->storeBoundTightening( bound );
+        }
+        for ( const auto &equation : previousSplit.getEquations() )
+            split->addEquation( equation );
+
         // Construct the new subquery and add it to subqueries
         SubQuery *subQuery = new SubQuery;
         subQuery->_queryId = queryId;
@@ -72,7 +72,10 @@ void Marabou::prepareInputQuery()
         }
 
         printf( "InputQuery: %s\n", inputQueryFilePath.ascii() );
-        _inputQuery = QueryLoader::loadQuery( inputQueryFilePath );
+        if ( QueryLoader::isBinaryQuery( inputQueryFilePath ) )
+            _inputQuery = QueryLoader::loadBinary( inputQueryFilePath );
+        else
+            _inputQuery = QueryLoader::loadQuery( inputQueryFilePath );
     }
     else
     {
@@ -123,7 +126,10 @@ void Marabou::prepareInputQuery()
     String queryDumpFilePath = Options::get()->getString( Options::QUERY_DUMP_FILE );
     if ( queryDumpFilePath.length() > 0 )
     {
-        _inputQuery.saveQuery( queryDumpFilePath );
+        if ( Options::get()->getBool( Options::QUERY_DUMP_BINARY ) )
+            _inputQuery.saveBinary( queryDumpFilePath );
+        else
+            _inputQuery.saveQuery( queryDumpFilePath );
         printf( "\nInput query successfully dumped to file\n" );
         exit( 0 );
     }
@@ -47,11 +47,13 @@ public:
         INVALID_WEIGHTED_SUM_INDEX = 22,
         UNSUCCESSFUL_QUEUE_PUSH = 23,
         NETWORK_LEVEL_REASONER_ACTIVATION_NOT_SUPPORTED = 24,
+        LP_SOLVER_UNKNOWN_VARIABLE = 25,
 
         // Error codes for Query Loader
         FILE_DOES_NOT_EXIST = 100,
         INVALID_EQUATION_TYPE = 101,
         UNSUPPORTED_PIECEWISE_CONSTRAINT = 102,
+        INVALID_BINARY_QUERY = 103,
 
         FEATURE_NOT_YET_SUPPORTED = 900,
 
@@ -273,7 +273,7 @@ void MaxConstraint::resetMaxIndex()
     _maxIndexSet = false;
 
     if ( _assignment.empty() ||
-         ( _assignment.size() == 1 && _assignment.begin()->first == _f ) )
+         ( _assignment.size() == 1 && _assignment.exists( _f ) ) )
     {
         // If none of the variables has been assigned, the max index is
         // not set
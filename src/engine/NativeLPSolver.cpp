@@ -0,0 +1,1356 @@
+/*********************                                                        */
+/*! \file NativeLPSolver.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "BasisFactorizationError.h"
+#include "BasisFactorizationFactory.h"
+#include "Debug.h"
+#include "File.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
+#include "MStringf.h"
+#include "MalformedBasisException.h"
+#include "MarabouError.h"
+#include "NativeLPSolver.h"
+#include "SparseColumnsOfBasis.h"
+#include "SparseUnsortedList.h"
+#include "TimeUtils.h"
+
+#include <cmath>
+#include <cstring>
+
+NativeLPSolver::NativeLPSolver()
+    : _maximize( false )
+    , _cutoffInUse( false )
+    , _cutoffValue( 0 )
+    , _timeLimit( FloatUtils::infinity() )
+    , _n( 0 )
+    , _m( 0 )
+    , _columns( NULL )
+    , _lowerBounds( NULL )
+    , _upperBounds( NULL )
+    , _costs( NULL )
+    , _assignment( NULL )
+    , _isBasic( NULL )
+    , _atUpperBound( NULL )
+    , _basicIndexToVariable( NULL )
+    , _basisFactorization( NULL )
+    , _basicAssignment( NULL )
+    , _basicCosts( NULL )
+    , _duals( NULL )
+    , _work( NULL )
+    , _denseColumn( NULL )
+    , _changeColumn( NULL )
+    , _pivotRow( NULL )
+    , _rowEntries( NULL )
+    , _reducedCosts( NULL )
+    , _status( UNSOLVED )
+    , _solution( NULL )
+    , _haveFeasibleSolution( false )
+    , _objectiveValue( 0 )
+    , _objectiveBound( 0 )
+    , _iterations( 0 )
+{
+}
+
+NativeLPSolver::~NativeLPSolver()
+{
+    freeMemoryIfNeeded();
+}
+
+void NativeLPSolver::freeMemoryIfNeeded()
+{
+    if ( _columns )
+    {
+        for ( unsigned i = 0; i < _n + _m; ++i )
+            delete _columns[i];
+        delete[] _columns;
+        _columns = NULL;
+    }
+
+    if ( _basisFactorization )
+    {
+        delete _basisFactorization;
+        _basisFactorization = NULL;
+    }
+
+    double **doubleArrays[] = {
+        &_lowerBounds, &_upperBounds, &_costs, &_assignment,
+        &_basicAssignment, &_basicCosts, &_duals, &_work, &_denseColumn,
+        &_changeColumn, &_pivotRow, &_rowEntries, &_reducedCosts, &_solution,
+    };
+
+    for ( double **array : doubleArrays )
+    {
+        if ( *array )
+        {
+            delete[] *array;
+            *array = NULL;
+        }
+    }
+
+    if ( _isBasic )
+    {
+        delete[] _isBasic;
+        _isBasic = NULL;
+    }
+
+    if ( _atUpperBound )
+    {
+        delete[] _atUpperBound;
+        _atUpperBound = NULL;
+    }
+
+    if ( _basicIndexToVariable )
+    {
+        delete[] _basicIndexToVariable;
+        _basicIndexToVariable = NULL;
+    }
+}
+
+void NativeLPSolver::addVariable( String name, double lb, double ub, VariableType type )
+{
+    ASSERT( !_nameToVariable.exists( name ) );
+
+    unsigned variable = _variableNames.size();
+    _nameToVariable[name] = variable;
+    _variableNames.append( name );
+
+    if ( type == BINARY )
+    {
+        lb = FloatUtils::max( lb, 0 );
+        ub = FloatUtils::min( ub, 1 );
+        _binaryVariables.append( variable );
+    }
+
+    _variableLowerBounds.append( lb );
+    _variableUpperBounds.append( ub );
+}
+
+unsigned NativeLPSolver::getVariable( const String &name ) const
+{
+    if ( !_nameToVariable.exists( name ) )
+        throw MarabouError( MarabouError::LP_SOLVER_UNKNOWN_VARIABLE, name.ascii() );
+
+    return _nameToVariable.get( name );
+}
+
+void NativeLPSolver::setLowerBound( String name, double lb )
+{
+    _variableLowerBounds[getVariable( name )] = lb;
+}
+
+void NativeLPSolver::setUpperBound( String name, double ub )
+{
+    _variableUpperBounds[getVariable( name )] = ub;
+}
+
+void NativeLPSolver::addLeqConstraint( const List<Term> &terms, double scalar )
+{
+    addConstraint( terms, FloatUtils::negativeInfinity(), scalar );
+}
+
+void NativeLPSolver::addGeqConstraint( const List<Term> &terms, double scalar )
+{
+    addConstraint( terms, scalar, FloatUtils::infinity() );
+}
+
+void NativeLPSolver::addEqConstraint( const List<Term> &terms, double scalar )
+{
+    addConstraint( terms, scalar, scalar );
+}
+
+void NativeLPSolver::addConstraint( const List<Term> &terms, double lb, double ub )
+{
+    // Merge repeated occurrences of the same variable
+    Map<unsigned, double> coefficients;
+    for ( const auto &term : terms )
+    {
+        unsigned variable = getVariable( term._variable );
+        if ( coefficients.exists( variable ) )
+            coefficients[variable] += term._coefficient;
+        else
+            coefficients[variable] = term._coefficient;
+    }
+
+    Row row;
+    row._lb = lb;
+    row._ub = ub;
+    for ( const auto &coefficient : coefficients )
+    {
+        if ( !FloatUtils::isZero( coefficient.second ) )
+            row._entries.append( Pair<unsigned, double>( coefficient.first, coefficient.second ) );
+    }
+
+    _rows.append( row );
+}
+
+void NativeLPSolver::setCost( const List<Term> &terms )
+{
+    setCostTerms( terms, false );
+}
+
+void NativeLPSolver::setObjective( const List<Term> &terms )
+{
+    setCostTerms( terms, true );
+}
+
+void NativeLPSolver::setCostTerms( const List<Term> &terms, bool maximize )
+{
+    _costTerms.clear();
+    for ( const auto &term : terms )
+        _costTerms.append( Pair<unsigned, double>( getVariable( term._variable ), term._coefficient ) );
+
+    _maximize = maximize;
+}
+
+void NativeLPSolver::setCutoff( double cutoff )
+{
+    _cutoffInUse = true;
+    _cutoffValue = cutoff;
+}
+
+void NativeLPSolver::setTimeLimit( double seconds )
+{
+    _timeLimit = seconds;
+}
+
+void NativeLPSolver::reset()
+{
+    _status = UNSOLVED;
+    _haveFeasibleSolution = false;
+}
+
+bool NativeLPSolver::optimal()
+{
+    return _status == OPTIMAL;
+}
+
+bool NativeLPSolver::cutoffOccurred()
+{
+    return _status == CUTOFF;
+}
+
+bool NativeLPSolver::infeasbile()
+{
+    return _status == INFEASIBLE;
+}
+
+bool NativeLPSolver::timeout()
+{
+    return _status == TIME_LIMIT;
+}
+
+bool NativeLPSolver::numericalFailure()
+{
+    return _status == NUMERICAL_FAILURE;
+}
+
+bool NativeLPSolver::haveFeasibleSolution()
+{
+    return _haveFeasibleSolution;
+}
+
+unsigned NativeLPSolver::getNumberOfIterations() const
+{
+    return _iterations;
+}
+
+void NativeLPSolver::extractSolution( Map<String, double> &values, double &costOrObjective )
+{
+    values.clear();
+
+    for ( unsigned i = 0; i < _n; ++i )
+        values[_variableNames.get( i )] = _solution[i];
+
+    costOrObjective = toUserSense( _objectiveValue );
+}
+
+double NativeLPSolver::getObjectiveBound()
+{
+    return toUserSense( _objectiveBound );
+}
+
+double NativeLPSolver::toUserSense( double value ) const
+{
+    return _maximize ? -value : value;
+}
+
+double NativeLPSolver::internalCutoff() const
+{
+    return _maximize ? -_cutoffValue : _cutoffValue;
+}
+
+void NativeLPSolver::getColumnOfBasis( unsigned column, double *result ) const
+{
+    ASSERT( column < _m );
+    _columns[_basicIndexToVariable[column]]->toDense( result );
+}
+
+void NativeLPSolver::getColumnOfBasis( unsigned column, SparseUnsortedList *result ) const
+{
+    ASSERT( column < _m );
+    _columns[_basicIndexToVariable[column]]->storeIntoOther( result );
+}
+
+void NativeLPSolver::getSparseBasis( SparseColumnsOfBasis &basis ) const
+{
+    for ( unsigned i = 0; i < _m; ++i )
+        basis._columns[i] = _columns[_basicIndexToVariable[i]];
+}
+
+void NativeLPSolver::buildTableauIfNeeded()
+{
+    unsigned n = _variableNames.size();
+    unsigned m = _rows.size();
+
+    if ( _columns && n == _n && m == _m )
+        return;
+
+    /*
+      The model has grown since the last solve. Keep the previous
+      basis: the old slack variables move to their new indices, and
+      the slack variables of the new rows join the basis.
+    */
+    unsigned numVariables = n + m;
+    bool *isBasic = new bool[numVariables];
+    if ( !isBasic )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::isBasic" );
+
+    bool *atUpperBound = new bool[numVariables];
+    if ( !atUpperBound )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::atUpperBound" );
+
+    for ( unsigned i = 0; i < n; ++i )
+    {
+        isBasic[i] = ( _columns && i < _n ) ? _isBasic[i] : false;
+        atUpperBound[i] = ( _columns && i < _n ) ? _atUpperBound[i] : false;
+    }
+
+    for ( unsigned i = 0; i < m; ++i )
+    {
+        isBasic[n + i] = ( _columns && i < _m ) ? _isBasic[_n + i] : true;
+        atUpperBound[n + i] = ( _columns && i < _m ) ? _atUpperBound[_n + i] : false;
+    }
+
+    freeMemoryIfNeeded();
+
+    _n = n;
+    _m = m;
+    _isBasic = isBasic;
+    _atUpperBound = atUpperBound;
+
+    _columns = new SparseUnsortedList *[numVariables];
+    if ( !_columns )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::columns" );
+
+    for ( unsigned i = 0; i < numVariables; ++i )
+    {
+        _columns[i] = new SparseUnsortedList( m );
+        if ( !_columns[i] )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::columns[i]" );
+    }
+
+    for ( unsigned i = 0; i < m; ++i )
+    {
+        for ( const auto &entry : _rows[i]._entries )
+            _columns[entry.first()]->append( i, entry.second() );
+        _columns[n + i]->append( i, -1 );
+    }
+
+    _lowerBounds = new double[numVariables];
+    if ( !_lowerBounds )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::lowerBounds" );
+
+    _upperBounds = new double[numVariables];
+    if ( !_upperBounds )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::upperBounds" );
+
+    _costs = new double[numVariables];
+    if ( !_costs )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::costs" );
+
+    _assignment = new double[numVariables];
+    if ( !_assignment )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::assignment" );
+
+    _rowEntries = new double[numVariables];
+    if ( !_rowEntries )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::rowEntries" );
+
+    _reducedCosts = new double[numVariables];
+    if ( !_reducedCosts )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::reducedCosts" );
+
+    std::fill_n( _assignment, numVariables, 0 );
+
+    _basicIndexToVariable = new unsigned[m];
+    if ( !_basicIndexToVariable )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::basicIndexToVariable" );
+
+    _basicAssignment = new double[m];
+    if ( !_basicAssignment )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::basicAssignment" );
+
+    _basicCosts = new double[m];
+    if ( !_basicCosts )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::basicCosts" );
+
+    _duals = new double[m];
+    if ( !_duals )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::duals" );
+
+    _work = new double[m];
+    if ( !_work )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::work" );
+
+    _denseColumn = new double[m];
+    if ( !_denseColumn )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::denseColumn" );
+
+    _changeColumn = new double[m];
+    if ( !_changeColumn )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::changeColumn" );
+
+    _pivotRow = new double[m];
+    if ( !_pivotRow )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::pivotRow" );
+
+    _solution = new double[n];
+    if ( !_solution )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "NativeLPSolver::solution" );
+
+    std::fill_n( _solution, n, 0 );
+
+    unsigned basicIndex = 0;
+    for ( unsigned i = 0; i < numVariables; ++i )
+    {
+        if ( _isBasic[i] )
+            _basicIndexToVariable[basicIndex++] = i;
+    }
+    ASSERT( basicIndex == m );
+
+    if ( m > 0 )
+        _basisFactorization = BasisFactorizationFactory::createBasisFactorization( m, *this );
+}
+
+void NativeLPSolver::loadBoundsAndCosts()
+{
+    for ( unsigned i = 0; i < _n; ++i )
+    {
+        _lowerBounds[i] = _variableLowerBounds[i];
+        _upperBounds[i] = _variableUpperBounds[i];
+        _costs[i] = 0;
+    }
+
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        _lowerBounds[_n + i] = _rows[i]._lb;
+        _upperBounds[_n + i] = _rows[i]._ub;
+        _costs[_n + i] = 0;
+    }
+
+    // Costs are kept in minimization form
+    for ( const auto &term : _costTerms )
+        _costs[term.first()] += _maximize ? -term.second() : term.second();
+
+    for ( unsigned i = 0; i < _n + _m; ++i )
+    {
+        if ( !_isBasic[i] )
+            placeNonBasic( i );
+    }
+}
+
+void NativeLPSolver::restoreSlackBasis()
+{
+    for ( unsigned i = 0; i < _n + _m; ++i )
+    {
+        _isBasic[i] = ( i >= _n );
+        _atUpperBound[i] = false;
+    }
+
+    for ( unsigned i = 0; i < _m; ++i )
+        _basicIndexToVariable[i] = _n + i;
+
+    for ( unsigned i = 0; i < _n; ++i )
+        placeNonBasic( i );
+}
+
+void NativeLPSolver::refactorize()
+{
+    if ( _m > 0 )
+        _basisFactorization->obtainFreshBasis();
+}
+
+void NativeLPSolver::placeNonBasic( unsigned variable )
+{
+    double lb = _lowerBounds[variable];
+    double ub = _upperBounds[variable];
+
+    if ( _atUpperBound[variable] && FloatUtils::isFinite( ub ) )
+    {
+        _assignment[variable] = ub;
+    }
+    else if ( FloatUtils::isFinite( lb ) )
+    {
+        _assignment[variable] = lb;
+        _atUpperBound[variable] = false;
+    }
+    else if ( FloatUtils::isFinite( ub ) )
+    {
+        _assignment[variable] = ub;
+        _atUpperBound[variable] = true;
+    }
+    else
+    {
+        // A free variable rests at zero
+        _assignment[variable] = 0;
+        _atUpperBound[variable] = false;
+    }
+}
+
+void NativeLPSolver::solve()
+{
+    _solveStart = TimeUtils::sampleMicro();
+    _iterations = 0;
+    _haveFeasibleSolution = false;
+    _objectiveValue = FloatUtils::infinity();
+    _objectiveBound = FloatUtils::negativeInfinity();
+
+    buildTableauIfNeeded();
+    loadBoundsAndCosts();
+
+    for ( unsigned i = 0; i < _n + _m; ++i )
+    {
+        if ( FloatUtils::gt( _lowerBounds[i],
+                             _upperBounds[i],
+                             GlobalConfiguration::BOUND_COMPARISON_ADDITIVE_TOLERANCE ) )
+        {
+            _status = INFEASIBLE;
+            return;
+        }
+    }
+
+    if ( !_binaryVariables.empty() )
+    {
+        branchAndBound();
+        return;
+    }
+
+    _status = solveRelaxation();
+
+    if ( _status == OPTIMAL )
+    {
+        _objectiveValue = computeObjectiveValue();
+        _objectiveBound = _objectiveValue;
+        _haveFeasibleSolution = true;
+        storeSolution();
+
+        if ( _cutoffInUse && _objectiveValue > internalCutoff() )
+            _status = CUTOFF;
+    }
+    else if ( _status == TIME_LIMIT )
+    {
+        _objectiveBound = computeDualBound();
+
+        try
+        {
+            computeBasicAssignment();
+            if ( !computePhaseOneCosts() )
+            {
+                _objectiveValue = computeObjectiveValue();
+                _haveFeasibleSolution = true;
+                storeSolution();
+            }
+        }
+        catch ( const MalformedBasisException & )
+        {
+        }
+        catch ( const BasisFactorizationError & )
+        {
+        }
+    }
+    else if ( _status == CUTOFF )
+    {
+        _objectiveBound = computeDualBound();
+    }
+}
+
+NativeLPSolver::Status NativeLPSolver::solveRelaxation()
+{
+    /*
+      Start from the current basis. If it is still dual feasible, as
+      happens after the bounds change under the same objective, run the
+      dual simplex. Otherwise, or if the dual simplex cannot finish,
+      run the primal simplex. If the basis turns out to be singular, or
+      the primal simplex runs into numerical trouble, start over from
+      the slack basis.
+    */
+    for ( unsigned attempt = 0; attempt < 2; ++attempt )
+    {
+        try
+        {
+            refactorize();
+            computeBasicAssignment();
+
+            if ( computePhaseOneCosts() && dualFeasible() )
+            {
+                Status status = dualSimplex();
+                if ( status == OPTIMAL || status == CUTOFF || status == TIME_LIMIT )
+                    return status;
+            }
+
+            Status status = primalSimplex();
+            if ( status != NUMERICAL_FAILURE )
+                return status;
+        }
+        catch ( const MalformedBasisException & )
+        {
+        }
+        catch ( const BasisFactorizationError & )
+        {
+        }
+
+        restoreSlackBasis();
+    }
+
+    return NUMERICAL_FAILURE;
+}
+
+void NativeLPSolver::computeBasicAssignment()
+{
+    if ( _m == 0 )
+        return;
+
+    // B * xB + N * xN = 0
+    std::fill_n( _work, _m, 0 );
+    for ( unsigned i = 0; i < _n + _m; ++i )
+    {
+        if ( _isBasic[i] || _assignment[i] == 0 )
+            continue;
+
+        for ( const auto &entry : *_columns[i] )
+            _work[entry._index] -= entry._value * _assignment[i];
+    }
+
+    _basisFactorization->forwardTransformation( _work, _basicAssignment );
+
+    for ( unsigned i = 0; i < _m; ++i )
+        _assignment[_basicIndexToVariable[i]] = _basicAssignment[i];
+}
+
+bool NativeLPSolver::computePhaseOneCosts()
+{
+    // The cost of the sum of infeasibilities of the basic variables
+    bool infeasible = false;
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        unsigned variable = _basicIndexToVariable[i];
+        double value = _assignment[variable];
+
+        if ( FloatUtils::lt( value,
+                             _lowerBounds[variable],
+                             GlobalConfiguration::BOUND_COMPARISON_ADDITIVE_TOLERANCE ) )
+        {
+            _basicCosts[i] = -1;
+            infeasible = true;
+        }
+        else if ( FloatUtils::gt( value,
+                                  _upperBounds[variable],
+                                  GlobalConfiguration::BOUND_COMPARISON_ADDITIVE_TOLERANCE ) )
+        {
+            _basicCosts[i] = 1;
+            infeasible = true;
+        }
+        else
+        {
+            _basicCosts[i] = 0;
+        }
+    }
+
+    return infeasible;
+}
+
+void NativeLPSolver::loadBasicCosts()
+{
+    for ( unsigned i = 0; i < _m; ++i )
+        _basicCosts[i] = _costs[_basicIndexToVariable[i]];
+}
+
+void NativeLPSolver::computeDuals()
+{
+    // y * B = cB
+    if ( _m > 0 )
+        _basisFactorization->backwardTransformation( _basicCosts, _duals );
+}
+
+double NativeLPSolver::computeReducedCost( unsigned variable, bool phaseOne ) const
+{
+    double reducedCost = phaseOne ? 0 : _costs[variable];
+    for ( const auto &entry : *_columns[variable] )
+        reducedCost -= _duals[entry._index] * entry._value;
+
+    return reducedCost;
+}
+
+bool NativeLPSolver::canIncrease( unsigned variable ) const
+{
+    return FloatUtils::lt( _assignment[variable],
+                           _upperBounds[variable],
+                           GlobalConfiguration::BOUND_COMPARISON_ADDITIVE_TOLERANCE );
+}
+
+bool NativeLPSolver::canDecrease( unsigned variable ) const
+{
+    return FloatUtils::gt( _assignment[variable],
+                           _lowerBounds[variable],
+                           GlobalConfiguration::BOUND_COMPARISON_ADDITIVE_TOLERANCE );
+}
+
+bool NativeLPSolver::dualFeasible()
+{
+    loadBasicCosts();
+    computeDuals();
+
+    for ( unsigned i = 0; i < _n + _m; ++i )
+    {
+        if ( _isBasic[i] )
+            continue;
+
+        double reducedCost = computeReducedCost( i, false );
+        if ( reducedCost < -GlobalConfiguration::ENTRY_ELIGIBILITY_TOLERANCE && canIncrease( i ) )
+            return false;
+        if ( reducedCost > GlobalConfiguration::ENTRY_ELIGIBILITY_TOLERANCE && canDecrease( i ) )
+            return false;
+    }
+
+    return true;
+}
+
+double NativeLPSolver::computeObjectiveValue() const
+{
+    double value = 0;
+    for ( unsigned i = 0; i < _n; ++i )
+    {
+        if ( _costs[i] != 0 )
+            value += _costs[i] * _assignment[i];
+    }
+
+    return value;
+}
+
+double NativeLPSolver::computeDualBound()
+{
+    /*
+      For any duals y, weak duality gives a lower bound on the cost:
+      the minimum of (c - y * [A | -I]) * x over the bounds of all
+      variables. Using the duals of the current basis, only the
+      non-basic variables contribute. The bound is only used when the
+      solve stops early, so no reduced cost is rounded to zero: even a
+      tiny one makes the bound unbounded if it meets an infinite bound.
+    */
+    try
+    {
+        loadBasicCosts();
+        computeDuals();
+    }
+    catch ( const MalformedBasisException & )
+    {
+        return FloatUtils::negativeInfinity();
+    }
+    catch ( const BasisFactorizationError & )
+    {
+        return FloatUtils::negativeInfinity();
+    }
+
+    double bound = 0;
+    for ( unsigned i = 0; i < _n + _m; ++i )
+    {
+        if ( _isBasic[i] )
+            continue;
+
+        double reducedCost = computeReducedCost( i, false );
+        if ( reducedCost == 0 )
+            continue;
+
+        double bestBound = reducedCost > 0 ? _lowerBounds[i] : _upperBounds[i];
+        if ( !FloatUtils::isFinite( bestBound ) )
+            return FloatUtils::negativeInfinity();
+
+        bound += reducedCost * bestBound;
+    }
+
+    return bound;
+}
+
+void NativeLPSolver::computeChangeColumn( unsigned variable )
+{
+    if ( _m == 0 )
+        return;
+
+    _columns[variable]->toDense( _denseColumn );
+    _basisFactorization->forwardTransformation( _denseColumn, _changeColumn );
+}
+
+void NativeLPSolver::pivot( unsigned entering, unsigned leavingIndex, bool leavingAtUpperBound )
+{
+    unsigned leaving = _basicIndexToVariable[leavingIndex];
+
+    _isBasic[leaving] = false;
+    _atUpperBound[leaving] = leavingAtUpperBound;
+    placeNonBasic( leaving );
+
+    _isBasic[entering] = true;
+    _basicIndexToVariable[leavingIndex] = entering;
+
+    _basisFactorization->updateToAdjacentBasis( leavingIndex, _changeColumn, _denseColumn );
+}
+
+void NativeLPSolver::storeSolution()
+{
+    memcpy( _solution, _assignment, sizeof(double) * _n );
+}
+
+bool NativeLPSolver::timeLimitReached() const
+{
+    if ( !FloatUtils::isFinite( _timeLimit ) )
+        return false;
+
+    return TimeUtils::timePassed( _solveStart, TimeUtils::sampleMicro() ) > _timeLimit * 1000000;
+}
+
+bool NativeLPSolver::getBlockingBound( unsigned variable, double rate, double &bound ) const
+{
+    /*
+      The bound that a basic variable hits first when it changes at
+      the given rate. In phase one, an infeasible variable moving
+      towards its bounds is blocked once it becomes feasible, and one
+      moving away from them is not blocked at all.
+    */
+    double value = _assignment[variable];
+    double lb = _lowerBounds[variable];
+    double ub = _upperBounds[variable];
+    double tolerance = GlobalConfiguration::BOUND_COMPARISON_ADDITIVE_TOLERANCE;
+
+    if ( rate < 0 )
+    {
+        if ( FloatUtils::isFinite( ub ) && FloatUtils::gt( value, ub, tolerance ) )
+        {
+            bound = ub;
+            return true;
+        }
+
+        if ( FloatUtils::isFinite( lb ) && FloatUtils::gte( value, lb, tolerance ) )
+        {
+            bound = lb;
+            return true;
+        }
+    }
+    else
+    {
+        if ( FloatUtils::isFinite( lb ) && FloatUtils::lt( value, lb, tolerance ) )
+        {
+            bound = lb;
+            return true;
+        }
+
+        if ( FloatUtils::isFinite( ub ) && FloatUtils::lte( value, ub, tolerance ) )
+        {
+            bound = ub;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+NativeLPSolver::Status NativeLPSolver::primalSimplex()
+{
+    unsigned numVariables = _n + _m;
+    unsigned iterations = 0;
+    unsigned degeneratePivots = 0;
+    bool refactorizedForInfeasibility = false;
+
+    while ( true )
+    {
+        if ( timeLimitReached() || iterations >= GlobalConfiguration::NATIVE_LP_SOLVER_MAX_ITERATIONS )
+            return TIME_LIMIT;
+
+        computeBasicAssignment();
+        bool phaseOne = computePhaseOneCosts();
+        if ( !phaseOne )
+            loadBasicCosts();
+        computeDuals();
+
+        // Dantzig's rule, or Bland's rule if the simplex seems to cycle
+        bool useBlandsRule =
+            degeneratePivots > GlobalConfiguration::NATIVE_LP_SOLVER_DEGENERATE_PIVOTS_BEFORE_BLANDS_RULE;
+        unsigned entering = numVariables;
+        double enteringReducedCost = 0;
+
+        for ( unsigned i = 0; i < numVariables; ++i )
+        {
+            if ( _isBasic[i] )
+                continue;
+
+            double reducedCost = computeReducedCost( i, phaseOne );
+            if ( !( reducedCost < -GlobalConfiguration::ENTRY_ELIGIBILITY_TOLERANCE && canIncrease( i ) ) &&
+                 !( reducedCost > GlobalConfiguration::ENTRY_ELIGIBILITY_TOLERANCE && canDecrease( i ) ) )
+                continue;
+
+            if ( entering == numVariables ||
+                 FloatUtils::abs( reducedCost ) > FloatUtils::abs( enteringReducedCost ) )
+            {
+                entering = i;
+                enteringReducedCost = reducedCost;
+            }
+
+            if ( useBlandsRule )
+                break;
+        }
+
+        if ( entering == numVariables )
+        {
+            if ( !phaseOne )
+                return OPTIMAL;
+
+            // Only conclude infeasibility on a fresh factorization
+            if ( refactorizedForInfeasibility )
+                return INFEASIBLE;
+
+            refactorize();
+            refactorizedForInfeasibility = true;
+            continue;
+        }
+
+        refactorizedForInfeasibility = false;
+        ++iterations;
+        ++_iterations;
+
+        double direction = enteringReducedCost < 0 ? 1 : -1;
+        computeChangeColumn( entering );
+
+        /*
+          Harris' ratio test. Basic variable i changes at the rate of
+          -direction * changeColumn[i] per unit of step. The first pass
+          finds the largest step for which all basic variables stay
+          within their bounds, relaxed by the tolerance; the second
+          picks the largest pivot element among the variables that
+          block within that step.
+        */
+        double tolerance = GlobalConfiguration::BOUND_COMPARISON_ADDITIVE_TOLERANCE;
+        double relaxedStep = FloatUtils::infinity();
+        for ( unsigned i = 0; i < _m; ++i )
+        {
+            if ( FloatUtils::abs( _changeColumn[i] ) < GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE )
+                continue;
+
+            double rate = -direction * _changeColumn[i];
+            double bound;
+            if ( !getBlockingBound( _basicIndexToVariable[i], rate, bound ) )
+                continue;
+
+            double step = ( bound - _assignment[_basicIndexToVariable[i]] ) / rate +
+                tolerance / FloatUtils::abs( rate );
+            if ( step < relaxedStep )
+                relaxedStep = step;
+        }
+
+        unsigned leavingIndex = _m;
+        double leavingStep = 0;
+        double leavingBound = 0;
+        double largestPivot = 0;
+        for ( unsigned i = 0; i < _m; ++i )
+        {
+            double pivot = FloatUtils::abs( _changeColumn[i] );
+            if ( pivot < GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE )
+                continue;
+
+            double rate = -direction * _changeColumn[i];
+            double bound;
+            if ( !getBlockingBound( _basicIndexToVariable[i], rate, bound ) )
+                continue;
+
+            double step = ( bound - _assignment[_basicIndexToVariable[i]] ) / rate;
+            if ( step < 0 )
+                step = 0;
+
+            if ( step <= relaxedStep && pivot > largestPivot )
+            {
+                leavingIndex = i;
+                leavingStep = step;
+                leavingBound = bound;
+                largestPivot = pivot;
+            }
+        }
+
+        double range = _upperBounds[entering] - _lowerBounds[entering];
+        bool rangeIsFinite =
+            FloatUtils::isFinite( _lowerBounds[entering] ) && FloatUtils::isFinite( _upperBounds[entering] );
+
+        if ( leavingIndex == _m && !rangeIsFinite )
+        {
+            // Phase one cannot be unbounded; this is numerical trouble
+            return phaseOne ? NUMERICAL_FAILURE : UNBOUNDED;
+        }
+
+        if ( leavingIndex == _m || ( rangeIsFinite && range <= leavingStep ) )
+        {
+            // The entering variable hits its other bound first
+            _atUpperBound[entering] = direction > 0;
+            placeNonBasic( entering );
+            degeneratePivots = 0;
+            continue;
+        }
+
+        if ( FloatUtils::isZero( leavingStep ) )
+            ++degeneratePivots;
+        else
+            degeneratePivots = 0;
+
+        unsigned leaving = _basicIndexToVariable[leavingIndex];
+        pivot( entering, leavingIndex, leavingBound == _upperBounds[leaving] );
+    }
+}
+
+NativeLPSolver::Status NativeLPSolver::dualSimplex()
+{
+    unsigned numVariables = _n + _m;
+    unsigned iterations = 0;
+
+    while ( true )
+    {
+        if ( timeLimitReached() )
+            return TIME_LIMIT;
+
+        // Give up and let the primal simplex take over
+        if ( iterations >= GlobalConfiguration::NATIVE_LP_SOLVER_MAX_ITERATIONS )
+            return UNSOLVED;
+
+        computeBasicAssignment();
+        loadBasicCosts();
+        computeDuals();
+
+        // While the basis is dual feasible, its cost bounds the optimum
+        // from below
+        if ( _cutoffInUse && computeObjectiveValue() > internalCutoff() )
+            return CUTOFF;
+
+        // The leaving variable is the most infeasible basic variable
+        unsigned leavingIndex = _m;
+        bool leavingIncreases = false;
+        double largestInfeasibility = GlobalConfiguration::BOUND_COMPARISON_ADDITIVE_TOLERANCE;
+        for ( unsigned i = 0; i < _m; ++i )
+        {
+            unsigned variable = _basicIndexToVariable[i];
+            double value = _assignment[variable];
+
+            if ( _lowerBounds[variable] - value > largestInfeasibility )
+            {
+                leavingIndex = i;
+                leavingIncreases = true;
+                largestInfeasibility = _lowerBounds[variable] - value;
+            }
+            else if ( value - _upperBounds[variable] > largestInfeasibility )
+            {
+                leavingIndex = i;
+                leavingIncreases = false;
+                largestInfeasibility = value - _upperBounds[variable];
+            }
+        }
+
+        if ( leavingIndex == _m )
+            return OPTIMAL;
+
+        ++iterations;
+        ++_iterations;
+
+        // The row of the leaving variable in the tableau
+        std::fill_n( _work, _m, 0 );
+        _work[leavingIndex] = 1;
+        _basisFactorization->backwardTransformation( _work, _pivotRow );
+
+        /*
+          The leaving variable changes at the rate of -rowEntry per unit
+          of increase of a non-basic variable. Among the variables that
+          can move it towards its bound, the dual ratio test picks the
+          one whose reduced cost reaches zero first, again in two passes.
+        */
+        double sign = leavingIncreases ? 1 : -1;
+        double relaxedRatio = FloatUtils::infinity();
+        for ( unsigned i = 0; i < numVariables; ++i )
+        {
+            _rowEntries[i] = 0;
+            if ( _isBasic[i] )
+                continue;
+
+            double rowEntry = 0;
+            for ( const auto &entry : *_columns[i] )
+                rowEntry += _pivotRow[entry._index] * entry._value;
+
+            if ( FloatUtils::abs( rowEntry ) < GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE )
+                continue;
+
+            bool increase = -rowEntry * sign > 0;
+            if ( ( increase && !canIncrease( i ) ) || ( !increase && !canDecrease( i ) ) )
+                continue;
+
+            _rowEntries[i] = rowEntry;
+            _reducedCosts[i] = computeReducedCost( i, false );
+
+            double ratio = ( FloatUtils::abs( _reducedCosts[i] ) + GlobalConfiguration::ENTRY_ELIGIBILITY_TOLERANCE ) /
+                FloatUtils::abs( rowEntry );
+            if ( ratio < relaxedRatio )
+                relaxedRatio = ratio;
+        }
+
+        unsigned entering = numVariables;
+        double largestPivot = 0;
+        for ( unsigned i = 0; i < numVariables; ++i )
+        {
+            double pivot = FloatUtils::abs( _rowEntries[i] );
+            if ( pivot == 0 )
+                continue;
+
+            if ( FloatUtils::abs( _reducedCosts[i] ) / pivot <= relaxedRatio && pivot > largestPivot )
+            {
+                entering = i;
+                largestPivot = pivot;
+            }
+        }
+
+        // The leaving variable cannot reach its bound: the problem is
+        // infeasible, to be confirmed by the primal simplex
+        if ( entering == numVariables )
+            return INFEASIBLE;
+
+        computeChangeColumn( entering );
+        if ( FloatUtils::abs( _changeColumn[leavingIndex] ) < GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE )
+            return UNSOLVED;
+
+        pivot( entering, leavingIndex, !leavingIncreases );
+    }
+}
+
+void NativeLPSolver::branchAndBound()
+{
+    /*
+      A depth-first search over the values of the binary variables.
+      Each node solves the LP relaxation under its fixings, warm
+      started from the basis of the previous node. The incumbent, or
+      the cutoff if there is no incumbent yet, prunes nodes whose
+      relaxation is no better.
+    */
+    double incumbent = _cutoffInUse ? internalCutoff() : FloatUtils::infinity();
+    bool haveIncumbent = false;
+    bool prunedByBound = false;
+    bool timedOut = false;
+    double unresolvedBound = FloatUtils::infinity();
+
+    Vector<Node> stack;
+    Node root;
+    root._bound = FloatUtils::negativeInfinity();
+    stack.append( root );
+
+    while ( !stack.empty() )
+    {
+        if ( timeLimitReached() )
+        {
+            timedOut = true;
+            for ( const auto &node : stack )
+                unresolvedBound = FloatUtils::min( unresolvedBound, node._bound );
+            break;
+        }
+
+        Node node = stack.pop();
+        if ( node._bound >= incumbent )
+        {
+            prunedByBound = true;
+            continue;
+        }
+
+        for ( const auto &variable : _binaryVariables )
+        {
+            _lowerBounds[variable] = _variableLowerBounds.get( variable );
+            _upperBounds[variable] = _variableUpperBounds.get( variable );
+        }
+
+        for ( const auto &fixing : node._fixings )
+        {
+            _lowerBounds[fixing.first()] = fixing.second();
+            _upperBounds[fixing.first()] = fixing.second();
+        }
+
+        for ( const auto &variable : _binaryVariables )
+        {
+            if ( !_isBasic[variable] )
+                placeNonBasic( variable );
+        }
+
+        Status status = solveRelaxation();
+
+        if ( status == INFEASIBLE )
+            continue;
+
+        if ( status == UNBOUNDED )
+        {
+            _status = UNBOUNDED;
+            return;
+        }
+
+        if ( status == CUTOFF )
+        {
+            prunedByBound = true;
+            continue;
+        }
+
+        if ( status == TIME_LIMIT || status == NUMERICAL_FAILURE )
+        {
+            // The node could not be solved, so only its parent's bound
+            // is known
+            if ( status == TIME_LIMIT )
+                timedOut = true;
+            unresolvedBound = FloatUtils::min( unresolvedBound, node._bound );
+            continue;
+        }
+
+        double value = computeObjectiveValue();
+        if ( value >= incumbent )
+        {
+            prunedByBound = true;
+            continue;
+        }
+
+        // Branch on the most fractional binary variable
+        unsigned branchVariable = _n;
+        double largestFraction = GlobalConfiguration::NATIVE_LP_SOLVER_INTEGRALITY_TOLERANCE;
+        for ( const auto &variable : _binaryVariables )
+        {
+            double fraction = FloatUtils::min( _assignment[variable], 1 - _assignment[variable] );
+            if ( fraction > largestFraction )
+            {
+                branchVariable = variable;
+                largestFraction = fraction;
+            }
+        }
+
+        if ( branchVariable == _n )
+        {
+            incumbent = value;
+            haveIncumbent = true;
+            storeSolution();
+            continue;
+        }
+
+        Node zero;
+        zero._fixings = node._fixings;
+        zero._fixings.append( Pair<unsigned, double>( branchVariable, 0 ) );
+        zero._bound = value;
+
+        Node one;
+        one._fixings = node._fixings;
+        one._fixings.append( Pair<unsigned, double>( branchVariable, 1 ) );
+        one._bound = value;
+
+        // Explore the closer rounding first
+        if ( _assignment[branchVariable] >= 0.5 )
+        {
+            stack.append( zero );
+            stack.append( one );
+        }
+        else
+        {
+            stack.append( one );
+            stack.append( zero );
+        }
+    }
+
+    _haveFeasibleSolution = haveIncumbent;
+    if ( haveIncumbent )
+        _objectiveValue = incumbent;
+
+    if ( unresolvedBound < incumbent )
+    {
+        // Report the parent bounds of unsolved nodes only if they are
+        // due to the time limit
+        _status = timedOut ? TIME_LIMIT : NUMERICAL_FAILURE;
+        _objectiveBound = unresolvedBound;
+    }
+    else if ( haveIncumbent )
+    {
+        _status = OPTIMAL;
+        _objectiveBound = incumbent;
+    }
+    else if ( prunedByBound )
+    {
+        _status = CUTOFF;
+        _objectiveBound = incumbent;
+    }
+    else
+    {
+        _status = INFEASIBLE;
+    }
+}
+
+void NativeLPSolver::dumpModel( String name )
+{
+    File file( name );
+    file.open( IFile::MODE_WRITE_TRUNCATE );
+
+    file.write( _maximize ? "Maximize\n obj:" : "Minimize\n obj:" );
+    for ( const auto &term : _costTerms )
+        file.write( Stringf( " %+.10lf %s", term.second(), _variableNames.get( term.first() ).ascii() ) );
+
+    file.write( "\nSubject To\n" );
+    for ( unsigned i = 0; i < _rows.size(); ++i )
+    {
+        const Row &row = _rows[i];
+        String expression;
+        for ( const auto &entry : row._entries )
+            expression += Stringf( " %+.10lf %s", entry.second(), _variableNames.get( entry.first() ).ascii() );
+
+        if ( row._lb == row._ub )
+            file.write( Stringf( " c%u:%s = %.10lf\n", i, expression.ascii(), row._lb ) );
+        else if ( FloatUtils::isFinite( row._ub ) )
+            file.write( Stringf( " c%u:%s <= %.10lf\n", i, expression.ascii(), row._ub ) );
+        else
+            file.write( Stringf( " c%u:%s >= %.10lf\n", i, expression.ascii(), row._lb ) );
+    }
+
+    file.write( "Bounds\n" );
+    for ( unsigned i = 0; i < _variableNames.size(); ++i )
+    {
+        file.write( Stringf( " %s <= %s <= %s\n",
+                             FloatUtils::doubleToString( _variableLowerBounds.get( i ) ).ascii(),
+                             _variableNames.get( i ).ascii(),
+                             FloatUtils::doubleToString( _variableUpperBounds.get( i ) ).ascii() ) );
+    }
+
+    if ( !_binaryVariables.empty() )
+    {
+        file.write( "Binaries\n" );
+        for ( const auto &variable : _binaryVariables )
+            file.write( Stringf( " %s\n", _variableNames.get( variable ).ascii() ) );
+    }
+
+    file.write( "End\n" );
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,276 @@
+/*********************                                                        */
+/*! \file NativeLPSolver.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A self-contained LP solver with the same interface as the
+ ** GurobiWrapper, used for LP- and MILP-based bound tightening when
+ ** Marabou is built without Gurobi.
+ **
+ ** The solver runs a bounded-variable simplex over the constraint
+ ** matrix [A | -I], where each row of A gets a slack variable that
+ ** carries the row's bounds. Basis solves go through Marabou's own
+ ** basis factorization (sparse Forrest-Tomlin by default). The basis
+ ** is kept between calls to solve(), so a change of objective is
+ ** warm-started with the primal simplex, and a change of bounds under
+ ** the same objective with the dual simplex. Binary variables are
+ ** handled by a depth-first branch and bound over LP relaxations.
+
+ **/
+
+#ifndef __NativeLPSolver_h__
+#define __NativeLPSolver_h__
+
+#include "IBasisFactorization.h"
+#include "List.h"
+#include "MString.h"
+#include "Map.h"
+#include "Pair.h"
+#include "Vector.h"
+
+#include <time.h>
+
+class SparseUnsortedList;
+
+class NativeLPSolver : public IBasisFactorization::BasisColumnOracle
+{
+public:
+    enum VariableType {
+        CONTINUOUS = 0,
+        BINARY = 1,
+    };
+
+    /*
+      A term has the form: coefficient * variable
+    */
+    struct Term
+    {
+        Term( double coefficient, String variable )
+            : _coefficient( coefficient )
+            , _variable( variable )
+        {
+        }
+
+        Term()
+            : _coefficient( 0 )
+            , _variable( "" )
+        {
+        }
+
+        double _coefficient;
+        String _variable;
+    };
+
+    NativeLPSolver();
+    ~NativeLPSolver();
+
+    // Add a new variable to the model
+    void addVariable( String name, double lb, double ub, VariableType type = CONTINUOUS );
+
+    // Set the lower or upper bound for an existing variable
+    void setLowerBound( String name, double lb );
+    void setUpperBound( String name, double ub );
+
+    // Add a new LEQ constraint, e.g. 3x + 4y <= -5
+    void addLeqConstraint( const List<Term> &terms, double scalar );
+
+    // Add a new GEQ constraint, e.g. 3x + 4y >= -5
+    void addGeqConstraint( const List<Term> &terms, double scalar );
+
+    // Add a new EQ constraint, e.g. 3x + 4y = -5
+    void addEqConstraint( const List<Term> &terms, double scalar );
+
+    // A cost function to minimize, or an objective function to maximize
+    void setCost( const List<Term> &terms );
+    void setObjective( const List<Term> &terms );
+
+    // Set a cutoff value for the objective function. If the optimal
+    // value is worse than the cutoff, the solver stops and reports
+    // that the cutoff occurred.
+    void setCutoff( double cutoff );
+
+    // Returns true iff an optimal solution has been found
+    bool optimal();
+
+    // Returns true iff the cutoff value was used
+    bool cutoffOccurred();
+
+    // Returns true iff the instance is infeasible
+    bool infeasbile();
+
+    // Returns true iff the instance timed out
+    bool timeout();
+
+    // Returns true iff the solver failed for numerical reasons. Unlike
+    // after a timeout, no bound on the objective function is known
+    bool numericalFailure();
+
+    // Returns true iff a feasible solution has been found
+    bool haveFeasibleSolution();
+
+    // Specify a time limit, in seconds
+    void setTimeLimit( double seconds );
+
+    // Solve and extract the solution, or the best known bound on the
+    // objective function
+    void solve();
+    void extractSolution( Map<String, double> &values, double &costOrObjective );
+    double getObjectiveBound();
+
+    // Discard the result of the last solve. The basis is kept, and
+    // serves as the starting point for the next solve.
+    void reset();
+
+    // Dump the model to a file, in LP format
+    void dumpModel( String name );
+
+    // The number of simplex iterations performed by the last solve
+    unsigned getNumberOfIterations() const;
+
+    /*
+      Methods for obtaining the basis, used by the basis factorization
+    */
+    void getColumnOfBasis( unsigned column, double *result ) const;
+    void getColumnOfBasis( unsigned column, SparseUnsortedList *result ) const;
+    void getSparseBasis( SparseColumnsOfBasis &basis ) const;
+
+private:
+    enum Status {
+        UNSOLVED = 0,
+        OPTIMAL,
+        INFEASIBLE,
+        UNBOUNDED,
+        CUTOFF,
+        TIME_LIMIT,
+        NUMERICAL_FAILURE,
+    };
+
+    struct Row
+    {
+        List<Pair<unsigned, double>> _entries;
+        double _lb;
+        double _ub;
+    };
+
+    /*
+      A node of the branch and bound tree: values for some of the
+      binary variables, and the objective bound of the parent
+    */
+    struct Node
+    {
+        List<Pair<unsigned, double>> _fixings;
+        double _bound;
+    };
+
+    /*
+      The model
+    */
+    Map<String, unsigned> _nameToVariable;
+    Vector<String> _variableNames;
+    Vector<double> _variableLowerBounds;
+    Vector<double> _variableUpperBounds;
+    Vector<unsigned> _binaryVariables;
+    Vector<Row> _rows;
+    List<Pair<unsigned, double>> _costTerms;
+    bool _maximize;
+    bool _cutoffInUse;
+    double _cutoffValue;
+    double _timeLimit;
+
+    /*
+      The simplex tableau: _n structural variables, followed by _m
+      slack variables, one per row
+    */
+    unsigned _n;
+    unsigned _m;
+    SparseUnsortedList **_columns;
+    double *_lowerBounds;
+    double *_upperBounds;
+    double *_costs;
+    double *_assignment;
+    bool *_isBasic;
+    bool *_atUpperBound;
+    unsigned *_basicIndexToVariable;
+    IBasisFactorization *_basisFactorization;
+
+    /*
+      Work memory
+    */
+    double *_basicAssignment;
+    double *_basicCosts;
+    double *_duals;
+    double *_work;
+    double *_denseColumn;
+    double *_changeColumn;
+    double *_pivotRow;
+    double *_rowEntries;
+    double *_reducedCosts;
+
+    /*
+      The result of the last solve, with the objective values in
+      minimization form
+    */
+    Status _status;
+    double *_solution;
+    bool _haveFeasibleSolution;
+    double _objectiveValue;
+    double _objectiveBound;
+    unsigned _iterations;
+    struct timespec _solveStart;
+
+    /*
+      Manage the model and the tableau
+    */
+    unsigned getVariable( const String &name ) const;
+    void addConstraint( const List<Term> &terms, double lb, double ub );
+    void setCostTerms( const List<Term> &terms, bool maximize );
+    void buildTableauIfNeeded();
+    void loadBoundsAndCosts();
+    void restoreSlackBasis();
+    void refactorize();
+    void freeMemoryIfNeeded();
+
+    /*
+      The simplex
+    */
+    Status solveRelaxation();
+    Status primalSimplex();
+    Status dualSimplex();
+    void branchAndBound();
+
+    void placeNonBasic( unsigned variable );
+    void computeBasicAssignment();
+    bool computePhaseOneCosts();
+    void loadBasicCosts();
+    void computeDuals();
+    double computeReducedCost( unsigned variable, bool phaseOne ) const;
+    bool dualFeasible();
+    double computeObjectiveValue() const;
+    double computeDualBound();
+    void computeChangeColumn( unsigned variable );
+    void pivot( unsigned entering, unsigned leavingIndex, bool leavingAtUpperBound );
+    void storeSolution();
+
+    bool getBlockingBound( unsigned variable, double rate, double &bound ) const;
+    bool canIncrease( unsigned variable ) const;
+    bool canDecrease( unsigned variable ) const;
+    bool timeLimitReached() const;
+    double internalCutoff() const;
+    double toUserSense( double value ) const;
+};
+
+#endif // __NativeLPSolver_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -24,6 +24,7 @@
 #include "PiecewiseLinearFunctionType.h"
 #include "Queue.h"
 #include "Tightening.h"
+#include "VariableValueMap.h"
 
 class Equation;
 class IConstraintBoundTightener;
@@ -262,9 +263,25 @@ public:
 
 protected:
     bool _constraintActive;
-	Map<unsigned, double> _assignment;
-    Map<unsigned, double> _lowerBounds;
-    Map<unsigned, double> _upperBounds;
+
+    /*
+      Give a participating variable a fixed slot in the assignment and
+      bound maps. For constraints with a fixed set of participants.
+    */
+    void addFixedSlot( unsigned variable )
+    {
+        _assignment.addFixedSlot( variable );
+        _lowerBounds.addFixedSlot( variable );
+        _upperBounds.addFixedSlot( variable );
+    }
+
+    /*
+      The current assignment and bounds of the participating
+      variables, as reported by the tableau.
+    */
+    VariableValueMap _assignment;
+    VariableValueMap _lowerBounds;
+    VariableValueMap _upperBounds;
 
     /*
       The score denotes priority for splitting. When score is negative, the PL constraint
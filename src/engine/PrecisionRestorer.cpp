@@ -22,7 +22,7 @@
 
 void PrecisionRestorer::storeInitialEngineState( const IEngine &engine )
 {
-    engine.storeState( _initialEngineState, true );
+    engine.storeState( _initialEngineState, TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE );
 }
 
 void PrecisionRestorer::restorePrecision( IEngine &engine,
@@ -44,19 +44,15 @@ void PrecisionRestorer::restorePrecision( IEngine &engine,
     try
     {
         EngineState targetEngineState;
-        engine.storeState( targetEngineState, false );
-
-        // Store the case splits performed so far
-        List<PiecewiseLinearCaseSplit> targetSplits;
-        smtCore.allSplitsSoFar( targetSplits );
+        engine.storeState( targetEngineState, TableauStateStorageLevel::STORE_NONE );
 
         // Restore engine and tableau to their original form
         engine.restoreState( _initialEngineState );
 
-        // Re-add all splits, which will restore variables and equations
-        for ( const auto &split : targetSplits )
-            engine.applySplit( split );
-        
+        // Re-add all splits, which will restore variables and equations.
+        // Stack states that are bound trail marks are re-anchored along the way.
+        smtCore.replaySplits();
+
         // At this point, the tableau has the appropriate dimensions. Restore the variable bounds
         // and basic variables.
         // Note that if column merging is enabled, the dimensions may not be precisely those before
@@ -134,7 +130,7 @@ void PrecisionRestorer::restorePrecision( IEngine &engine,
                 }
 
                 EngineState currentEngineState;
-                engine.storeState( currentEngineState, false );
+                engine.storeState( currentEngineState, TableauStateStorageLevel::STORE_NONE );
 
                 ASSERT( currentEngineState._numPlConstraintsDisabledByValidSplits ==
                         targetEngineState._numPlConstraintsDisabledByValidSplits );
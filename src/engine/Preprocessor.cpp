@@ -30,12 +30,16 @@
 
 Preprocessor::Preprocessor()
     : _statistics( NULL )
+    , _equationsRewritten( false )
 {
 }
 
 InputQuery Preprocessor::preprocess( const InputQuery &query, bool attemptVariableElimination )
 {
     _preprocessed = query;
+    _propagatedLowerBounds.clear();
+    _propagatedUpperBounds.clear();
+    _equationsRewritten = false;
 
     /*
       Next, make sure all equations are of type EQUALITY. If not, turn them
@@ -148,261 +152,370 @@ void Preprocessor::makeAllEquationsEqualities()
 
 bool Preprocessor::processEquations()
 {
-    enum {
-        ZERO = 0,
-        POSITIVE = 1,
-        NEGATIVE = 2,
-        INFINITE = 3,
-    };
+    initializeEquationPropagation();
+
+    unsigned numVariables = _preprocessed.getNumberOfVariables();
+    unsigned numEquations = _equationsByIndex.size();
+
+    /*
+      Queue the equations that need to be examined: all of them on the
+      first call or after identical variables have been merged, and
+      otherwise only those over variables whose bounds have changed
+      since the previous call (e.g., by the piecewise linear
+      constraints).
+    */
+    if ( _propagatedLowerBounds.size() != numVariables || _equationsRewritten )
+    {
+        for ( unsigned i = 0; i < numEquations; ++i )
+            enqueueEquation( i );
+    }
+    else
+    {
+        for ( unsigned variable = 0; variable < numVariables; ++variable )
+        {
+            if ( _lowerBounds[variable] == _propagatedLowerBounds[variable] &&
+                 _upperBounds[variable] == _propagatedUpperBounds[variable] )
+                continue;
+
+            for ( unsigned entry = _firstEntryOfVariable[variable];
+                  entry < _firstEntryOfVariable[variable + 1];
+                  ++entry )
+                enqueueEquation( _equationOfEntry[entry] );
+        }
+    }
 
     bool tighterBoundFound = false;
+    while ( !_equationQueue.empty() )
+    {
+        unsigned equation = _equationQueue.front();
+        _equationQueue.popFront();
 
+        // The equation stays marked as queued while it is processed, so
+        // that its own tightenings do not put it back into the queue
+        if ( !_equationRemoved[equation] )
+            tighterBoundFound = tightenBoundsUsingEquation( equation ) || tighterBoundFound;
+
+        _equationQueued[equation] = false;
+    }
+
+    // Remove the equations that have nothing left to contribute
     List<Equation> &equations( _preprocessed.getEquations() );
-    List<Equation>::iterator equation = equations.begin();
+    List<Equation>::iterator it = equations.begin();
+    for ( unsigned i = 0; i < numEquations; ++i )
+    {
+        if ( _equationRemoved[i] )
+            it = equations.erase( it );
+        else
+            ++it;
+    }
 
-    while ( equation != equations.end() )
+    // Store the new bounds
+    for ( unsigned variable = 0; variable < numVariables; ++variable )
     {
-        // The equation is of the form sum (ci * xi) - b ? 0
-        Equation::EquationType type = equation->_type;
+        if ( _lowerBounds[variable] != _preprocessed.getLowerBound( variable ) )
+            _preprocessed.setLowerBound( variable, _lowerBounds[variable] );
+        if ( _upperBounds[variable] != _preprocessed.getUpperBound( variable ) )
+            _preprocessed.setUpperBound( variable, _upperBounds[variable] );
+    }
 
-        unsigned maxVar = equation->_addends.begin()->_variable;
-        for ( const auto &addend : equation->_addends )
-        {
-            if ( addend._variable > maxVar )
-                maxVar = addend._variable;
-        }
+    _propagatedLowerBounds = _lowerBounds;
+    _propagatedUpperBounds = _upperBounds;
+    _equationsRewritten = false;
+
+    return tighterBoundFound;
+}
 
-        ++maxVar;
+void Preprocessor::initializeEquationPropagation()
+{
+    unsigned numVariables = _preprocessed.getNumberOfVariables();
 
-        double *ciTimesLb = new double[maxVar];
-        double *ciTimesUb = new double[maxVar];
-        char *ciSign = new char[maxVar];
+    _lowerBounds = Vector<double>( numVariables );
+    _upperBounds = Vector<double>( numVariables );
+    for ( unsigned variable = 0; variable < numVariables; ++variable )
+    {
+        _lowerBounds[variable] = _preprocessed.getLowerBound( variable );
+        _upperBounds[variable] = _preprocessed.getUpperBound( variable );
+    }
 
-        Set<unsigned> excludedFromLB;
-        Set<unsigned> excludedFromUB;
+    _equationsByIndex.clear();
+    for ( auto &equation : _preprocessed.getEquations() )
+        _equationsByIndex.append( &equation );
 
-        unsigned xi;
-        double xiLB;
-        double xiUB;
-        double ci;
-        double lowerBound;
-        double upperBound;
-        bool validLb;
-        bool validUb;
+    unsigned numEquations = _equationsByIndex.size();
 
-        // The first goal is to compute the LB and UB of: sum (ci * xi) - b
-        // For this we first identify unbounded variables
-        double auxLb = -equation->_scalar;
-        double auxUb = -equation->_scalar;
+    // Count the entries of each variable, then fill them in
+    _firstEntryOfVariable = Vector<unsigned>( numVariables + 1, 0 );
+    for ( const auto &equation : _equationsByIndex )
+    {
         for ( const auto &addend : equation->_addends )
         {
-            ci = addend._coefficient;
-            xi = addend._variable;
-
-            if ( FloatUtils::isZero( ci ) )
-            {
-                ciSign[xi] = ZERO;
-                ciTimesLb[xi] = 0;
-                ciTimesUb[xi] = 0;
-                continue;
-            }
+            if ( !FloatUtils::isZero( addend._coefficient ) )
+                ++_firstEntryOfVariable[addend._variable + 1];
+        }
+    }
 
-            ciSign[xi] = ci > 0 ? POSITIVE : NEGATIVE;
+    for ( unsigned variable = 0; variable < numVariables; ++variable )
+        _firstEntryOfVariable[variable + 1] += _firstEntryOfVariable[variable];
 
-            xiLB = _preprocessed.getLowerBound( xi );
-            xiUB = _preprocessed.getUpperBound( xi );
+    unsigned numEntries = _firstEntryOfVariable[numVariables];
+    _equationOfEntry = Vector<unsigned>( numEntries );
+    _coefficientOfEntry = Vector<double>( numEntries );
 
-            if ( FloatUtils::isFinite( xiLB ) )
-            {
-                ciTimesLb[xi] = ci * xiLB;
-                if ( ciSign[xi] == POSITIVE )
-                    auxLb += ciTimesLb[xi];
-                else
-                    auxUb += ciTimesLb[xi];
-            }
-            else
-            {
-                if ( ci > 0 )
-                    excludedFromLB.insert( xi );
-                else
-                    excludedFromUB.insert( xi );
-            }
+    Vector<unsigned> nextEntry = _firstEntryOfVariable;
+    for ( unsigned i = 0; i < numEquations; ++i )
+    {
+        for ( const auto &addend : _equationsByIndex[i]->_addends )
+        {
+            if ( FloatUtils::isZero( addend._coefficient ) )
+                continue;
 
-            if ( FloatUtils::isFinite( xiUB ) )
-            {
-                ciTimesUb[xi] = ci * xiUB;
-                if ( ciSign[xi] == POSITIVE )
-                    auxUb += ciTimesUb[xi];
-                else
-                    auxLb += ciTimesUb[xi];
-            }
-            else
-            {
-                if ( ci > 0 )
-                    excludedFromUB.insert( xi );
-                else
-                    excludedFromLB.insert( xi );
-            }
+            unsigned entry = nextEntry[addend._variable]++;
+            _equationOfEntry[entry] = i;
+            _coefficientOfEntry[entry] = addend._coefficient;
         }
+    }
 
-        // Now, go over each addend in sum (ci * xi) - b ? 0, and see what can be done
-        for ( const auto &addend : equation->_addends )
-        {
-            ci = addend._coefficient;
-            xi = addend._variable;
+    _minActivity = Vector<double>( numEquations, 0 );
+    _maxActivity = Vector<double>( numEquations, 0 );
+    _minActivityNumInfinite = Vector<unsigned>( numEquations, 0 );
+    _maxActivityNumInfinite = Vector<unsigned>( numEquations, 0 );
+    for ( unsigned i = 0; i < numEquations; ++i )
+        computeActivity( i );
 
-            // If ci = 0, nothing to do.
-            if ( ciSign[xi] == ZERO )
-                continue;
+    _equationQueued = Vector<char>( numEquations, false );
+    _equationRemoved = Vector<char>( numEquations, false );
+    _equationQueue.clear();
+}
 
-            /*
-              The expression for xi is:
+void Preprocessor::computeActivity( unsigned equation )
+{
+    double minActivity = 0;
+    double maxActivity = 0;
+    unsigned minActivityNumInfinite = 0;
+    unsigned maxActivityNumInfinite = 0;
 
-                   xi ? ( -1/ci ) * ( sum_{j\neqi} ( cj * xj ) - b )
+    for ( const auto &addend : _equationsByIndex[equation]->_addends )
+    {
+        double ci = addend._coefficient;
+        if ( FloatUtils::isZero( ci ) )
+            continue;
 
-              We use the previously computed auxLb and auxUb and adjust them because
-              xi is removed from the sum. We also need to pay attention to the sign of ci,
-              and to the presence of infinite bounds.
+        // A positive coefficient takes the smallest value at the lower
+        // bound, and a negative one at the upper bound
+        double boundForMin = ci > 0 ? _lowerBounds[addend._variable] : _upperBounds[addend._variable];
+        double boundForMax = ci > 0 ? _upperBounds[addend._variable] : _lowerBounds[addend._variable];
 
-              Assuming "?" stands for equality, we can compute a LB if:
-                1. ci is negative, and no vars except xi were excluded from the auxLb
-                2. ci is positive, and no vars except xi were excluded from the auxUb
+        if ( FloatUtils::isFinite( boundForMin ) )
+            minActivity += ci * boundForMin;
+        else
+            ++minActivityNumInfinite;
 
-              And vice-versa for UB.
+        if ( FloatUtils::isFinite( boundForMax ) )
+            maxActivity += ci * boundForMax;
+        else
+            ++maxActivityNumInfinite;
+    }
 
-              In case "?" is GE or LE, only one direction can be computed.
-            */
-            if ( ciSign[xi] == NEGATIVE )
-            {
-                validLb =
-                    ( ( type == Equation::LE ) || ( type == Equation::EQ ) )
-                    &&
-                    ( excludedFromLB.empty() ||
-                      ( excludedFromLB.size() == 1 && excludedFromLB.exists( xi ) ) );
-                validUb =
-                    ( ( type == Equation::GE ) || ( type == Equation::EQ ) )
-                    &&
-                    ( excludedFromUB.empty() ||
-                      ( excludedFromUB.size() == 1 && excludedFromUB.exists( xi ) ) );
-            }
-            else
-            {
-                validLb =
-                    ( ( type == Equation::GE ) || ( type == Equation::EQ ) )
-                    &&
-                    ( excludedFromUB.empty() ||
-                      ( excludedFromUB.size() == 1 && excludedFromUB.exists( xi ) ) );
-                validUb =
-                    ( ( type == Equation::LE ) || ( type == Equation::EQ ) )
-                    &&
-                    ( excludedFromLB.empty() ||
-                      ( excludedFromLB.size() == 1 && excludedFromLB.exists( xi ) ) );
-            }
+    _minActivity[equation] = minActivity;
+    _maxActivity[equation] = maxActivity;
+    _minActivityNumInfinite[equation] = minActivityNumInfinite;
+    _maxActivityNumInfinite[equation] = maxActivityNumInfinite;
+}
 
-            // Now compute the actual bounds and see if they are tighter
-            if ( validLb )
-            {
-                if ( ciSign[xi] == NEGATIVE )
-                {
-                    lowerBound = auxLb;
-                    if ( !excludedFromLB.exists( xi ) )
-                        lowerBound -= ciTimesUb[xi];
-                }
-                else
-                {
-                    lowerBound = auxUb;
-                    if ( !excludedFromUB.exists( xi ) )
-                        lowerBound -= ciTimesUb[xi];
-                }
-
-                lowerBound /= -ci;
-
-                if ( FloatUtils::gt( lowerBound, _preprocessed.getLowerBound( xi ) ) )
-                {
-                    tighterBoundFound = true;
-                    _preprocessed.setLowerBound( xi, lowerBound );
-                }
-            }
+bool Preprocessor::tightenBoundsUsingEquation( unsigned index )
+{
+    const Equation &equation( *_equationsByIndex[index] );
 
-            if ( validUb )
-            {
-                if ( ciSign[xi] == NEGATIVE )
-                {
-                    upperBound = auxUb;
-                    if ( !excludedFromUB.exists( xi ) )
-                        upperBound -= ciTimesLb[xi];
-                }
-                else
-                {
-                    upperBound = auxLb;
-                    if ( !excludedFromLB.exists( xi ) )
-                        upperBound -= ciTimesLb[xi];
-                }
-
-                upperBound /= -ci;
-
-                if ( FloatUtils::lt( upperBound, _preprocessed.getUpperBound( xi ) ) )
-                {
-                    tighterBoundFound = true;
-                    _preprocessed.setUpperBound( xi, upperBound );
-                }
-            }
+    // The equation is of the form sum (ci * xi) ? b
+    Equation::EquationType type = equation._type;
+    double b = equation._scalar;
 
-            if ( FloatUtils::gt( _preprocessed.getLowerBound( xi ),
-                                 _preprocessed.getUpperBound( xi ),
-                                 GlobalConfiguration::PREPROCESSOR_ALMOST_FIXED_THRESHOLD ) )
-            {
-                delete[] ciTimesLb;
-                delete[] ciTimesUb;
-                delete[] ciSign;
+    bool tighterBoundFound = false;
 
-                throw InfeasibleQueryException();
-            }
-        }
+    for ( const auto &addend : equation._addends )
+    {
+        double ci = addend._coefficient;
+        unsigned xi = addend._variable;
 
-        delete[] ciTimesLb;
-        delete[] ciTimesUb;
-        delete[] ciSign;
+        if ( FloatUtils::isZero( ci ) )
+            continue;
 
         /*
-          Next, do another sweep over the equation.
-          Look for almost-fixed variables and fix them, and remove the equation
-          entirely if it has nothing left to contribute.
+          The expression for xi is:
+
+               ci * xi ? b - sum_{j\neqi} ( cj * xj )
+
+          We compute the smallest and largest values of the sum over
+          j != i by taking the contribution of xi out of the cached
+          activities. If "?" is LE, only the smallest value of the sum
+          is useful (it gives an upper bound on ci * xi), and if it is
+          GE only the largest value is; for equality, both are.
         */
-        bool allFixed = true;
-        for ( const auto &addend : equation->_addends )
+        double boundForMin = ci > 0 ? _lowerBounds[xi] : _upperBounds[xi];
+        double boundForMax = ci > 0 ? _upperBounds[xi] : _lowerBounds[xi];
+
+        double restMin = _minActivity[index];
+        unsigned restMinNumInfinite = _minActivityNumInfinite[index];
+        if ( FloatUtils::isFinite( boundForMin ) )
+            restMin -= ci * boundForMin;
+        else
+            --restMinNumInfinite;
+
+        double restMax = _maxActivity[index];
+        unsigned restMaxNumInfinite = _maxActivityNumInfinite[index];
+        if ( FloatUtils::isFinite( boundForMax ) )
+            restMax -= ci * boundForMax;
+        else
+            --restMaxNumInfinite;
+
+        double lowerBound = FloatUtils::negativeInfinity();
+        double upperBound = FloatUtils::infinity();
+
+        if ( type != Equation::GE && restMinNumInfinite == 0 )
         {
-            unsigned var = addend._variable;
-            double lb = _preprocessed.getLowerBound( var );
-            double ub = _preprocessed.getUpperBound( var );
+            // ci * xi <= b - restMin
+            if ( ci > 0 )
+                upperBound = ( b - restMin ) / ci;
+            else
+                lowerBound = ( b - restMin ) / ci;
+        }
 
-            if ( FloatUtils::areEqual( lb, ub, GlobalConfiguration::PREPROCESSOR_ALMOST_FIXED_THRESHOLD ) )
-                _preprocessed.setUpperBound( var, _preprocessed.getLowerBound( var ) );
+        if ( type != Equation::LE && restMaxNumInfinite == 0 )
+        {
+            // ci * xi >= b - restMax
+            if ( ci > 0 )
+                lowerBound = ( b - restMax ) / ci;
             else
-                allFixed = false;
+                upperBound = ( b - restMax ) / ci;
         }
 
-        if ( !allFixed )
+        if ( FloatUtils::gt( lowerBound, _lowerBounds[xi] ) )
         {
-            ++equation;
+            tighterBoundFound = true;
+            setPropagatedLowerBound( xi, lowerBound );
         }
-        else
+
+        if ( FloatUtils::lt( upperBound, _upperBounds[xi] ) )
         {
-            double sum = 0;
-            for ( const auto &addend : equation->_addends )
-                sum += addend._coefficient * _preprocessed.getLowerBound( addend._variable );
+            tighterBoundFound = true;
+            setPropagatedUpperBound( xi, upperBound );
+        }
 
-            if ( FloatUtils::areDisequal( sum, equation->_scalar, GlobalConfiguration::PREPROCESSOR_ALMOST_FIXED_THRESHOLD ) )
-            {
-                throw InfeasibleQueryException();
-            }
-            equation = equations.erase( equation );
+        if ( FloatUtils::gt( _lowerBounds[xi],
+                             _upperBounds[xi],
+                             GlobalConfiguration::PREPROCESSOR_ALMOST_FIXED_THRESHOLD ) )
+            throw InfeasibleQueryException();
+    }
+
+    /*
+      Next, do another sweep over the equation.
+      Look for almost-fixed variables and fix them, and remove the equation
+      entirely if it has nothing left to contribute.
+    */
+    bool allFixed = true;
+    for ( const auto &addend : equation._addends )
+    {
+        unsigned var = addend._variable;
+        double lb = _lowerBounds[var];
+        double ub = _upperBounds[var];
+
+        if ( FloatUtils::areEqual( lb, ub, GlobalConfiguration::PREPROCESSOR_ALMOST_FIXED_THRESHOLD ) )
+        {
+            if ( lb != ub )
+                setPropagatedUpperBound( var, lb );
         }
+        else
+            allFixed = false;
+    }
+
+    if ( allFixed )
+    {
+        double sum = 0;
+        for ( const auto &addend : equation._addends )
+            sum += addend._coefficient * _lowerBounds[addend._variable];
+
+        if ( FloatUtils::areDisequal( sum, equation._scalar, GlobalConfiguration::PREPROCESSOR_ALMOST_FIXED_THRESHOLD ) )
+        {
+            throw InfeasibleQueryException();
+        }
+
+        _equationRemoved[index] = true;
     }
 
     return tighterBoundFound;
 }
 
+void Preprocessor::setPropagatedLowerBound( unsigned variable, double value )
+{
+    ASSERT( FloatUtils::isFinite( value ) );
+
+    for ( unsigned entry = _firstEntryOfVariable[variable];
+          entry < _firstEntryOfVariable[variable + 1];
+          ++entry )
+    {
+        unsigned equation = _equationOfEntry[entry];
+        double coefficient = _coefficientOfEntry[entry];
+
+        if ( coefficient > 0 )
+            updateActivity( _minActivity[equation], _minActivityNumInfinite[equation],
+                            coefficient, _lowerBounds[variable], value );
+        else
+            updateActivity( _maxActivity[equation], _maxActivityNumInfinite[equation],
+                            coefficient, _lowerBounds[variable], value );
+
+        enqueueEquation( equation );
+    }
+
+    _lowerBounds[variable] = value;
+}
+
+void Preprocessor::setPropagatedUpperBound( unsigned variable, double value )
+{
+    ASSERT( FloatUtils::isFinite( value ) );
+
+    for ( unsigned entry = _firstEntryOfVariable[variable];
+          entry < _firstEntryOfVariable[variable + 1];
+          ++entry )
+    {
+        unsigned equation = _equationOfEntry[entry];
+        double coefficient = _coefficientOfEntry[entry];
+
+        if ( coefficient > 0 )
+            updateActivity( _maxActivity[equation], _maxActivityNumInfinite[equation],
+                            coefficient, _upperBounds[variable], value );
+        else
+            updateActivity( _minActivity[equation], _minActivityNumInfinite[equation],
+                            coefficient, _upperBounds[variable], value );
+
+        enqueueEquation( equation );
+    }
+
+    _upperBounds[variable] = value;
+}
+
+void Preprocessor::updateActivity( double &activity, unsigned &numInfinite,
+                                   double coefficient, double previousBound, double newBound )
+{
+    if ( FloatUtils::isFinite( previousBound ) )
+    {
+        activity += coefficient * ( newBound - previousBound );
+    }
+    else
+    {
+        --numInfinite;
+        activity += coefficient * newBound;
+    }
+}
+
+void Preprocessor::enqueueEquation( unsigned equation )
+{
+    if ( _equationQueued[equation] || _equationRemoved[equation] )
+        return;
+
+    _equationQueued[equation] = true;
+    _equationQueue.append( equation );
+}
+
 bool Preprocessor::processConstraints()
 {
     bool tighterBoundFound = false;
@@ -505,6 +618,7 @@ bool Preprocessor::processIdenticalVariables()
         _preprocessed.mergeIdenticalVariables( v1, v2 );
 
         _mergedVariables[v1] = v2;
+        _equationsRewritten = true;
     }
 
     return found;
@@ -22,6 +22,7 @@
 #include "Map.h"
 #include "PiecewiseLinearConstraint.h"
 #include "Set.h"
+#include "Vector.h"
 
 class Preprocessor
 {
@@ -66,6 +67,21 @@ private:
 	*/
 	bool processEquations();
 
+    /*
+      Helpers for processEquations(): index the equations and the
+      variables that appear in them, tighten bounds using a single
+      equation, and update the cached activities of the equations
+      when a bound changes.
+    */
+    void initializeEquationPropagation();
+    void computeActivity( unsigned equation );
+    bool tightenBoundsUsingEquation( unsigned equation );
+    void setPropagatedLowerBound( unsigned variable, double value );
+    void setPropagatedUpperBound( unsigned variable, double value );
+    void updateActivity( double &activity, unsigned &numInfinite,
+                         double coefficient, double previousBound, double newBound );
+    void enqueueEquation( unsigned equation );
+
     /*
       Tighten the bounds using the piecewise linear constraints
 	*/
@@ -132,6 +148,46 @@ private:
     */
     Map<unsigned, unsigned> _oldIndexToNewIndex;
 
+    /*
+      The state of the bound propagation over the equations. The bounds
+      are kept in dense arrays, and the equations that each variable
+      appears in are stored in a flat array: the entries of variable x
+      are those between _firstEntryOfVariable[x] and
+      _firstEntryOfVariable[x + 1]. For every equation sum (ci * xi) = b
+      we cache the smallest and largest values of sum (ci * xi), split
+      into the sum of the finite contributions and the number of
+      infinite ones.
+    */
+    Vector<double> _lowerBounds;
+    Vector<double> _upperBounds;
+    Vector<Equation *> _equationsByIndex;
+    Vector<unsigned> _firstEntryOfVariable;
+    Vector<unsigned> _equationOfEntry;
+    Vector<double> _coefficientOfEntry;
+    Vector<double> _minActivity;
+    Vector<double> _maxActivity;
+    Vector<unsigned> _minActivityNumInfinite;
+    Vector<unsigned> _maxActivityNumInfinite;
+    Vector<char> _equationQueued;
+    Vector<char> _equationRemoved;
+    List<unsigned> _equationQueue;
+
+    /*
+      The bounds at the end of the previous call to processEquations().
+      Only equations over variables whose bounds have changed since
+      then need to be examined again.
+    */
+    Vector<double> _propagatedLowerBounds;
+    Vector<double> _propagatedUpperBounds;
+
+    /*
+      Whether identical variables have been merged since the previous
+      call to processEquations(). Merging rewrites equations, possibly
+      cancelling addends out, without changing any bounds, so all the
+      equations must then be examined again.
+    */
+    bool _equationsRewritten;
+
     /*
       For debugging only
     */
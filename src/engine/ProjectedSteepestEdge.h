@@ -36,7 +36,7 @@ public:
       Apply the projected steepest edge pivot selection rule.
     */
     bool select( ITableau &tableau,
-                 const List<unsigned> &candidates,
+                 const Vector<unsigned> &candidates,
                  const Set<unsigned> &excluded );
 
     /*
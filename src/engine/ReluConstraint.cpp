@@ -37,6 +37,8 @@ ReluConstraint::ReluConstraint( unsigned b, unsigned f )
     , _direction( PhaseStatus::PHASE_NOT_FIXED )
     , _haveEliminatedVariables( false )
 {
+    addFixedSlot( _b );
+    addFixedSlot( _f );
     setPhaseStatus( PhaseStatus::PHASE_NOT_FIXED );
 }
 
@@ -73,6 +75,11 @@ ReluConstraint::ReluConstraint( const String &serializedRelu )
         _auxVarInUse = true;
     }
 
+    addFixedSlot( _b );
+    addFixedSlot( _f );
+    if ( _auxVarInUse )
+        addFixedSlot( _aux );
+
     setPhaseStatus( PhaseStatus::PHASE_NOT_FIXED );
 }
 
@@ -559,23 +566,10 @@ void ReluConstraint::updateVariableIndex( unsigned oldIndex, unsigned newIndex )
             !_upperBounds.exists( newIndex ) &&
             newIndex != _b && newIndex != _f && ( !_auxVarInUse || newIndex != _aux ) );
 
-    if ( _assignment.exists( oldIndex ) )
-    {
-        _assignment[newIndex] = _assignment.get( oldIndex );
-        _assignment.erase( oldIndex );
-    }
-
-    if ( _lowerBounds.exists( oldIndex ) )
-    {
-        _lowerBounds[newIndex] = _lowerBounds.get( oldIndex );
-        _lowerBounds.erase( oldIndex );
-    }
-
-    if ( _upperBounds.exists( oldIndex ) )
-    {
-        _upperBounds[newIndex] = _upperBounds.get( oldIndex );
-        _upperBounds.erase( oldIndex );
-    }
+    // The fixed slots of the variable move along with it
+    _assignment.renameVariable( oldIndex, newIndex );
+    _lowerBounds.renameVariable( oldIndex, newIndex );
+    _upperBounds.renameVariable( oldIndex, newIndex );
 
     if ( oldIndex == _b )
         _b = newIndex;
@@ -781,6 +775,7 @@ void ReluConstraint::addAuxiliaryEquations( InputQuery &inputQuery )
 
     // We now care about the auxiliary variable, as well
     _auxVarInUse = true;
+    addFixedSlot( _aux );
 }
 
 void ReluConstraint::getCostFunctionComponent( Map<unsigned, double> &cost ) const
@@ -26,11 +26,18 @@ RowBoundTightener::RowBoundTightener( const ITableau &tableau )
     , _upperBounds( NULL )
     , _tightenedLower( NULL )
     , _tightenedUpper( NULL )
-    , _rows( NULL )
-    , _z( NULL )
-    , _ciTimesLb( NULL )
-    , _ciTimesUb( NULL )
-    , _ciSign( NULL )
+    , _rowCoefficients( NULL )
+    , _rowScalars( NULL )
+    , _basicVariables( NULL )
+    , _nonBasicVariables( NULL )
+    , _nonBasicLowerBounds( NULL )
+    , _nonBasicUpperBounds( NULL )
+    , _pivotRowCoefficients( NULL )
+    , _minContributions( NULL )
+    , _maxContributions( NULL )
+    , _panel( NULL )
+    , _transformedPanel( NULL )
+    , _rowActivitiesValid( false )
     , _statistics( NULL )
 {
 }
@@ -60,26 +67,53 @@ void RowBoundTightener::setDimensions()
 
     resetBounds();
 
-    if ( GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_TYPE ==
-         GlobalConfiguration::COMPUTE_INVERTED_BASIS_MATRIX )
-    {
-        _rows = new TableauRow *[_m];
-        for ( unsigned i = 0; i < _m; ++i )
-            _rows[i] = new TableauRow( _n - _m );
-    }
-    else if ( GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_TYPE ==
-              GlobalConfiguration::USE_IMPLICIT_INVERTED_BASIS_MATRIX )
-    {
-        _rows = new TableauRow *[_m];
-        for ( unsigned i = 0; i < _m; ++i )
-            _rows[i] = new TableauRow( _n - _m );
+    unsigned numNonBasic = _n - _m;
+    unsigned panelSize = GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_PANEL_SIZE;
 
-        _z = new double[_m];
-    }
+    _rowCoefficients = new double[_m * numNonBasic];
+    if ( !_rowCoefficients )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::rowCoefficients" );
+
+    _rowScalars = new double[_m];
+    if ( !_rowScalars )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::rowScalars" );
+
+    _basicVariables = new unsigned[_m];
+    if ( !_basicVariables )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::basicVariables" );
+
+    _nonBasicVariables = new unsigned[numNonBasic];
+    if ( !_nonBasicVariables )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::nonBasicVariables" );
 
-    _ciTimesLb = new double[_n];
-    _ciTimesUb = new double[_n];
-    _ciSign = new char[_n];
+    _nonBasicLowerBounds = new double[numNonBasic];
+    if ( !_nonBasicLowerBounds )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::nonBasicLowerBounds" );
+
+    _nonBasicUpperBounds = new double[numNonBasic];
+    if ( !_nonBasicUpperBounds )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::nonBasicUpperBounds" );
+
+    _pivotRowCoefficients = new double[numNonBasic];
+    if ( !_pivotRowCoefficients )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::pivotRowCoefficients" );
+
+    _minContributions = new double[numNonBasic];
+    if ( !_minContributions )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::minContributions" );
+
+    _maxContributions = new double[numNonBasic];
+    if ( !_maxContributions )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::maxContributions" );
+
+    // A panel holds either full-length rows of inv(B) * A, or columns of A
+    _panel = new double[_n * panelSize];
+    if ( !_panel )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::panel" );
+
+    _transformedPanel = new double[_m * panelSize];
+    if ( !_transformedPanel )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "RowBoundTightener::transformedPanel" );
 }
 
 void RowBoundTightener::resetBounds()
@@ -92,6 +126,9 @@ void RowBoundTightener::resetBounds()
         _lowerBounds[i] = _tableau.getLowerBound( i );
         _upperBounds[i] = _tableau.getUpperBound( i );
     }
+
+    // The bounds may have become looser, so the row activities are stale
+    _rowActivitiesValid = false;
 }
 
 void RowBoundTightener::clear()
@@ -104,6 +141,9 @@ void RowBoundTightener::clear()
         _lowerBounds[i] = _tableau.getLowerBound( i );
         _upperBounds[i] = _tableau.getUpperBound( i );
     }
+
+    // The bounds may have become looser, so the row activities are stale
+    _rowActivitiesValid = false;
 }
 
 RowBoundTightener::~RowBoundTightener()
@@ -137,86 +177,84 @@ void RowBoundTightener::freeMemoryIfNeeded()
         _tightenedUpper = NULL;
     }
 
-    if ( _rows )
+    if ( _rowCoefficients )
     {
-        for ( unsigned i = 0; i < _m; ++i )
-            delete _rows[i];
-        delete[] _rows;
-        _rows = NULL;
+        delete[] _rowCoefficients;
+        _rowCoefficients = NULL;
     }
 
-    if ( _z )
+    if ( _rowScalars )
     {
-        delete[] _z;
-        _z = NULL;
+        delete[] _rowScalars;
+        _rowScalars = NULL;
     }
 
-    if ( _ciTimesLb )
+    if ( _basicVariables )
     {
-        delete[] _ciTimesLb;
-        _ciTimesLb = NULL;
+        delete[] _basicVariables;
+        _basicVariables = NULL;
     }
 
-    if ( _ciTimesUb )
+    if ( _nonBasicVariables )
     {
-        delete[] _ciTimesUb;
-        _ciTimesUb = NULL;
+        delete[] _nonBasicVariables;
+        _nonBasicVariables = NULL;
     }
 
-    if ( _ciSign )
+    if ( _nonBasicLowerBounds )
     {
-        delete[] _ciSign;
-        _ciSign = NULL;
+        delete[] _nonBasicLowerBounds;
+        _nonBasicLowerBounds = NULL;
     }
-}
 
-void RowBoundTightener::examineImplicitInvertedBasisMatrix( bool untilSaturation )
-{
-    /*
-      Roughly (the dimensions don't add up):
+    if ( _nonBasicUpperBounds )
+    {
+        delete[] _nonBasicUpperBounds;
+        _nonBasicUpperBounds = NULL;
+    }
 
-         xB = inv(B)*b - inv(B)*An
-    */
+    if ( _pivotRowCoefficients )
+    {
+        delete[] _pivotRowCoefficients;
+        _pivotRowCoefficients = NULL;
+    }
 
-    // Find z = inv(B) * b, by solving the forward transformation Bz = b
-    _tableau.forwardTransformation( _tableau.getRightHandSide(), _z );
-    for ( unsigned i = 0; i < _m; ++i )
+    if ( _minContributions )
     {
-        _rows[i]->_scalar = _z[i];
-        _rows[i]->_lhs = _tableau.basicIndexToVariable( i );
+        delete[] _minContributions;
+        _minContributions = NULL;
     }
 
-    // Now, go over the columns of the constraint martrix, perform an FTRAN
-    // for each of them, and populate the rows.
-    for ( unsigned i = 0; i < _n - _m; ++i )
+    if ( _maxContributions )
     {
-        unsigned nonBasic = _tableau.nonBasicIndexToVariable( i );
-        const double *ANColumn = _tableau.getAColumn( nonBasic );
-        _tableau.forwardTransformation( ANColumn, _z );
+        delete[] _maxContributions;
+        _maxContributions = NULL;
+    }
 
-        for ( unsigned j = 0; j < _m; ++j )
-        {
-            _rows[j]->_row[i]._var = nonBasic;
-            _rows[j]->_row[i]._coefficient = -_z[j];
-        }
+    if ( _panel )
+    {
+        delete[] _panel;
+        _panel = NULL;
     }
 
-    // We now have all the rows, can use them for tightening.
-    // The tightening procedure may throw an exception, in which case we need
-    // to release the rows.
-    unsigned newBoundsLearned;
-    unsigned maxNumberOfIterations = untilSaturation ?
-        GlobalConfiguration::ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS : 1;
-    do
+    if ( _transformedPanel )
     {
-        newBoundsLearned = onePassOverInvertedBasisRows();
+        delete[] _transformedPanel;
+        _transformedPanel = NULL;
+    }
+}
 
-        if ( _statistics && ( newBoundsLearned > 0 ) )
-            _statistics->incNumTighteningsFromExplicitBasis( newBoundsLearned );
+void RowBoundTightener::examineImplicitInvertedBasisMatrix( bool untilSaturation )
+{
+    /*
+      Roughly (the dimensions don't add up):
 
-        --maxNumberOfIterations;
-    }
-    while ( ( maxNumberOfIterations != 0 ) && ( newBoundsLearned > 0 ) );
+         xB = inv(B)*b - inv(B)*An
+    */
+    computeImplicitInvertedBasisRows();
+
+    // We now have all the rows, can use them for tightening.
+    tightenOnInvertedBasisRows( untilSaturation );
 }
 
 void RowBoundTightener::examineInvertedBasisMatrix( bool untilSaturation )
@@ -225,80 +263,182 @@ void RowBoundTightener::examineInvertedBasisMatrix( bool untilSaturation )
       Roughly (the dimensions don't add up):
 
          xB = inv(B)*b - inv(B)*An
-
-      We compute one row at a time.
     */
 
-    const double *b = _tableau.getRightHandSide();
     const double *invB = _tableau.getInverseBasisMatrix();
 
     try
     {
+        computeInvertedBasisRows( invB );
+
+        // We now have all the rows, can use them for tightening.
+        // The tightening procedure may throw an exception, in which case we need
+        // to release the inverted basis.
+        tightenOnInvertedBasisRows( untilSaturation );
+    }
+    catch ( ... )
+    {
+        delete[] invB;
+        throw;
+    }
+
+    delete[] invB;
+}
+
+void RowBoundTightener::computeImplicitInvertedBasisRows()
+{
+    unsigned numNonBasic = _n - _m;
+    unsigned panelSize = GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_PANEL_SIZE;
+
+    // Find z = inv(B) * b, by solving the forward transformation Bz = b
+    _tableau.forwardTransformation( _tableau.getRightHandSide(), _rowScalars );
+    for ( unsigned i = 0; i < _m; ++i )
+        _basicVariables[i] = _tableau.basicIndexToVariable( i );
+
+    for ( unsigned j = 0; j < numNonBasic; ++j )
+        _nonBasicVariables[j] = _tableau.nonBasicIndexToVariable( j );
+
+    /*
+      Now, go over the columns of An in panels. The columns of a panel
+      are transformed together, and then copied into the rows: each
+      row receives a contiguous block of coefficients.
+    */
+    for ( unsigned firstColumn = 0; firstColumn < numNonBasic; firstColumn += panelSize )
+    {
+        unsigned width = std::min( panelSize, numNonBasic - firstColumn );
+
+        std::fill_n( _panel, _m * width, 0 );
+        for ( unsigned r = 0; r < width; ++r )
+        {
+            const SparseUnsortedList *column =
+                _tableau.getSparseAColumn( _nonBasicVariables[firstColumn + r] );
+            for ( const auto &entry : *column )
+                _panel[entry._index * width + r] = entry._value;
+        }
+
+        _tableau.forwardTransformation( _panel, _transformedPanel, width );
+
         for ( unsigned i = 0; i < _m; ++i )
         {
-            TableauRow *row = _rows[i];
-            // First, compute the scalar, using inv(B)*b
-            row->_scalar = 0;
-            for ( unsigned j = 0; j < _m; ++j )
-                row->_scalar += ( invB[i * _m + j] * b[j] );
-
-            // Now update the row's coefficients for basic variable i
-            for ( unsigned j = 0; j < _n - _m; ++j )
-            {
-                row->_row[j]._var = _tableau.nonBasicIndexToVariable( j );
+            double *coefficients = _rowCoefficients + i * numNonBasic + firstColumn;
+            const double *transformed = _transformedPanel + i * width;
 
-                // Dot product of the i'th row of inv(B) with the appropriate
-                // column of An
+            for ( unsigned r = 0; r < width; ++r )
+                coefficients[r] = -transformed[r];
+        }
+    }
+}
 
-                const SparseUnsortedList *column = _tableau.getSparseAColumn( row->_row[j]._var );
-                row->_row[j]._coefficient = 0;
+void RowBoundTightener::computeInvertedBasisRows( const double *invB )
+{
+    unsigned numNonBasic = _n - _m;
+    unsigned panelSize = GlobalConfiguration::EXPLICIT_BASIS_BOUND_TIGHTENING_PANEL_SIZE;
 
-                for ( const auto &entry : *column )
-                    row->_row[j]._coefficient -= invB[i*_m + entry._index] * entry._value;
-            }
+    const double *b = _tableau.getRightHandSide();
 
-            // Store the lhs variable
-            row->_lhs = _tableau.basicIndexToVariable( i );
-        }
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        // First, compute the scalar, using inv(B)*b
+        _rowScalars[i] = 0;
+        for ( unsigned j = 0; j < _m; ++j )
+            _rowScalars[i] += ( invB[i * _m + j] * b[j] );
 
-        // We now have all the rows, can use them for tightening.
-        // The tightening procedure may throw an exception, in which case we need
-        // to release the rows.
+        // Store the lhs variable
+        _basicVariables[i] = _tableau.basicIndexToVariable( i );
+    }
+
+    for ( unsigned j = 0; j < numNonBasic; ++j )
+        _nonBasicVariables[j] = _tableau.nonBasicIndexToVariable( j );
 
-        unsigned newBoundsLearned;
-        unsigned maxNumberOfIterations = untilSaturation ?
-            GlobalConfiguration::ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS : 1;
-        do
+    /*
+      Compute the rows of -inv(B) * A over all n columns, in panels of
+      rows. Each row of A is read once per panel, and its entries are
+      applied to all the rows of the panel together (the panel stores
+      entry j of row r at j * width + r). The columns of the
+      non-basic variables are then extracted.
+    */
+    double *factors = _transformedPanel;
+
+    for ( unsigned firstRow = 0; firstRow < _m; firstRow += panelSize )
+    {
+        unsigned width = std::min( panelSize, _m - firstRow );
+
+        std::fill_n( _panel, _n * width, 0 );
+        for ( unsigned k = 0; k < _m; ++k )
         {
-            newBoundsLearned = onePassOverInvertedBasisRows();
+            bool allZero = true;
+            for ( unsigned r = 0; r < width; ++r )
+            {
+                factors[r] = invB[( firstRow + r ) * _m + k];
+                if ( factors[r] != 0.0 )
+                    allZero = false;
+            }
 
-            if ( _statistics && ( newBoundsLearned > 0 ) )
-                _statistics->incNumTighteningsFromExplicitBasis( newBoundsLearned );
+            if ( allZero )
+                continue;
 
-            --maxNumberOfIterations;
+            const SparseUnsortedList *row = _tableau.getSparseARow( k );
+            for ( const auto &entry : *row )
+            {
+                double *target = _panel + entry._index * width;
+                double value = entry._value;
+
+                for ( unsigned r = 0; r < width; ++r )
+                    target[r] -= factors[r] * value;
+            }
+        }
+
+        for ( unsigned j = 0; j < numNonBasic; ++j )
+        {
+            const double *source = _panel + _nonBasicVariables[j] * width;
+            for ( unsigned r = 0; r < width; ++r )
+                _rowCoefficients[( firstRow + r ) * numNonBasic + j] = source[r];
         }
-        while ( ( maxNumberOfIterations != 0 ) && ( newBoundsLearned > 0 ) );
     }
-    catch ( ... )
+}
+
+void RowBoundTightener::tightenOnInvertedBasisRows( bool untilSaturation )
+{
+    unsigned newBoundsLearned;
+    unsigned maxNumberOfIterations = untilSaturation ?
+        GlobalConfiguration::ROW_BOUND_TIGHTENER_SATURATION_ITERATIONS : 1;
+    do
     {
-        delete[] invB;
-        throw;
-    }
+        newBoundsLearned = onePassOverInvertedBasisRows();
 
-    delete[] invB;
+        if ( _statistics && ( newBoundsLearned > 0 ) )
+            _statistics->incNumTighteningsFromExplicitBasis( newBoundsLearned );
+
+        --maxNumberOfIterations;
+    }
+    while ( ( maxNumberOfIterations != 0 ) && ( newBoundsLearned > 0 ) );
 }
 
 unsigned RowBoundTightener::onePassOverInvertedBasisRows()
 {
     unsigned newBounds = 0;
+    unsigned numNonBasic = _n - _m;
+
+    collectNonBasicBounds();
 
     for ( unsigned i = 0; i < _m; ++i )
-        newBounds += tightenOnSingleInvertedBasisRow( *( _rows[i] ) );
+        newBounds += tightenOnSingleInvertedBasisRow( _basicVariables[i],
+                                                      _rowScalars[i],
+                                                      _rowCoefficients + i * numNonBasic );
 
     return newBounds;
 }
 
-unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &row )
+void RowBoundTightener::collectNonBasicBounds()
+{
+    for ( unsigned i = 0; i < _n - _m; ++i )
+    {
+        _nonBasicLowerBounds[i] = _lowerBounds[_nonBasicVariables[i]];
+        _nonBasicUpperBounds[i] = _upperBounds[_nonBasicVariables[i]];
+    }
+}
+
+unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( unsigned y, double scalar, const double *coefficients )
 {
 	/*
       A row is of the form
@@ -307,69 +447,49 @@ unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &r
 
       We wish to tighten once for y, but also once for every x.
     */
-    unsigned n = _tableau.getN();
-    unsigned m = _tableau.getM();
+    unsigned numNonBasic = _n - _m;
 
     unsigned result = 0;
 
-    // Compute ci * lb, ci * ub, flag signs for all entries
-    enum {
-        ZERO = 0,
-        POSITIVE = 1,
-        NEGATIVE = 2,
-    };
-
-    for ( unsigned i = 0; i < n - m; ++i )
+    /*
+      Compute the smallest and largest values of each ci * xi. Entries
+      with a zero coefficient contribute nothing, even if the bounds of
+      xi are infinite. The loop has no branches, so that the compiler
+      can vectorize it.
+    */
+    for ( unsigned i = 0; i < numNonBasic; ++i )
     {
-        double ci = row[i];
-
-        if ( FloatUtils::isZero( ci ) )
-        {
-            _ciSign[i] = ZERO;
-            _ciTimesLb[i] = 0;
-            _ciTimesUb[i] = 0;
-            continue;
-        }
+        double ci = coefficients[i];
+        double ciTimesLb = ci * _nonBasicLowerBounds[i];
+        double ciTimesUb = ci * _nonBasicUpperBounds[i];
 
-        _ciSign[i] = FloatUtils::isPositive( ci ) ? POSITIVE : NEGATIVE;
+        bool zero = FloatUtils::isZero( ci );
+        bool positive = ci > 0;
 
-        unsigned xi = row._row[i]._var;
-        _ciTimesLb[i] = ci * _lowerBounds[xi];
-        _ciTimesUb[i] = ci * _upperBounds[xi];
+        _minContributions[i] = zero ? 0 : ( positive ? ciTimesLb : ciTimesUb );
+        _maxContributions[i] = zero ? 0 : ( positive ? ciTimesUb : ciTimesLb );
     }
 
     // Start with a pass for y
-    unsigned y = row._lhs;
-    double upperBound = row._scalar;
-    double lowerBound = row._scalar;
-
-    unsigned xi;
-    double ci;
+    double upperBound = scalar;
+    double lowerBound = scalar;
 
-    for ( unsigned i = 0; i < n - m; ++i )
+    for ( unsigned i = 0; i < numNonBasic; ++i )
     {
-        if ( _ciSign[i] == POSITIVE )
-        {
-            lowerBound += _ciTimesLb[i];
-            upperBound += _ciTimesUb[i];
-        }
-        else
-        {
-            lowerBound += _ciTimesUb[i];
-            upperBound += _ciTimesLb[i];
-        }
+        lowerBound += _minContributions[i];
+        upperBound += _maxContributions[i];
     }
 
     if ( FloatUtils::lt( _lowerBounds[y], lowerBound ) )
     {
-        _lowerBounds[y] = lowerBound;
+        updateLowerBound( y, lowerBound );
         _tightenedLower[y] = true;
         ++result;
     }
 
     if ( FloatUtils::gt( _upperBounds[y], upperBound ) )
     {
-        _upperBounds[y] = upperBound;
+        updateUpperBound( y, upperBound );
         _tightenedUpper[y] = true;
         ++result;
     }
@@ -392,52 +512,34 @@ unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &r
     // Then, when we consider xi we adjust the computed lower and upper
     // boudns accordingly.
 
-    double auxLb = _lowerBounds[y] - row._scalar;
-    double auxUb = _upperBounds[y] - row._scalar;
+    double auxLb = _lowerBounds[y] - scalar;
+    double auxUb = _upperBounds[y] - scalar;
 
     // Now add ALL xi's
-    for ( unsigned i = 0; i < n - m; ++i )
+    for ( unsigned i = 0; i < numNonBasic; ++i )
     {
-        if ( _ciSign[i] == NEGATIVE )
-        {
-            auxLb -= _ciTimesLb[i];
-            auxUb -= _ciTimesUb[i];
-        }
-        else
-        {
-            auxLb -= _ciTimesUb[i];
-            auxUb -= _ciTimesLb[i];
-        }
+        auxLb -= _maxContributions[i];
+        auxUb -= _minContributions[i];
     }
 
     // Now consider each individual xi
-    for ( unsigned i = 0; i < n - m; ++i )
+    for ( unsigned i = 0; i < numNonBasic; ++i )
     {
+        double ci = coefficients[i];
+
         // If ci = 0, nothing to do.
-        if ( _ciSign[i] == ZERO )
+        if ( FloatUtils::isZero( ci ) )
             continue;
 
-        lowerBound = auxLb;
-        upperBound = auxUb;
-
         // Adjust the aux bounds to remove xi
-        if ( _ciSign[i] == NEGATIVE )
-        {
-            lowerBound += _ciTimesLb[i];
-            upperBound += _ciTimesUb[i];
-        }
-        else
-        {
-            lowerBound += _ciTimesUb[i];
-            upperBound += _ciTimesLb[i];
-        }
+        lowerBound = auxLb + _maxContributions[i];
+        upperBound = auxUb + _minContributions[i];
 
         // Now divide everything by ci, switching signs if needed.
-        ci = row[i];
         lowerBound = lowerBound / ci;
         upperBound = upperBound / ci;
 
-        if ( _ciSign[i] == NEGATIVE )
+        if ( ci < 0 )
         {
             double temp = upperBound;
             upperBound = lowerBound;
@@ -445,17 +547,19 @@ unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &r
         }
 
         // If a tighter bound is found, store it
-        xi = row._row[i]._var;
+        unsigned xi = _nonBasicVariables[i];
         if ( FloatUtils::lt( _lowerBounds[xi], lowerBound ) )
         {
-            _lowerBounds[xi] = lowerBound;
+            updateLowerBound( xi, lowerBound );
+            _nonBasicLowerBounds[i] = lowerBound;
             _tightenedLower[xi] = true;
             ++result;
         }
 
         if ( FloatUtils::gt( _upperBounds[xi], upperBound ) )
         {
-            _upperBounds[xi] = upperBound;
+            updateUpperBound( xi, upperBound );
+            _nonBasicUpperBounds[i] = upperBound;
             _tightenedUpper[xi] = true;
             ++result;
         }
@@ -469,10 +573,13 @@ unsigned RowBoundTightener::tightenOnSingleInvertedBasisRow( const TableauRow &r
 
 void RowBoundTightener::examineConstraintMatrix( bool untilSaturation )
 {
+    if ( !_rowActivitiesValid )
+        initializeRowActivities();
+
     unsigned newBoundsLearned;
 
     /*
-      If working until saturation, do single passes over the matrix until no new bounds
+      If working until saturation, do passes over the queued rows until no new bounds
       are learned. Otherwise, just do a single pass.
     */
     unsigned maxNumberOfIterations = untilSaturation ?
@@ -489,143 +596,263 @@ void RowBoundTightener::examineConstraintMatrix( bool untilSaturation )
     while ( ( maxNumberOfIterations != 0 ) && ( newBoundsLearned > 0 ) );
 }
 
-unsigned RowBoundTightener::onePassOverConstraintMatrix()
+void RowBoundTightener::initializeRowActivities()
 {
-    unsigned result = 0;
+    // Copy the rows of A
+    _rowFirstEntry.clear();
+    _rowEntryVariable.clear();
+    _rowEntryCoefficient.clear();
+    _rowRightHandSide.clear();
+    _variableFirstEntry = Vector<unsigned>( _n + 1, 0 );
 
-    unsigned m = _tableau.getM();
+    const double *b = _tableau.getRightHandSide();
 
-    for ( unsigned i = 0; i < m; ++i )
-        result += tightenOnSingleConstraintRow( i );
+    for ( unsigned row = 0; row < _m; ++row )
+    {
+        _rowFirstEntry.append( _rowEntryVariable.size() );
+        _rowRightHandSide.append( b[row] );
 
-    return result;
-}
+        for ( const auto &entry : *_tableau.getSparseARow( row ) )
+        {
+            if ( FloatUtils::isZero( entry._value ) )
+                continue;
 
-unsigned RowBoundTightener::tightenOnSingleConstraintRow( unsigned row )
-{
-    /*
-      The cosntraint matrix A satisfies Ax = b.
-      Each row is of the form:
+            _rowEntryVariable.append( entry._index );
+            _rowEntryCoefficient.append( entry._value );
+            ++_variableFirstEntry[entry._index + 1];
+        }
+    }
+    _rowFirstEntry.append( _rowEntryVariable.size() );
 
-          sum ci xi - b = 0
+    // Index the rows of each variable
+    for ( unsigned i = 0; i < _n; ++i )
+        _variableFirstEntry[i + 1] += _variableFirstEntry[i];
 
-      We first compute the lower and upper bounds for the expression
+    unsigned numEntries = _rowEntryVariable.size();
+    _variableEntryRow = Vector<unsigned>( numEntries );
+    _variableEntryCoefficient = Vector<double>( numEntries );
 
-          sum ci xi - b
-    */
-    unsigned n = _tableau.getN();
+    Vector<unsigned> nextEntry = _variableFirstEntry;
+    for ( unsigned row = 0; row < _m; ++row )
+    {
+        for ( unsigned i = _rowFirstEntry[row]; i < _rowFirstEntry[row + 1]; ++i )
+        {
+            unsigned entry = nextEntry[_rowEntryVariable[i]]++;
+            _variableEntryRow[entry] = row;
+            _variableEntryCoefficient[entry] = _rowEntryCoefficient[i];
+        }
+    }
 
-    unsigned result = 0;
+    // Compute the activities
+    _rowMinActivity = Vector<double>( _m, 0 );
+    _rowMaxActivity = Vector<double>( _m, 0 );
+    _rowMinActivityNumInfinite = Vector<unsigned>( _m, 0 );
+    _rowMaxActivityNumInfinite = Vector<unsigned>( _m, 0 );
 
-    const SparseUnsortedList *sparseRow = _tableau.getSparseARow( row );
-    const double *b = _tableau.getRightHandSide();
+    for ( unsigned row = 0; row < _m; ++row )
+    {
+        for ( unsigned i = _rowFirstEntry[row]; i < _rowFirstEntry[row + 1]; ++i )
+        {
+            unsigned variable = _rowEntryVariable[i];
+            double ci = _rowEntryCoefficient[i];
 
-    double ci;
-    unsigned index;
+            double boundForMin = ci > 0 ? _lowerBounds[variable] : _upperBounds[variable];
+            double boundForMax = ci > 0 ? _upperBounds[variable] : _lowerBounds[variable];
 
-    // Compute ci * lb, ci * ub, flag signs for all entries
-    enum {
-        ZERO = 0,
-        POSITIVE = 1,
-        NEGATIVE = 2,
-    };
+            if ( FloatUtils::isFinite( boundForMin ) )
+                _rowMinActivity[row] += ci * boundForMin;
+            else
+                ++_rowMinActivityNumInfinite[row];
 
-    std::fill_n( _ciSign, n, ZERO );
-    std::fill_n( _ciTimesLb, n, 0 );
-    std::fill_n( _ciTimesUb, n, 0 );
+            if ( FloatUtils::isFinite( boundForMax ) )
+                _rowMaxActivity[row] += ci * boundForMax;
+            else
+                ++_rowMaxActivityNumInfinite[row];
+        }
+    }
 
-    for ( const auto &entry : *sparseRow )
+    // All rows need to be examined
+    _rowQueued = Vector<char>( _m, false );
+    _rowQueue.clear();
+    for ( unsigned row = 0; row < _m; ++row )
+        enqueueRow( row );
+
+    _rowActivitiesValid = true;
+}
+
+void RowBoundTightener::updateLowerBound( unsigned variable, double bound )
+{
+    if ( _rowActivitiesValid )
     {
-        index = entry._index;
-        ci = entry._value;
+        for ( unsigned entry = _variableFirstEntry[variable];
+              entry < _variableFirstEntry[variable + 1];
+              ++entry )
+        {
+            unsigned row = _variableEntryRow[entry];
+            double ci = _variableEntryCoefficient[entry];
+
+            // The lower bound gives the smallest value of ci * xi if
+            // ci is positive, and the largest one otherwise
+            if ( ci > 0 )
+                updateActivity( _rowMinActivity[row], _rowMinActivityNumInfinite[row],
+                                ci, _lowerBounds[variable], bound );
+            else
+                updateActivity( _rowMaxActivity[row], _rowMaxActivityNumInfinite[row],
+                                ci, _lowerBounds[variable], bound );
+
+            enqueueRow( row );
+        }
+    }
+
+    _lowerBounds[variable] = bound;
+}
 
-        _ciSign[index] = FloatUtils::isPositive( ci ) ? POSITIVE : NEGATIVE;
-        _ciTimesLb[index] = ci * _lowerBounds[index];
-        _ciTimesUb[index] = ci * _upperBounds[index];
+void RowBoundTightener::updateUpperBound( unsigned variable, double bound )
+{
+    if ( _rowActivitiesValid )
+    {
+        for ( unsigned entry = _variableFirstEntry[variable];
+              entry < _variableFirstEntry[variable + 1];
+              ++entry )
+        {
+            unsigned row = _variableEntryRow[entry];
+            double ci = _variableEntryCoefficient[entry];
+
+            if ( ci > 0 )
+                updateActivity( _rowMaxActivity[row], _rowMaxActivityNumInfinite[row],
+                                ci, _upperBounds[variable], bound );
+            else
+                updateActivity( _rowMinActivity[row], _rowMinActivityNumInfinite[row],
+                                ci, _upperBounds[variable], bound );
+
+            enqueueRow( row );
+        }
     }
 
-    /*
-      Do a pass for each of the rhs variables.
-      For this, we wish to logically transform the equation into:
+    _upperBounds[variable] = bound;
+}
 
-          xi = 1/ci * ( b - sum cj xj )
+void RowBoundTightener::updateActivity( double &activity, unsigned &numInfinite,
+                                        double coefficient, double previousBound, double newBound )
+{
+    // Bounds only become tighter, so an infinite bound can only be
+    // replaced by a finite one
+    if ( !FloatUtils::isFinite( newBound ) )
+        return;
 
-      And then compute the upper/lower bounds for xi.
+    if ( FloatUtils::isFinite( previousBound ) )
+    {
+        activity += coefficient * ( newBound - previousBound );
+    }
+    else
+    {
+        --numInfinite;
+        activity += coefficient * newBound;
+    }
+}
 
-      However, for efficiency, we compute the lower and upper
-      bounds of the expression:
+void RowBoundTightener::enqueueRow( unsigned row )
+{
+    if ( _rowQueued[row] )
+        return;
 
-              b - sum ci xi
+    _rowQueued[row] = true;
+    _rowQueue.push( row );
+}
 
-      Then, when we consider xi we adjust the computed lower and upper
-      boudns accordingly.
-    */
+unsigned RowBoundTightener::onePassOverConstraintMatrix()
+{
+    unsigned result = 0;
 
-    double auxLb = b[row];
-    double auxUb = b[row];
+    // Rows that are queued during the pass are left for the next one
+    unsigned numRows = _rowQueue.size();
 
-    // Now add ALL xi's
-    for ( unsigned i = 0; i < n; ++i )
+    for ( unsigned i = 0; i < numRows; ++i )
     {
-        if ( _ciSign[i] == NEGATIVE )
-        {
-            auxLb -= _ciTimesLb[i];
-            auxUb -= _ciTimesUb[i];
-        }
-        else
-        {
-            auxLb -= _ciTimesUb[i];
-            auxUb -= _ciTimesLb[i];
-        }
+        unsigned row = _rowQueue.peak();
+        _rowQueue.pop();
+
+        // The row stays marked while it is examined, so that its own
+        // tightenings do not queue it again
+        result += tightenOnSingleConstraintRow( row );
+        _rowQueued[row] = false;
     }
 
-    double lowerBound;
-    double upperBound;
+    return result;
+}
+
+unsigned RowBoundTightener::tightenOnSingleConstraintRow( unsigned row )
+{
+    /*
+      The cosntraint matrix A satisfies Ax = b.
+      Each row is of the form:
+
+          sum ci xi = b
+
+      So each xi satisfies:
 
-    // Now consider each individual xi with non zero coefficient
-    for ( const auto &entry : *sparseRow )
+          ci xi = b - sum_{j\neqi} cj xj
+
+      The smallest and largest values of the sum over j != i are
+      obtained by taking the contribution of xi out of the activities
+      of the row.
+    */
+    unsigned result = 0;
+    double b = _rowRightHandSide[row];
+
+    for ( unsigned i = _rowFirstEntry[row]; i < _rowFirstEntry[row + 1]; ++i )
     {
-        index = entry._index;
+        unsigned index = _rowEntryVariable[i];
+        double ci = _rowEntryCoefficient[i];
 
-        lowerBound = auxLb;
-        upperBound = auxUb;
+        double boundForMin = ci > 0 ? _lowerBounds[index] : _upperBounds[index];
+        double boundForMax = ci > 0 ? _upperBounds[index] : _lowerBounds[index];
 
-        // Adjust the aux bounds to remove xi
-        if ( _ciSign[index] == NEGATIVE )
-        {
-            lowerBound += _ciTimesLb[index];
-            upperBound += _ciTimesUb[index];
-        }
+        double restMin = _rowMinActivity[row];
+        unsigned restMinNumInfinite = _rowMinActivityNumInfinite[row];
+        if ( FloatUtils::isFinite( boundForMin ) )
+            restMin -= ci * boundForMin;
         else
-        {
-            lowerBound += _ciTimesUb[index];
-            upperBound += _ciTimesLb[index];
-        }
+            --restMinNumInfinite;
 
-        // Now divide everything by ci, switching signs if needed.
-        ci = entry._value;
+        double restMax = _rowMaxActivity[row];
+        unsigned restMaxNumInfinite = _rowMaxActivityNumInfinite[row];
+        if ( FloatUtils::isFinite( boundForMax ) )
+            restMax -= ci * boundForMax;
+        else
+            --restMaxNumInfinite;
 
-        lowerBound = lowerBound / ci;
-        upperBound = upperBound / ci;
+        // ci xi is between b - restMax and b - restMin
+        double lowerBound = FloatUtils::negativeInfinity();
+        double upperBound = FloatUtils::infinity();
 
-        if ( _ciSign[index] == NEGATIVE )
+        if ( restMaxNumInfinite == 0 )
         {
-            double temp = upperBound;
-            upperBound = lowerBound;
-            lowerBound = temp;
+            if ( ci > 0 )
+                lowerBound = ( b - restMax ) / ci;
+            else
+                upperBound = ( b - restMax ) / ci;
+        }
+
+        if ( restMinNumInfinite == 0 )
+        {
+            if ( ci > 0 )
+                upperBound = ( b - restMin ) / ci;
+            else
+                lowerBound = ( b - restMin ) / ci;
         }
 
         // If a tighter bound is found, store it
         if ( FloatUtils::lt( _lowerBounds[index], lowerBound ) )
         {
-            _lowerBounds[index] = lowerBound;
+            updateLowerBound( index, lowerBound );
             _tightenedLower[index] = true;
             ++result;
         }
 
         if ( FloatUtils::gt( _upperBounds[index], upperBound ) )
         {
-            _upperBounds[index] = upperBound;
+            updateUpperBound( index, upperBound );
             _tightenedUpper[index] = true;
             ++result;
         }
@@ -643,7 +870,16 @@ void RowBoundTightener::examinePivotRow()
         _statistics->incNumRowsExaminedByRowTightener();
 
     const TableauRow &row( *_tableau.getPivotRow() );
-    unsigned newBoundsLearned = tightenOnSingleInvertedBasisRow( row );
+
+    for ( unsigned i = 0; i < row._size; ++i )
+    {
+        _nonBasicVariables[i] = row._row[i]._var;
+        _pivotRowCoefficients[i] = row._row[i]._coefficient;
+    }
+    collectNonBasicBounds();
+
+    unsigned newBoundsLearned =
+        tightenOnSingleInvertedBasisRow( row._lhs, row._scalar, _pivotRowCoefficients );
 
     if ( _statistics && ( newBoundsLearned > 0 ) )
         _statistics->incNumTighteningsFromRows( newBoundsLearned );
@@ -676,7 +912,7 @@ void RowBoundTightener::notifyLowerBound( unsigned variable, double bound )
 {
     if ( FloatUtils::gt( bound, _lowerBounds[variable] ) )
     {
-        _lowerBounds[variable] = bound;
+        updateLowerBound( variable, bound );
         _tightenedLower[variable] = false;
     }
 }
@@ -685,11 +921,33 @@ void RowBoundTightener::notifyUpperBound( unsigned variable, double bound )
 {
     if ( FloatUtils::lt( bound, _upperBounds[variable] ) )
     {
-        _upperBounds[variable] = bound;
+        updateUpperBound( variable, bound );
         _tightenedUpper[variable] = false;
     }
 }
 
+void RowBoundTightener::notifyBoundChanges( const unsigned *variables, unsigned count )
+{
+    for ( unsigned i = 0; i < count; ++i )
+    {
+        unsigned variable = variables[i];
+
+        double lb = _tableau.getLowerBound( variable );
+        if ( FloatUtils::gt( lb, _lowerBounds[variable] ) )
+        {
+            updateLowerBound( variable, lb );
+            _tightenedLower[variable] = false;
+        }
+
+        double ub = _tableau.getUpperBound( variable );
+        if ( FloatUtils::lt( ub, _upperBounds[variable] ) )
+        {
+            updateUpperBound( variable, ub );
+            _tightenedUpper[variable] = false;
+        }
+    }
+}
+
 void RowBoundTightener::notifyDimensionChange( unsigned /* m */ , unsigned /* n */ )
 {
     setDimensions();
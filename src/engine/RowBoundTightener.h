@@ -22,6 +22,7 @@
 #include "Queue.h"
 #include "TableauRow.h"
 #include "Tightening.h"
+#include "Vector.h"
 
 class RowBoundTightener : public IRowBoundTightener
 {
@@ -51,6 +52,12 @@ public:
     void notifyLowerBound( unsigned variable, double bound );
     void notifyUpperBound( unsigned variable, double bound );
 
+    /*
+      Batched callback from the Tableau: catch up on the bounds of the
+      given variables.
+    */
+    void notifyBoundChanges( const unsigned *variables, unsigned count );
+
     /*
       Callback from the Tableau, to inform of a change in dimensions
     */
@@ -115,13 +122,58 @@ private:
     bool *_tightenedUpper;
 
     /*
-      Work space for the inverted basis matrix tighteners
+      Work space for the inverted basis matrix tighteners. The rows of
+      inv(B) * An are stored densely, one after the other, along with
+      their scalars and basic variables. The columns correspond to the
+      non-basic variables, whose bounds are also copied into contiguous
+      arrays, so that a row can be processed without indirection.
+    */
+    double *_rowCoefficients;
+    double *_rowScalars;
+    unsigned *_basicVariables;
+    unsigned *_nonBasicVariables;
+    double *_nonBasicLowerBounds;
+    double *_nonBasicUpperBounds;
+    double *_pivotRowCoefficients;
+
+    /*
+      The smallest and largest values of ci * xi for every entry of the
+      row being processed.
+    */
+    double *_minContributions;
+    double *_maxContributions;
+
+    /*
+      Work space for computing inv(B) * An in panels of
+      EXPLICIT_BASIS_BOUND_TIGHTENING_PANEL_SIZE rows or columns
+    */
+    double *_panel;
+    double *_transformedPanel;
+
+    /*
+      State of the constraint matrix tightener. The rows of A (and the
+      right hand side) are copied when the matrix is first examined
+      after the bounds have been reset, along with an index of the rows
+      that each variable appears in. For every row sum ci xi = b we keep
+      the smallest and largest values of sum ci xi, as the sum of the
+      finite contributions and the number of infinite ones. These are
+      updated whenever a bound is tightened, and the rows that are
+      affected are queued for examination.
     */
-    TableauRow **_rows;
-    double *_z;
-    double *_ciTimesLb;
-    double *_ciTimesUb;
-    char *_ciSign;
+    bool _rowActivitiesValid;
+    Vector<unsigned> _rowFirstEntry;
+    Vector<unsigned> _rowEntryVariable;
+    Vector<double> _rowEntryCoefficient;
+    Vector<double> _rowRightHandSide;
+    Vector<unsigned> _variableFirstEntry;
+    Vector<unsigned> _variableEntryRow;
+    Vector<double> _variableEntryCoefficient;
+    Vector<double> _rowMinActivity;
+    Vector<double> _rowMaxActivity;
+    Vector<unsigned> _rowMinActivityNumInfinite;
+    Vector<unsigned> _rowMaxActivityNumInfinite;
+    Vector<char> _rowQueued;
+    Queue<unsigned> _rowQueue;
 
     /*
       Statistics collection
@@ -134,18 +186,51 @@ private:
     void freeMemoryIfNeeded();
 
     /*
-      Do a single pass over the constraint matrix and derive any
-      tighter bounds. Return the number of new bounds learned.
+      Copy the rows of the constraint matrix, compute their activities
+      and queue all of them.
+    */
+    void initializeRowActivities();
+
+    /*
+      Store a tighter bound for a variable, updating the activities of
+      the rows of the constraint matrix that it appears in.
+    */
+    void updateLowerBound( unsigned variable, double bound );
+    void updateUpperBound( unsigned variable, double bound );
+    void updateActivity( double &activity, unsigned &numInfinite,
+                         double coefficient, double previousBound, double newBound );
+    void enqueueRow( unsigned row );
+
+    /*
+      Examine the rows that are currently queued, and derive any
+      tighter bounds. Rows that are affected by these bounds are
+      queued for the next pass. Return the number of new bounds
+      learned.
     */
     unsigned onePassOverConstraintMatrix();
 
     /*
-      Process the tableau row and attempt to derive tighter
-      lower/upper bounds for the specified variable. Return the number of
-      tighter bounds found.
+      Process the row of the constraint matrix and attempt to derive
+      tighter lower/upper bounds for its variables. Return the number
+      of tighter bounds found.
      */
     unsigned tightenOnSingleConstraintRow( unsigned row );
 
+    /*
+      Compute the rows of inv(B) * An, either from the explicit inverse
+      of the basis or through forward transformations of the columns
+      of An. The panels are laid out so that every step of the
+      computation works on contiguous memory for the whole panel.
+    */
+    void computeInvertedBasisRows( const double *invB );
+    void computeImplicitInvertedBasisRows();
+
+    /*
+      Do single passes over the inverted basis rows until saturation
+      (if requested) and report the number of new bounds learned.
+    */
+    void tightenOnInvertedBasisRows( bool untilSaturation );
+
     /*
       Do a single pass over the inverted basis rows and derive any
       tighter bounds. Return the number of new bounds learned.
@@ -153,11 +238,17 @@ private:
     unsigned onePassOverInvertedBasisRows();
 
     /*
-      Process the inverted basis row and attempt to derive tighter
-      lower/upper bounds for the specified variable. Return the number
-      of tighter bounds found.
+      Copy the bounds of the non-basic variables into contiguous arrays
+    */
+    void collectNonBasicBounds();
+
+    /*
+      Process the inverted basis row y = sum ci xi + scalar, where the
+      xi are the non-basic variables, and attempt to derive tighter
+      lower/upper bounds for y and for the xi. Return the number of
+      tighter bounds found.
     */
-    unsigned tightenOnSingleInvertedBasisRow( const TableauRow &row );
+    unsigned tightenOnSingleInvertedBasisRow( unsigned y, double scalar, const double *coefficients );
 };
 
 #endif // __RowBoundTightener_h__
@@ -16,6 +16,8 @@
 
 SigmoidConstraint::SigmoidConstraint(unsigned b, unsigned f)
         : _b(b), _f(f), _isBoundWereChanged(false), _haveEliminatedVariables(false), _isFixed(false) {
+    addFixedSlot(_b);
+    addFixedSlot(_f);
 }
 
 SigmoidConstraint::SigmoidConstraint(const String &serializedSigmoid)
@@ -36,6 +38,8 @@ SigmoidConstraint::SigmoidConstraint(const String &serializedSigmoid)
     _b = atoi(var->ascii());
 
     ASSERT(_b < _f)
+    addFixedSlot(_b);
+    addFixedSlot(_f);
     printf("b is: %d and _f is %d\n", _b, _f);
 
 }
@@ -267,20 +271,10 @@ void SigmoidConstraint::updateVariableIndex(unsigned oldIndex, unsigned newIndex
            !_upperBounds.exists(newIndex) &&
            newIndex != _b && newIndex != _f);
 
-    if (_assignment.exists(oldIndex)) {
-        _assignment[newIndex] = _assignment.get(oldIndex);
-        _assignment.erase(oldIndex);
-    }
-
-    if (_lowerBounds.exists(oldIndex)) {
-        _lowerBounds[newIndex] = _lowerBounds.get(oldIndex);
-        _lowerBounds.erase(oldIndex);
-    }
-
-    if (_upperBounds.exists(oldIndex)) {
-        _upperBounds[newIndex] = _upperBounds.get(oldIndex);
-        _upperBounds.erase(oldIndex);
-    }
+    // The fixed slots of the variable move along with it
+    _assignment.renameVariable(oldIndex, newIndex);
+    _lowerBounds.renameVariable(oldIndex, newIndex);
+    _upperBounds.renameVariable(oldIndex, newIndex);
 
     if (oldIndex == _b)
         _b = newIndex;
@@ -19,10 +19,13 @@
 #include "FloatUtils.h"
 #include "GlobalConfiguration.h"
 #include "IEngine.h"
+#include "InfeasibleQueryException.h"
 #include "MStringf.h"
 #include "MarabouError.h"
 #include "ReluConstraint.h"
+#include "Set.h"
 #include "SmtCore.h"
+#include "Vector.h"
 
 SmtCore::SmtCore( IEngine *engine )
         : _statistics( NULL )
@@ -32,7 +35,14 @@ SmtCore::SmtCore( IEngine *engine )
         , _stateId( 0 )
         , _constraintViolationThreshold
                   ( GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD )
+        , _tableauStateStorageLevel
+                  ( ( GlobalConfiguration::USE_BOUND_TRAIL_FOR_SMT_STATES &&
+                      !GlobalConfiguration::USE_COLUMN_MERGING_EQUATIONS ) ?
+                    TableauStateStorageLevel::STORE_BOUND_TRAIL :
+                    TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE )
 {
+    _conflictAnalysis = GlobalConfiguration::USE_CONFLICT_ANALYSIS &&
+        _tableauStateStorageLevel == TableauStateStorageLevel::STORE_BOUND_TRAIL;
 }
 
 SmtCore::~SmtCore()
@@ -101,42 +111,56 @@ void SmtCore::performSplit()
     ASSERT( _constraintForSplitting->isActive() );
     _needToSplit = false;
 
+    // Obtain the splits, and drop any that the learned clauses rule out
+    List<PiecewiseLinearCaseSplit> splits = _constraintForSplitting->getCaseSplits();
+    ASSERT( !splits.empty() );
+    removeBlockedSplits( _constraintForSplitting, splits );
+    if ( splits.empty() )
+    {
+        SMT_LOG( "All splits are blocked by learned clauses" );
+        _constraintToViolationCount[_constraintForSplitting] = 0;
+        _constraintForSplitting = NULL;
+        throw InfeasibleQueryException();
+    }
+
     if ( _statistics )
     {
         _statistics->incNumSplits();
         _statistics->incNumVisitedTreeStates();
     }
 
-    // Before storing the state of the engine, we:
-    //   1. Obtain the splits.
-    //   2. Disable the constraint, so that it is marked as disbaled in the EngineState.
-    List<PiecewiseLinearCaseSplit> splits = _constraintForSplitting->getCaseSplits();
-    ASSERT( !splits.empty() );
-    ASSERT( splits.size() >= 2 ); // Not really necessary, can add code to handle this case.
+    // Before storing the state of the engine, disable the constraint, so that
+    // it is marked as disbaled in the EngineState.
     _constraintForSplitting->setActiveConstraint( false );
 
     // Obtain the current state of the engine
     EngineState *stateBeforeSplits = new EngineState;
     stateBeforeSplits->_stateId = _stateId;
     ++_stateId;
-    _engine->storeState( *stateBeforeSplits, true );
+    _engine->storeState( *stateBeforeSplits, _tableauStateStorageLevel );
 
     StackEntry *stackEntry = new StackEntry;
-    // Perform the first split: add bounds and equations
+    stackEntry->_constraint = _constraintForSplitting;
+    stackEntry->_engineState = stateBeforeSplits;
+
+    // The first split is the active one, store the remaining splits for later
     List<PiecewiseLinearCaseSplit>::iterator split = splits.begin();
-    _engine->applySplit( *split );
     stackEntry->_activeSplit = *split;
-
-    // Store the remaining splits on the stack, for later
-    stackEntry->_engineState = stateBeforeSplits;
-    ++split;
-    while ( split != splits.end() )
-    {
+    for ( ++split; split != splits.end(); ++split )
         stackEntry->_alternativeSplits.append( *split );
-        ++split;
-    }
 
+    /*
+      Push the entry before applying the split. This turns on the bound
+      trail if it was off (at the root), so that the split's bound
+      changes are recorded after the stored mark and restoring the
+      state undoes them.
+    */
     _stack.append( stackEntry );
+    updateBoundTrailRecording();
+
+    // Perform the first split: add bounds and equations
+    _engine->applySplit( stackEntry->_activeSplit );
+
     if ( _statistics )
     {
         _statistics->setCurrentStackDepth( getStackDepth() );
@@ -183,7 +207,10 @@ bool SmtCore::popSplit()
         _stack.popBack();
 
         if ( _stack.empty() )
+        {
+            updateBoundTrailRecording();
             return false;
+        }
     }
 
     if ( checkSkewFromDebuggingSolution() )
@@ -225,6 +252,267 @@ bool SmtCore::popSplit()
     return true;
 }
 
+bool SmtCore::backjump( const List<ConflictBound> &explanation )
+{
+    if ( !_conflictAnalysis || _stack.empty() )
+        return popSplit();
+
+    SMT_LOG( "Analyzing a conflict" );
+
+    struct timespec start = TimeUtils::sampleMicro();
+
+    // Level k (counting from 1) is the k'th entry of the stack
+    Vector<const StackEntry *> levels;
+    for ( const auto &stackEntry : _stack )
+        levels.append( stackEntry );
+    unsigned depth = levels.size();
+
+    Set<unsigned> dependencies;
+    unsigned prefixLength = 0;
+
+    for ( const auto &conflictBound : explanation )
+    {
+        const Tightening &bound = conflictBound._bound;
+
+        // The bound was established in the deepest state whose trail
+        // mark precedes it. The trail is recorded from the moment the
+        // first entry is pushed, before its split is applied, so bounds
+        // that are not on it (position 0) hold for the entire query.
+        unsigned level = 0;
+        while ( level < depth &&
+                levels[level]->_engineState->_tableauState._boundTrailSize <
+                conflictBound._trailPosition )
+            ++level;
+
+        if ( level == 0 )
+            continue;
+
+        // A bound implied by a single decision depends on that decision alone
+        unsigned decisionLevel = 0;
+        for ( unsigned i = 0; i < depth && decisionLevel == 0; ++i )
+        {
+            for ( const auto &tightening : levels[i]->_activeSplit.getBoundTightenings() )
+            {
+                if ( tightening._variable != bound._variable || tightening._type != bound._type )
+                    continue;
+
+                if ( ( bound._type == Tightening::LB && FloatUtils::gte( tightening._value, bound._value ) ) ||
+                     ( bound._type == Tightening::UB && FloatUtils::lte( tightening._value, bound._value ) ) )
+                {
+                    decisionLevel = i + 1;
+                    break;
+                }
+            }
+        }
+
+        // Otherwise, the bound was derived from everything that held at its level
+        if ( decisionLevel != 0 )
+            dependencies.insert( decisionLevel );
+        else if ( level > prefixLength )
+            prefixLength = level;
+    }
+
+    // The conflict also depends on any equations that were added to the tableau
+    for ( unsigned i = depth; i > prefixLength; --i )
+    {
+        bool addedEquations = !levels[i - 1]->_activeSplit.getEquations().empty();
+        for ( const auto &impliedSplit : levels[i - 1]->_impliedValidSplits )
+            if ( !impliedSplit.getEquations().empty() )
+                addedEquations = true;
+
+        if ( addedEquations )
+        {
+            prefixLength = i;
+            break;
+        }
+    }
+
+    for ( unsigned i = 1; i <= prefixLength; ++i )
+        dependencies.insert( i );
+
+    if ( dependencies.empty() )
+    {
+        // The conflict holds at the root, so the query is unsat
+        SMT_LOG( "Conflict does not depend on any split" );
+        freeMemory();
+        updateBoundTrailRecording();
+        if ( _statistics )
+            _statistics->setCurrentStackDepth( getStackDepth() );
+        return false;
+    }
+
+    // Learn the conjunction of the decisions as a forbidden combination
+    LearnedClause clause;
+    unsigned deepestLevel = 0;
+    for ( const auto &level : dependencies )
+    {
+        const StackEntry *stackEntry = levels[level - 1];
+        clause.append( ClauseLiteral( stackEntry->_constraint, stackEntry->_activeSplit ) );
+        if ( level > deepestLevel )
+            deepestLevel = level;
+    }
+
+    _learnedClauses.append( clause );
+    if ( _learnedClauses.size() > GlobalConfiguration::MAX_LEARNED_CLAUSES )
+        _learnedClauses.erase( _learnedClauses.begin() );
+
+    /*
+      The levels above the deepest decision in the clause did not take
+      part in the conflict, so their alternatives would fail for the
+      same reason and can be discarded. We do not jump any further, to
+      the second deepest decision, as the constraints split on at the
+      skipped levels would then need to be re-activated and split on
+      again.
+    */
+    unsigned skippedLevels = 0;
+    while ( _stack.size() > deepestLevel )
+    {
+        delete _stack.back()->_engineState;
+        delete _stack.back();
+        _stack.popBack();
+        ++skippedLevels;
+    }
+
+    if ( _statistics )
+    {
+        _statistics->incNumLearnedClauses();
+        _statistics->addNumBackjumpedLevels( skippedLevels );
+        struct timespec end = TimeUtils::sampleMicro();
+        _statistics->addTimeSmtCore( TimeUtils::timePassed( start, end ) );
+    }
+
+    return popSplit();
+}
+
+bool SmtCore::conflictAnalysisEnabled() const
+{
+    return _conflictAnalysis;
+}
+
+void SmtCore::clearLearnedClauses()
+{
+    _learnedClauses.clear();
+}
+
+void SmtCore::getDecisions( Map<PiecewiseLinearConstraint *,
+                            const PiecewiseLinearCaseSplit *> &decisions ) const
+{
+    decisions.clear();
+    for ( const auto &stackEntry : _stack )
+        decisions[stackEntry->_constraint] = &stackEntry->_activeSplit;
+}
+
+bool SmtCore::getBlockedLiteral( const LearnedClause &clause,
+                                 const Map<PiecewiseLinearConstraint *,
+                                 const PiecewiseLinearCaseSplit *> &decisions,
+                                 const ClauseLiteral *&blocked ) const
+{
+    blocked = NULL;
+    for ( const auto &literal : clause )
+    {
+        if ( decisions.exists( literal.first() ) )
+        {
+            // A different decision satisfies the clause
+            if ( !( *decisions.get( literal.first() ) == literal.second() ) )
+                return false;
+            continue;
+        }
+
+        // More than one undecided split, nothing is blocked yet
+        if ( blocked )
+            return false;
+
+        blocked = &literal;
+    }
+
+    return blocked != NULL;
+}
+
+void SmtCore::removeBlockedSplits( PiecewiseLinearConstraint *constraint,
+                                   List<PiecewiseLinearCaseSplit> &splits ) const
+{
+    if ( !_conflictAnalysis || _learnedClauses.empty() )
+        return;
+
+    Map<PiecewiseLinearConstraint *, const PiecewiseLinearCaseSplit *> decisions;
+    getDecisions( decisions );
+
+    const ClauseLiteral *blocked;
+    for ( const auto &clause : _learnedClauses )
+    {
+        if ( getBlockedLiteral( clause, decisions, blocked ) && blocked->first() == constraint )
+            splits.erase( blocked->second() );
+    }
+}
+
+void SmtCore::getImpliedSplitsFromLearnedClauses
+    ( List<Pair<PiecewiseLinearConstraint *, PiecewiseLinearCaseSplit>> &impliedSplits ) const
+{
+    impliedSplits.clear();
+
+    if ( !_conflictAnalysis || _learnedClauses.empty() )
+        return;
+
+    Map<PiecewiseLinearConstraint *, const PiecewiseLinearCaseSplit *> decisions;
+    getDecisions( decisions );
+
+    List<PiecewiseLinearConstraint *> constraints;
+    Map<PiecewiseLinearConstraint *, List<PiecewiseLinearCaseSplit>> remainingSplits;
+
+    const ClauseLiteral *blocked;
+    for ( const auto &clause : _learnedClauses )
+    {
+        if ( !getBlockedLiteral( clause, decisions, blocked ) || !blocked->first()->isActive() )
+            continue;
+
+        PiecewiseLinearConstraint *constraint = blocked->first();
+        if ( !remainingSplits.exists( constraint ) )
+        {
+            constraints.append( constraint );
+            remainingSplits[constraint] = constraint->getCaseSplits();
+        }
+
+        remainingSplits[constraint].erase( blocked->second() );
+    }
+
+    for ( const auto &constraint : constraints )
+    {
+        const List<PiecewiseLinearCaseSplit> &splits = remainingSplits[constraint];
+
+        if ( splits.empty() )
+        {
+            SMT_LOG( "All splits of a constraint are blocked by learned clauses" );
+            throw InfeasibleQueryException();
+        }
+
+        if ( splits.size() == 1 )
+            impliedSplits.append( Pair<PiecewiseLinearConstraint *, PiecewiseLinearCaseSplit>
+                                  ( constraint, splits.front() ) );
+    }
+}
+
+void SmtCore::backtrackToRoot()
+{
+    if ( _stack.empty() )
+        return;
+
+    SMT_LOG( "Backtracking to the root" );
+
+    /*
+      The root state was stored after the first constraint was disabled
+      for splitting. Restore it as active, as it was before the split.
+    */
+    StackEntry *root = _stack.front();
+    if ( root->_engineState->_plConstraintToState.exists( root->_constraint ) )
+        root->_engineState->_plConstraintToState[root->_constraint]->setActiveConstraint( true );
+    _engine->restoreState( *( root->_engineState ) );
+    freeMemory();
+    updateBoundTrailRecording();
+
+    if ( _statistics )
+        _statistics->setCurrentStackDepth( getStackDepth() );
+}
+
 void SmtCore::resetReportedViolations()
 {
     _constraintToViolationCount.clear();
@@ -256,6 +544,64 @@ void SmtCore::allSplitsSoFar( List<PiecewiseLinearCaseSplit> &result ) const
     }
 }
 
+void SmtCore::replaySplits()
+{
+    for ( const auto &split : _impliedValidSplitsAtRoot )
+        _engine->applySplit( split );
+
+    for ( const auto &stackEntry : _stack )
+    {
+        if ( stackEntry->_engineState->_tableauStateStorageLevel ==
+             TableauStateStorageLevel::STORE_BOUND_TRAIL )
+            _engine->refreshBoundTrailState( *stackEntry->_engineState );
+
+        _engine->applySplit( stackEntry->_activeSplit );
+        for ( const auto &impliedSplit : stackEntry->_impliedValidSplits )
+            _engine->applySplit( impliedSplit );
+    }
+}
+
+bool SmtCore::splitOffSubtree( PiecewiseLinearCaseSplit &subtree )
+{
+    // The shallowest alternative is the root of the largest subtree
+    auto stackEntry = _stack.begin();
+    while ( stackEntry != _stack.end() && ( *stackEntry )->_alternativeSplits.empty() )
+        ++stackEntry;
+
+    if ( stackEntry == _stack.end() )
+        return false;
+
+    SMT_LOG( "Splitting off a subtree" );
+
+    List<PiecewiseLinearCaseSplit> splits = _impliedValidSplitsAtRoot;
+    for ( auto it = _stack.begin(); it != stackEntry; ++it )
+    {
+        splits.append( ( *it )->_activeSplit );
+        splits.append( ( *it )->_impliedValidSplits );
+    }
+
+    auto alternative = ( *stackEntry )->_alternativeSplits.begin();
+    splits.append( *alternative );
+    ( *stackEntry )->_alternativeSplits.erase( alternative );
+
+    for ( const auto &split : splits )
+    {
+        for ( const auto &bound : split.getBoundTightenings() )
+            subtree.storeBoundTightening( bound );
+        for ( const auto &equation : split.getEquations() )
+            subtree.addEquation( equation );
+    }
+
+    return true;
+}
+
+void SmtCore::updateBoundTrailRecording()
+{
+    _engine->setBoundTrailRecording( _tableauStateStorageLevel ==
+                                     TableauStateStorageLevel::STORE_BOUND_TRAIL &&
+                                     !_stack.empty() );
+}
+
 void SmtCore::setStatistics( Statistics *statistics )
 {
     _statistics = statistics;
@@ -16,10 +16,13 @@
 #ifndef __SmtCore_h__
 #define __SmtCore_h__
 
+#include "Map.h"
+#include "Pair.h"
 #include "PiecewiseLinearCaseSplit.h"
 #include "PiecewiseLinearConstraint.h"
 #include "Stack.h"
 #include "Statistics.h"
+#include "TableauStateStorageLevel.h"
 
 #define SMT_LOG( x, ... ) LOG( GlobalConfiguration::SMT_CORE_LOGGING, "SmtCore: %s\n", x )
 
@@ -30,6 +33,23 @@ class String;
 class SmtCore
 {
 public:
+    /*
+      A bound that took part in a conflict, together with the size of
+      the bound trail from which the bound has held (0 if it has held
+      since before the search started).
+    */
+    struct ConflictBound
+    {
+        ConflictBound( const Tightening &bound, unsigned trailPosition )
+            : _bound( bound )
+            , _trailPosition( trailPosition )
+        {
+        }
+
+        Tightening _bound;
+        unsigned _trailPosition;
+    };
+
     SmtCore( IEngine *engine );
     ~SmtCore();
 
@@ -71,6 +91,44 @@ public:
     */
     bool popSplit();
 
+    /*
+      Analyze a conflict, given the bounds that together make the
+      current subproblem infeasible. The decisions that these bounds
+      depend on are stored as a learned clause, the levels that did
+      not take part in the conflict are skipped, and then a pop is
+      performed. Return true if successful, false if the whole query
+      is infeasible. If conflict analysis is disabled, this is just a
+      pop.
+    */
+    bool backjump( const List<ConflictBound> &explanation );
+
+    /*
+      Whether conflicts should be analyzed, i.e. whether the engine
+      should bother explaining them.
+    */
+    bool conflictAnalysisEnabled() const;
+
+    /*
+      Forget all learned clauses. The clauses are only valid for the
+      query that they were learned from.
+    */
+    void clearLearnedClauses();
+
+    /*
+      Collect the splits that are implied by the learned clauses, given
+      the current decisions: if all splits of a clause but one hold,
+      the remaining constraint cannot take the remaining split. If this
+      leaves a single split for that constraint, it is implied.
+    */
+    void getImpliedSplitsFromLearnedClauses
+        ( List<Pair<PiecewiseLinearConstraint *, PiecewiseLinearCaseSplit>> &impliedSplits ) const;
+
+    /*
+      Restore the engine state stored at the bottom of the stack, if
+      any, and clear the stack.
+    */
+    void backtrackToRoot();
+
     /*
       The current stack depth.
     */
@@ -87,6 +145,22 @@ public:
     */
     void allSplitsSoFar( List<PiecewiseLinearCaseSplit> &result ) const;
 
+    /*
+      Re-apply all splits performed so far, in order, to an engine that
+      has been restored to its initial state. States on the stack that
+      are stored as bound trail marks are re-anchored along the way.
+    */
+    void replaySplits();
+
+    /*
+      Remove the shallowest alternative split from the stack, and store
+      in subtree the splits that lead to it: the valid splits implied at
+      the root, and the active and implied splits of all levels above
+      it. The search of the removed subtree is left to someone else.
+      Return false if there is no alternative split on the stack.
+    */
+    bool splitOffSubtree( PiecewiseLinearCaseSplit &subtree );
+
     /*
       Have the SMT core start reporting statistics.
     */
@@ -122,12 +196,55 @@ private:
     struct StackEntry
     {
     public:
+        PiecewiseLinearConstraint *_constraint;
         PiecewiseLinearCaseSplit _activeSplit;
         List<PiecewiseLinearCaseSplit> _impliedValidSplits;
         List<PiecewiseLinearCaseSplit> _alternativeSplits;
         EngineState *_engineState;
     };
 
+    /*
+      A learned clause is a set of case splits that cannot all hold
+      at once.
+    */
+    typedef Pair<PiecewiseLinearConstraint *, PiecewiseLinearCaseSplit> ClauseLiteral;
+    typedef List<ClauseLiteral> LearnedClause;
+
+    /*
+      The learned clauses, oldest first.
+    */
+    List<LearnedClause> _learnedClauses;
+
+    /*
+      Whether conflicts are analyzed. Locating the level of a bound
+      relies on the trail marks of the stored states, so this requires
+      the states to be stored as bound trail marks.
+    */
+    bool _conflictAnalysis;
+
+    /*
+      Store the split currently taken by each decision on the stack.
+    */
+    void getDecisions( Map<PiecewiseLinearConstraint *,
+                       const PiecewiseLinearCaseSplit *> &decisions ) const;
+
+    /*
+      Among the splits that the clause forbids given the decisions,
+      find the one that is still open. Return false if the clause
+      blocks nothing at the moment.
+    */
+    bool getBlockedLiteral( const LearnedClause &clause,
+                            const Map<PiecewiseLinearConstraint *,
+                            const PiecewiseLinearCaseSplit *> &decisions,
+                            const ClauseLiteral *&blocked ) const;
+
+    /*
+      Remove from the list the splits of the constraint that are blocked
+      by the learned clauses.
+    */
+    void removeBlockedSplits( PiecewiseLinearConstraint *constraint,
+                              List<PiecewiseLinearCaseSplit> &splits ) const;
+
     /*
       Valid splits that were implied by level 0 of the stack.
     */
@@ -174,6 +291,18 @@ private:
       Split when some relu has been violated for this many times
     */
     unsigned _constraintViolationThreshold;
+
+    /*
+      How the tableau is stored in the engine states on the stack
+    */
+    TableauStateStorageLevel _tableauStateStorageLevel;
+
+    /*
+      Record bound changes in the tableau's trail only while the stack
+      holds states stored as trail marks, so that the trail does not
+      grow without bound at the root or in full snapshot mode.
+    */
+    void updateBoundTrailRecording();
 };
 
 #endif // __SmtCore_h__
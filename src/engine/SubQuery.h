@@ -20,7 +20,7 @@
 #include "MString.h"
 #include "PiecewiseLinearCaseSplit.h"
 
-#include <boost/lockfree/queue.hpp>
+#include <memory>
 #include <utility>
 
 // Struct representing a subquery
@@ -42,10 +42,6 @@ struct SubQuery
     unsigned _timeoutInSeconds;
 };
 
-// Synchronized Queue containing the Sub-Queries shared by workers
-typedef boost::lockfree::queue<SubQuery *, boost::lockfree::
-  fixed_sized<false>>WorkerQueue;
-
 // A vector of Sub-Queries
 
 // Guy: consider using our wrapper class Vector instead of std::vector
@@ -34,15 +34,18 @@
 Tableau::Tableau()
     : _n ( 0 )
     , _m ( 0 )
+    , _allocatedM( 0 )
+    , _allocatedN( 0 )
     , _A( NULL )
     , _sparseColumnsOfA( NULL )
     , _sparseRowsOfA( NULL )
-    , _denseA( NULL )
+    , _denseAColumn( NULL )
     , _changeColumn( NULL )
     , _pivotRow( NULL )
     , _b( NULL )
     , _workM( NULL )
     , _workN( NULL )
+    , _sparseWorkM( NULL )
     , _unitVector( NULL )
     , _basisFactorization( NULL )
     , _multipliers( NULL )
@@ -59,6 +62,7 @@ Tableau::Tableau()
     , _statistics( NULL )
     , _costFunctionManager( NULL )
     , _rhsIsAllZeros( true )
+    , _recordBoundTrail( false )
 {
 }
 
@@ -77,7 +81,7 @@ void Tableau::freeMemoryIfNeeded()
 
     if ( _sparseColumnsOfA )
     {
-        for ( unsigned i = 0; i < _n; ++i )
+        for ( unsigned i = 0; i < _allocatedN; ++i )
         {
             if ( _sparseColumnsOfA[i] )
             {
@@ -92,7 +96,7 @@ void Tableau::freeMemoryIfNeeded()
 
     if ( _sparseRowsOfA )
     {
-        for ( unsigned i = 0; i < _m; ++i )
+        for ( unsigned i = 0; i < _allocatedM; ++i )
         {
             if ( _sparseRowsOfA[i] )
             {
@@ -105,10 +109,10 @@ void Tableau::freeMemoryIfNeeded()
         _sparseRowsOfA = NULL;
     }
 
-    if ( _denseA )
+    if ( _denseAColumn )
     {
-        delete[] _denseA;
-        _denseA = NULL;
+        delete[] _denseAColumn;
+        _denseAColumn = NULL;
     }
 
     if ( _changeColumn )
@@ -129,9 +133,15 @@ void Tableau::freeMemoryIfNeeded()
         _b = NULL;
     }
 
+    if ( _sparseWorkM )
+    {
+        delete _sparseWorkM;
+        _sparseWorkM = NULL;
+    }
+
     if ( _unitVector )
     {
-        delete[] _unitVector;
+        delete _unitVector;
         _unitVector = NULL;
     }
 
@@ -212,6 +222,8 @@ void Tableau::setDimensions( unsigned m, unsigned n )
 {
     _m = m;
     _n = n;
+    _allocatedM = m;
+    _allocatedN = n;
 
     _A = new CSRMatrix();
     if ( !_A )
@@ -239,9 +251,9 @@ void Tableau::setDimensions( unsigned m, unsigned n )
             throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::sparseRowOfA[i]" );
     }
 
-    _denseA = new double[m*n];
-    if ( !_denseA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::denseA" );
+    _denseAColumn = new double[m];
+    if ( !_denseAColumn )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::denseAColumn" );
 
     _changeColumn = new double[m];
     if ( !_changeColumn )
@@ -255,7 +267,11 @@ void Tableau::setDimensions( unsigned m, unsigned n )
     if ( !_b )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::b" );
 
-    _unitVector = new double[m];
+    _sparseWorkM = new SparseUnsortedList( m );
+    if ( !_sparseWorkM )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::sparseWorkM" );
+
+    _unitVector = new SparseUnsortedList( m );
     if ( !_unitVector )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::unitVector" );
 
@@ -321,15 +337,31 @@ void Tableau::setConstraintMatrix( const double *A )
     for ( unsigned column = 0; column < _n; ++column )
     {
         for ( unsigned row = 0; row < _m; ++row )
-            _denseA[column*_m + row] = A[row*_n + column];
+            _workM[row] = A[row*_n + column];
 
-        _sparseColumnsOfA[column]->initialize( _denseA + ( column * _m ), _m );
+        _sparseColumnsOfA[column]->initialize( _workM, _m );
     }
 
     for ( unsigned row = 0; row < _m; ++row )
         _sparseRowsOfA[row]->initialize( A + ( row * _n ), _n );
 }
 
+void Tableau::setConstraintMatrix( const SparseMatrix *A )
+{
+    A->storeIntoOther( _A );
+
+    for ( unsigned column = 0; column < _n; ++column )
+        _sparseColumnsOfA[column]->clear();
+
+    // Rows are visited in order, so the columns come out sorted as well
+    for ( unsigned row = 0; row < _m; ++row )
+    {
+        A->getRow( row, _sparseRowsOfA[row] );
+        for ( const auto &entry : *_sparseRowsOfA[row] )
+            _sparseColumnsOfA[entry._index]->append( row, entry._value );
+    }
+}
+
 void Tableau::markAsBasic( unsigned variable )
 {
     _basicVariables.insert( variable );
@@ -469,6 +501,8 @@ void Tableau::computeBasicStatus( unsigned basicIndex )
 void Tableau::setLowerBound( unsigned variable, double value )
 {
     ASSERT( variable < _n );
+    if ( _recordBoundTrail )
+        _boundTrail.append( BoundTrailEntry( variable, true, _lowerBounds[variable] ) );
     _lowerBounds[variable] = value;
     notifyLowerBound( variable, value );
     checkBoundsValid( variable );
@@ -477,6 +511,8 @@ void Tableau::setLowerBound( unsigned variable, double value )
 void Tableau::setUpperBound( unsigned variable, double value )
 {
     ASSERT( variable < _n );
+    if ( _recordBoundTrail )
+        _boundTrail.append( BoundTrailEntry( variable, false, _upperBounds[variable] ) );
     _upperBounds[variable] = value;
     notifyUpperBound( variable, value );
     checkBoundsValid( variable );
@@ -609,7 +645,7 @@ unsigned Tableau::getBasicStatusByIndex( unsigned basicIndex )
     return _basicStatus[basicIndex];
 }
 
-void Tableau::getEntryCandidates( List<unsigned> &candidates ) const
+void Tableau::getEntryCandidates( Vector<unsigned> &candidates ) const
 {
     candidates.clear();
     const double *costFunction = _costFunctionManager->getCostFunction();
@@ -951,7 +987,9 @@ void Tableau::pickLeavingVariable()
 
 void Tableau::pickLeavingVariable( double *changeColumn )
 {
-    if ( GlobalConfiguration::USE_HARRIS_RATIO_TEST )
+    if ( GlobalConfiguration::USE_BOUND_FLIPPING_RATIO_TEST )
+        boundFlippingRatioTest( changeColumn );
+    else if ( GlobalConfiguration::USE_HARRIS_RATIO_TEST )
         harrisRatioTest( changeColumn );
     else
         standardRatioTest( changeColumn );
@@ -1374,6 +1412,208 @@ void Tableau::harrisRatioTest( double *changeColumn )
     ASSERT( _leavingVariable != _m );
 }
 
+void Tableau::boundFlippingRatioTest( double *changeColumn )
+{
+    /*
+      A long-step ratio test for the phase one objective, i.e. the sum
+      of infeasibilities. As a function of the step t taken by the
+      entering variable, this objective is piecewise linear: its slope
+      is initially -|reduced cost|, and it grows by |changeColumn[i]|
+      whenever an out-of-bounds basic variable x_i reaches its near
+      bound and becomes feasible. The standard ratio test stops at the
+      first such breakpoint. Here, we keep passing breakpoints for as
+      long as the slope remains negative, which fixes several
+      out-of-bounds basic variables in a single pivot. The breakpoint
+      at which the slope stops being negative determines the leaving
+      variable.
+
+      No basic variable is allowed to become out-of-bounds, so the step
+      is also limited by the bounds of the in-bounds basic variables,
+      by the far bounds of the out-of-bounds basic variables and by the
+      entering variable's own bounds.
+    */
+    double reducedCost = _costFunctionManager->getCostFunction()[_enteringVariable];
+    ASSERT( !FloatUtils::isZero( reducedCost ) );
+    bool decrease = FloatUtils::isPositive( reducedCost );
+
+    DEBUG({
+            if ( decrease )
+            {
+                ASSERTM( nonBasicCanDecrease( _enteringVariable ),
+                         "Error! Entering variable needs to decrease but is at its lower bound" );
+            }
+            else
+            {
+                ASSERTM( nonBasicCanIncrease( _enteringVariable ),
+                         "Error! Entering variable needs to increase but is at its upper bound" );
+            }
+        });
+
+    unsigned entering = _nonBasicIndexToVariable[_enteringVariable];
+    double currentValue = _nonBasicAssignment[_enteringVariable];
+
+    // The largest step allowed by the entering variable's bounds. A
+    // marker shows that no leaving variable has been selected.
+    double maxStep = decrease ?
+        currentValue - _lowerBounds[entering] : _upperBounds[entering] - currentValue;
+    _leavingVariable = _m;
+    double largestPivot = 0;
+
+    // First pass: collect the breakpoints, and find the largest step
+    // that keeps all basic variables that are within bounds in bounds
+    _breakpoints.clear();
+    for ( unsigned i = 0; i < _m; ++i )
+    {
+        if ( changeColumn[i] < +GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE &&
+             changeColumn[i] > -GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE )
+            continue;
+
+        double step = FloatUtils::abs( ratioConstraintPerBasic( i, changeColumn[i], decrease ) );
+
+        double basicCost = _costFunctionManager->getBasicCost( i );
+        bool basicIncreases = FloatUtils::isNegative( changeColumn[i] ) != decrease;
+
+        if ( ( basicCost > 0 && !basicIncreases ) || ( basicCost < 0 && basicIncreases ) )
+        {
+            // An out-of-bounds basic moving towards its bounds. It
+            // becomes feasible at the breakpoint, and it may move on
+            // until it hits its far bound.
+            _breakpoints.append( Pair<double, unsigned>( step, i ) );
+
+            unsigned basic = _basicIndexToVariable[i];
+            double farBound = basicIncreases ? _upperBounds[basic] : _lowerBounds[basic];
+            step = FloatUtils::abs( ( farBound - _basicAssignment[i] ) / changeColumn[i] );
+        }
+
+        if ( ( step < maxStep ) ||
+             ( ( step == maxStep ) && ( FloatUtils::abs( changeColumn[i] ) > largestPivot ) ) )
+        {
+            maxStep = step;
+            _leavingVariable = i;
+            largestPivot = FloatUtils::abs( changeColumn[i] );
+        }
+    }
+
+    // Second pass: walk the breakpoints in order, until the slope is no
+    // longer negative or the maximal step is reached
+    _breakpoints.sort();
+
+    double slope = -FloatUtils::abs( reducedCost );
+    unsigned passedBreakpoints = 0;
+    for ( unsigned i = 0; i < _breakpoints.size(); ++i )
+    {
+        double step = _breakpoints[i].first();
+        if ( step > maxStep )
+            break;
+
+        unsigned basicIndex = _breakpoints[i].second();
+        slope += FloatUtils::abs( changeColumn[basicIndex] );
+
+        if ( FloatUtils::isNegative( slope ) )
+        {
+            ++passedBreakpoints;
+            continue;
+        }
+
+        // Stop here. Among the breakpoints at this step, prefer the
+        // largest pivot element.
+        maxStep = step;
+        _leavingVariable = basicIndex;
+        for ( unsigned j = i + 1; j < _breakpoints.size() && _breakpoints[j].first() == step; ++j )
+        {
+            unsigned otherIndex = _breakpoints[j].second();
+            if ( FloatUtils::abs( changeColumn[otherIndex] ) > FloatUtils::abs( changeColumn[_leavingVariable] ) )
+                _leavingVariable = otherIndex;
+        }
+        break;
+    }
+
+    if ( _statistics && passedBreakpoints > 0 )
+        _statistics->addNumTableauPassedBreakpoints( passedBreakpoints );
+
+    _changeRatio = decrease ? -maxStep : maxStep;
+
+    // Only perform this check if pivot isn't fake
+    if ( _leavingVariable != _m )
+        _leavingVariableIncreases = FloatUtils::isNegative( changeColumn[_leavingVariable] ) != decrease;
+}
+
+bool Tableau::pickEnteringVariableByDualRatioTest()
+{
+    /*
+      The leaving variable is an out-of-bounds basic variable that is
+      about to be pushed onto its violated bound. Its row, computed in
+      _pivotRow, is
+
+        x_leaving = sum_i ( coefficient_i * x_i ) + scalar
+
+      and the entering variable must be a non-basic variable that can
+      move in the direction that moves the leaving variable towards
+      the violated bound.
+
+      In the textbook dual ratio test, the entering variable is the
+      eligible non-basic with the smallest ratio between its reduced
+      cost and its pivot row entry. Here we are solving a feasibility
+      problem, so the objective is zero, every basis is dual feasible,
+      and all these ratios are zero. We therefore break the tie in
+      favor of entering variables that remain within their own bounds
+      once the leaving variable hits its bound, and then in favor of
+      the largest pivot element, for numerical stability.
+    */
+
+    ASSERT( _leavingVariable < _m );
+    ASSERT( basicOutOfBounds( _leavingVariable ) );
+
+    bool leavingIncreases = basicTooLow( _leavingVariable );
+
+    unsigned leaving = _basicIndexToVariable[_leavingVariable];
+    double violatedBound =
+        leavingIncreases ? _lowerBounds[leaving] : _upperBounds[leaving];
+    double leavingDelta = violatedBound - _basicAssignment[_leavingVariable];
+
+    unsigned bestEntering = _n - _m;
+    bool bestStaysWithinBounds = false;
+    double largestPivot = 0;
+
+    for ( unsigned i = 0; i < _n - _m; ++i )
+    {
+        double coefficient = _pivotRow->_row[i]._coefficient;
+        if ( coefficient < +GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE &&
+             coefficient > -GlobalConfiguration::PIVOT_CHANGE_COLUMN_TOLERANCE )
+            continue;
+
+        // Does the non-basic need to increase or decrease?
+        bool nonBasicIncreases = ( coefficient > 0 ) == leavingIncreases;
+        if ( nonBasicIncreases ? !nonBasicCanIncrease( i ) : !nonBasicCanDecrease( i ) )
+            continue;
+
+        // Will the entering variable be within its own bounds after the pivot?
+        unsigned variable = _nonBasicIndexToVariable[i];
+        double newValue = _nonBasicAssignment[i] + leavingDelta / coefficient;
+        bool staysWithinBounds =
+            FloatUtils::gte( newValue, _lowerBounds[variable] ) &&
+            FloatUtils::lte( newValue, _upperBounds[variable] );
+
+        if ( ( staysWithinBounds && !bestStaysWithinBounds ) ||
+             ( ( staysWithinBounds == bestStaysWithinBounds ) &&
+               ( FloatUtils::abs( coefficient ) > largestPivot ) ) )
+        {
+            bestEntering = i;
+            bestStaysWithinBounds = staysWithinBounds;
+            largestPivot = FloatUtils::abs( coefficient );
+        }
+    }
+
+    if ( bestEntering == _n - _m )
+        return false;
+
+    _enteringVariable = bestEntering;
+    _leavingVariableIncreases = leavingIncreases;
+    _changeRatio = leavingDelta / _pivotRow->_row[bestEntering]._coefficient;
+
+    return true;
+}
+
 double Tableau::getChangeRatio() const
 {
     return _changeRatio;
@@ -1386,9 +1626,14 @@ void Tableau::setChangeRatio( double changeRatio )
 
 void Tableau::computeChangeColumn()
 {
-    // Compute d = inv(B) * a using the basis factorization
-    const double *a = getAColumn( _nonBasicIndexToVariable[_enteringVariable] );
-    _basisFactorization->forwardTransformation( a, _changeColumn );
+    /*
+      Compute d = inv(B) * a using the basis factorization. The column
+      of A is typically very sparse, so the sparse transformation is used.
+    */
+    const SparseUnsortedList *a = _sparseColumnsOfA[_nonBasicIndexToVariable[_enteringVariable]];
+    *_sparseWorkM = SparseUnsortedList( _m );
+    _basisFactorization->forwardTransformation( *a, *_sparseWorkM );
+    _sparseWorkM->toDense( _changeColumn );
 }
 
 const double *Tableau::getChangeColumn() const
@@ -1504,14 +1749,16 @@ void Tableau::getTableauRow( unsigned index, TableauRow *row )
     /*
       Let e denote a unit matrix with 1 in its *index* entry.
       A row is then computed by: e * inv(B) * -AN. e * inv(B) is
-      solved by invoking BTRAN.
+      solved by invoking BTRAN, on the (sparse) unit vector.
     */
 
     ASSERT( index < _m );
 
-    std::fill( _unitVector, _unitVector + _m, 0.0 );
-    _unitVector[index] = 1;
-    computeMultipliers( _unitVector );
+    *_unitVector = SparseUnsortedList( _m );
+    _unitVector->append( index, 1 );
+    *_sparseWorkM = SparseUnsortedList( _m );
+    _basisFactorization->backwardTransformation( *_unitVector, *_sparseWorkM );
+    _sparseWorkM->toDense( _multipliers );
 
     for ( unsigned i = 0; i < _n - _m; ++i )
     {
@@ -1547,7 +1794,8 @@ const SparseMatrix *Tableau::getSparseA() const
 
 const double *Tableau::getAColumn( unsigned variable ) const
 {
-    return _denseA + ( variable * _m );
+    _sparseColumnsOfA[variable]->toDense( _denseAColumn );
+    return _denseAColumn;
 }
 
 void Tableau::getSparseAColumn( unsigned variable, SparseUnsortedList *result ) const
@@ -1584,10 +1832,24 @@ void Tableau::dumpEquations()
     }
 }
 
-void Tableau::storeState( TableauState &state ) const
+void Tableau::storeState( TableauState &state, TableauStateStorageLevel level ) const
 {
+    ASSERT( level != TableauStateStorageLevel::STORE_NONE );
+
+    if ( level == TableauStateStorageLevel::STORE_BOUND_TRAIL )
+    {
+        // Only the dimensions, the basis and a mark into the trail
+        state.setDimensionsForBoundTrail( _m, _n );
+        memcpy( state._basicIndexToVariable, _basicIndexToVariable, sizeof(unsigned) * _m );
+        state._boundTrailSize = _boundTrail.size();
+        state._boundsValid = _boundsValid;
+        state._mergedVariables = _mergedVariables;
+        return;
+    }
+
     // Set the dimensions
     state.setDimensions( _m, _n, *this );
+    state._boundTrailSize = _boundTrail.size();
 
     // Store matrix A
     _A->storeIntoOther( state._A );
@@ -1595,7 +1857,6 @@ void Tableau::storeState( TableauState &state ) const
         _sparseColumnsOfA[i]->storeIntoOther( state._sparseColumnsOfA[i] );
     for ( unsigned i = 0; i < _m; ++i )
         _sparseRowsOfA[i]->storeIntoOther( state._sparseRowsOfA[i] );
-    memcpy( state._denseA, _denseA, sizeof(double) * _m * _n );
 
     // Store right hand side vector _b
     memcpy( state._b, _b, sizeof(double) * _m );
@@ -1629,8 +1890,47 @@ void Tableau::storeState( TableauState &state ) const
 
 void Tableau::restoreState( const TableauState &state )
 {
-    freeMemoryIfNeeded();
-    setDimensions( state._m, state._n );
+    // Restoring a state invalidates the buffered bound changes;
+    // batched watchers are expected to re-read all bounds afterwards
+    _pendingBoundChanges.clear();
+
+    if ( state._storageLevel == TableauStateStorageLevel::STORE_BOUND_TRAIL )
+    {
+        restoreStateFromBoundTrail( state );
+        return;
+    }
+
+    if ( _sparseColumnsOfA &&
+         state._m <= _allocatedM &&
+         state._n - state._m == _n - _m )
+    {
+        // The current arrays are large enough, keep them
+        if ( state._m != _m )
+        {
+            IBasisFactorization *newBasisFactorization =
+                BasisFactorizationFactory::createBasisFactorization( state._m, *this );
+            if ( !newBasisFactorization )
+                throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newBasisFactorization" );
+            delete _basisFactorization;
+            _basisFactorization = newBasisFactorization;
+            _basisFactorization->setStatistics( _statistics );
+        }
+
+        bool dimensionsChanged = ( state._m != _m );
+        _m = state._m;
+        _n = state._n;
+
+        if ( dimensionsChanged )
+        {
+            for ( const auto &watcher : _resizeWatchers )
+                watcher->notifyDimensionChange( _m, _n );
+        }
+    }
+    else
+    {
+        freeMemoryIfNeeded();
+        setDimensions( state._m, state._n );
+    }
 
     // Restore matrix A
     state._A->storeIntoOther( _A );
@@ -1638,7 +1938,6 @@ void Tableau::restoreState( const TableauState &state )
         state._sparseColumnsOfA[i]->storeIntoOther( _sparseColumnsOfA[i] );
     for ( unsigned i = 0; i < _m; ++i )
         state._sparseRowsOfA[i]->storeIntoOther( _sparseRowsOfA[i] );
-    memcpy( _denseA, state._denseA, sizeof(double) * _m * _n );
 
     // Restore right hand side vector _b
     memcpy( _b, state._b, sizeof(double) * _m );
@@ -1670,6 +1969,142 @@ void Tableau::restoreState( const TableauState &state )
     // Restore the merged varaibles
     _mergedVariables = state._mergedVariables;
 
+    // Bound changes recorded after the state was stored are now void
+    _boundTrail.truncate( state._boundTrailSize );
+
+    computeAssignment();
+    _costFunctionManager->initialize();
+    computeCostFunction();
+
+    if ( _statistics )
+        _statistics->setCurrentTableauDimension( _m, _n );
+}
+
+void Tableau::getBoundTrailPositions( const List<Tightening> &bounds, Vector<unsigned> &positions ) const
+{
+    positions.clear();
+
+    Map<unsigned, unsigned> lowerBoundToIndex;
+    Map<unsigned, unsigned> upperBoundToIndex;
+    Vector<double> values;
+    for ( const auto &bound : bounds )
+    {
+        Map<unsigned, unsigned> &boundToIndex =
+            bound._type == Tightening::LB ? lowerBoundToIndex : upperBoundToIndex;
+        boundToIndex[bound._variable] = positions.size();
+        positions.append( 0 );
+        values.append( bound._value );
+    }
+
+    /*
+      Scan the trail newest first. A change to a bound means that the
+      bound held from that point on, and if the previous value was not
+      as tight, this is also where it started to hold. Bounds are
+      dropped from the maps once their starting point is found.
+    */
+    for ( unsigned i = _boundTrail.size();
+          i > 0 && ( !lowerBoundToIndex.empty() || !upperBoundToIndex.empty() );
+          --i )
+    {
+        BoundTrailEntry entry = _boundTrail.get( i - 1 );
+        Map<unsigned, unsigned> &boundToIndex =
+            entry._isLowerBound ? lowerBoundToIndex : upperBoundToIndex;
+
+        if ( !boundToIndex.exists( entry._variable ) )
+            continue;
+
+        unsigned index = boundToIndex.get( entry._variable );
+        positions[index] = i;
+
+        bool heldBefore = entry._isLowerBound ?
+            FloatUtils::gte( entry._previousValue, values[index] ) :
+            FloatUtils::lte( entry._previousValue, values[index] );
+
+        if ( !heldBefore )
+            boundToIndex.erase( entry._variable );
+    }
+
+    // Bounds that held before all of their recorded changes held from the start
+    for ( const auto &it : lowerBoundToIndex )
+        positions[it.second] = 0;
+    for ( const auto &it : upperBoundToIndex )
+        positions[it.second] = 0;
+}
+
+void Tableau::setBoundTrailRecording( bool record )
+{
+    _recordBoundTrail = record;
+    if ( !record )
+        _boundTrail.clear();
+}
+
+void Tableau::restoreStateFromBoundTrail( const TableauState &state )
+{
+    ASSERT( state._storageLevel == TableauStateStorageLevel::STORE_BOUND_TRAIL );
+
+    // Merged columns cannot be un-merged
+    if ( _mergedVariables.size() != state._mergedVariables.size() )
+        throw MarabouError( MarabouError::CANNOT_RESTORE_TABLEAU,
+                            "Columns were merged after the bound trail mark" );
+
+    if ( _boundTrail.size() < state._boundTrailSize )
+        throw MarabouError( MarabouError::CANNOT_RESTORE_TABLEAU,
+                            "Bound trail is shorter than the stored mark" );
+
+    // Undo the bound changes, newest first
+    for ( unsigned i = _boundTrail.size(); i > state._boundTrailSize; --i )
+    {
+        const BoundTrailEntry &entry = _boundTrail[i - 1];
+        if ( entry._isLowerBound )
+            _lowerBounds[entry._variable] = entry._previousValue;
+        else
+            _upperBounds[entry._variable] = entry._previousValue;
+    }
+    _boundTrail.truncate( state._boundTrailSize );
+
+    if ( _m != state._m )
+    {
+        // Rows were added since the mark. Drop them, and go back to
+        // the basis that was in use when the state was stored.
+        removeLastRows( state._m, state._n );
+
+        _basicVariables.clear();
+        for ( unsigned i = 0; i < _m; ++i )
+        {
+            markAsBasic( state._basicIndexToVariable[i] );
+            assignIndexToBasicVariable( state._basicIndexToVariable[i], i );
+        }
+
+        unsigned nonBasicIndex = 0;
+        for ( unsigned i = 0; i < _n; ++i )
+        {
+            if ( !_basicVariables.exists( i ) )
+            {
+                _nonBasicIndexToVariable[nonBasicIndex] = i;
+                _variableToIndex[i] = nonBasicIndex;
+                // removeLastRows kept the previous values in _workN
+                _nonBasicAssignment[nonBasicIndex] = _workN[i];
+                ++nonBasicIndex;
+            }
+        }
+        ASSERT( nonBasicIndex == _n - _m );
+
+        _basisFactorization->obtainFreshBasis();
+    }
+
+    // The restored bounds are usually looser, but make sure that the
+    // non-basic variables are within them
+    for ( unsigned i = 0; i < _n - _m; ++i )
+    {
+        unsigned nonBasic = _nonBasicIndexToVariable[i];
+        if ( FloatUtils::lt( _nonBasicAssignment[i], _lowerBounds[nonBasic] ) )
+            _nonBasicAssignment[i] = _lowerBounds[nonBasic];
+        else if ( FloatUtils::gt( _nonBasicAssignment[i], _upperBounds[nonBasic] ) )
+            _nonBasicAssignment[i] = _upperBounds[nonBasic];
+    }
+
+    _boundsValid = state._boundsValid;
+
     computeAssignment();
     _costFunctionManager->initialize();
     computeCostFunction();
@@ -1678,6 +2113,46 @@ void Tableau::restoreState( const TableauState &state )
         _statistics->setCurrentTableauDimension( _m, _n );
 }
 
+void Tableau::removeLastRows( unsigned m, unsigned n )
+{
+    ASSERT( m < _m && n < _n );
+    ASSERT( _n - _m == n - m );
+
+    // Keep the current values of the remaining variables
+    for ( unsigned i = 0; i < n; ++i )
+    {
+        unsigned index = _variableToIndex[i];
+        _workN[i] = _basicVariables.exists( i ) ?
+            _basicAssignment[index] : _nonBasicAssignment[index];
+    }
+
+    // Discard the new columns and rows. All arrays keep their
+    // capacity, and the discarded rows and columns are cleared when
+    // they are reused by addRow.
+    for ( unsigned i = 0; i < n; ++i )
+        _sparseColumnsOfA[i]->truncate( m );
+
+    for ( unsigned i = 0; i < m; ++i )
+        _sparseRowsOfA[i]->truncate( n );
+
+    _A->truncate( m, n );
+
+    // A smaller basis factorization
+    IBasisFactorization *newBasisFactorization =
+        BasisFactorizationFactory::createBasisFactorization( m, *this );
+    if ( !newBasisFactorization )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newBasisFactorization" );
+    delete _basisFactorization;
+    _basisFactorization = newBasisFactorization;
+    _basisFactorization->setStatistics( _statistics );
+
+    _m = m;
+    _n = n;
+
+    for ( const auto &watcher : _resizeWatchers )
+        watcher->notifyDimensionChange( _m, _n );
+}
+
 void Tableau::checkBoundsValid()
 {
     _boundsValid = true;
@@ -1782,13 +2257,11 @@ unsigned Tableau::addEquation( const Equation &equation )
         _workN[addend._variable] = addend._coefficient;
         _sparseColumnsOfA[addend._variable]->set( _m - 1, addend._coefficient );
         _sparseRowsOfA[_m - 1]->set( addend._variable, addend._coefficient );
-        _denseA[(addend._variable * _m) + _m - 1] = addend._coefficient;
     }
 
     _workN[auxVariable] = 1;
     _sparseColumnsOfA[auxVariable]->set( _m - 1, 1 );
     _sparseRowsOfA[_m - 1]->set( auxVariable, 1 );
-    _denseA[(auxVariable * _m) + _m - 1] = 1;
     _A->addLastRow( _workN );
 
     // Invalidate the cost function, so that it is recomputed in the next iteration.
@@ -1886,6 +2359,23 @@ unsigned Tableau::addEquation( const Equation &equation )
     return auxVariable;
 }
 
+/*
+  Replace an array with a larger one, keeping its first size entries
+*/
+template<typename T>
+static void growArray( T *&array, unsigned size, unsigned newSize )
+{
+    T *newArray = new T[newSize];
+    if ( !newArray )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::growArray" );
+
+    if ( size > 0 )
+        memcpy( newArray, array, sizeof(T) * size );
+
+    delete[] array;
+    array = newArray;
+}
+
 void Tableau::addRow()
 {
     unsigned newM = _m + 1;
@@ -1896,133 +2386,24 @@ void Tableau::addRow()
       the tableau to match newM and newN. Notice that newM = _m + 1 and
       newN = _n + 1, and so newN - newM = _n - _m. Consequently, structures
       that are of size _n - _m are left as is.
-    */
 
-    // Allocate a larger _sparseColumnsOfA, keep old ones
-    SparseUnsortedList **newSparseColumnsOfA = new SparseUnsortedList *[newN];
-    if ( !newSparseColumnsOfA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newSparseColumnsOfA" );
+      The arrays are only re-allocated when their capacity is exhausted,
+      in which case it grows by half, so that adding rows one at a time
+      takes amortized time proportional to the size of a row.
+    */
+    if ( newM > _allocatedM )
+        increaseCapacity( std::max( newM, _allocatedM + _allocatedM / 2 ) );
 
+    // The existing columns and rows get a new (empty) entry
     for ( unsigned i = 0; i < _n; ++i )
-    {
-        newSparseColumnsOfA[i] = _sparseColumnsOfA[i];
-        newSparseColumnsOfA[i]->incrementSize();
-    }
-
-    newSparseColumnsOfA[newN - 1] = new SparseUnsortedList( newM );
-    if ( !newSparseColumnsOfA[newN - 1] )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newSparseColumnsOfA[newN-1]" );
-
-    delete[] _sparseColumnsOfA;
-    _sparseColumnsOfA = newSparseColumnsOfA;
-
-    // Allocate a larger _sparseRowsOfA, keep old ones
-    SparseUnsortedList **newSparseRowsOfA = new SparseUnsortedList *[newM];
-    if ( !newSparseRowsOfA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newSparseRowsOfA" );
+        _sparseColumnsOfA[i]->incrementSize();
+    *_sparseColumnsOfA[newN - 1] = SparseUnsortedList( newM );
 
     for ( unsigned i = 0; i < _m; ++i )
-    {
-        newSparseRowsOfA[i] = _sparseRowsOfA[i];
-        newSparseRowsOfA[i]->incrementSize();
-    }
-
-    newSparseRowsOfA[newM - 1] = new SparseUnsortedList( newN );
-    if ( !newSparseRowsOfA[newM - 1] )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newSparseRowsOfA[newN-1]" );
+        _sparseRowsOfA[i]->incrementSize();
+    *_sparseRowsOfA[newM - 1] = SparseUnsortedList( newN );
 
-    delete[] _sparseRowsOfA;
-    _sparseRowsOfA = newSparseRowsOfA;
-
-    // Allocate a larger _denseA, keep old entries
-    double *newDenseA = new double[newM * newN];
-    if ( !newDenseA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newDenseA" );
-
-    for ( unsigned column = 0; column < _n; ++column )
-    {
-        memcpy( newDenseA + ( column * newM ), _denseA + ( column * _m ), sizeof(double) * _m );
-        newDenseA[column*newM + newM - 1] = 0.0;
-    }
-    std::fill_n( newDenseA + ( newN - 1 ) * newM, newM, 0.0 );
-
-    delete[] _denseA;
-    _denseA = newDenseA;
-
-    // Allocate a new changeColumn. Don't need to initialize
-    double *newChangeColumn = new double[newM];
-    if ( !newChangeColumn )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newChangeColumn" );
-    delete[] _changeColumn;
-    _changeColumn = newChangeColumn;
-
-    // Allocate a new b and copy the old values
-    double *newB = new double[newM];
-    if ( !newB )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newB" );
-    std::fill( newB + _m, newB + newM, 0.0 );
-    memcpy( newB, _b, _m * sizeof(double) );
-    delete[] _b;
-    _b = newB;
-
-    // Allocate a new unit vector. Don't need to initialize
-    double *newUnitVector = new double[newM];
-    if ( !newUnitVector )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newUnitVector" );
-    delete[] _unitVector;
-    _unitVector = newUnitVector;
-
-    // Allocate new multipliers. Don't need to initialize
-    double *newMultipliers = new double[newM];
-    if ( !newMultipliers )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newMultipliers" );
-    delete[] _multipliers;
-    _multipliers = newMultipliers;
-
-    // Allocate new index arrays. Copy old indices, but don't assign indices to new variables yet.
-    unsigned *newBasicIndexToVariable = new unsigned[newM];
-    if ( !newBasicIndexToVariable )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newBasicIndexToVariable" );
-    memcpy( newBasicIndexToVariable, _basicIndexToVariable, _m * sizeof(unsigned) );
-    delete[] _basicIndexToVariable;
-    _basicIndexToVariable = newBasicIndexToVariable;
-
-    unsigned *newVariableToIndex = new unsigned[newN];
-    if ( !newVariableToIndex )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newVariableToIndex" );
-    memcpy( newVariableToIndex, _variableToIndex, _n * sizeof(unsigned) );
-    delete[] _variableToIndex;
-    _variableToIndex = newVariableToIndex;
-
-    // Allocate a new basic assignment vector, copy old values
-    double *newBasicAssignment = new double[newM];
-    if ( !newBasicAssignment )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newAssignment" );
-    memcpy( newBasicAssignment, _basicAssignment, sizeof(double) * _m );
-    delete[] _basicAssignment;
-    _basicAssignment = newBasicAssignment;
-
-    unsigned *newBasicStatus = new unsigned[newM];
-    if ( !newBasicStatus )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newBasicStatus" );
-    memcpy( newBasicStatus, _basicStatus, sizeof(unsigned) * _m );
-    delete[] _basicStatus;
-    _basicStatus = newBasicStatus;
-
-    // Allocate new lower and upper bound arrays, and copy old values
-    double *newLowerBounds = new double[newN];
-    if ( !newLowerBounds )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newLowerBounds" );
-    memcpy( newLowerBounds, _lowerBounds, _n * sizeof(double) );
-    delete[] _lowerBounds;
-    _lowerBounds = newLowerBounds;
-
-    double *newUpperBounds = new double[newN];
-    if ( !newUpperBounds )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newUpperBounds" );
-    memcpy( newUpperBounds, _upperBounds, _n * sizeof(double) );
-    delete[] _upperBounds;
-    _upperBounds = newUpperBounds;
+    _b[_m] = 0.0;
 
     // Mark the new variable as unbounded
     _lowerBounds[_n] = FloatUtils::negativeInfinity();
@@ -2037,19 +2418,6 @@ void Tableau::addRow()
     _basisFactorization = newBasisFactorization;
     _basisFactorization->setStatistics( _statistics );
 
-    // Allocate a larger _workM and _workN. Don't need to initialize.
-    double *newWorkM = new double[newM];
-    if ( !newWorkM )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newWorkM" );
-    delete[] _workM;
-    _workM = newWorkM;
-
-    double *newWorkN = new double[newN];
-    if ( !newWorkN )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newWorkN" );
-    delete[] _workN;
-    _workN = newWorkN;
-
     _m = newM;
     _n = newN;
     _costFunctionManager->initialize();
@@ -2064,6 +2432,66 @@ void Tableau::addRow()
     }
 }
 
+void Tableau::increaseCapacity( unsigned m )
+{
+    ASSERT( m > _allocatedM );
+
+    unsigned newAllocatedM = m;
+    unsigned newAllocatedN = m + ( _n - _m );
+
+    // Pointers to the sparse columns and rows. The new slots get empty
+    // lists, which only allocate memory once entries are added.
+    SparseUnsortedList **newSparseColumnsOfA = new SparseUnsortedList *[newAllocatedN];
+    if ( !newSparseColumnsOfA )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newSparseColumnsOfA" );
+
+    memcpy( newSparseColumnsOfA, _sparseColumnsOfA, sizeof(SparseUnsortedList *) * _allocatedN );
+    for ( unsigned i = _allocatedN; i < newAllocatedN; ++i )
+    {
+        newSparseColumnsOfA[i] = new SparseUnsortedList;
+        if ( !newSparseColumnsOfA[i] )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newSparseColumnsOfA[i]" );
+    }
+
+    delete[] _sparseColumnsOfA;
+    _sparseColumnsOfA = newSparseColumnsOfA;
+
+    SparseUnsortedList **newSparseRowsOfA = new SparseUnsortedList *[newAllocatedM];
+    if ( !newSparseRowsOfA )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newSparseRowsOfA" );
+
+    memcpy( newSparseRowsOfA, _sparseRowsOfA, sizeof(SparseUnsortedList *) * _allocatedM );
+    for ( unsigned i = _allocatedM; i < newAllocatedM; ++i )
+    {
+        newSparseRowsOfA[i] = new SparseUnsortedList;
+        if ( !newSparseRowsOfA[i] )
+            throw MarabouError( MarabouError::ALLOCATION_FAILED, "Tableau::newSparseRowsOfA[i]" );
+    }
+
+    delete[] _sparseRowsOfA;
+    _sparseRowsOfA = newSparseRowsOfA;
+
+    // Arrays of size m, with or without their current values
+    growArray( _changeColumn, 0, newAllocatedM );
+    growArray( _b, _m, newAllocatedM );
+    growArray( _multipliers, 0, newAllocatedM );
+    growArray( _basicIndexToVariable, _m, newAllocatedM );
+    growArray( _basicAssignment, _m, newAllocatedM );
+    growArray( _basicStatus, _m, newAllocatedM );
+    growArray( _workM, 0, newAllocatedM );
+    growArray( _denseAColumn, 0, newAllocatedM );
+
+    // Arrays of size n. _workN is kept, as removeLastRows stores
+    // values in it.
+    growArray( _variableToIndex, _n, newAllocatedN );
+    growArray( _lowerBounds, _n, newAllocatedN );
+    growArray( _upperBounds, _n, newAllocatedN );
+    growArray( _workN, _n, newAllocatedN );
+
+    _allocatedM = newAllocatedM;
+    _allocatedN = newAllocatedN;
+}
+
 void Tableau::registerToWatchVariable( VariableWatcher *watcher, unsigned variable )
 {
     _variableToWatchers[variable].append( watcher );
@@ -2079,6 +2507,34 @@ void Tableau::registerToWatchAllVariables( VariableWatcher *watcher )
     _globalWatchers.append( watcher );
 }
 
+void Tableau::registerBatchedWatcher( VariableWatcher *watcher )
+{
+    _batchedWatchers.append( watcher );
+}
+
+void Tableau::flushBoundChanges()
+{
+    if ( _pendingBoundChanges.empty() )
+        return;
+
+    for ( auto &watcher : _batchedWatchers )
+        watcher->notifyBoundChanges( _pendingBoundChanges.data(), _pendingBoundChanges.size() );
+
+    _pendingBoundChanges.clear();
+}
+
+void Tableau::recordBoundChange( unsigned variable )
+{
+    if ( _batchedWatchers.empty() )
+        return;
+
+    // Lower and upper bounds are often set back to back
+    if ( !_pendingBoundChanges.empty() && _pendingBoundChanges.last() == variable )
+        return;
+
+    _pendingBoundChanges.append( variable );
+}
+
 void Tableau::registerResizeWatcher( ResizeWatcher *watcher )
 {
     _resizeWatchers.append( watcher );
@@ -2098,6 +2554,8 @@ void Tableau::notifyVariableValue( unsigned variable, double value )
 
 void Tableau::notifyLowerBound( unsigned variable, double bound )
 {
+    recordBoundChange( variable );
+
     for ( auto &watcher : _globalWatchers )
         watcher->notifyLowerBound( variable, bound );
 
@@ -2110,6 +2568,8 @@ void Tableau::notifyLowerBound( unsigned variable, double bound )
 
 void Tableau::notifyUpperBound( unsigned variable, double bound )
 {
+    recordBoundChange( variable );
+
     for ( auto &watcher : _globalWatchers )
         watcher->notifyUpperBound( variable, bound );
 
@@ -2130,6 +2590,11 @@ void Tableau::forwardTransformation( const double *y, double *x ) const
     _basisFactorization->forwardTransformation( y, x );
 }
 
+void Tableau::forwardTransformation( const double *y, double *x, unsigned numVectors ) const
+{
+    _basisFactorization->forwardTransformation( y, x, numVectors );
+}
+
 void Tableau::backwardTransformation( const double *y, double *x ) const
 {
     _basisFactorization->backwardTransformation( y, x );
@@ -2350,6 +2815,21 @@ void Tableau::updateAssignmentForPivot()
                 basicGoingToUpperBound = false;
         }
 
+        /*
+          After a long step, an out-of-bounds leaving variable may have
+          crossed its near bound and stopped at its far bound. This is
+          detected using the change ratio.
+        */
+        if ( GlobalConfiguration::USE_BOUND_FLIPPING_RATIO_TEST &&
+             ( _basicStatus[_leavingVariable] == Tableau::BELOW_LB ||
+               _basicStatus[_leavingVariable] == Tableau::ABOVE_UB ) )
+        {
+            double newValue = currentBasicValue - _changeColumn[_leavingVariable] * _changeRatio;
+            basicGoingToUpperBound =
+                FloatUtils::abs( newValue - _upperBounds[currentBasic] ) <
+                FloatUtils::abs( newValue - _lowerBounds[currentBasic] );
+        }
+
         if ( basicGoingToUpperBound )
             basicDelta = _upperBounds[currentBasic] - currentBasicValue;
         else
@@ -2388,6 +2868,10 @@ void Tableau::updateCostFunctionForPivot()
     if ( performingFakePivot() )
         return;
 
+    // An invalid cost function will be recomputed from scratch anyway
+    if ( _costFunctionManager->costFunctionInvalid() )
+        return;
+
     double pivotElement = -_changeColumn[_leavingVariable];
     double normalizedError = _costFunctionManager->updateCostFunctionForPivot( _enteringVariable,
                                                                                _leavingVariable,
@@ -2508,11 +2992,6 @@ void Tableau::mergeColumns( unsigned x1, unsigned x2 )
     for ( unsigned i = 0; i < _m; ++i )
         _sparseRowsOfA[i]->mergeEntries( x2, x1 );
 
-    // And the dense ones, too
-    for ( unsigned i = 0; i < _m; ++i )
-        _denseA[x1*_m + i] += _denseA[x2*_m + i];
-    std::fill_n( _denseA + x2 * _m, _m, 0 );
-
     computeAssignment();
     computeCostFunction();
 
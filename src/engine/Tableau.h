@@ -20,11 +20,14 @@
 #include "ITableau.h"
 #include "MString.h"
 #include "Map.h"
+#include "Pair.h"
 #include "Set.h"
 #include "SparseColumnsOfBasis.h"
 #include "SparseMatrix.h"
 #include "SparseUnsortedList.h"
 #include "Statistics.h"
+#include "TableauStateStorageLevel.h"
+#include "Vector.h"
 
 #define TABLEAU_LOG( x, ... ) LOG( GlobalConfiguration::TABLEAU_LOGGING, "Tableau: %s\n", x )
 
@@ -47,9 +50,11 @@ public:
     void setDimensions( unsigned m, unsigned n );
 
     /*
-      Initialize the constraint matrix
+      Initialize the constraint matrix, from a dense or a sparse
+      m x n matrix
     */
     void setConstraintMatrix( const double *A );
+    void setConstraintMatrix( const SparseMatrix *A );
 
     /*
       Set which variable will enter the basis. The input is the
@@ -82,6 +87,12 @@ public:
     void forwardTransformation( const double *y, double *x ) const;
     void backwardTransformation( const double *y, double *x ) const;
 
+    /*
+      Perform several forward transformations at once. Entry i of
+      vector r is stored at index i * numVectors + r.
+    */
+    void forwardTransformation( const double *y, double *x, unsigned numVectors ) const;
+
     /*
       Mark a variable as basic in the initial basis
      */
@@ -224,6 +235,15 @@ public:
     double getChangeRatio() const;
     void setChangeRatio( double changeRatio );
 
+    /*
+      The dual ratio test: pick the entering variable according to the
+      (already selected) out-of-bounds leaving variable, whose row must
+      have been computed into the pivot row. Returns false if no
+      non-basic variable can move the leaving variable towards its
+      violated bound.
+    */
+    bool pickEnteringVariableByDualRatioTest();
+
     /*
       Returns true iff the current iteration is a fake pivot, i.e. the
       entering variable jumping from one bound to the other.
@@ -280,7 +300,7 @@ public:
       basis, i.e. variables that can be changed in a way that would
       reduce the cost value.
     */
-    void getEntryCandidates( List<unsigned> &candidates ) const;
+    void getEntryCandidates( Vector<unsigned> &candidates ) const;
 
     /*
       Compute the multipliers for a given list of row coefficient.
@@ -322,8 +342,9 @@ public:
     void getTableauRow( unsigned index, TableauRow *row );
 
     /*
-      Get the original constraint matrix A or a column thereof,
-      in dense form.
+      Get the original constraint matrix A or a column thereof. A dense
+      column is written into a buffer owned by the tableau, which is
+      overwritten by the next call to getAColumn.
     */
     const SparseMatrix *getSparseA() const;
     const double *getAColumn( unsigned variable ) const;
@@ -343,10 +364,31 @@ public:
       - Basic and non-basic assignments
       - The current indexing
       - The current basis
+
+      Alternatively, the state can be stored as a mark into the bound
+      trail. In this case only the dimensions and the basic variables
+      are copied, and restoring the state rewinds the bound changes
+      and the rows added since the mark.
     */
-    void storeState( TableauState &state ) const;
+    void storeState( TableauState &state, TableauStateStorageLevel level ) const;
     void restoreState( const TableauState &state );
 
+    /*
+      For each of the given bounds, which must hold currently, find the
+      earliest point from which it has held without interruption, and
+      store the size of the bound trail at that point (0 if it has held
+      since before the first recorded change). Comparing these positions
+      to the trail marks of stored states reveals the state in which a
+      bound was established.
+    */
+    void getBoundTrailPositions( const List<Tightening> &bounds, Vector<unsigned> &positions ) const;
+
+    /*
+      Bound changes are only recorded in the trail while some stored
+      state refers to it. Turning the recording off clears the trail.
+    */
+    void setBoundTrailRecording( bool record );
+
     /*
       Register or unregister to watch a variable.
     */
@@ -354,6 +396,15 @@ public:
     void registerToWatchVariable( VariableWatcher *watcher, unsigned variable );
     void unregisterToWatchVariable( VariableWatcher *watcher, unsigned variable );
 
+    /*
+      Register a watcher that is interested in the bounds of all
+      variables, but only needs to catch up on them once per step.
+      Bound changes are buffered, and passed to the batched watchers
+      together when flushBoundChanges() is called.
+    */
+    void registerBatchedWatcher( VariableWatcher *watcher );
+    void flushBoundChanges();
+
     /*
       Register to watch for tableau dimension changes.
     */
@@ -453,6 +504,13 @@ private:
     HashMap<unsigned, VariableWatchers> _variableToWatchers;
     List<VariableWatcher *> _globalWatchers;
 
+    /*
+      Batched watchers, and the variables whose bounds have changed
+      since they were last notified
+    */
+    List<VariableWatcher *> _batchedWatchers;
+    Vector<unsigned> _pendingBoundChanges;
+
     /*
       Resize watchers
     */
@@ -465,14 +523,24 @@ private:
     unsigned _m;
 
     /*
-      The constraint matrix A, and a collection of its
-      sparse columns. The matrix is also stored in dense
-      form (column-major).
+      The number of rows and columns that the arrays of the tableau
+      have room for. Rows added during the search use this spare
+      capacity, which grows geometrically, and rows that are removed
+      leave it in place. Adding a row also adds a column, so
+      _allocatedN - _allocatedM always equals _n - _m.
+    */
+    unsigned _allocatedM;
+    unsigned _allocatedN;
+
+    /*
+      The constraint matrix A, and a collection of its sparse columns
+      and rows. A is only stored in sparse form, and dense columns are
+      expanded on demand into _denseAColumn.
     */
     SparseMatrix *_A;
     SparseUnsortedList **_sparseColumnsOfA;
     SparseUnsortedList **_sparseRowsOfA;
-    double *_denseA;
+    mutable double *_denseAColumn;
 
     /*
       Used to compute inv(B)*a
@@ -494,11 +562,12 @@ private:
     */
     double *_workM;
     double *_workN;
+    SparseUnsortedList *_sparseWorkM;
 
     /*
       A unit vector of size m
     */
-    double *_unitVector;
+    SparseUnsortedList *_unitVector;
 
     /*
       The current factorization of the basis
@@ -577,6 +646,12 @@ private:
     */
     bool _leavingVariableIncreases;
 
+    /*
+      Work space for the bound flipping ratio test: the breakpoints of
+      the out-of-bounds basic variables, as (step, basic index) pairs.
+    */
+    Vector<Pair<double, unsigned>> _breakpoints;
+
     /*
       The status of the basic assignment
     */
@@ -605,16 +680,64 @@ private:
      */
     bool _rhsIsAllZeros;
 
+    /*
+      The bound trail: every change to a lower or upper bound is
+      recorded together with the previous value of that bound, so
+      that states stored as trail marks can be restored by undoing
+      the changes in reverse order.
+    */
+    struct BoundTrailEntry
+    {
+        BoundTrailEntry( unsigned variable, bool isLowerBound, double previousValue )
+            : _variable( variable )
+            , _isLowerBound( isLowerBound )
+            , _previousValue( previousValue )
+        {
+        }
+
+        unsigned _variable;
+        bool _isLowerBound;
+        double _previousValue;
+    };
+
+    Vector<BoundTrailEntry> _boundTrail;
+    bool _recordBoundTrail;
+
     /*
       Free all allocated memory.
     */
     void freeMemoryIfNeeded();
 
+    /*
+      Restore a state that was stored as a bound trail mark: undo the
+      bound changes recorded after the mark, drop any rows that were
+      added since, and restore the basis if needed.
+    */
+    void restoreStateFromBoundTrail( const TableauState &state );
+
+    /*
+      Shrink the tableau back to m rows and n variables, discarding the
+      rows and auxiliary variables added by addEquation.
+    */
+    void removeLastRows( unsigned m, unsigned n );
+
     /*
       Resize the relevant data structures to add a new row to the tableau.
     */
     void addRow();
 
+    /*
+      Grow the arrays of the tableau so that they can hold at least
+      m rows, keeping their current contents
+    */
+    void increaseCapacity( unsigned m );
+
+    /*
+      Remember that a variable's bounds have changed, for the next
+      flush to the batched watchers.
+    */
+    void recordBoundChange( unsigned variable );
+
     /*
       Update the variable assignment to reflect a pivot operation,
       without re-computing it from scratch.
@@ -626,6 +749,7 @@ private:
     */
     void standardRatioTest( double *changeColumn );
     void harrisRatioTest( double *changeColumn );
+    void boundFlippingRatioTest( double *changeColumn );
 
     /*
       For debugging purposes only
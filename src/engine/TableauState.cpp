@@ -20,10 +20,11 @@
 #include "TableauState.h"
 
 TableauState::TableauState()
-    : _A( NULL )
+    : _storageLevel( TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE )
+    , _boundTrailSize( 0 )
+    , _A( NULL )
     , _sparseColumnsOfA( NULL )
     , _sparseRowsOfA( NULL )
-    , _denseA( NULL )
     , _b( NULL )
     , _lowerBounds( NULL )
     , _upperBounds( NULL )
@@ -74,12 +75,6 @@ TableauState::~TableauState()
         _sparseRowsOfA = NULL;
     }
 
-    if ( _denseA )
-    {
-        delete[] _denseA;
-        _denseA = NULL;
-    }
-
     if ( _b )
     {
         delete[] _b;
@@ -137,6 +132,7 @@ TableauState::~TableauState()
 
 void TableauState::setDimensions( unsigned m, unsigned n, const IBasisFactorization::BasisColumnOracle &oracle )
 {
+    _storageLevel = TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE;
     _m = m;
     _n = n;
 
@@ -166,10 +162,6 @@ void TableauState::setDimensions( unsigned m, unsigned n, const IBasisFactorizat
             throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::sparseRowsOfA[i]" );
     }
 
-    _denseA = new double[m*n];
-    if ( !_denseA )
-        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::denseA" );
-
     _b = new double[m];
     if ( !_b )
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::b" );
@@ -207,6 +199,20 @@ void TableauState::setDimensions( unsigned m, unsigned n, const IBasisFactorizat
         throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::basisFactorization" );
 }
 
+void TableauState::setDimensionsForBoundTrail( unsigned m, unsigned n )
+{
+    _storageLevel = TableauStateStorageLevel::STORE_BOUND_TRAIL;
+    _m = m;
+    _n = n;
+
+    if ( _basicIndexToVariable )
+        delete[] _basicIndexToVariable;
+
+    _basicIndexToVariable = new unsigned[m];
+    if ( !_basicIndexToVariable )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "TableauState::basicIndexToVariable" );
+}
+
 //
 // Local Variables:
 // compile-command: "make -C ../.. "
@@ -21,6 +21,7 @@
 #include "Map.h"
 #include "Set.h"
 #include "SparseMatrix.h"
+#include "TableauStateStorageLevel.h"
 
 class TableauState
 {
@@ -36,12 +37,27 @@ class TableauState
       - Basic assignment status
       - The current indexing
       - The current basis
+
+      A state stored as a bound trail only keeps the dimensions, the
+      basic variables and a mark into the tableau's bound trail. The
+      remaining elements are rewound from the trail upon restoration.
     */
 public:
     TableauState();
     ~TableauState();
 
     void setDimensions( unsigned m, unsigned n, const IBasisFactorization::BasisColumnOracle &oracle );
+    void setDimensionsForBoundTrail( unsigned m, unsigned n );
+
+    /*
+      Whether this is a complete copy of the tableau or a bound trail mark
+    */
+    TableauStateStorageLevel _storageLevel;
+
+    /*
+      The size of the tableau's bound trail when the state was stored
+    */
+    unsigned _boundTrailSize;
 
     /*
       The dimensions of matrix A
@@ -55,7 +71,6 @@ public:
     SparseMatrix *_A;
     SparseUnsortedList **_sparseColumnsOfA;
     SparseUnsortedList **_sparseRowsOfA;
-    double *_denseA;
 
     /*
       The right hand side
@@ -0,0 +1,44 @@
+/*********************                                                        */
+/*! \file TableauStateStorageLevel.h
+** \verbatim
+** Top contributors (to current version):
+**   Guy Katz
+** This file is part of the Marabou project.
+** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+** in the top-level source directory) and their institutional affiliations.
+** All rights reserved. See the file COPYING in the top-level source
+** directory for licensing information.\endverbatim
+**
+** The levels of detail at which the tableau can be stored in an
+** EngineState when the SMT core performs a split. Storing a bound trail
+** mark is cheap, but the trail must be recorded from the moment the
+** state is stored until it is restored.
+
+**/
+
+#ifndef __TableauStateStorageLevel_h__
+#define __TableauStateStorageLevel_h__
+
+enum class TableauStateStorageLevel
+{
+    // Do not store the tableau at all
+    STORE_NONE = 0,
+
+    // Store only a mark into the tableau's bound trail, together with the
+    // dimensions and the basic variables. Restoring rewinds the bound
+    // changes and added rows that occurred after the mark.
+    STORE_BOUND_TRAIL = 1,
+
+    // Store a complete copy of the tableau
+    STORE_ENTIRE_TABLEAU_STATE = 2,
+};
+
+#endif // __TableauStateStorageLevel_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,336 @@
+/*********************                                                        */
+/*! \file VariableValueMap.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** A flat map from variables to values, used by piecewise-linear
+ ** constraints to store the assignments and bounds of their
+ ** participating variables.
+ **
+ ** Constraints with a fixed set of participants (ReLU, absolute value,
+ ** sigmoid) give each of b, f and aux a fixed slot. A lookup of these
+ ** variables compares against at most FIXED_SLOTS keys at known
+ ** positions, and never touches the heap. All other entries (e.g., the
+ ** elements of max and disjunction constraints) are kept sorted by
+ ** variable and are found by binary search. The first few of them are
+ ** stored inline, and larger arrays grow by doubling.
+
+ **/
+
+#ifndef __VariableValueMap_h__
+#define __VariableValueMap_h__
+
+#include "CommonError.h"
+
+#include <cstring>
+
+class VariableValueMap
+{
+public:
+    enum {
+        // Enough for b, f and an auxiliary variable
+        FIXED_SLOTS = 3,
+        INLINE_CAPACITY = 3,
+    };
+
+    VariableValueMap()
+        : _numFixedSlots( 0 )
+        , _fixedSlotsInUse( 0 )
+        , _size( 0 )
+        , _capacity( INLINE_CAPACITY )
+        , _variables( _inlineVariables )
+        , _values( _inlineValues )
+    {
+    }
+
+    VariableValueMap( const VariableValueMap &other )
+        : _numFixedSlots( 0 )
+        , _fixedSlotsInUse( 0 )
+        , _size( 0 )
+        , _capacity( INLINE_CAPACITY )
+        , _variables( _inlineVariables )
+        , _values( _inlineValues )
+    {
+        *this = other;
+    }
+
+    ~VariableValueMap()
+    {
+        freeMemoryIfNeeded();
+    }
+
+    VariableValueMap &operator=( const VariableValueMap &other )
+    {
+        if ( this == &other )
+            return *this;
+
+        _numFixedSlots = other._numFixedSlots;
+        _fixedSlotsInUse = other._fixedSlotsInUse;
+        memcpy( _fixedVariables, other._fixedVariables, sizeof(unsigned) * _numFixedSlots );
+        memcpy( _fixedValues, other._fixedValues, sizeof(double) * _numFixedSlots );
+
+        reserve( other._size );
+        _size = other._size;
+        memcpy( _variables, other._variables, sizeof(unsigned) * _size );
+        memcpy( _values, other._values, sizeof(double) * _size );
+
+        return *this;
+    }
+
+    /*
+      Give the variable the next fixed slot. An existing entry for the
+      variable moves into the slot. Once all fixed slots are taken,
+      further variables are stored like any other.
+    */
+    void addFixedSlot( unsigned variable )
+    {
+        if ( _numFixedSlots == FIXED_SLOTS || findFixed( variable ) < _numFixedSlots )
+            return;
+
+        unsigned slot = _numFixedSlots++;
+        _fixedVariables[slot] = variable;
+
+        unsigned index = find( variable );
+        if ( index < _size && _variables[index] == variable )
+        {
+            _fixedValues[slot] = _values[index];
+            _fixedSlotsInUse |= ( 1 << slot );
+            removeAt( index );
+        }
+    }
+
+    bool exists( unsigned variable ) const
+    {
+        unsigned slot = findFixed( variable );
+        if ( slot < _numFixedSlots )
+            return _fixedSlotsInUse & ( 1 << slot );
+
+        unsigned index = find( variable );
+        return index < _size && _variables[index] == variable;
+    }
+
+    double get( unsigned variable ) const
+    {
+        unsigned slot = findFixed( variable );
+        if ( slot < _numFixedSlots )
+        {
+            if ( !( _fixedSlotsInUse & ( 1 << slot ) ) )
+                throw CommonError( CommonError::KEY_DOESNT_EXIST_IN_MAP );
+            return _fixedValues[slot];
+        }
+
+        unsigned index = find( variable );
+        if ( index == _size || _variables[index] != variable )
+            throw CommonError( CommonError::KEY_DOESNT_EXIST_IN_MAP );
+
+        return _values[index];
+    }
+
+    double operator[]( unsigned variable ) const
+    {
+        return get( variable );
+    }
+
+    /*
+      Return the value stored for the variable, adding an entry with
+      value 0 if there is none
+    */
+    double &operator[]( unsigned variable )
+    {
+        unsigned slot = findFixed( variable );
+        if ( slot < _numFixedSlots )
+        {
+            if ( !( _fixedSlotsInUse & ( 1 << slot ) ) )
+            {
+                _fixedValues[slot] = 0;
+                _fixedSlotsInUse |= ( 1 << slot );
+            }
+            return _fixedValues[slot];
+        }
+
+        unsigned index = find( variable );
+        if ( index == _size || _variables[index] != variable )
+        {
+            reserve( _size + 1 );
+            memmove( _variables + index + 1, _variables + index,
+                     sizeof(unsigned) * ( _size - index ) );
+            memmove( _values + index + 1, _values + index,
+                     sizeof(double) * ( _size - index ) );
+            _variables[index] = variable;
+            _values[index] = 0;
+            ++_size;
+        }
+
+        return _values[index];
+    }
+
+    /*
+      Remove the variable's entry. A fixed slot stays assigned to the
+      variable.
+    */
+    void erase( unsigned variable )
+    {
+        unsigned slot = findFixed( variable );
+        if ( slot < _numFixedSlots )
+        {
+            if ( !( _fixedSlotsInUse & ( 1 << slot ) ) )
+                throw CommonError( CommonError::KEY_DOESNT_EXIST_IN_MAP );
+            _fixedSlotsInUse &= ~( 1 << slot );
+            return;
+        }
+
+        unsigned index = find( variable );
+        if ( index == _size || _variables[index] != variable )
+            throw CommonError( CommonError::KEY_DOESNT_EXIST_IN_MAP );
+
+        removeAt( index );
+    }
+
+    /*
+      Move the entry of oldVariable, if any, to newVariable, which
+      should have no entry. A fixed slot moves along with it.
+    */
+    void renameVariable( unsigned oldVariable, unsigned newVariable )
+    {
+        unsigned slot = findFixed( oldVariable );
+        if ( slot < _numFixedSlots )
+        {
+            _fixedVariables[slot] = newVariable;
+            return;
+        }
+
+        if ( exists( oldVariable ) )
+        {
+            double value = get( oldVariable );
+            erase( oldVariable );
+            ( *this )[newVariable] = value;
+        }
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    unsigned size() const
+    {
+        unsigned size = _size;
+        for ( unsigned slot = 0; slot < _numFixedSlots; ++slot )
+        {
+            if ( _fixedSlotsInUse & ( 1 << slot ) )
+                ++size;
+        }
+        return size;
+    }
+
+    /*
+      Remove all entries. Fixed slots stay assigned.
+    */
+    void clear()
+    {
+        _fixedSlotsInUse = 0;
+        _size = 0;
+    }
+
+private:
+    unsigned _numFixedSlots;
+    unsigned _fixedSlotsInUse;
+    unsigned _fixedVariables[FIXED_SLOTS];
+    double _fixedValues[FIXED_SLOTS];
+
+    /*
+      Entries without a fixed slot, sorted by variable
+    */
+    unsigned _size;
+    unsigned _capacity;
+    unsigned *_variables;
+    double *_values;
+
+    unsigned _inlineVariables[INLINE_CAPACITY];
+    double _inlineValues[INLINE_CAPACITY];
+
+    /*
+      The fixed slot of the variable, or _numFixedSlots if it has none
+    */
+    unsigned findFixed( unsigned variable ) const
+    {
+        unsigned slot = 0;
+        while ( slot < _numFixedSlots && _fixedVariables[slot] != variable )
+            ++slot;
+        return slot;
+    }
+
+    /*
+      The index of the first sorted entry whose variable is not smaller
+      than the given one
+    */
+    unsigned find( unsigned variable ) const
+    {
+        unsigned low = 0;
+        unsigned high = _size;
+        while ( low < high )
+        {
+            unsigned middle = ( low + high ) / 2;
+            if ( _variables[middle] < variable )
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        return low;
+    }
+
+    void removeAt( unsigned index )
+    {
+        --_size;
+        memmove( _variables + index, _variables + index + 1,
+                 sizeof(unsigned) * ( _size - index ) );
+        memmove( _values + index, _values + index + 1,
+                 sizeof(double) * ( _size - index ) );
+    }
+
+    void reserve( unsigned capacity )
+    {
+        if ( capacity <= _capacity )
+            return;
+
+        unsigned newCapacity = 2 * _capacity;
+        if ( newCapacity < capacity )
+            newCapacity = capacity;
+
+        unsigned *newVariables = new unsigned[newCapacity];
+        double *newValues = new double[newCapacity];
+        memcpy( newVariables, _variables, sizeof(unsigned) * _size );
+        memcpy( newValues, _values, sizeof(double) * _size );
+
+        freeMemoryIfNeeded();
+
+        _variables = newVariables;
+        _values = newValues;
+        _capacity = newCapacity;
+    }
+
+    void freeMemoryIfNeeded()
+    {
+        if ( _variables != _inlineVariables )
+        {
+            delete[] _variables;
+            delete[] _values;
+        }
+    }
+};
+
+#endif // __VariableValueMap_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
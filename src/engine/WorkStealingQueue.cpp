@@ -0,0 +1,272 @@
+/*********************                                                        */
+/*! \file WorkStealingQueue.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "Debug.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "WorkStealingQueue.h"
+
+WorkStealingQueue::WorkStealingQueue( unsigned numWorkers,
+                                      std::atomic_uint &numUnsolvedSubQueries,
+                                      std::atomic_bool &shouldQuitSolving )
+    : _numWorkers( numWorkers )
+    , _deques( NULL )
+    , _numUnsolvedSubQueries( &numUnsolvedSubQueries )
+    , _shouldQuitSolving( &shouldQuitSolving )
+    , _numPendingSubQueries( 0 )
+    , _numIdleWorkers( 0 )
+{
+    ASSERT( _numWorkers > 0 );
+
+    _deques = new WorkerDeque[_numWorkers];
+    if ( !_deques )
+        throw MarabouError( MarabouError::ALLOCATION_FAILED, "WorkStealingQueue::deques" );
+
+    for ( unsigned i = 0; i < _numWorkers; ++i )
+    {
+        _deques[i]._currentTimeoutInSeconds = 0;
+        _deques[i]._numSharedSubtrees = 0;
+    }
+}
+
+WorkStealingQueue::~WorkStealingQueue()
+{
+    if ( _deques )
+    {
+        clear();
+        delete[] _deques;
+        _deques = NULL;
+    }
+}
+
+void WorkStealingQueue::push( unsigned workerId, SubQuery *subQuery )
+{
+    ASSERT( workerId < _numWorkers );
+
+    {
+        std::lock_guard<std::mutex> lock( _deques[workerId]._mutex );
+        _deques[workerId]._subQueries.push_back( subQuery );
+    }
+
+    ++_numPendingSubQueries;
+    notifyIdleWorker();
+}
+
+SubQuery *WorkStealingQueue::pop( unsigned workerId )
+{
+    while ( true )
+    {
+        SubQuery *subQuery = tryPop( workerId );
+        if ( subQuery )
+            return subQuery;
+
+        std::unique_lock<std::mutex> lock( _idleMutex );
+        if ( _shouldQuitSolving->load() )
+            return NULL;
+
+        ++_numIdleWorkers;
+        _idleCondition.wait( lock, [this]() {
+            return _numPendingSubQueries.load() > 0 || _shouldQuitSolving->load();
+        } );
+        --_numIdleWorkers;
+
+        if ( _shouldQuitSolving->load() )
+            return NULL;
+    }
+}
+
+SubQuery *WorkStealingQueue::tryPop( unsigned workerId )
+{
+    ASSERT( workerId < _numWorkers );
+
+    SubQuery *subQuery = popOwn( workerId );
+    if ( !subQuery )
+        subQuery = steal( workerId );
+
+    return subQuery;
+}
+
+SubQuery *WorkStealingQueue::popOwn( unsigned workerId )
+{
+    std::lock_guard<std::mutex> lock( _deques[workerId]._mutex );
+    std::deque<SubQuery *> &subQueries = _deques[workerId]._subQueries;
+    if ( subQueries.empty() )
+        return NULL;
+
+    SubQuery *subQuery = subQueries.back();
+    subQueries.pop_back();
+    --_numPendingSubQueries;
+    return subQuery;
+}
+
+SubQuery *WorkStealingQueue::steal( unsigned workerId )
+{
+    if ( _numPendingSubQueries.load() == 0 )
+        return NULL;
+
+    // Find the victim with the most pending subqueries
+    unsigned victim = workerId;
+    unsigned victimSize = 0;
+    for ( unsigned i = 0; i < _numWorkers; ++i )
+    {
+        if ( i == workerId )
+            continue;
+
+        std::lock_guard<std::mutex> lock( _deques[i]._mutex );
+        if ( _deques[i]._subQueries.size() > victimSize )
+        {
+            victim = i;
+            victimSize = _deques[i]._subQueries.size();
+        }
+    }
+
+    if ( victimSize == 0 )
+        return NULL;
+
+    // Take half of the victim's subqueries (rounded up) from the front,
+    // where the oldest and typically largest subqueries are
+    SubQueries stolen;
+    {
+        std::lock_guard<std::mutex> lock( _deques[victim]._mutex );
+        std::deque<SubQuery *> &subQueries = _deques[victim]._subQueries;
+        unsigned numToSteal = ( subQueries.size() + 1 ) / 2;
+        for ( unsigned i = 0; i < numToSteal; ++i )
+        {
+            stolen.append( subQueries.front() );
+            subQueries.pop_front();
+        }
+    }
+
+    // The victim may have drained its deque in the meantime
+    if ( stolen.empty() )
+        return NULL;
+
+    SubQuery *subQuery = stolen.front();
+    stolen.popFront();
+    --_numPendingSubQueries;
+
+    if ( !stolen.empty() )
+    {
+        std::lock_guard<std::mutex> lock( _deques[workerId]._mutex );
+        for ( const auto &stolenSubQuery : stolen )
+            _deques[workerId]._subQueries.push_back( stolenSubQuery );
+    }
+
+    return subQuery;
+}
+
+void WorkStealingQueue::startSubQuery( unsigned workerId, const SubQuery &subQuery )
+{
+    ASSERT( workerId < _numWorkers );
+
+    // Only the owning worker reads or writes this information
+    WorkerDeque &deque = _deques[workerId];
+    deque._currentQueryId = subQuery._queryId;
+    deque._currentSplit = *subQuery._split;
+    deque._currentTimeoutInSeconds = subQuery._timeoutInSeconds;
+    deque._numSharedSubtrees = 0;
+}
+
+bool WorkStealingQueue::workersAreStarving() const
+{
+    return _numIdleWorkers.load() > 0 && _numPendingSubQueries.load() == 0;
+}
+
+void WorkStealingQueue::shareSubtree( unsigned workerId, const PiecewiseLinearCaseSplit &subtree )
+{
+    ASSERT( workerId < _numWorkers );
+
+    WorkerDeque &deque = _deques[workerId];
+
+    auto split = std::unique_ptr<PiecewiseLinearCaseSplit>
+        ( new PiecewiseLinearCaseSplit( deque._currentSplit ) );
+    for ( const auto &bound : subtree.getBoundTightenings() )
+        split->storeBoundTightening( bound );
+    for ( const auto &equation : subtree.getEquations() )
+        split->addEquation( equation );
+
+    String queryId = deque._currentQueryId +
+        Stringf( "-s%u", ++deque._numSharedSubtrees );
+
+    SubQuery *subQuery = new SubQuery( queryId, split, deque._currentTimeoutInSeconds );
+
+    // The subquery counts as unsolved before it becomes visible, so that
+    // the count cannot drop to zero while it is pending
+    *_numUnsolvedSubQueries += 1;
+    push( workerId, subQuery );
+}
+
+unsigned WorkStealingQueue::getNumSharedSubtrees( unsigned workerId ) const
+{
+    ASSERT( workerId < _numWorkers );
+
+    // Only the owning worker reads or writes this information
+    return _deques[workerId]._numSharedSubtrees;
+}
+
+void WorkStealingQueue::quit()
+{
+    {
+        std::lock_guard<std::mutex> lock( _idleMutex );
+        *_shouldQuitSolving = true;
+    }
+    _idleCondition.notify_all();
+}
+
+void WorkStealingQueue::notifyIdleWorker()
+{
+    // Taking the lock ensures that a worker that is about to wait has
+    // either seen the new subquery or is already waiting
+    {
+        std::lock_guard<std::mutex> lock( _idleMutex );
+    }
+    _idleCondition.notify_one();
+}
+
+unsigned WorkStealingQueue::getNumPendingSubQueries() const
+{
+    return _numPendingSubQueries.load();
+}
+
+bool WorkStealingQueue::empty() const
+{
+    return _numPendingSubQueries.load() == 0;
+}
+
+unsigned WorkStealingQueue::clear()
+{
+    unsigned counter = 0;
+    for ( unsigned i = 0; i < _numWorkers; ++i )
+    {
+        std::lock_guard<std::mutex> lock( _deques[i]._mutex );
+        for ( auto &subQuery : _deques[i]._subQueries )
+        {
+            delete subQuery;
+            ++counter;
+        }
+        _deques[i]._subQueries.clear();
+    }
+
+    _numPendingSubQueries -= counter;
+    return counter;
+}
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,164 @@
+/*********************                                                        */
+/*! \file WorkStealingQueue.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The scheduler that distributes subqueries among DnC workers. Every
+ ** worker owns a deque of pending subqueries: it pushes and pops at the
+ ** back of its own deque, and when that deque runs dry it steals half
+ ** of the pending subqueries from the front of the fullest deque.
+ ** Workers that find no work at all block on a condition variable
+ ** until a subquery is pushed or solving is over.
+ **
+ ** While some workers are idle and no subquery is pending, a busy
+ ** worker can also share an unexplored subtree of its SMT stack, which
+ ** is packaged as a new subquery on top of the subquery that the worker
+ ** is currently solving.
+
+ **/
+
+#ifndef __WorkStealingQueue_h__
+#define __WorkStealingQueue_h__
+
+#include "MString.h"
+#include "PiecewiseLinearCaseSplit.h"
+#include "SubQuery.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+class WorkStealingQueue
+{
+public:
+    WorkStealingQueue( unsigned numWorkers,
+                       std::atomic_uint &numUnsolvedSubQueries,
+                       std::atomic_bool &shouldQuitSolving );
+    ~WorkStealingQueue();
+
+    /*
+      Push a subquery to the back of the given worker's deque. The queue
+      takes ownership of the subquery.
+    */
+    void push( unsigned workerId, SubQuery *subQuery );
+
+    /*
+      Pop a subquery for the given worker: from the back of its own
+      deque, or by stealing from another worker. If there is no pending
+      subquery, block until one is pushed. Return NULL once solving is
+      over.
+    */
+    SubQuery *pop( unsigned workerId );
+
+    /*
+      Like pop(), but return NULL instead of blocking.
+    */
+    SubQuery *tryPop( unsigned workerId );
+
+    /*
+      Record the subquery that a worker is currently solving, so that
+      subtrees of its search can later be shared as new subqueries.
+    */
+    void startSubQuery( unsigned workerId, const SubQuery &subQuery );
+
+    /*
+      Returns true iff some worker is waiting for work and there is no
+      pending subquery to hand to it.
+    */
+    bool workersAreStarving() const;
+
+    /*
+      Package a subtree of the given worker's current search as a new
+      subquery, and make it available for stealing.
+    */
+    void shareSubtree( unsigned workerId, const PiecewiseLinearCaseSplit &subtree );
+
+    /*
+      The number of subtrees that the worker has shared since it started
+      its current subquery.
+    */
+    unsigned getNumSharedSubtrees( unsigned workerId ) const;
+
+    /*
+      Signal that solving is over and wake up any waiting workers.
+    */
+    void quit();
+
+    /*
+      The number of subqueries currently waiting to be solved.
+    */
+    unsigned getNumPendingSubQueries() const;
+    bool empty() const;
+
+    /*
+      Delete all pending subqueries and return how many were deleted.
+    */
+    unsigned clear();
+
+private:
+    /*
+      The deque of a single worker, and information about the subquery
+      that it is currently solving.
+    */
+    struct WorkerDeque
+    {
+        std::mutex _mutex;
+        std::deque<SubQuery *> _subQueries;
+
+        String _currentQueryId;
+        PiecewiseLinearCaseSplit _currentSplit;
+        unsigned _currentTimeoutInSeconds;
+        unsigned _numSharedSubtrees;
+    };
+
+    /*
+      Pop from the back of the worker's own deque.
+    */
+    SubQuery *popOwn( unsigned workerId );
+
+    /*
+      Steal half of the pending subqueries of the fullest other deque.
+      One of them is returned, the rest go to the thief's own deque.
+    */
+    SubQuery *steal( unsigned workerId );
+
+    /*
+      Wake up one waiting worker, if there is any.
+    */
+    void notifyIdleWorker();
+
+    unsigned _numWorkers;
+    WorkerDeque *_deques;
+
+    /*
+      Shared with the DnC manager and workers
+    */
+    std::atomic_uint *_numUnsolvedSubQueries;
+    std::atomic_bool *_shouldQuitSolving;
+
+    std::atomic_uint _numPendingSubQueries;
+    std::atomic_uint _numIdleWorkers;
+
+    /*
+      Idle workers wait on this condition
+    */
+    std::mutex _idleMutex;
+    std::condition_variable _idleCondition;
+};
+
+#endif // __WorkStealingQueue_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -59,6 +59,7 @@ void printHelpMessage()
     std::cout << "\t--help - Prints the help message " << std::endl;
     std::cout << "\t--version - Prints the version " << std::endl;
     std::cout << "\t--pl-aux-eq - PL constraints generate auxiliary equations" <<std::endl;
+    std::cout << "\t--lp-tightening - Tighten neuron bounds during the search with the native LP solver" << std::endl;
     std::cout << "\t--dnc - Use the divide-and-conquer solving mode " << std::endl;
     std::cout << "\t--num-workers - (DNC) Number of workers " << std::endl;
     std::cout << "\t--initial-divides - (DNC) Number of initial bisections over input range" << std::endl;
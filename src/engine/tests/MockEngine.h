@@ -19,6 +19,7 @@
 #include "IEngine.h"
 #include "List.h"
 #include "PiecewiseLinearCaseSplit.h"
+#include "WorkStealingQueue.h"
 
 class MockEngine : public IEngine
 {
@@ -29,6 +30,11 @@ public:
         wasDiscarded = false;
 
         lastStoredState = NULL;
+        lastStorageLevel = TableauStateStorageLevel::STORE_NONE;
+        lastBoundTrailRecording = false;
+        lastRestoredState = NULL;
+        timesBacktrackedToRoot = 0;
+        workStealingQueue = NULL;
     }
 
     ~MockEngine()
@@ -89,9 +95,21 @@ public:
     }
 
     mutable EngineState *lastStoredState;
-    void storeState( EngineState &state, bool /* storeAlsoTableauState */ ) const
+    mutable TableauStateStorageLevel lastStorageLevel;
+    void storeState( EngineState &state, TableauStateStorageLevel level ) const
     {
         lastStoredState = &state;
+        lastStorageLevel = level;
+    }
+
+    void refreshBoundTrailState( EngineState &/* state */ ) const
+    {
+    }
+
+    bool lastBoundTrailRecording;
+    void setBoundTrailRecording( bool record )
+    {
+        lastBoundTrailRecording = record;
     }
 
     const EngineState *lastRestoredState;
@@ -106,8 +124,13 @@ public:
 
     unsigned _timeToSolve;
     IEngine::ExitCode _exitCode;
+    WorkStealingQueue *workStealingQueue;
+    List<PiecewiseLinearCaseSplit> subtreesToShare;
     bool solve( unsigned timeoutInSeconds )
     {
+        for ( const auto &subtree : subtreesToShare )
+            workStealingQueue->shareSubtree( 0, subtree );
+
         if ( timeoutInSeconds >= _timeToSolve )
             _exitCode = IEngine::TIMEOUT;
         return _exitCode == IEngine::SAT;
@@ -132,6 +155,18 @@ public:
     {
     }
 
+    unsigned timesBacktrackedToRoot;
+    void backtrackToRoot()
+    {
+        ++timesBacktrackedToRoot;
+    }
+
+    List<PiecewiseLinearCaseSplit> remainingSubtrees;
+    void splitOffRemainingSubtrees( List<PiecewiseLinearCaseSplit> &subtrees )
+    {
+        subtrees = remainingSubtrees;
+    }
+
     List<unsigned> _inputVariables;
     void setInputVariables( List<unsigned> &inputVariables )
     {
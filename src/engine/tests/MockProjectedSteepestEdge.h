@@ -52,7 +52,7 @@ public:
     }
 
     bool select( ITableau &,
-                 const List<unsigned> &,
+                 const Vector<unsigned> &,
                  const Set<unsigned> & )
     {
         return true;
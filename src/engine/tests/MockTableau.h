@@ -19,6 +19,7 @@
 #include "FloatUtils.h"
 #include "ITableau.h"
 #include "Map.h"
+#include "SparseMatrix.h"
 #include "SparseUnsortedList.h"
 #include "TableauRow.h"
 
@@ -33,11 +34,14 @@ public:
 		wasDiscarded = false;
 
         setDimensionsCalled = false;
+        lastBoundTrailRecording = false;
         lastRightHandSide = NULL;
         initializeTableauCalled = false;
 
         lastBtranInput = NULL;
         nextBtranOutput = NULL;
+        nextFtranOutput = NULL;
+        nextInverseBasis = NULL;
 
         lastEntries = NULL;
         nextCostFunction = NULL;
@@ -67,6 +71,12 @@ public:
             nextBtranOutput = NULL;
         }
 
+        if ( nextFtranOutput )
+        {
+            delete[] nextFtranOutput;
+            nextFtranOutput = NULL;
+        }
+
         if ( lastEntries )
         {
             delete[] lastEntries;
@@ -83,9 +93,9 @@ public:
 	bool wasCreated;
 	bool wasDiscarded;
 
-    List<unsigned> mockCandidates;
+    Vector<unsigned> mockCandidates;
     unsigned mockEnteringVariable;
-    void getEntryCandidates( List<unsigned> &candidates ) const
+    void getEntryCandidates( Vector<unsigned> &candidates ) const
     {
         candidates = mockCandidates;
     }
@@ -135,6 +145,12 @@ public:
         memcpy( lastEntries, A, sizeof(double) * lastM * lastN );
     }
 
+    void setConstraintMatrix( const SparseMatrix *A )
+    {
+        TS_ASSERT( setDimensionsCalled );
+        A->toDense( lastEntries );
+    }
+
     double *lastRightHandSide;
     void setRightHandSide( const double * b )
     {
@@ -243,6 +259,7 @@ public:
 
     void pickLeavingVariable() {};
     void pickLeavingVariable( double */* d */ ) {}
+    bool pickEnteringVariableByDualRatioTest() { return false; }
 
     unsigned mockLeavingVariable;
     void setLeavingVariableIndex( unsigned basic )
@@ -465,7 +482,7 @@ public:
     {
     }
 
-    void storeState( TableauState &/* state */ ) const
+    void storeState( TableauState &/* state */, TableauStateStorageLevel /* level */ ) const
     {
     }
 
@@ -473,6 +490,18 @@ public:
     {
     }
 
+    bool lastBoundTrailRecording;
+    void setBoundTrailRecording( bool record )
+    {
+        lastBoundTrailRecording = record;
+    }
+
+    Vector<unsigned> nextBoundTrailPositions;
+    void getBoundTrailPositions( const List<Tightening> &/* bounds */, Vector<unsigned> &positions ) const
+    {
+        positions = nextBoundTrailPositions;
+    }
+
     Map<unsigned, double> tightenedLowerBounds;
     void tightenLowerBound( unsigned variable, double value )
     {
@@ -493,6 +522,14 @@ public:
     {
     }
 
+    void registerBatchedWatcher( VariableWatcher */* watcher */ )
+    {
+    }
+
+    void flushBoundChanges()
+    {
+    }
+
     Set<ResizeWatcher *> lastResizeWatchers;
     void registerResizeWatcher( ResizeWatcher *watcher )
     {
@@ -532,7 +569,38 @@ public:
         return b;
     }
 
-    void forwardTransformation( const double *, double * ) const {}
+    /*
+      If set, the forward transformations compute inv(B) * y using
+      this m x m matrix (stored row by row), and
+      getInverseBasisMatrix() returns a copy of it
+    */
+    const double *nextInverseBasis;
+
+    double *nextFtranOutput;
+    void forwardTransformation( const double *y, double *x ) const
+    {
+        if ( nextFtranOutput )
+            memcpy( x, nextFtranOutput, lastM * sizeof(double) );
+        else if ( nextInverseBasis )
+            forwardTransformation( y, x, 1 );
+    }
+
+    void forwardTransformation( const double *y, double *x, unsigned numVectors ) const
+    {
+        TS_ASSERT( nextInverseBasis );
+
+        // Entry i of vector r is stored at i * numVectors + r
+        for ( unsigned i = 0; i < lastM; ++i )
+        {
+            for ( unsigned r = 0; r < numVectors; ++r )
+            {
+                double sum = 0;
+                for ( unsigned k = 0; k < lastM; ++k )
+                    sum += nextInverseBasis[i * lastM + k] * y[k * numVectors + r];
+                x[i * numVectors + r] = sum;
+            }
+        }
+    }
 
     mutable double *lastBtranInput;
     double *nextBtranOutput;
@@ -562,7 +630,12 @@ public:
 
     double *getInverseBasisMatrix() const
     {
-        return NULL;
+        if ( !nextInverseBasis )
+            return NULL;
+
+        double *result = new double[lastM * lastM];
+        memcpy( result, nextInverseBasis, lastM * lastM * sizeof(double) );
+        return result;
     }
 
     void refreshBasisFactorization()
@@ -0,0 +1,130 @@
+/*********************                                                        */
+/*! \file RealEngineFactories.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Supplies the real tableau, bound tighteners and other components to
+ ** an Engine created within a unit test, so that the engine and its
+ ** SMT core can be tested together without mocks. The last tableau
+ ** created is kept for inspecting its bounds.
+
+**/
+
+#ifndef __RealEngineFactories_h__
+#define __RealEngineFactories_h__
+
+#include "ConstraintBoundTightener.h"
+#include "ConstraintMatrixAnalyzer.h"
+#include "CostFunctionManager.h"
+#include "ProjectedSteepestEdge.h"
+#include "RowBoundTightener.h"
+#include "Tableau.h"
+
+#include "T/ConstraintBoundTightenerFactory.h"
+#include "T/ConstraintMatrixAnalyzerFactory.h"
+#include "T/CostFunctionManagerFactory.h"
+#include "T/ProjectedSteepestEdgeFactory.h"
+#include "T/RowBoundTightenerFactory.h"
+#include "T/TableauFactory.h"
+
+class RealEngineFactories :
+    public T::Base_createTableau,
+    public T::Base_discardTableau,
+    public T::Base_createProjectedSteepestEdgeRule,
+    public T::Base_discardProjectedSteepestEdgeRule,
+    public T::Base_createRowBoundTightener,
+    public T::Base_discardRowBoundTightener,
+    public T::Base_createConstraintBoundTightener,
+    public T::Base_discardConstraintBoundTightener,
+    public T::Base_createCostFunctionManager,
+    public T::Base_discardCostFunctionManager,
+    public T::Base_createConstraintMatrixAnalyzer,
+    public T::Base_discardConstraintMatrixAnalyzer
+{
+public:
+    RealEngineFactories()
+        : lastTableau( NULL )
+    {
+    }
+
+    Tableau *lastTableau;
+
+    ITableau *createTableau()
+    {
+        lastTableau = new Tableau;
+        return lastTableau;
+    }
+
+    void discardTableau( ITableau *tableau )
+    {
+        if ( tableau == lastTableau )
+            lastTableau = NULL;
+        delete tableau;
+    }
+
+    IProjectedSteepestEdgeRule *createProjectedSteepestEdgeRule()
+    {
+        return new ProjectedSteepestEdgeRule;
+    }
+
+    void discardProjectedSteepestEdgeRule( IProjectedSteepestEdgeRule *rule )
+    {
+        delete rule;
+    }
+
+    IRowBoundTightener *createRowBoundTightener( const ITableau &tableau )
+    {
+        return new RowBoundTightener( tableau );
+    }
+
+    void discardRowBoundTightener( IRowBoundTightener *rowBoundTightener )
+    {
+        delete rowBoundTightener;
+    }
+
+    IConstraintBoundTightener *createConstraintBoundTightener( const ITableau &tableau )
+    {
+        return new ConstraintBoundTightener( tableau );
+    }
+
+    void discardConstraintBoundTightener( IConstraintBoundTightener *constraintBoundTightener )
+    {
+        delete constraintBoundTightener;
+    }
+
+    ICostFunctionManager *createCostFunctionManager( ITableau *tableau )
+    {
+        return new CostFunctionManager( tableau );
+    }
+
+    void discardCostFunctionManager( ICostFunctionManager *costFunctionManager )
+    {
+        delete costFunctionManager;
+    }
+
+    IConstraintMatrixAnalyzer *createConstraintMatrixAnalyzer()
+    {
+        return new ConstraintMatrixAnalyzer;
+    }
+
+    void discardConstraintMatrixAnalyzer( IConstraintMatrixAnalyzer *constraintMatrixAnalyzer )
+    {
+        delete constraintMatrixAnalyzer;
+    }
+};
+
+#endif // __RealEngineFactories_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -49,7 +49,7 @@ public:
         BlandsRule blandsRule;
 
         Set<unsigned> excluded;
-        List<unsigned> candidates;
+        Vector<unsigned> candidates;
 
         TS_ASSERT( !blandsRule.select( *tableau, candidates, excluded ) );
 
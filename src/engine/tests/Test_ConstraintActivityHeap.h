@@ -0,0 +1,116 @@
+/*********************                                                        */
+/*! \file Test_ConstraintActivityHeap.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "ConstraintActivityHeap.h"
+#include "FloatUtils.h"
+#include "MockErrno.h"
+#include "ReluConstraint.h"
+
+class MockForConstraintActivityHeap
+    : public MockErrno
+{
+public:
+};
+
+class ConstraintActivityHeapTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForConstraintActivityHeap *mock;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForConstraintActivityHeap );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    void test_bump_and_pick()
+    {
+        // Variable 2 is shared by the first two constraints
+        ReluConstraint relu1( 0, 2 );
+        ReluConstraint relu2( 2, 3 );
+        ReluConstraint relu3( 4, 5 );
+
+        List<PiecewiseLinearConstraint *> constraints = { &relu1, &relu2, &relu3 };
+
+        ConstraintActivityHeap heap;
+        TS_ASSERT_THROWS_NOTHING( heap.initialize( constraints ) );
+        TS_ASSERT_EQUALS( heap.getHeapSize(), 3U );
+
+        // All activities are zero, so the original order is kept
+        TS_ASSERT_EQUALS( heap.getMostActiveConstraint(), &relu1 );
+        TS_ASSERT( FloatUtils::isZero( heap.getActivity( &relu1 ) ) );
+
+        TS_ASSERT_THROWS_NOTHING( heap.bumpConstraint( &relu3 ) );
+        TS_ASSERT_EQUALS( heap.getMostActiveConstraint(), &relu3 );
+        TS_ASSERT( FloatUtils::areEqual( heap.getActivity( &relu3 ), 1 ) );
+
+        // Bumping a variable bumps all of its constraints
+        TS_ASSERT_THROWS_NOTHING( heap.bumpVariable( 2 ) );
+        TS_ASSERT( FloatUtils::areEqual( heap.getActivity( &relu1 ), 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( heap.getActivity( &relu2 ), 1 ) );
+
+        // After a decay, new bumps weigh more than old ones
+        TS_ASSERT_THROWS_NOTHING( heap.decay() );
+        TS_ASSERT_THROWS_NOTHING( heap.bumpVariable( 3 ) );
+        TS_ASSERT( FloatUtils::gt( heap.getActivity( &relu2 ), 2 ) );
+        TS_ASSERT_EQUALS( heap.getMostActiveConstraint(), &relu2 );
+
+        // Unknown variables are ignored
+        TS_ASSERT_THROWS_NOTHING( heap.bumpVariable( 100 ) );
+        TS_ASSERT_EQUALS( heap.getHeapSize(), 3U );
+    }
+
+    void test_inactive_constraints_are_skipped()
+    {
+        ReluConstraint relu1( 0, 1 );
+        ReluConstraint relu2( 2, 3 );
+
+        List<PiecewiseLinearConstraint *> constraints = { &relu1, &relu2 };
+
+        ConstraintActivityHeap heap;
+        heap.initialize( constraints );
+        heap.bumpConstraint( &relu1 );
+        TS_ASSERT_EQUALS( heap.getMostActiveConstraint(), &relu1 );
+
+        relu1.setActiveConstraint( false );
+        TS_ASSERT_EQUALS( heap.getMostActiveConstraint(), &relu2 );
+        TS_ASSERT_EQUALS( heap.getHeapSize(), 1U );
+
+        relu2.setActiveConstraint( false );
+        TS_ASSERT( !heap.getMostActiveConstraint() );
+        TS_ASSERT_EQUALS( heap.getHeapSize(), 0U );
+
+        // Once re-activated, the constraints are found again
+        relu1.setActiveConstraint( true );
+        relu2.setActiveConstraint( true );
+        TS_ASSERT_THROWS_NOTHING( heap.reinsertRemovedConstraints() );
+        TS_ASSERT_EQUALS( heap.getHeapSize(), 2U );
+        TS_ASSERT_EQUALS( heap.getMostActiveConstraint(), &relu1 );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
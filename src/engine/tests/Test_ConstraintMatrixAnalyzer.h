@@ -16,7 +16,9 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "CSRMatrix.h"
 #include "ConstraintMatrixAnalyzer.h"
+#include "GlobalConfiguration.h"
 
 #include <string.h>
 #include <cstdio>
@@ -294,6 +296,67 @@ public:
             TS_ASSERT_THROWS_NOTHING( delete analyzer );
         }
     }
+
+    void test_sparse_analysis()
+    {
+        /*
+          The first 50 rows are independent: each has its own column
+          in the first 100 columns. The last 10 rows are combinations
+          of the first ones.
+        */
+        const unsigned m = 60;
+        const unsigned n = 200;
+        TS_ASSERT_LESS_THAN( GlobalConfiguration::CONSTRAINT_MATRIX_ANALYZER_DENSE_SIZE_LIMIT, m * n );
+
+        double *A = new double[m * n];
+        std::fill_n( A, m * n, 0.0 );
+
+        for ( unsigned i = 0; i < 50; ++i )
+        {
+            A[i * n + 2 * i] = 1 + ( i % 3 );
+            A[i * n + 100 + ( 3 * i ) % 100] = 1;
+            A[i * n + 100 + ( 5 * i + 1 ) % 100] -= 1;
+        }
+
+        for ( unsigned k = 0; k < 10; ++k )
+            for ( unsigned j = 0; j < n; ++j )
+                A[( 50 + k ) * n + j] = A[k * n + j] + 2 * A[( k + 10 ) * n + j] - A[( k + 20 ) * n + j];
+
+        CSRMatrix sparseA( A, m, n );
+
+        ConstraintMatrixAnalyzer analyzer;
+        TS_ASSERT_THROWS_NOTHING( analyzer.analyze( &sparseA, m, n ) );
+
+        TS_ASSERT_EQUALS( analyzer.getRank(), 50U );
+        TS_ASSERT_EQUALS( analyzer.getRedundantRows().size(), 10U );
+
+        List<unsigned> independentColumns = analyzer.getIndependentColumns();
+        TS_ASSERT_EQUALS( independentColumns.size(), 50U );
+
+        // The remaining rows, restricted to the independent columns,
+        // form a non-singular matrix
+        Set<unsigned> redundantRows = analyzer.getRedundantRows();
+        double *B = new double[50 * 50];
+        unsigned row = 0;
+        for ( unsigned i = 0; i < m; ++i )
+        {
+            if ( redundantRows.exists( i ) )
+                continue;
+
+            unsigned column = 0;
+            for ( const auto &j : independentColumns )
+                B[row * 50 + column++] = A[i * n + j];
+            ++row;
+        }
+        TS_ASSERT_EQUALS( row, 50U );
+
+        ConstraintMatrixAnalyzer denseAnalyzer;
+        TS_ASSERT_THROWS_NOTHING( denseAnalyzer.analyze( B, 50, 50 ) );
+        TS_ASSERT_EQUALS( denseAnalyzer.getRank(), 50U );
+
+        delete[] B;
+        delete[] A;
+    }
 };
 
 //
@@ -50,7 +50,7 @@ public:
         DantzigsRule dantzigsRule;
 
         Set<unsigned> excluded;
-        List<unsigned> candidates;
+        Vector<unsigned> candidates;
 
         TS_ASSERT( !dantzigsRule.select( *tableau, candidates, excluded ) );
 
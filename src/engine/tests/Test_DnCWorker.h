@@ -16,16 +16,127 @@
 #include <cxxtest/TestSuite.h>
 
 #include "DnCWorker.h"
+#include "Engine.h"
+#include "EngineState.h"
+#include "FloatUtils.h"
+#include "InputQuery.h"
 #include "MockEngine.h"
+#include "RealEngineFactories.h"
+#include "ReluConstraint.h"
+#include "Set.h"
+#include "SmtCore.h"
 
 #include <string.h>
 
+/*
+  An engine whose search performs a single split with a real SMT core,
+  engine and tableau, and then times out.
+*/
+class SplittingEngine : public IEngine
+{
+public:
+    SplittingEngine( InputQuery &inputQuery )
+        : engine( 0 )
+        , smtCore( &engine )
+        , stackDepthAfterSplit( 0 )
+    {
+        engine.processInputQuery( inputQuery, false );
+        constraint = *engine.getInputQuery()->getPiecewiseLinearConstraints().begin();
+    }
+
+    ~SplittingEngine()
+    {
+        smtCore.freeMemory();
+    }
+
+    Engine engine;
+    SmtCore smtCore;
+    PiecewiseLinearConstraint *constraint;
+    unsigned stackDepthAfterSplit;
+
+    void applySplit( const PiecewiseLinearCaseSplit &split )
+    {
+        engine.applySplit( split );
+    }
+
+    void storeState( EngineState &state, TableauStateStorageLevel level ) const
+    {
+        engine.storeState( state, level );
+    }
+
+    void restoreState( const EngineState &state )
+    {
+        engine.restoreState( state );
+    }
+
+    void refreshBoundTrailState( EngineState &state ) const
+    {
+        engine.refreshBoundTrailState( state );
+    }
+
+    void setBoundTrailRecording( bool record )
+    {
+        engine.setBoundTrailRecording( record );
+    }
+
+    void setNumPlConstraintsDisabledByValidSplits( unsigned numConstraints )
+    {
+        engine.setNumPlConstraintsDisabledByValidSplits( numConstraints );
+    }
+
+    bool solve( unsigned /* timeoutInSeconds */ )
+    {
+        for ( unsigned i = 0; i < GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD; ++i )
+            smtCore.reportViolatedConstraint( constraint );
+        smtCore.performSplit();
+        stackDepthAfterSplit = smtCore.getStackDepth();
+        return false;
+    }
+
+    ExitCode getExitCode() const
+    {
+        return IEngine::TIMEOUT;
+    }
+
+    void reset()
+    {
+        engine.reset();
+        smtCore.freeMemory();
+        smtCore.resetReportedViolations();
+    }
+
+    void backtrackToRoot()
+    {
+        smtCore.backtrackToRoot();
+    }
+
+    List<unsigned> getInputVariables() const
+    {
+        return engine.getInputVariables();
+    }
+
+    void splitOffRemainingSubtrees( List<PiecewiseLinearCaseSplit> & )
+    {
+    }
+
+    void updateScores()
+    {
+    }
+
+    PiecewiseLinearConstraint *pickSplitPLConstraint()
+    {
+        return constraint;
+    }
+};
+
 class DnCWorkerTestSuite : public CxxTest::TestSuite
 {
 public:
 
-    WorkerQueue *_workload;
+    WorkStealingQueue *_workload;
     std::shared_ptr<MockEngine> _engine;
+    std::atomic_uint numUnsolvedSubQueries;
+    std::atomic_bool shouldQuitSolving;
 
     DnCWorkerTestSuite()
         : _workload( NULL )
@@ -34,7 +145,10 @@ public:
 
     void setUp()
     {
-        _workload = new WorkerQueue( 0 );
+        numUnsolvedSubQueries = 0;
+        shouldQuitSolving = false;
+        _workload = new WorkStealingQueue( 1, numUnsolvedSubQueries,
+                                           shouldQuitSolving );
 
         // Initialize the mockEngine
         _engine = std::make_shared<MockEngine>();
@@ -55,20 +169,7 @@ public:
     // Clear workload and return the number of removed subQueries
     unsigned clearSubQueries()
     {
-        unsigned counter = 0;
-        SubQuery *subQuery = NULL;
-        while ( !_workload->empty() )
-        {
-            _workload->pop( subQuery );
-            if ( subQuery )
-            {
-                delete subQuery;
-                subQuery = NULL;
-            }
-            ++counter;
-        }
-
-        return counter;
+        return _workload->clear();
     }
 
     void createPlaceHolderSubQuery()
@@ -97,7 +198,7 @@ public:
         subQuery->_queryId = "";
         subQuery->_split = std::move( split );
         subQuery->_timeoutInSeconds = 5;
-        TS_ASSERT( _workload->push( std::move( subQuery ) ) );
+        _workload->push( 0, subQuery );
     }
 
     // Test different branches of DnCWorker.popOneSubQueryAndSolve()
@@ -117,8 +218,8 @@ public:
         createPlaceHolderSubQuery();
         _engine->setTimeToSolve( 10 );
         _engine->setExitCode( IEngine::TIMEOUT );
-        std::atomic_uint numUnsolvedSubQueries( 1 );
-        std::atomic_bool shouldQuitSolving( false );
+        numUnsolvedSubQueries = 1;
+        shouldQuitSolving = false;
         unsigned threadId = 0;
         unsigned onlineDivides = 2;
         float timeoutFactor = 1;
@@ -250,6 +351,180 @@ public:
         TS_ASSERT( numUnsolvedSubQueries.load() == 1 );
         TS_ASSERT( shouldQuitSolving.load() );
     }
+
+    void test_resume_from_cached_region()
+    {
+        createPlaceHolderSubQuery();
+        _engine->setTimeToSolve( 10 );
+        _engine->setExitCode( IEngine::TIMEOUT );
+        numUnsolvedSubQueries = 1;
+
+        DnCWorker dncWorker( _workload, _engine, numUnsolvedSubQueries,
+                             shouldQuitSolving, 0, 1, 1,
+                             DivideStrategy::LargestInterval );
+        const EngineState *initialState = _engine->lastStoredState;
+
+        // The subQuery times out: the engine returns to the root of the
+        // search, and the state there is cached
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( _engine->timesBacktrackedToRoot, 1U );
+        TS_ASSERT_EQUALS( _engine->lastRestoredState, initialState );
+        const EngineState *cachedState = _engine->lastStoredState;
+        TS_ASSERT_DIFFERS( cachedState, initialState );
+        TS_ASSERT_EQUALS( _workload->getNumPendingSubQueries(), 2U );
+
+        // The first half of the region is solved without restoring any
+        // state, and only the bisected bounds are applied. Variable 1
+        // has the largest interval, [-2, 2]
+        _engine->setExitCode( IEngine::UNSAT );
+        _engine->lastRestoredState = NULL;
+        _engine->lastLowerBounds.clear();
+        _engine->lastUpperBounds.clear();
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT( !_engine->lastRestoredState );
+        TS_ASSERT_EQUALS( _engine->lastLowerBounds.size() +
+                          _engine->lastUpperBounds.size(), 1U );
+
+        // The second half starts from the cached state
+        _engine->lastLowerBounds.clear();
+        _engine->lastUpperBounds.clear();
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( _engine->lastRestoredState, cachedState );
+        TS_ASSERT_EQUALS( _engine->lastLowerBounds.size() +
+                          _engine->lastUpperBounds.size(), 1U );
+        TS_ASSERT_EQUALS( numUnsolvedSubQueries.load(), 0U );
+
+        // A subQuery outside of the cached region starts from the
+        // initial state, with all of its bounds
+        SubQuery *subQuery = new SubQuery;
+        auto split = std::unique_ptr<PiecewiseLinearCaseSplit>
+            ( new PiecewiseLinearCaseSplit );
+        split->storeBoundTightening( Tightening( 1, -3.0, Tightening::LB ) );
+        split->storeBoundTightening( Tightening( 1, 2.0, Tightening::UB ) );
+        subQuery->_queryId = "2";
+        subQuery->_split = std::move( split );
+        subQuery->_timeoutInSeconds = 5;
+        _workload->push( 0, subQuery );
+        numUnsolvedSubQueries = 1;
+
+        _engine->lastLowerBounds.clear();
+        _engine->lastUpperBounds.clear();
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( _engine->lastRestoredState, initialState );
+        TS_ASSERT_EQUALS( _engine->lastLowerBounds.size(), 1U );
+        TS_ASSERT_EQUALS( _engine->lastUpperBounds.size(), 1U );
+    }
+
+    void test_timeout_after_sharing_subtrees()
+    {
+        createPlaceHolderSubQuery();
+        _engine->setTimeToSolve( 10 );
+        _engine->setExitCode( IEngine::TIMEOUT );
+        numUnsolvedSubQueries = 1;
+
+        // While solving, the engine gives the subtree x4 >= 1 away, and
+        // x4 <= 0 and x5 <= 0 are what remains of its search
+        PiecewiseLinearCaseSplit shared;
+        shared.storeBoundTightening( Tightening( 4, 1.0, Tightening::LB ) );
+        _engine->workStealingQueue = _workload;
+        _engine->subtreesToShare.append( shared );
+
+        PiecewiseLinearCaseSplit remaining1;
+        remaining1.storeBoundTightening( Tightening( 4, 0.0, Tightening::UB ) );
+        PiecewiseLinearCaseSplit remaining2;
+        remaining2.storeBoundTightening( Tightening( 5, 0.0, Tightening::UB ) );
+        _engine->remainingSubtrees.append( remaining1 );
+        _engine->remainingSubtrees.append( remaining2 );
+
+        DnCWorker dncWorker( _workload, _engine, numUnsolvedSubQueries,
+                             shouldQuitSolving, 0, 2, 1,
+                             DivideStrategy::LargestInterval );
+        dncWorker.popOneSubQueryAndSolve();
+
+        // Instead of re-dividing the whole region, which contains the
+        // shared subtree, only the remaining subtrees are added
+        TS_ASSERT_EQUALS( _workload->getNumPendingSubQueries(), 3U );
+        TS_ASSERT_EQUALS( numUnsolvedSubQueries.load(), 3U );
+
+        _engine->subtreesToShare.clear();
+        _engine->setExitCode( IEngine::UNSAT );
+        Set<String> expectedIds = { "-r1", "-r2", "-s1" };
+        for ( unsigned i = 0; i < 3; ++i )
+        {
+            SubQuery *subQuery = _workload->tryPop( 0 );
+            TS_ASSERT( subQuery );
+            TS_ASSERT( expectedIds.exists( subQuery->_queryId ) );
+            expectedIds.erase( subQuery->_queryId );
+
+            // Each subQuery lies inside the original region
+            TS_ASSERT_EQUALS( subQuery->_split->getBoundTightenings().size(), 7U );
+            delete subQuery;
+        }
+    }
+
+    void test_cached_region_state_after_split_and_timeout()
+    {
+        RealEngineFactories factories;
+
+        // x1 = relu( x0 ) and x2 = x0 + x1, with the input x2 in [-10, 10]
+        InputQuery inputQuery;
+        inputQuery.setNumberOfVariables( 3 );
+        inputQuery.setLowerBound( 0, -1 );
+        inputQuery.setUpperBound( 0, 1 );
+        inputQuery.setLowerBound( 1, 0 );
+        inputQuery.setUpperBound( 1, 1 );
+        inputQuery.setLowerBound( 2, -10 );
+        inputQuery.setUpperBound( 2, 10 );
+        inputQuery.markInputVariable( 2, 0 );
+
+        Equation equation;
+        equation.addAddend( 1, 0 );
+        equation.addAddend( 1, 1 );
+        equation.addAddend( -1, 2 );
+        equation.setScalar( 0 );
+        inputQuery.addEquation( equation );
+
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 0, 1 ) );
+
+        std::shared_ptr<SplittingEngine> engine =
+            std::make_shared<SplittingEngine>( inputQuery );
+        const Tableau *tableau = factories.lastTableau;
+        TS_ASSERT( tableau );
+
+        SubQuery *subQuery = new SubQuery;
+        auto split = std::unique_ptr<PiecewiseLinearCaseSplit>
+            ( new PiecewiseLinearCaseSplit );
+        split->storeBoundTightening( Tightening( 2, -10.0, Tightening::LB ) );
+        split->storeBoundTightening( Tightening( 2, 10.0, Tightening::UB ) );
+        subQuery->_queryId = "";
+        subQuery->_split = std::move( split );
+        subQuery->_timeoutInSeconds = 5;
+        _workload->push( 0, subQuery );
+        numUnsolvedSubQueries = 1;
+
+        DnCWorker dncWorker( _workload, engine, numUnsolvedSubQueries,
+                             shouldQuitSolving, 0, 1, 1,
+                             DivideStrategy::LargestInterval );
+
+        // The search splits on the ReLU, taking its inactive phase, and
+        // then times out
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( engine->stackDepthAfterSplit, 1U );
+        TS_ASSERT_EQUALS( _workload->getNumPendingSubQueries(), 2U );
+
+        // The cached state is the one from before the split: the bounds
+        // of the split are undone, and the ReLU can be split on again
+        TS_ASSERT( FloatUtils::areEqual( tableau->getLowerBound( 0 ), -1 ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getUpperBound( 0 ), 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getLowerBound( 1 ), 0 ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getUpperBound( 1 ), 1 ) );
+        TS_ASSERT( engine->constraint->isActive() );
+
+        // The new subQueries start from the cached state, and split again
+        engine->stackDepthAfterSplit = 0;
+        dncWorker.popOneSubQueryAndSolve();
+        TS_ASSERT_EQUALS( engine->stackDepthAfterSplit, 1U );
+    }
 };
 
 //
@@ -0,0 +1,148 @@
+/*********************                                                        */
+/*! \file Test_DualSteepestEdge.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "DualSteepestEdge.h"
+#include "FloatUtils.h"
+#include "MockTableau.h"
+
+class MockForDualSteepestEdge
+{
+public:
+};
+
+class DualSteepestEdgeTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockForDualSteepestEdge *mock;
+    MockTableau *tableau;
+
+    void setUp()
+    {
+        TS_ASSERT( mock = new MockForDualSteepestEdge );
+        TS_ASSERT( tableau = new MockTableau );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+        TS_ASSERT_THROWS_NOTHING( delete mock );
+    }
+
+    void initializeBasics()
+    {
+        /*
+          Basic variables x4, x5, x6 at indices 0, 1, 2:
+
+            x4 = 5,  bounds [0, 3]  (too high by 2)
+            x5 = -3, bounds [0, 3]  (too low by 3)
+            x6 = 1,  bounds [0, 3]
+        */
+        tableau->setDimensions( 3, 7 );
+
+        for ( unsigned i = 0; i < 3; ++i )
+        {
+            tableau->nextBasicIndexToVariable[i] = 4 + i;
+            tableau->setLowerBound( 4 + i, 0 );
+            tableau->setUpperBound( 4 + i, 3 );
+        }
+
+        tableau->nextValues[4] = 5;
+        tableau->nextValues[5] = -3;
+        tableau->nextValues[6] = 1;
+
+        tableau->nextBasicTooHigh.insert( 0 );
+        tableau->nextBasicTooLow.insert( 1 );
+    }
+
+    void test_select()
+    {
+        DualSteepestEdgeRule dualSteepestEdge;
+
+        initializeBasics();
+        TS_ASSERT_THROWS_NOTHING( dualSteepestEdge.initialize( *tableau ) );
+
+        for ( unsigned i = 0; i < 3; ++i )
+            TS_ASSERT_EQUALS( dualSteepestEdge.getWeight( i ), 1.0 );
+
+        // With equal weights, the largest infeasibility wins
+        TS_ASSERT( dualSteepestEdge.select( *tableau ) );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariableIndex(), 1U );
+
+        // Nothing to select when all basics are within bounds
+        tableau->nextBasicTooHigh.clear();
+        tableau->nextBasicTooLow.clear();
+        TS_ASSERT( !dualSteepestEdge.select( *tableau ) );
+    }
+
+    void test_weight_update()
+    {
+        DualSteepestEdgeRule dualSteepestEdge;
+
+        initializeBasics();
+        TS_ASSERT_THROWS_NOTHING( dualSteepestEdge.initialize( *tableau ) );
+
+        /*
+          x5 (index 1) leaves. The change column is [ 1, 2, 0 ], the
+          row of inv(B) for the leaving index is rho = [ 0, 0.5, 0 ],
+          and tau = inv(B) * rho = [ 0.1, 0.25, 0 ]. Then:
+
+            w_1 = |rho|^2 / 2^2 = 0.25 / 4 = 0.0625
+            w_0 = 1 - 2 * 0.5 * 0.1 + 0.5^2 * 0.25 = 0.9625
+            w_2 is unchanged
+        */
+        double changeColumn[] = { 1, 2, 0 };
+        tableau->nextChangeColumn = changeColumn;
+        tableau->setLeavingVariableIndex( 1 );
+
+        tableau->nextBtranOutput[0] = 0;
+        tableau->nextBtranOutput[1] = 0.5;
+        tableau->nextBtranOutput[2] = 0;
+
+        tableau->nextFtranOutput = new double[3];
+        tableau->nextFtranOutput[0] = 0.1;
+        tableau->nextFtranOutput[1] = 0.25;
+        tableau->nextFtranOutput[2] = 0;
+
+        TS_ASSERT_THROWS_NOTHING( dualSteepestEdge.prePivotHook( *tableau ) );
+
+        // The unit vector e_1 was passed to btran
+        TS_ASSERT_EQUALS( tableau->lastBtranInput[0], 0.0 );
+        TS_ASSERT_EQUALS( tableau->lastBtranInput[1], 1.0 );
+        TS_ASSERT_EQUALS( tableau->lastBtranInput[2], 0.0 );
+
+        TS_ASSERT( FloatUtils::areEqual( dualSteepestEdge.getWeight( 0 ), 0.9625 ) );
+        TS_ASSERT( FloatUtils::areEqual( dualSteepestEdge.getWeight( 1 ), 0.0625 ) );
+        TS_ASSERT( FloatUtils::areEqual( dualSteepestEdge.getWeight( 2 ), 1.0 ) );
+
+        /*
+          Now x5 is only too low by 1, while x4 is still too high by 2.
+          However, x5's small weight means that it is the steepest.
+        */
+        tableau->nextValues[5] = -1;
+
+        TS_ASSERT( dualSteepestEdge.select( *tableau ) );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariableIndex(), 1U );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
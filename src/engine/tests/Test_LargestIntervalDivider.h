@@ -203,6 +203,41 @@ public:
             delete subQuery;
         }
     }
+
+    void test_create_subqueries_keeps_rest_of_split()
+    {
+        // A shared subtree: the input region, a phase of a ReLU over
+        // x4 and an equation. Each new subquery must keep the latter two
+        PiecewiseLinearCaseSplit previousSplit;
+        previousSplit.storeBoundTightening( Tightening( 1, -2.0, Tightening::LB ) );
+        previousSplit.storeBoundTightening( Tightening( 1, 2.0, Tightening::UB ) );
+        previousSplit.storeBoundTightening( Tightening( 2, 3.0, Tightening::LB ) );
+        previousSplit.storeBoundTightening( Tightening( 2, 5.0, Tightening::UB ) );
+        previousSplit.storeBoundTightening( Tightening( 3, 2.0, Tightening::LB ) );
+        previousSplit.storeBoundTightening( Tightening( 3, 5.0, Tightening::UB ) );
+        previousSplit.storeBoundTightening( Tightening( 4, 0.0, Tightening::UB ) );
+
+        Equation equation;
+        equation.addAddend( 1, 1 );
+        equation.addAddend( -1, 5 );
+        equation.setScalar( 0 );
+        previousSplit.addEquation( equation );
+
+        SubQueries subQueries;
+        queryDivider->createSubQueries( 2, "mock", previousSplit, 5, subQueries );
+
+        TS_ASSERT_EQUALS( subQueries.size(), 2U );
+        for ( const auto &subQuery : subQueries )
+        {
+            const List<Tightening> &bounds = subQuery->_split->getBoundTightenings();
+            TS_ASSERT_EQUALS( bounds.size(), 7U );
+            TS_ASSERT( bounds.exists( Tightening( 4, 0.0, Tightening::UB ) ) );
+            TS_ASSERT_EQUALS( subQuery->_split->getEquations().size(), 1U );
+            TS_ASSERT( subQuery->_split->getEquations().exists( equation ) );
+
+            delete subQuery;
+        }
+    }
 };
 
 //
@@ -0,0 +1,272 @@
+/*********************                                                        */
+/*! \file Test_NativeLPSolver.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "FloatUtils.h"
+#include "MStringf.h"
+#include "MarabouError.h"
+#include "MockErrno.h"
+#include "NativeLPSolver.h"
+
+typedef NativeLPSolver::Term Term;
+
+class NativeLPSolverTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockErrno *mockErrno;
+
+    void setUp()
+    {
+        TS_ASSERT( mockErrno = new MockErrno );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mockErrno );
+    }
+
+    void test_minimize_and_maximize()
+    {
+        NativeLPSolver lp;
+
+        lp.addVariable( "x", 0, 3 );
+        lp.addVariable( "y", -2, 3 );
+        lp.addVariable( "z", FloatUtils::negativeInfinity(), FloatUtils::infinity() );
+
+        // x + y <= 4
+        lp.addLeqConstraint( { Term( 1, "x" ), Term( 1, "y" ) }, 4 );
+        // x - y >= -1
+        lp.addGeqConstraint( { Term( 1, "x" ), Term( -1, "y" ) }, -1 );
+        // z = 2x + y
+        lp.addEqConstraint( { Term( 1, "z" ), Term( -2, "x" ), Term( -1, "y" ) }, 0 );
+
+        Map<String, double> solution;
+        double value;
+
+        // Maximize z: x = 3, y = 1
+        lp.setObjective( { Term( 1, "z" ) } );
+        TS_ASSERT_THROWS_NOTHING( lp.solve() );
+        TS_ASSERT( lp.optimal() );
+        TS_ASSERT( lp.haveFeasibleSolution() );
+        TS_ASSERT_THROWS_NOTHING( lp.extractSolution( solution, value ) );
+        TS_ASSERT( FloatUtils::areEqual( value, 7 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["x"], 3 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["y"], 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["z"], 7 ) );
+        TS_ASSERT( FloatUtils::areEqual( lp.getObjectiveBound(), 7 ) );
+
+        // Minimize z: x = 0, y = -2
+        lp.setCost( { Term( 1, "z" ) } );
+        TS_ASSERT_THROWS_NOTHING( lp.solve() );
+        TS_ASSERT( lp.optimal() );
+        TS_ASSERT_THROWS_NOTHING( lp.extractSolution( solution, value ) );
+        TS_ASSERT( FloatUtils::areEqual( value, -2 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["x"], 0 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["y"], -2 ) );
+
+        // Minimize y - x: both variables at their bounds
+        lp.setCost( { Term( 1, "y" ), Term( -1, "x" ) } );
+        TS_ASSERT_THROWS_NOTHING( lp.solve() );
+        TS_ASSERT( lp.optimal() );
+        TS_ASSERT_THROWS_NOTHING( lp.extractSolution( solution, value ) );
+        TS_ASSERT( FloatUtils::areEqual( value, -5 ) );
+    }
+
+    void test_infeasible()
+    {
+        NativeLPSolver lp;
+
+        lp.addVariable( "x", 0, 1 );
+        lp.addVariable( "y", 0, 1 );
+
+        lp.addGeqConstraint( { Term( 1, "x" ), Term( 1, "y" ) }, 3 );
+        lp.setCost( { Term( 1, "x" ) } );
+
+        TS_ASSERT_THROWS_NOTHING( lp.solve() );
+        TS_ASSERT( lp.infeasbile() );
+        TS_ASSERT( !lp.optimal() );
+        TS_ASSERT( !lp.haveFeasibleSolution() );
+
+        // Crossing bounds are detected up front
+        NativeLPSolver lp2;
+        lp2.addVariable( "x", 2, 1 );
+        lp2.setCost( { Term( 1, "x" ) } );
+        TS_ASSERT_THROWS_NOTHING( lp2.solve() );
+        TS_ASSERT( lp2.infeasbile() );
+    }
+
+    void test_warm_start()
+    {
+        NativeLPSolver lp;
+
+        // A chain: x0 in [-1, 1], x(i+1) = x(i) + 1 for 20 variables,
+        // plus a constraint coupling the first and last
+        lp.addVariable( "x0", -1, 1 );
+        for ( unsigned i = 1; i < 20; ++i )
+        {
+            lp.addVariable( Stringf( "x%u", i ), -100, 100 );
+            lp.addEqConstraint( { Term( 1, Stringf( "x%u", i ) ),
+                                  Term( -1, Stringf( "x%u", i - 1 ) ) },
+                                1 );
+        }
+        lp.addLeqConstraint( { Term( 1, "x19" ), Term( 1, "x0" ) }, 18 );
+
+        Map<String, double> solution;
+        double value;
+
+        lp.setObjective( { Term( 1, "x19" ) } );
+        TS_ASSERT_THROWS_NOTHING( lp.solve() );
+        TS_ASSERT( lp.optimal() );
+        TS_ASSERT_THROWS_NOTHING( lp.extractSolution( solution, value ) );
+        TS_ASSERT( FloatUtils::areEqual( value, 18.5 ) );
+        unsigned coldIterations = lp.getNumberOfIterations();
+        TS_ASSERT( coldIterations > 0 );
+
+        // Solving again from an optimal basis needs no pivots
+        lp.reset();
+        TS_ASSERT_THROWS_NOTHING( lp.solve() );
+        TS_ASSERT( lp.optimal() );
+        TS_ASSERT_EQUALS( lp.getNumberOfIterations(), 0U );
+
+        // Tighten a bound under the same objective: the dual simplex
+        // repairs the basis
+        lp.setUpperBound( "x0", -0.75 );
+        TS_ASSERT_THROWS_NOTHING( lp.solve() );
+        TS_ASSERT( lp.optimal() );
+        TS_ASSERT_THROWS_NOTHING( lp.extractSolution( solution, value ) );
+        TS_ASSERT( FloatUtils::areEqual( value, 18.25 ) );
+        TS_ASSERT( lp.getNumberOfIterations() < coldIterations );
+
+        // A new objective over the same constraints
+        lp.setCost( { Term( 1, "x10" ) } );
+        TS_ASSERT_THROWS_NOTHING( lp.solve() );
+        TS_ASSERT( lp.optimal() );
+        TS_ASSERT_THROWS_NOTHING( lp.extractSolution( solution, value ) );
+        TS_ASSERT( FloatUtils::areEqual( value, 9 ) );
+    }
+
+    void test_model_grows_between_solves()
+    {
+        NativeLPSolver lp;
+
+        lp.addVariable( "x", -1, 2 );
+        lp.setObjective( { Term( 1, "x" ) } );
+
+        Map<String, double> solution;
+        double value;
+
+        // No constraints at all
+        TS_ASSERT_THROWS_NOTHING( lp.solve() );
+        TS_ASSERT( lp.optimal() );
+        TS_ASSERT_THROWS_NOTHING( lp.extractSolution( solution, value ) );
+        TS_ASSERT( FloatUtils::areEqual( value, 2 ) );
+
+        // y = 2x - 1, y <= 1
+        lp.addVariable( "y", -10, 10 );
+        lp.addEqConstraint( { Term( 1, "y" ), Term( -2, "x" ) }, -1 );
+        lp.addLeqConstraint( { Term( 1, "y" ) }, 1 );
+
+        TS_ASSERT_THROWS_NOTHING( lp.solve() );
+        TS_ASSERT( lp.optimal() );
+        TS_ASSERT_THROWS_NOTHING( lp.extractSolution( solution, value ) );
+        TS_ASSERT( FloatUtils::areEqual( value, 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["y"], 1 ) );
+
+        lp.setCost( { Term( 1, "y" ) } );
+        TS_ASSERT_THROWS_NOTHING( lp.solve() );
+        TS_ASSERT( lp.optimal() );
+        TS_ASSERT_THROWS_NOTHING( lp.extractSolution( solution, value ) );
+        TS_ASSERT( FloatUtils::areEqual( value, -3 ) );
+    }
+
+    void test_cutoff()
+    {
+        NativeLPSolver lp;
+
+        lp.addVariable( "x", 0, 3 );
+        lp.addVariable( "y", 0, 3 );
+        lp.addLeqConstraint( { Term( 1, "x" ), Term( 1, "y" ) }, 4 );
+        lp.setObjective( { Term( 1, "x" ), Term( 1, "y" ) } );
+
+        lp.setCutoff( 5 );
+        TS_ASSERT_THROWS_NOTHING( lp.solve() );
+        TS_ASSERT( lp.cutoffOccurred() );
+
+        lp.setCutoff( 3 );
+        TS_ASSERT_THROWS_NOTHING( lp.solve() );
+        TS_ASSERT( lp.optimal() );
+    }
+
+    void test_binary_variables()
+    {
+        NativeLPSolver lp;
+
+        // A knapsack: maximize 5a + 4b + 3c s.t. 2a + 3b + c <= 5.
+        // The LP relaxation gives 32/3, the integral optimum is 9.
+        lp.addVariable( "a", 0, 1, NativeLPSolver::BINARY );
+        lp.addVariable( "b", 0, 1, NativeLPSolver::BINARY );
+        lp.addVariable( "c", 0, 1, NativeLPSolver::BINARY );
+        lp.addLeqConstraint( { Term( 2, "a" ), Term( 3, "b" ), Term( 1, "c" ) }, 5 );
+        lp.setObjective( { Term( 5, "a" ), Term( 4, "b" ), Term( 3, "c" ) } );
+
+        Map<String, double> solution;
+        double value;
+
+        TS_ASSERT_THROWS_NOTHING( lp.solve() );
+        TS_ASSERT( lp.optimal() );
+        TS_ASSERT_THROWS_NOTHING( lp.extractSolution( solution, value ) );
+        TS_ASSERT( FloatUtils::areEqual( value, 9 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["a"], 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["b"], 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( solution["c"], 0 ) );
+        TS_ASSERT( FloatUtils::areEqual( lp.getObjectiveBound(), 9 ) );
+
+        // Solutions worse than the cutoff are discarded
+        lp.setCutoff( 10 );
+        TS_ASSERT_THROWS_NOTHING( lp.solve() );
+        TS_ASSERT( lp.cutoffOccurred() );
+
+        lp.setCutoff( 8 );
+        TS_ASSERT_THROWS_NOTHING( lp.solve() );
+        TS_ASSERT( lp.optimal() );
+        TS_ASSERT_THROWS_NOTHING( lp.extractSolution( solution, value ) );
+        TS_ASSERT( FloatUtils::areEqual( value, 9 ) );
+    }
+
+    void test_unknown_variable()
+    {
+        NativeLPSolver lp;
+        lp.addVariable( "x", 0, 1 );
+
+        TS_ASSERT_THROWS_EQUALS( lp.setUpperBound( "y", 1 ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::LP_SOLVER_UNKNOWN_VARIABLE );
+
+        TS_ASSERT_THROWS_EQUALS( lp.addLeqConstraint( { Term( 1, "x" ), Term( 1, "y" ) }, 1 ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::LP_SOLVER_UNKNOWN_VARIABLE );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -200,6 +200,48 @@ public:
         TS_ASSERT_EQUALS( processed.getUpperBound( 0 ), 6.5 );
 	}
 
+    void test_tighten_bounds_along_equation_chain()
+    {
+        InputQuery inputQuery;
+
+        inputQuery.setNumberOfVariables( 5 );
+        inputQuery.setLowerBound( 0, 0 );
+        inputQuery.setUpperBound( 0, 1 );
+
+        // x(i+1) - x(i) = 1, with the equations listed from the end of
+        // the chain, so that every bound is derived from a later equation
+        for ( unsigned i = 4; i > 0; --i )
+        {
+            Equation equation;
+            equation.addAddend( 1, i );
+            equation.addAddend( -1, i - 1 );
+            equation.setScalar( 1 );
+            inputQuery.addEquation( equation );
+        }
+
+        InputQuery processed = Preprocessor().preprocess( inputQuery, false );
+
+        for ( unsigned i = 0; i < 5; ++i )
+        {
+            TS_ASSERT_EQUALS( processed.getLowerBound( i ), i );
+            TS_ASSERT_EQUALS( processed.getUpperBound( i ), i + 1 );
+        }
+
+        // Once x0 is fixed, every variable becomes fixed and all the
+        // equations are removed
+        inputQuery.setUpperBound( 0, 0 );
+
+        processed = Preprocessor().preprocess( inputQuery, false );
+
+        for ( unsigned i = 0; i < 5; ++i )
+        {
+            TS_ASSERT_EQUALS( processed.getLowerBound( i ), i );
+            TS_ASSERT_EQUALS( processed.getUpperBound( i ), i );
+        }
+
+        TS_ASSERT( processed.getEquations().empty() );
+    }
+
     void test_tighten_bounds_using_constraints()
     {
         InputQuery inputQuery;
@@ -527,6 +569,61 @@ public:
         }
     }
 
+    void test_propagate_through_merged_variables()
+    {
+        InputQuery inputQuery;
+
+        inputQuery.setNumberOfVariables( 4 );
+        inputQuery.setLowerBound( 0, 0 );
+        inputQuery.setUpperBound( 0, 10 );
+        inputQuery.setLowerBound( 1, 0 );
+        inputQuery.setUpperBound( 1, 10 );
+        inputQuery.setLowerBound( 2, -10 );
+        inputQuery.setUpperBound( 2, 10 );
+        inputQuery.setLowerBound( 3, -100 );
+        inputQuery.setUpperBound( 3, 100 );
+
+        // x0 - x1 = 0
+        Equation equation1;
+        equation1.addAddend( 1, 0 );
+        equation1.addAddend( -1, 1 );
+        equation1.setScalar( 0 );
+        inputQuery.addEquation( equation1 );
+
+        // x0 - x1 + x2 = 1
+        Equation equation2;
+        equation2.addAddend( 1, 0 );
+        equation2.addAddend( -1, 1 );
+        equation2.addAddend( 1, 2 );
+        equation2.setScalar( 1 );
+        inputQuery.addEquation( equation2 );
+
+        // x3 - 2x2 = 0
+        Equation equation3;
+        equation3.addAddend( 1, 3 );
+        equation3.addAddend( -2, 2 );
+        equation3.setScalar( 0 );
+        inputQuery.addEquation( equation3 );
+
+        /*
+          Before the merge, the equations only give x2 in [-9, 10] and
+          x3 in [-18, 20]. Once x0 is merged into x1 the second
+          equation becomes x2 = 1, although no bound has changed, and
+          the next round of propagation must pick that up.
+        */
+        Preprocessor preprocessor;
+        InputQuery processed;
+        TS_ASSERT_THROWS_NOTHING( processed = preprocessor.preprocess( inputQuery, true ) );
+
+        TS_ASSERT( preprocessor.variableIsMerged( 0 ) );
+        TS_ASSERT_EQUALS( preprocessor.getMergedIndex( 0 ), 1U );
+
+        TS_ASSERT( preprocessor.variableIsFixed( 2 ) );
+        TS_ASSERT_EQUALS( preprocessor.getFixedValue( 2 ), 1.0 );
+        TS_ASSERT( preprocessor.variableIsFixed( 3 ) );
+        TS_ASSERT_EQUALS( preprocessor.getFixedValue( 3 ), 2.0 );
+    }
+
     void test_merge_and_fix_disjoint()
     {
 		InputQuery inputQuery;
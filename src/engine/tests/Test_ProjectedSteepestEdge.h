@@ -60,7 +60,7 @@ public:
         // All variables are eligible, none are excluded
         Set<unsigned> excluded;
 
-        List<unsigned> candidates = { 0, 1, 2 };
+        Vector<unsigned> candidates = { 0, 1, 2 };
         double costFunction[] = { -5.0, -3.0, -7.0 };
 
         memcpy( tableau.nextCostFunction, costFunction, sizeof(costFunction) );
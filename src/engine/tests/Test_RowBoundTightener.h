@@ -377,6 +377,189 @@ public:
         TS_ASSERT( FloatUtils::areEqual( it->_value, 2 ) );
         TS_ASSERT_EQUALS( it->_type, Tightening::UB );
     }
+
+    void test_examine_constraint_matrix_after_bound_change()
+    {
+        RowBoundTightener tightener( *tableau );
+
+        tableau->setDimensions( 1, 5 );
+
+        tableau->setLowerBound( 0, 0 );
+        tableau->setUpperBound( 0, 3 );
+        tableau->setLowerBound( 1, -1 );
+        tableau->setUpperBound( 1, 2 );
+        tableau->setLowerBound( 2, -10 );
+        tableau->setUpperBound( 2, 10 );
+        tableau->setLowerBound( 3, 0 );
+        tableau->setUpperBound( 3, 1 );
+        tableau->setLowerBound( 4, 2 );
+        tableau->setUpperBound( 4, 2 );
+
+        /*
+           Equation:
+                x0 -2x1 +x3 +2x4 = 1
+
+           The first pass gives x0 <= 1 and x1 >= 1.5. Once x3 is fixed
+           to 1, only the affected row is revisited and gives x0 <= 0
+           and x1 >= 2.
+        */
+
+        tightener.setDimensions();
+
+        double A[] = { 1, -2, 0, 1, 2 };
+        double b[] = { 1 };
+
+        tableau->A = A;
+        tableau->b = b;
+
+        List<Tightening> tightenings;
+        TS_ASSERT_THROWS_NOTHING( tightener.examineConstraintMatrix( false ) );
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+        TS_ASSERT_EQUALS( tightenings.size(), 2U );
+
+        tightener.notifyLowerBound( 3, 1 );
+
+        tightenings.clear();
+        TS_ASSERT_THROWS_NOTHING( tightener.examineConstraintMatrix( false ) );
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+        TS_ASSERT_EQUALS( tightenings.size(), 2U );
+
+        auto it = tightenings.begin();
+
+        TS_ASSERT_EQUALS( it->_variable, 0U );
+        TS_ASSERT( FloatUtils::areEqual( it->_value, 0 ) );
+        TS_ASSERT_EQUALS( it->_type, Tightening::UB );
+
+        ++it;
+
+        TS_ASSERT_EQUALS( it->_variable, 1U );
+        TS_ASSERT( FloatUtils::areEqual( it->_value, 2 ) );
+        TS_ASSERT_EQUALS( it->_type, Tightening::LB );
+    }
+
+    /*
+       A = | 1 0  1 2 0 | , b = | 2 |
+           | 0 1 -1 1 1 |       | 3 |
+
+       With x3 and x4 basic, B = | 2 0 | and inv(B) = |  0.5 0 |
+                                 | 1 1 |              | -0.5 1 |
+
+       The rows of the inverted basis are:
+                x3 = 1 - 0.5x0         - 0.5x2
+                x4 = 2 + 0.5x0 - x1    + 1.5x2
+
+       Ranges:
+                x0: [0, 2]
+                x1: [0, 1]
+                x2: [0, 2]
+                x3: [-10, 10]
+                x4: [-10, 1.75]
+
+       A single pass gives:
+                first row:  -1 <= x3 <= 1
+                second row: x4 >= 1, and then using x4 <= 1.75:
+                            x0 <= 1.5, x1 >= 0.25, x2 <= 0.5
+    */
+    double invertedBasisA[10];
+    double invertedBasisB[2];
+    double invertedBasisInverse[4];
+    double invertedBasisColumns[5][2];
+
+    void setUpInvertedBasisExample( RowBoundTightener &tightener )
+    {
+        tableau->setDimensions( 2, 5 );
+
+        tableau->setLowerBound( 0, 0 );
+        tableau->setUpperBound( 0, 2 );
+        tableau->setLowerBound( 1, 0 );
+        tableau->setUpperBound( 1, 1 );
+        tableau->setLowerBound( 2, 0 );
+        tableau->setUpperBound( 2, 2 );
+        tableau->setLowerBound( 3, -10 );
+        tableau->setUpperBound( 3, 10 );
+        tableau->setLowerBound( 4, -10 );
+        tableau->setUpperBound( 4, 1.75 );
+
+        tightener.setDimensions();
+
+        double A[] = {
+            1, 0,  1, 2, 0,
+            0, 1, -1, 1, 1,
+        };
+        double b[] = { 2, 3 };
+        double invB[] = {
+             0.5, 0,
+            -0.5, 1,
+        };
+
+        memcpy( invertedBasisA, A, sizeof(A) );
+        memcpy( invertedBasisB, b, sizeof(b) );
+        memcpy( invertedBasisInverse, invB, sizeof(invB) );
+
+        tableau->A = invertedBasisA;
+        tableau->b = invertedBasisB;
+        tableau->nextInverseBasis = invertedBasisInverse;
+
+        tableau->nextBasicIndexToVariable[0] = 3;
+        tableau->nextBasicIndexToVariable[1] = 4;
+        tableau->nextNonBasicIndexToVariable[0] = 0;
+        tableau->nextNonBasicIndexToVariable[1] = 1;
+        tableau->nextNonBasicIndexToVariable[2] = 2;
+
+        // The columns of A, for the implicit computation
+        for ( unsigned i = 0; i < 5; ++i )
+        {
+            invertedBasisColumns[i][0] = invertedBasisA[i];
+            invertedBasisColumns[i][1] = invertedBasisA[5 + i];
+            tableau->nextAColumn[i] = invertedBasisColumns[i];
+        }
+    }
+
+    void checkInvertedBasisTightenings( RowBoundTightener &tightener )
+    {
+        List<Tightening> tightenings;
+        TS_ASSERT_THROWS_NOTHING( tightener.getRowTightenings( tightenings ) );
+        TS_ASSERT_EQUALS( tightenings.size(), 6U );
+
+        Tightening expected[] = {
+            Tightening( 0, 1.5, Tightening::UB ),
+            Tightening( 1, 0.25, Tightening::LB ),
+            Tightening( 2, 0.5, Tightening::UB ),
+            Tightening( 3, -1, Tightening::LB ),
+            Tightening( 3, 1, Tightening::UB ),
+            Tightening( 4, 1, Tightening::LB ),
+        };
+
+        unsigned i = 0;
+        for ( const auto &tightening : tightenings )
+        {
+            if ( i >= 6 )
+                break;
+
+            TS_ASSERT_EQUALS( tightening._variable, expected[i]._variable );
+            TS_ASSERT( FloatUtils::areEqual( tightening._value, expected[i]._value ) );
+            TS_ASSERT_EQUALS( tightening._type, expected[i]._type );
+            ++i;
+        }
+    }
+
+    void test_examine_inverted_basis_matrix()
+    {
+        RowBoundTightener tightener( *tableau );
+        setUpInvertedBasisExample( tightener );
+
+        TS_ASSERT_THROWS_NOTHING( tightener.examineInvertedBasisMatrix( false ) );
+        checkInvertedBasisTightenings( tightener );
+    }
+
+    void test_examine_implicit_inverted_basis_matrix()
+    {
+        RowBoundTightener tightener( *tableau );
+        setUpInvertedBasisExample( tightener );
+
+        TS_ASSERT_THROWS_NOTHING( tightener.examineImplicitInvertedBasisMatrix( false ) );
+        checkInvertedBasisTightenings( tightener );
+    }
 };
 
 //
@@ -15,10 +15,15 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "Engine.h"
+#include "EngineState.h"
+#include "FloatUtils.h"
 #include "GlobalConfiguration.h"
+#include "InputQuery.h"
 #include "MockEngine.h"
 #include "MockErrno.h"
 #include "PiecewiseLinearConstraint.h"
+#include "RealEngineFactories.h"
 #include "ReluConstraint.h"
 #include "SmtCore.h"
 
@@ -261,6 +266,14 @@ public:
 
         TS_ASSERT( engine->lastStoredState );
         TS_ASSERT( !engine->lastRestoredState );
+        TS_ASSERT( engine->lastStorageLevel ==
+                   ( GlobalConfiguration::USE_BOUND_TRAIL_FOR_SMT_STATES ?
+                     TableauStateStorageLevel::STORE_BOUND_TRAIL :
+                     TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE ) );
+
+        // Bound changes are recorded while trail marks are on the stack
+        TS_ASSERT_EQUALS( engine->lastBoundTrailRecording,
+                          engine->lastStorageLevel == TableauStateStorageLevel::STORE_BOUND_TRAIL );
 
         EngineState *originalState = engine->lastStoredState;
         engine->lastStoredState = NULL;
@@ -329,6 +342,7 @@ public:
         TS_ASSERT( !smtCore.popSplit() );
         TS_ASSERT( !engine->lastRestoredState );
         TS_ASSERT_EQUALS( smtCore.getStackDepth(), 0U );
+        TS_ASSERT( !engine->lastBoundTrailRecording );
     }
 
     void test_perform_split__inactive_constraint()
@@ -493,6 +507,314 @@ public:
         TS_ASSERT_EQUALS( *it, split4 );
     }
 
+    void test_split_off_subtree()
+    {
+        SmtCore smtCore( engine );
+
+        MockConstraint constraint;
+
+        PiecewiseLinearCaseSplit split1;
+        split1.storeBoundTightening( Tightening( 1, 3.0, Tightening::LB ) );
+
+        PiecewiseLinearCaseSplit split2;
+        split2.storeBoundTightening( Tightening( 1, 3.0, Tightening::UB ) );
+
+        Equation equation( Equation::EQ );
+        equation.addAddend( -3, 0 );
+        equation.addAddend( 3, 1 );
+        equation.setScalar( -5 );
+        split2.addEquation( equation );
+
+        constraint.nextSplits.append( split1 );
+        constraint.nextSplits.append( split2 );
+
+        for ( unsigned i = 0; i < GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD; ++i )
+            smtCore.reportViolatedConstraint( &constraint );
+
+        constraint.nextIsActive = true;
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+
+        PiecewiseLinearCaseSplit split3;
+        split3.storeBoundTightening( Tightening( 14, 2.3, Tightening::LB ) );
+        TS_ASSERT_THROWS_NOTHING( smtCore.recordImpliedValidSplit( split3 ) );
+
+        MockConstraint constraint2;
+
+        PiecewiseLinearCaseSplit split4;
+        split4.storeBoundTightening( Tightening( 7, 3.0, Tightening::LB ) );
+
+        PiecewiseLinearCaseSplit split5;
+        split5.storeBoundTightening( Tightening( 7, 3.0, Tightening::UB ) );
+
+        constraint2.nextSplits.append( split4 );
+        constraint2.nextSplits.append( split5 );
+
+        for ( unsigned i = 0; i < GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD; ++i )
+            smtCore.reportViolatedConstraint( &constraint2 );
+
+        constraint2.nextIsActive = true;
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 2U );
+
+        // The shallowest alternative goes first, with nothing above it
+        PiecewiseLinearCaseSplit subtree;
+        TS_ASSERT( smtCore.splitOffSubtree( subtree ) );
+        TS_ASSERT_EQUALS( subtree, split2 );
+
+        // Then the alternative on the second level, under the first
+        // level's active and implied splits
+        PiecewiseLinearCaseSplit expected;
+        expected.storeBoundTightening( Tightening( 1, 3.0, Tightening::LB ) );
+        expected.storeBoundTightening( Tightening( 14, 2.3, Tightening::LB ) );
+        expected.storeBoundTightening( Tightening( 7, 3.0, Tightening::UB ) );
+
+        PiecewiseLinearCaseSplit subtree2;
+        TS_ASSERT( smtCore.splitOffSubtree( subtree2 ) );
+        TS_ASSERT_EQUALS( subtree2, expected );
+
+        // Nothing is left to explore except for the active path
+        PiecewiseLinearCaseSplit subtree3;
+        TS_ASSERT( !smtCore.splitOffSubtree( subtree3 ) );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 2U );
+        TS_ASSERT( !smtCore.popSplit() );
+    }
+
+    void splitOnWithTrailMark( SmtCore &smtCore, MockConstraint &constraint, unsigned mark )
+    {
+        for ( unsigned i = 0; i < GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD; ++i )
+            smtCore.reportViolatedConstraint( &constraint );
+
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+        engine->lastStoredState->_tableauState._boundTrailSize = mark;
+    }
+
+    void test_backjump_and_learned_clauses()
+    {
+        SmtCore smtCore( engine );
+
+        if ( !smtCore.conflictAnalysisEnabled() )
+            return;
+
+        /*
+          Three constraints, each splitting variable i into x_i >= 1
+          or x_i <= 0. The splits are performed at trail marks 10, 20
+          and 30.
+        */
+        MockConstraint constraints[3];
+        PiecewiseLinearCaseSplit activeSplits[3];
+        PiecewiseLinearCaseSplit inactiveSplits[3];
+        for ( unsigned i = 0; i < 3; ++i )
+        {
+            activeSplits[i].storeBoundTightening( Tightening( i + 1, 1.0, Tightening::LB ) );
+            inactiveSplits[i].storeBoundTightening( Tightening( i + 1, 0.0, Tightening::UB ) );
+            constraints[i].nextSplits.append( activeSplits[i] );
+            constraints[i].nextSplits.append( inactiveSplits[i] );
+
+            splitOnWithTrailMark( smtCore, constraints[i], 10 * ( i + 1 ) );
+        }
+
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 3U );
+
+        /*
+          The conflict involves x_1 >= 1, which the first decision
+          implies, and a bound on x_5 that was last tightened on the
+          second level. The third level is skipped, and the second level
+          takes its alternative.
+        */
+        List<SmtCore::ConflictBound> explanation;
+        explanation.append( SmtCore::ConflictBound( Tightening( 1, 1.0, Tightening::LB ), 35 ) );
+        explanation.append( SmtCore::ConflictBound( Tightening( 5, 7.0, Tightening::UB ), 25 ) );
+        explanation.append( SmtCore::ConflictBound( Tightening( 6, 2.0, Tightening::UB ), 0 ) );
+
+        engine->lastLowerBounds.clear();
+        engine->lastUpperBounds.clear();
+        TS_ASSERT( smtCore.backjump( explanation ) );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 2U );
+        TS_ASSERT_EQUALS( engine->lastUpperBounds.size(), 1U );
+        TS_ASSERT_EQUALS( engine->lastUpperBounds.begin()->_variable, 2U );
+
+        List<Pair<PiecewiseLinearConstraint *, PiecewiseLinearCaseSplit>> impliedSplits;
+        TS_ASSERT_THROWS_NOTHING( smtCore.getImpliedSplitsFromLearnedClauses( impliedSplits ) );
+        TS_ASSERT( impliedSplits.empty() );
+
+        /*
+          Next, the second decision alone leads to a conflict. Its level
+          has no alternatives left, so the first level takes its
+          alternative instead.
+        */
+        explanation.clear();
+        explanation.append( SmtCore::ConflictBound( Tightening( 2, 0.0, Tightening::UB ), 28 ) );
+        TS_ASSERT( smtCore.backjump( explanation ) );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 1U );
+
+        // The second constraint is now left with its active split only
+        TS_ASSERT_THROWS_NOTHING( smtCore.getImpliedSplitsFromLearnedClauses( impliedSplits ) );
+        TS_ASSERT_EQUALS( impliedSplits.size(), 1U );
+        TS_ASSERT_EQUALS( impliedSplits.begin()->first(), &constraints[1] );
+        TS_ASSERT_EQUALS( impliedSplits.begin()->second(), activeSplits[1] );
+
+        // Splitting on it takes that split, with no alternatives
+        engine->lastLowerBounds.clear();
+        splitOnWithTrailMark( smtCore, constraints[1], 40 );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 2U );
+        TS_ASSERT_EQUALS( engine->lastLowerBounds.size(), 1U );
+        TS_ASSERT_EQUALS( engine->lastLowerBounds.begin()->_variable, 2U );
+
+        // A conflict that does not depend on any split means unsat
+        explanation.clear();
+        explanation.append( SmtCore::ConflictBound( Tightening( 6, 2.0, Tightening::UB ), 3 ) );
+        TS_ASSERT( !smtCore.backjump( explanation ) );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 0U );
+
+        // Once the clauses are cleared, nothing is implied any more
+        smtCore.clearLearnedClauses();
+        TS_ASSERT_THROWS_NOTHING( smtCore.getImpliedSplitsFromLearnedClauses( impliedSplits ) );
+        TS_ASSERT( impliedSplits.empty() );
+    }
+
+    void assertBounds( const Tableau *tableau, unsigned variable, double lb, double ub )
+    {
+        TS_ASSERT( FloatUtils::areEqual( tableau->getLowerBound( variable ), lb ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getUpperBound( variable ), ub ) );
+    }
+
+    void test_perform_split_and_pop_with_engine()
+    {
+        RealEngineFactories factories;
+
+        // A single ReLU, f = x1 = relu( b = x0 ), and x2 = x0 + x1
+        InputQuery inputQuery;
+        inputQuery.setNumberOfVariables( 3 );
+        inputQuery.setLowerBound( 0, -1 );
+        inputQuery.setUpperBound( 0, 1 );
+        inputQuery.setLowerBound( 1, 0 );
+        inputQuery.setUpperBound( 1, 1 );
+        inputQuery.setLowerBound( 2, -10 );
+        inputQuery.setUpperBound( 2, 10 );
+
+        Equation equation;
+        equation.addAddend( 1, 0 );
+        equation.addAddend( 1, 1 );
+        equation.addAddend( -1, 2 );
+        equation.setScalar( 0 );
+        inputQuery.addEquation( equation );
+
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 0, 1 ) );
+
+        Engine realEngine( 0 );
+        TS_ASSERT( realEngine.processInputQuery( inputQuery, false ) );
+
+        const Tableau *tableau = factories.lastTableau;
+        TS_ASSERT( tableau );
+
+        PiecewiseLinearConstraint *relu =
+            *realEngine.getInputQuery()->getPiecewiseLinearConstraints().begin();
+
+        SmtCore smtCore( &realEngine );
+        for ( unsigned i = 0; i < GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD; ++i )
+            smtCore.reportViolatedConstraint( relu );
+        TS_ASSERT( smtCore.needToSplit() );
+
+        // The first split is the inactive phase
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 1U );
+        assertBounds( tableau, 0, -1, 0 );
+        assertBounds( tableau, 1, 0, 0 );
+
+        // Popping it undoes its bounds before applying the active phase
+        TS_ASSERT( smtCore.popSplit() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 1U );
+        assertBounds( tableau, 0, 0, 1 );
+        assertBounds( tableau, 1, 0, 1 );
+
+        // Backtracking to the root restores the original bounds
+        TS_ASSERT_THROWS_NOTHING( smtCore.backtrackToRoot() );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 0U );
+        assertBounds( tableau, 0, -1, 1 );
+        assertBounds( tableau, 1, 0, 1 );
+    }
+
+    void test_backjump_to_first_decision_with_engine()
+    {
+        RealEngineFactories factories;
+
+        // Two ReLUs, x1 = relu( x0 ) and x3 = relu( x2 ), and x4 = x0 + x2
+        InputQuery inputQuery;
+        inputQuery.setNumberOfVariables( 5 );
+        for ( unsigned i = 0; i < 4; i += 2 )
+        {
+            inputQuery.setLowerBound( i, -1 );
+            inputQuery.setUpperBound( i, 1 );
+            inputQuery.setLowerBound( i + 1, 0 );
+            inputQuery.setUpperBound( i + 1, 1 );
+        }
+        inputQuery.setLowerBound( 4, -10 );
+        inputQuery.setUpperBound( 4, 10 );
+
+        Equation equation;
+        equation.addAddend( 1, 0 );
+        equation.addAddend( 1, 2 );
+        equation.addAddend( -1, 4 );
+        equation.setScalar( 0 );
+        inputQuery.addEquation( equation );
+
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 0, 1 ) );
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 2, 3 ) );
+
+        Engine realEngine( 0 );
+        TS_ASSERT( realEngine.processInputQuery( inputQuery, false ) );
+
+        const Tableau *tableau = factories.lastTableau;
+        TS_ASSERT( tableau );
+
+        const List<PiecewiseLinearConstraint *> &constraints =
+            realEngine.getInputQuery()->getPiecewiseLinearConstraints();
+        List<PiecewiseLinearConstraint *>::const_iterator it = constraints.begin();
+        PiecewiseLinearConstraint *first = *it;
+        PiecewiseLinearConstraint *second = *( ++it );
+
+        // Split on both ReLUs, taking their inactive phases
+        SmtCore smtCore( &realEngine );
+        for ( unsigned i = 0; i < GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD; ++i )
+            smtCore.reportViolatedConstraint( first );
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+        assertBounds( tableau, 1, 0, 0 );
+
+        for ( unsigned i = 0; i < GlobalConfiguration::CONSTRAINT_VIOLATION_THRESHOLD; ++i )
+            smtCore.reportViolatedConstraint( second );
+        TS_ASSERT_THROWS_NOTHING( smtCore.performSplit() );
+        assertBounds( tableau, 3, 0, 0 );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 2U );
+
+        /*
+          A conflict that involves a root bound and a bound of the first
+          decision only. The decision's bound is on the trail, after the
+          mark of the first stack entry.
+        */
+        List<Tightening> conflict;
+        conflict.append( Tightening( 1, 0.0, Tightening::UB ) );
+        conflict.append( Tightening( 4, 10.0, Tightening::UB ) );
+
+        Vector<unsigned> positions;
+        tableau->getBoundTrailPositions( conflict, positions );
+        TS_ASSERT_EQUALS( positions.size(), 2U );
+        TS_ASSERT_LESS_THAN( 0U, positions[0] );
+        TS_ASSERT_EQUALS( positions[1], 0U );
+
+        List<SmtCore::ConflictBound> explanation;
+        unsigned index = 0;
+        for ( const auto &bound : conflict )
+            explanation.append( SmtCore::ConflictBound( bound, positions[index++] ) );
+
+        // The second decision is skipped, and the first one is flipped
+        TS_ASSERT( smtCore.backjump( explanation ) );
+        TS_ASSERT_EQUALS( smtCore.getStackDepth(), 1U );
+        assertBounds( tableau, 0, 0, 1 );
+        assertBounds( tableau, 1, 0, 1 );
+        assertBounds( tableau, 2, -1, 1 );
+        assertBounds( tableau, 3, 0, 1 );
+    }
+
     void test_todo()
     {
         // Reason: the inefficiency in resizing the tableau mutliple times
@@ -16,13 +16,17 @@
 
 #include <cxxtest/TestSuite.h>
 
+#include "CSRMatrix.h"
 #include "Equation.h"
+#include "FloatUtils.h"
+#include "GlobalConfiguration.h"
 #include "MockCostFunctionManager.h"
 #include "MockErrno.h"
 #include "MarabouError.h"
 #include "Tableau.h"
 #include "TableauRow.h"
 #include "TableauState.h"
+#include "Tightening.h"
 
 #include <string.h>
 
@@ -51,6 +55,15 @@ public:
     {
         lastNotifiedUpperBounds[variable] = bound;
     }
+
+    List<List<unsigned>> notifiedBoundChanges;
+    void notifyBoundChanges( const unsigned *variables, unsigned count )
+    {
+        List<unsigned> batch;
+        for ( unsigned i = 0; i < count; ++i )
+            batch.append( variables[i] );
+        notifiedBoundChanges.append( batch );
+    }
 };
 
 class TableauTestSuite : public CxxTest::TestSuite
@@ -70,7 +83,7 @@ public:
 
     bool hasCandidates( const ITableau &tableau ) const
     {
-        List<unsigned> candidates;
+        Vector<unsigned> candidates;
         tableau.getEntryCandidates( candidates );
         return !candidates.empty();
     }
@@ -171,6 +184,88 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_sparse_constraint_matrix()
+    {
+        double A[] = {
+            3, 2, 1, 2, 1, 0, 0,
+            1, 1, 1, 1, 0, 1, 0,
+            4, 3, 3, 4, 0, 0, 1,
+        };
+
+        Tableau *dense = NULL;
+        Tableau *sparse = NULL;
+
+        TS_ASSERT( dense = new Tableau );
+        TS_ASSERT( sparse = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( dense->setDimensions( 3, 7 ) );
+        TS_ASSERT_THROWS_NOTHING( sparse->setDimensions( 3, 7 ) );
+
+        CSRMatrix matrix( A, 3, 7 );
+        TS_ASSERT_THROWS_NOTHING( dense->setConstraintMatrix( A ) );
+        TS_ASSERT_THROWS_NOTHING( sparse->setConstraintMatrix( &matrix ) );
+
+        // Both tableaus hold the same rows and columns, in the same order
+        for ( unsigned i = 0; i < 3; ++i )
+        {
+            const SparseUnsortedList *denseRow = dense->getSparseARow( i );
+            const SparseUnsortedList *sparseRow = sparse->getSparseARow( i );
+
+            TS_ASSERT_EQUALS( denseRow->getNnz(), sparseRow->getNnz() );
+            auto it = sparseRow->begin();
+            for ( const auto &entry : *denseRow )
+            {
+                TS_ASSERT_EQUALS( entry._index, it->_index );
+                TS_ASSERT_EQUALS( entry._value, it->_value );
+                ++it;
+            }
+        }
+
+        for ( unsigned i = 0; i < 7; ++i )
+        {
+            const SparseUnsortedList *denseColumn = dense->getSparseAColumn( i );
+            const SparseUnsortedList *sparseColumn = sparse->getSparseAColumn( i );
+
+            TS_ASSERT_EQUALS( denseColumn->getNnz(), sparseColumn->getNnz() );
+            auto it = sparseColumn->begin();
+            for ( const auto &entry : *denseColumn )
+            {
+                TS_ASSERT_EQUALS( entry._index, it->_index );
+                TS_ASSERT_EQUALS( entry._value, it->_value );
+                ++it;
+            }
+        }
+
+        for ( unsigned i = 0; i < 3; ++i )
+            for ( unsigned j = 0; j < 7; ++j )
+                TS_ASSERT_EQUALS( sparse->getSparseA()->get( i, j ), A[i*7 + j] );
+
+        // The sparse tableau computes the same assignment
+        double b[3] = { 225, 117, 420 };
+        sparse->setRightHandSide( b );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( sparse->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( sparse->setUpperBound( i, 2 ) );
+        }
+        for ( unsigned i = 4; i < 7; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( sparse->setLowerBound( i, 0 ) );
+            TS_ASSERT_THROWS_NOTHING( sparse->setUpperBound( i, 500 ) );
+        }
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( sparse->initializeTableau( basics ) );
+
+        TS_ASSERT_EQUALS( sparse->getValue( 4 ), 217.0 );
+        TS_ASSERT_EQUALS( sparse->getValue( 5 ), 113.0 );
+        TS_ASSERT_EQUALS( sparse->getValue( 6 ), 406.0 );
+
+        TS_ASSERT_THROWS_NOTHING( delete dense );
+        TS_ASSERT_THROWS_NOTHING( delete sparse );
+    }
+
     void test_watcher__value_changes()
     {
         Tableau *tableau = NULL;
@@ -227,6 +322,42 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_batched_watcher__bound_changes()
+    {
+        Tableau *tableau = NULL;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        initializeTableauValues( *tableau );
+
+        MockVariableWatcher watcher;
+        TS_ASSERT_THROWS_NOTHING( tableau->registerBatchedWatcher( &watcher ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 2, 1 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 2, 2 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 114 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 2, 1.5 ) );
+
+        // Nothing is sent until the changes are flushed, and batched
+        // watchers get no per-variable callbacks
+        TS_ASSERT( watcher.notifiedBoundChanges.empty() );
+        TS_ASSERT( watcher.lastNotifiedLowerBounds.empty() );
+        TS_ASSERT( watcher.lastNotifiedUpperBounds.empty() );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->flushBoundChanges() );
+
+        List<unsigned> expected = { 2, 5, 2 };
+        TS_ASSERT_EQUALS( watcher.notifiedBoundChanges.size(), 1U );
+        TS_ASSERT_EQUALS( *watcher.notifiedBoundChanges.begin(), expected );
+
+        // Flushing again without changes does not notify
+        TS_ASSERT_THROWS_NOTHING( tableau->flushBoundChanges() );
+        TS_ASSERT_EQUALS( watcher.notifiedBoundChanges.size(), 1U );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_get_entering_variable__have_eligible_variables()
     {
         Tableau *tableau = NULL;
@@ -421,16 +552,35 @@ public:
         // Var 5 poses no constraint
         // Var 6 will hit its upper bound: constraint is 8
         TS_ASSERT_THROWS_NOTHING( tableau->pickLeavingVariable( d5 ) );
-        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 6u );
-        TS_ASSERT_EQUALS( tableau->getChangeRatio(), 8.0 );
+        if ( GlobalConfiguration::USE_BOUND_FLIPPING_RATIO_TEST )
+        {
+            // The slope is still negative once var 6 is fixed, so
+            // the entering variable goes all the way to its bound
+            TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 2u );
+            TS_ASSERT_EQUALS( tableau->getChangeRatio(), 9.0 );
+        }
+        else
+        {
+            TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 6u );
+            TS_ASSERT_EQUALS( tableau->getChangeRatio(), 8.0 );
+        }
 
         double d6[] = { -0.5, 0, 0.1 };
         // Var 4 will hit its lower bound: constraint is 4
         // Var 5 poses no constraint
         // Var 6 will hit its upper bound: constraint is 40
         TS_ASSERT_THROWS_NOTHING( tableau->pickLeavingVariable( d6 ) );
-        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 4u );
-        TS_ASSERT_EQUALS( tableau->getChangeRatio(), 4.0 );
+        if ( GlobalConfiguration::USE_BOUND_FLIPPING_RATIO_TEST )
+        {
+            // As before, var 4's breakpoint is passed
+            TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 2u );
+            TS_ASSERT_EQUALS( tableau->getChangeRatio(), 9.0 );
+        }
+        else
+        {
+            TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 4u );
+            TS_ASSERT_EQUALS( tableau->getChangeRatio(), 4.0 );
+        }
 
         double d7[] = { 1, 0, 0.00001 };
         // The entering variable (2) can change by 9 at most. Here
@@ -442,6 +592,101 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_bound_flipping_ratio_test()
+    {
+        if ( !GlobalConfiguration::USE_BOUND_FLIPPING_RATIO_TEST )
+            return;
+
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 10 ) );
+        }
+
+        // All three basics are too high
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 200 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 210 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 100 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 110 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 390 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 400 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        TS_ASSERT_EQUALS( tableau->getValue( 4 ), 217.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 5 ), 113.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 6 ), 406.0 );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->computeCostFunction() );
+        costFunctionManager.nextCostFunction = new double[4];
+        costFunctionManager.nextCostFunction[0] = -6;
+        costFunctionManager.nextCostFunction[1] = -6;
+        costFunctionManager.nextCostFunction[2] = -6;
+        costFunctionManager.nextCostFunction[3] = -6;
+
+        costFunctionManager.nextBasicCost[0] = +1;
+        costFunctionManager.nextBasicCost[1] = +1;
+        costFunctionManager.nextBasicCost[2] = +1;
+
+        /*
+          x2 enters and increases from 1, and the basics decrease at
+          rates 2, 1 and 3. The breakpoints are:
+
+            x5 becomes feasible at 3.5, and hits its lower bound at 8.5
+            x6 becomes feasible at 3, and hits its lower bound at 13
+            x7 becomes feasible at 2, and hits its lower bound at 16/3
+
+          The initial slope is -6. After passing x7 and x6 it is -2, and
+          it hits 0 at x5's breakpoint.
+        */
+        tableau->setEnteringVariableIndex( 1u );
+        TS_ASSERT_THROWS_NOTHING( tableau->computeChangeColumn() );
+        TS_ASSERT_THROWS_NOTHING( tableau->pickLeavingVariable() );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 4u );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getChangeRatio(), 3.5 ) );
+
+        /*
+          With a steeper slope, all breakpoints are passed, and the step
+          is limited by x7's far bound.
+        */
+        for ( unsigned i = 0; i < 4; ++i )
+            costFunctionManager.nextCostFunction[i] = -10;
+
+        TS_ASSERT_THROWS_NOTHING( tableau->pickLeavingVariable() );
+        TS_ASSERT_EQUALS( tableau->getLeavingVariable(), 6u );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getChangeRatio(), 16.0 / 3 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->computePivotRow() );
+        TS_ASSERT_THROWS_NOTHING( tableau->performPivot() );
+
+        // x7 was too high, but leaves the basis at its lower bound
+        TS_ASSERT( !tableau->isBasic( 6u ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getValue( 6u ), 390.0 ) );
+
+        TS_ASSERT( tableau->isBasic( 1u ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getValue( 1u ), 1 + 16.0 / 3 ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getValue( 4u ), 217 - 32.0 / 3 ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getValue( 5u ), 113 - 16.0 / 3 ) );
+
+        // All variables are now within bounds
+        TS_ASSERT( tableau->allBoundsValid() );
+        TS_ASSERT( !tableau->existsBasicOutOfBounds() );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_perform_pivot_nonbasic_goes_to_opposite_bound()
     {
         Tableau *tableau = NULL;
@@ -582,6 +827,87 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_dual_ratio_test()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 10 ) );
+        }
+
+        // x1 is fixed, and cannot enter the basis
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 0, 1 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 219 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 228 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 112 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 114 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 400 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 402 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        /*
+          All non-basics are at their lower bound, 1:
+
+            x5 = 225 - 3 - 2 - 1 - 2 = 217, below its lower bound
+            x6 = 117 - 1 - 1 - 1 - 1 = 113, within bounds
+            x7 = 420 - 4 - 3 - 3 - 4 = 406, above its upper bound
+        */
+        TS_ASSERT_EQUALS( tableau->getValue( 4 ), 217.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 6 ), 406.0 );
+
+        // x5 can only increase if some non-basic decreases - none can.
+        tableau->setLeavingVariableIndex( 0 );
+        TS_ASSERT_THROWS_NOTHING( tableau->computePivotRow() );
+        TS_ASSERT( !tableau->pickEnteringVariableByDualRatioTest() );
+
+        /*
+          x7 decreases if x2, x3 or x4 increase (x1 is fixed). The
+          largest pivot, x4, is picked - as all three would remain
+          within their bounds.
+        */
+        tableau->setLeavingVariableIndex( 2 );
+        TS_ASSERT_THROWS_NOTHING( tableau->computePivotRow() );
+
+        TS_ASSERT( tableau->pickEnteringVariableByDualRatioTest() );
+        TS_ASSERT_EQUALS( tableau->getEnteringVariable(), 3U );
+
+        // If x4 would exceed its upper bound, x2 is preferred
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 3, 1.5 ) );
+        TS_ASSERT( tableau->pickEnteringVariableByDualRatioTest() );
+        TS_ASSERT_EQUALS( tableau->getEnteringVariable(), 1U );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 3, 10 ) );
+
+        TS_ASSERT( tableau->pickEnteringVariableByDualRatioTest() );
+        TS_ASSERT_EQUALS( tableau->getEnteringVariable(), 3U );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getChangeRatio(), 1.0 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->computeChangeColumn() );
+        TS_ASSERT_THROWS_NOTHING( tableau->performPivot() );
+
+        // x7 is now non-basic at its upper bound, and x4 has increased by 1
+        TS_ASSERT( tableau->isBasic( 3u ) );
+        TS_ASSERT( !tableau->isBasic( 6u ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getValue( 6u ), 402.0 ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getValue( 3u ), 2.0 ) );
+        TS_ASSERT( FloatUtils::areEqual( tableau->getValue( 4u ), 215.0 ) );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_get_row()
     {
         Tableau *tableau = NULL;
@@ -1061,7 +1387,8 @@ public:
         TableauState *tableauState = NULL;
         TS_ASSERT( tableauState = new TableauState );
 
-        TS_ASSERT_THROWS_NOTHING( tableau->storeState( *tableauState ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->storeState( *tableauState,
+                                                       TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE ) );
 
         // Do some more stuff
         TS_ASSERT_THROWS_NOTHING( tableau->computeCostFunction() );
@@ -1122,6 +1449,294 @@ public:
         TS_ASSERT_THROWS_NOTHING( delete tableau );
     }
 
+    void test_store_and_restore_bound_trail()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 10 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 200 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 228 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 100 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 114 ) );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 350 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 420 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+        tableau->setBoundTrailRecording( true );
+
+        // Store only a trail mark
+        TableauState *tableauState = NULL;
+        TS_ASSERT( tableauState = new TableauState );
+        TS_ASSERT_THROWS_NOTHING( tableau->storeState( *tableauState,
+                                                       TableauStateStorageLevel::STORE_BOUND_TRAIL ) );
+        TS_ASSERT( !tableauState->_sparseColumnsOfA );
+        TS_ASSERT( !tableauState->_lowerBounds );
+
+        // Tighten some bounds and add an equation: 2x2 - 4x3 + x8 = 5
+        TS_ASSERT_THROWS_NOTHING( tableau->tightenLowerBound( 0, 3 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->tightenUpperBound( 1, 4 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->tightenLowerBound( 1, 2 ) );
+
+        Equation equation;
+        equation.addAddend( 2, 1 );
+        equation.addAddend( -4, 2 );
+        equation.setScalar( 5 );
+        TS_ASSERT_THROWS_NOTHING( tableau->addEquation( equation ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->tightenUpperBound( 7, 0 ) );
+
+        TS_ASSERT_EQUALS( tableau->getM(), 4U );
+        TS_ASSERT_EQUALS( tableau->getN(), 8U );
+        TS_ASSERT_EQUALS( tableau->getLowerBound( 0 ), 3.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 0 ), 3.0 );
+
+        // Rewind
+        TS_ASSERT_THROWS_NOTHING( tableau->restoreState( *tableauState ) );
+
+        TS_ASSERT_EQUALS( tableau->getM(), 3U );
+        TS_ASSERT_EQUALS( tableau->getN(), 7U );
+        TS_ASSERT_EQUALS( tableau->getSparseA()->getNnz(), 15U );
+        TS_ASSERT_EQUALS( tableau->getSparseAColumn( 1 )->getNnz(), 3U );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_EQUALS( tableau->getLowerBound( i ), 1.0 );
+            TS_ASSERT_EQUALS( tableau->getUpperBound( i ), 10.0 );
+        }
+        TS_ASSERT_EQUALS( tableau->getLowerBound( 5 ), 100.0 );
+        TS_ASSERT_EQUALS( tableau->getUpperBound( 5 ), 114.0 );
+
+        TS_ASSERT( tableau->isBasic( 4 ) );
+        TS_ASSERT( tableau->isBasic( 5 ) );
+        TS_ASSERT( tableau->isBasic( 6 ) );
+
+        // x5 = 225 - 3x1 - 2x2 - x3 - 2x4, with x1 and x2 kept at their
+        // values, which are within the restored bounds
+        TS_ASSERT_EQUALS( tableau->getValue( 0 ), 3.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 1 ), 2.0 );
+        TS_ASSERT_EQUALS( tableau->getValue( 4 ), 225.0 - 9 - 4 - 1 - 2 );
+
+        // Adding the equation again works as before
+        TS_ASSERT_EQUALS( tableau->addEquation( equation ), 7U );
+        TS_ASSERT_EQUALS( tableau->getM(), 4U );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableauState );
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
+    void test_get_bound_trail_positions()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+        tableau->setBoundTrailRecording( true );
+
+        for ( unsigned i = 0; i < 7; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 300 ) );
+        }
+
+        TableauState tableauState;
+        tableau->storeState( tableauState, TableauStateStorageLevel::STORE_BOUND_TRAIL );
+        unsigned mark = tableauState._boundTrailSize;
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 0, 1.5 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 0, 1.8 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 113 ) );
+
+        List<Tightening> bounds;
+        // Holds since the first change after the mark
+        bounds.append( Tightening( 0, 1.5, Tightening::LB ) );
+        // Holds since the last change to x0's lower bound
+        bounds.append( Tightening( 0, 1.8, Tightening::LB ) );
+        bounds.append( Tightening( 5, 113, Tightening::UB ) );
+        // Holds since before the mark
+        bounds.append( Tightening( 4, 300, Tightening::UB ) );
+        // Has always held
+        bounds.append( Tightening( 6, FloatUtils::negativeInfinity(), Tightening::LB ) );
+
+        // Bounds on the same variable and side are located separately
+        List<Tightening> firstBound;
+        firstBound.append( *bounds.begin() );
+
+        Vector<unsigned> positions;
+        TS_ASSERT_THROWS_NOTHING( tableau->getBoundTrailPositions( firstBound, positions ) );
+        TS_ASSERT_EQUALS( positions.size(), 1U );
+        TS_ASSERT_EQUALS( positions[0], mark + 1 );
+
+        bounds.erase( bounds.begin() );
+        TS_ASSERT_THROWS_NOTHING( tableau->getBoundTrailPositions( bounds, positions ) );
+        TS_ASSERT_EQUALS( positions.size(), 4U );
+        TS_ASSERT_EQUALS( positions[0], mark + 2 );
+        TS_ASSERT_EQUALS( positions[1], mark + 3 );
+        TS_ASSERT( positions[2] > 0 && positions[2] <= mark );
+        TS_ASSERT_EQUALS( positions[3], 0U );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
+    void test_bound_trail_recording()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        // Bound changes are not recorded by default
+        for ( unsigned i = 0; i < 7; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 300 ) );
+        }
+
+        TableauState tableauState;
+        tableau->storeState( tableauState, TableauStateStorageLevel::STORE_BOUND_TRAIL );
+        TS_ASSERT_EQUALS( tableauState._boundTrailSize, 0U );
+
+        tableau->setBoundTrailRecording( true );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 0, 1.5 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 113 ) );
+
+        tableau->storeState( tableauState, TableauStateStorageLevel::STORE_BOUND_TRAIL );
+        TS_ASSERT_EQUALS( tableauState._boundTrailSize, 2U );
+
+        // Turning the recording off clears the trail
+        tableau->setBoundTrailRecording( false );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 0, 2 ) );
+
+        tableau->storeState( tableauState, TableauStateStorageLevel::STORE_BOUND_TRAIL );
+        TS_ASSERT_EQUALS( tableauState._boundTrailSize, 0U );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
+    void checkAColumn( Tableau *tableau, unsigned variable, const List<double> &expected )
+    {
+        TS_ASSERT_EQUALS( tableau->getM(), expected.size() );
+
+        const double *column = tableau->getAColumn( variable );
+        const SparseUnsortedList *sparseColumn = tableau->getSparseAColumn( variable );
+
+        unsigned row = 0;
+        for ( const auto &value : expected )
+        {
+            TS_ASSERT_EQUALS( column[row], value );
+            TS_ASSERT_EQUALS( sparseColumn->get( row ), value );
+            TS_ASSERT_EQUALS( tableau->getSparseARow( row )->get( variable ), value );
+            ++row;
+        }
+    }
+
+    void test_add_equations_and_restore_entire_state()
+    {
+        Tableau *tableau = NULL;
+        MockCostFunctionManager costFunctionManager;
+
+        TS_ASSERT( tableau = new Tableau );
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setDimensions( 3, 7 ) );
+        tableau->registerCostFunctionManager( &costFunctionManager );
+        initializeTableauValues( *tableau );
+
+        for ( unsigned i = 0; i < 4; ++i )
+        {
+            TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( i, 1 ) );
+            TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( i, 10 ) );
+        }
+
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 4, 200 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 4, 228 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 5, 100 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 5, 114 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setLowerBound( 6, 350 ) );
+        TS_ASSERT_THROWS_NOTHING( tableau->setUpperBound( 6, 420 ) );
+
+        List<unsigned> basics = { 4, 5, 6 };
+        TS_ASSERT_THROWS_NOTHING( tableau->initializeTableau( basics ) );
+
+        // 2x2 - 4x3 + x8 = 5
+        Equation equation1;
+        equation1.addAddend( 2, 1 );
+        equation1.addAddend( -4, 2 );
+        equation1.setScalar( 5 );
+
+        // x1 + x2 + x9 = 5
+        Equation equation2;
+        equation2.addAddend( 1, 0 );
+        equation2.addAddend( 1, 1 );
+        equation2.setScalar( 5 );
+
+        // x3 + x4 + x10 = 5
+        Equation equation3;
+        equation3.addAddend( 1, 2 );
+        equation3.addAddend( 1, 3 );
+        equation3.setScalar( 5 );
+
+        TS_ASSERT_EQUALS( tableau->addEquation( equation1 ), 7U );
+
+        TableauState *tableauState = NULL;
+        TS_ASSERT( tableauState = new TableauState );
+        TS_ASSERT_THROWS_NOTHING( tableau->storeState( *tableauState,
+                                                       TableauStateStorageLevel::STORE_ENTIRE_TABLEAU_STATE ) );
+
+        // Grow past the current capacity
+        TS_ASSERT_EQUALS( tableau->addEquation( equation2 ), 8U );
+        TS_ASSERT_EQUALS( tableau->addEquation( equation3 ), 9U );
+
+        TS_ASSERT_EQUALS( tableau->getM(), 6U );
+        TS_ASSERT_EQUALS( tableau->getN(), 10U );
+        checkAColumn( tableau, 0, { 3, 1, 4, 0, 1, 0 } );
+        checkAColumn( tableau, 1, { 2, 1, 3, 2, 1, 0 } );
+        checkAColumn( tableau, 9, { 0, 0, 0, 0, 0, 1 } );
+        TS_ASSERT_EQUALS( tableau->getValue( 8 ), 5.0 - tableau->getValue( 0 ) - tableau->getValue( 1 ) );
+
+        // Going back to 4 rows keeps the allocated memory
+        TS_ASSERT_THROWS_NOTHING( tableau->restoreState( *tableauState ) );
+
+        TS_ASSERT_EQUALS( tableau->getM(), 4U );
+        TS_ASSERT_EQUALS( tableau->getN(), 8U );
+        checkAColumn( tableau, 0, { 3, 1, 4, 0 } );
+        checkAColumn( tableau, 1, { 2, 1, 3, 2 } );
+        checkAColumn( tableau, 7, { 0, 0, 0, 1 } );
+
+        // The rows and columns that are reused start out empty
+        TS_ASSERT_EQUALS( tableau->addEquation( equation3 ), 8U );
+
+        TS_ASSERT_EQUALS( tableau->getM(), 5U );
+        checkAColumn( tableau, 0, { 3, 1, 4, 0, 0 } );
+        checkAColumn( tableau, 2, { 1, 1, 3, -4, 1 } );
+        checkAColumn( tableau, 8, { 0, 0, 0, 0, 1 } );
+        TS_ASSERT_EQUALS( tableau->getSparseARow( 4 )->getNnz(), 3U );
+        TS_ASSERT_EQUALS( tableau->getValue( 8 ), 5.0 - tableau->getValue( 2 ) - tableau->getValue( 3 ) );
+
+        TS_ASSERT_THROWS_NOTHING( delete tableauState );
+        TS_ASSERT_THROWS_NOTHING( delete tableau );
+    }
+
     void test_add_equation()
     {
         Tableau *tableau = NULL;
@@ -1533,8 +2148,6 @@ public:
 
     void test_todo()
     {
-        TS_TRACE( "When resizing the talbeau, allocate a larger size and only use part of it, "
-                  "instead of increasing it one row at a time?" );
         TS_TRACE( "Make sure all watchers are properply informed when restoring a tabealu" );
         TS_TRACE( "Recomputing the cost function: more clever handling for row addition and "
                   "the setNonBasic() case?" );
@@ -0,0 +1,212 @@
+/*********************                                                        */
+/*! \file Test_VariableValueMap.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "MockErrno.h"
+#include "VariableValueMap.h"
+
+class VariableValueMapTestSuite : public CxxTest::TestSuite
+{
+public:
+    MockErrno *mockErrno;
+
+    void setUp()
+    {
+        TS_ASSERT( mockErrno = new MockErrno );
+    }
+
+    void tearDown()
+    {
+        TS_ASSERT_THROWS_NOTHING( delete mockErrno );
+    }
+
+    void test_insert_and_get()
+    {
+        VariableValueMap map;
+
+        TS_ASSERT( map.empty() );
+        TS_ASSERT( !map.exists( 3 ) );
+        TS_ASSERT_THROWS_EQUALS( map.get( 3 ),
+                                 const CommonError &e,
+                                 e.getCode(),
+                                 CommonError::KEY_DOESNT_EXIST_IN_MAP );
+
+        map[3] = 1.5;
+        map[7] = -2;
+
+        TS_ASSERT_EQUALS( map.size(), 2U );
+        TS_ASSERT( map.exists( 3 ) );
+        TS_ASSERT( map.exists( 7 ) );
+        TS_ASSERT_EQUALS( map.get( 3 ), 1.5 );
+        TS_ASSERT_EQUALS( map[7], -2 );
+
+        // Overwrite an existing entry
+        map[3] = 4;
+        TS_ASSERT_EQUALS( map.size(), 2U );
+        TS_ASSERT_EQUALS( map.get( 3 ), 4 );
+
+        // A new entry starts at zero
+        TS_ASSERT_EQUALS( map[9], 0 );
+        TS_ASSERT_EQUALS( map.size(), 3U );
+
+        const VariableValueMap &constMap( map );
+        TS_ASSERT_EQUALS( constMap[3], 4 );
+        TS_ASSERT_THROWS_EQUALS( constMap[5],
+                                 const CommonError &e,
+                                 e.getCode(),
+                                 CommonError::KEY_DOESNT_EXIST_IN_MAP );
+    }
+
+    void test_erase_and_clear()
+    {
+        VariableValueMap map;
+
+        map[1] = 10;
+        map[2] = 20;
+        map[3] = 30;
+
+        TS_ASSERT_THROWS_NOTHING( map.erase( 1 ) );
+        TS_ASSERT_EQUALS( map.size(), 2U );
+        TS_ASSERT( !map.exists( 1 ) );
+        TS_ASSERT_EQUALS( map.get( 2 ), 20 );
+        TS_ASSERT_EQUALS( map.get( 3 ), 30 );
+
+        TS_ASSERT_THROWS_EQUALS( map.erase( 1 ),
+                                 const CommonError &e,
+                                 e.getCode(),
+                                 CommonError::KEY_DOESNT_EXIST_IN_MAP );
+
+        map.clear();
+        TS_ASSERT( map.empty() );
+        TS_ASSERT( !map.exists( 2 ) );
+    }
+
+    void test_grow_beyond_inline_capacity_and_copy()
+    {
+        VariableValueMap map;
+
+        for ( unsigned i = 0; i < 20; ++i )
+            map[100 - i] = i;
+
+        TS_ASSERT_EQUALS( map.size(), 20U );
+        for ( unsigned i = 0; i < 20; ++i )
+            TS_ASSERT_EQUALS( map.get( 100 - i ), i );
+
+        // Copies are deep, in both directions between inline and heap
+        // storage
+        VariableValueMap copy( map );
+        map[100] = -1;
+        TS_ASSERT_EQUALS( copy.get( 100 ), 0 );
+        TS_ASSERT_EQUALS( copy.size(), 20U );
+
+        VariableValueMap small;
+        small[5] = 5;
+        small = map;
+        TS_ASSERT_EQUALS( small.size(), 20U );
+        TS_ASSERT_EQUALS( small.get( 100 ), -1 );
+
+        VariableValueMap other;
+        other[6] = 6;
+        map = other;
+        TS_ASSERT_EQUALS( map.size(), 1U );
+        TS_ASSERT_EQUALS( map.get( 6 ), 6 );
+        TS_ASSERT( !map.exists( 100 ) );
+    }
+
+    void test_fixed_slots()
+    {
+        VariableValueMap map;
+
+        // An existing entry moves into its fixed slot
+        map[8] = 3;
+        map.addFixedSlot( 5 );
+        map.addFixedSlot( 8 );
+        map.addFixedSlot( 5 );
+
+        TS_ASSERT_EQUALS( map.size(), 1U );
+        TS_ASSERT( !map.exists( 5 ) );
+        TS_ASSERT_EQUALS( map.get( 8 ), 3 );
+
+        map[5] = 1;
+        map[2] = 7;
+        TS_ASSERT_EQUALS( map.size(), 3U );
+        TS_ASSERT_EQUALS( map.get( 5 ), 1 );
+        TS_ASSERT_EQUALS( map.get( 2 ), 7 );
+
+        // Erasing keeps the slot, and renaming moves it
+        TS_ASSERT_THROWS_NOTHING( map.erase( 5 ) );
+        TS_ASSERT( !map.exists( 5 ) );
+        TS_ASSERT_THROWS_EQUALS( map.erase( 5 ),
+                                 const CommonError &e,
+                                 e.getCode(),
+                                 CommonError::KEY_DOESNT_EXIST_IN_MAP );
+
+        map.renameVariable( 8, 11 );
+        map.renameVariable( 2, 4 );
+        TS_ASSERT( !map.exists( 8 ) );
+        TS_ASSERT( !map.exists( 2 ) );
+        TS_ASSERT_EQUALS( map.get( 11 ), 3 );
+        TS_ASSERT_EQUALS( map.get( 4 ), 7 );
+        TS_ASSERT_EQUALS( map.size(), 2U );
+
+        // Copies keep the fixed slots
+        VariableValueMap copy( map );
+        copy[5] = 2;
+        TS_ASSERT_EQUALS( copy.size(), 3U );
+        TS_ASSERT_EQUALS( copy.get( 11 ), 3 );
+        TS_ASSERT( !map.exists( 5 ) );
+
+        map.clear();
+        TS_ASSERT( map.empty() );
+        map[11] = 6;
+        TS_ASSERT_EQUALS( map.get( 11 ), 6 );
+    }
+
+    void test_sorted_entries()
+    {
+        VariableValueMap map;
+        map.addFixedSlot( 50 );
+
+        // Insert and erase in an order unrelated to the variables
+        for ( unsigned i = 0; i < 40; ++i )
+            map[( i * 17 ) % 40] = i;
+        for ( unsigned i = 0; i < 40; i += 3 )
+            map.erase( ( i * 17 ) % 40 );
+
+        TS_ASSERT_EQUALS( map.size(), 26U );
+        for ( unsigned i = 0; i < 40; ++i )
+        {
+            unsigned variable = ( i * 17 ) % 40;
+            if ( i % 3 == 0 )
+            {
+                TS_ASSERT( !map.exists( variable ) );
+            }
+            else
+            {
+                TS_ASSERT_EQUALS( map.get( variable ), i );
+            }
+        }
+        TS_ASSERT( !map.exists( 50 ) );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,169 @@
+/*********************                                                        */
+/*! \file Test_WorkStealingQueue.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Haoze Wu
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "WorkStealingQueue.h"
+
+#include <thread>
+
+class WorkStealingQueueTestSuite : public CxxTest::TestSuite
+{
+public:
+    std::atomic_uint numUnsolvedSubQueries;
+    std::atomic_bool shouldQuitSolving;
+
+    void setUp()
+    {
+        numUnsolvedSubQueries = 0;
+        shouldQuitSolving = false;
+    }
+
+    SubQuery *createSubQuery( const String &queryId )
+    {
+        auto split = std::unique_ptr<PiecewiseLinearCaseSplit>
+            ( new PiecewiseLinearCaseSplit );
+        split->storeBoundTightening( Tightening( 1, -2.0, Tightening::LB ) );
+        split->storeBoundTightening( Tightening( 1, 2.0, Tightening::UB ) );
+
+        return new SubQuery( queryId, split, 5 );
+    }
+
+    void test_pop_own_subqueries()
+    {
+        WorkStealingQueue queue( 2, numUnsolvedSubQueries, shouldQuitSolving );
+
+        queue.push( 0, createSubQuery( "1" ) );
+        queue.push( 0, createSubQuery( "2" ) );
+        TS_ASSERT_EQUALS( queue.getNumPendingSubQueries(), 2U );
+
+        // A worker pops its own subqueries last-in, first-out
+        SubQuery *subQuery = queue.tryPop( 0 );
+        TS_ASSERT( subQuery );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "2" );
+        delete subQuery;
+
+        subQuery = queue.tryPop( 0 );
+        TS_ASSERT( subQuery );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "1" );
+        delete subQuery;
+
+        TS_ASSERT( queue.empty() );
+        TS_ASSERT( !queue.tryPop( 0 ) );
+        TS_ASSERT( !queue.tryPop( 1 ) );
+    }
+
+    void test_steal_half()
+    {
+        WorkStealingQueue queue( 3, numUnsolvedSubQueries, shouldQuitSolving );
+
+        queue.push( 0, createSubQuery( "1" ) );
+        queue.push( 0, createSubQuery( "2" ) );
+        queue.push( 0, createSubQuery( "3" ) );
+        queue.push( 0, createSubQuery( "4" ) );
+        queue.push( 1, createSubQuery( "5" ) );
+
+        // Worker 2 steals the two oldest subqueries of worker 0, the
+        // fullest deque, and keeps one of them for later
+        SubQuery *subQuery = queue.tryPop( 2 );
+        TS_ASSERT( subQuery );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "1" );
+        delete subQuery;
+        TS_ASSERT_EQUALS( queue.getNumPendingSubQueries(), 4U );
+
+        subQuery = queue.tryPop( 2 );
+        TS_ASSERT( subQuery );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "2" );
+        delete subQuery;
+
+        // Worker 0 still has its newest subqueries
+        subQuery = queue.tryPop( 0 );
+        TS_ASSERT( subQuery );
+        TS_ASSERT_EQUALS( subQuery->_queryId, "4" );
+        delete subQuery;
+
+        TS_ASSERT_EQUALS( queue.clear(), 2U );
+        TS_ASSERT( queue.empty() );
+    }
+
+    void test_share_subtree()
+    {
+        WorkStealingQueue queue( 2, numUnsolvedSubQueries, shouldQuitSolving );
+
+        SubQuery *subQuery = createSubQuery( "3-1" );
+        numUnsolvedSubQueries = 1;
+        queue.startSubQuery( 0, *subQuery );
+
+        TS_ASSERT( !queue.workersAreStarving() );
+
+        PiecewiseLinearCaseSplit subtree;
+        subtree.storeBoundTightening( Tightening( 4, 0.0, Tightening::UB ) );
+        queue.shareSubtree( 0, subtree );
+
+        TS_ASSERT_EQUALS( numUnsolvedSubQueries.load(), 2U );
+        TS_ASSERT_EQUALS( queue.getNumPendingSubQueries(), 1U );
+
+        SubQuery *shared = queue.tryPop( 1 );
+        TS_ASSERT( shared );
+        TS_ASSERT_EQUALS( shared->_queryId, "3-1-s1" );
+        TS_ASSERT_EQUALS( shared->_timeoutInSeconds, 5U );
+
+        PiecewiseLinearCaseSplit expected( *subQuery->_split );
+        expected.storeBoundTightening( Tightening( 4, 0.0, Tightening::UB ) );
+        TS_ASSERT_EQUALS( *shared->_split, expected );
+
+        delete shared;
+        delete subQuery;
+    }
+
+    void test_idle_workers_wait_for_work()
+    {
+        WorkStealingQueue queue( 2, numUnsolvedSubQueries, shouldQuitSolving );
+
+        SubQuery *popped = NULL;
+        std::thread worker( [&]() { popped = queue.pop( 1 ); } );
+
+        while ( !queue.workersAreStarving() )
+            std::this_thread::yield();
+
+        queue.push( 0, createSubQuery( "1" ) );
+        worker.join();
+
+        TS_ASSERT( popped );
+        TS_ASSERT_EQUALS( popped->_queryId, "1" );
+        TS_ASSERT( !queue.workersAreStarving() );
+        delete popped;
+
+        // Once solving is over, waiting workers return empty-handed
+        std::thread worker2( [&]() { popped = queue.pop( 1 ); } );
+
+        while ( !queue.workersAreStarving() )
+            std::this_thread::yield();
+
+        queue.quit();
+        worker2.join();
+
+        TS_ASSERT( !popped );
+        TS_ASSERT( shouldQuitSolving.load() );
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -19,8 +19,14 @@
 #include "Layer.h"
 #include "MStringf.h"
 #include "NLRError.h"
+#include "Options.h"
 #include "TimeUtils.h"
 
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <thread>
+
 namespace NLR {
 
 LPFormulator::LPFormulator( LayerOwner *layerOwner )
@@ -45,35 +51,7 @@ double LPFormulator::solveLPRelaxation( const Map<unsigned, Layer *> &layers,
 
     createLPRelaxation( layers, gurobi, lastLayer );
 
-    List<GurobiWrapper::Term> terms;
-    terms.append( GurobiWrapper::Term( 1, variableName ) );
-
-    if ( minOrMax == MAX )
-        gurobi.setObjective( terms );
-    else
-        gurobi.setCost( terms );
-
-    gurobi.solve();
-
-    if ( gurobi.infeasbile() )
-        throw InfeasibleQueryException();
-
-    if ( gurobi.cutoffOccurred() )
-        return _cutoffValue;
-
-    if ( gurobi.optimal() )
-    {
-        Map<String, double> dontCare;
-        double result = 0;
-        gurobi.extractSolution( dontCare, result );
-        return result;
-    }
-    else if ( gurobi.timeout() )
-    {
-        return gurobi.getObjectiveBound();
-    }
-
-    throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
+    return optimizeVariable( gurobi, minOrMax, variableName );
 }
 
 void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned, Layer *> &layers )
@@ -147,6 +125,11 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
             {
                 ub = gurobi.getObjectiveBound();
             }
+            else if ( gurobi.numericalFailure() )
+            {
+                // No bound is known, so keep the current one
+                ub = currentUb;
+            }
             else
             {
                 throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
@@ -194,6 +177,11 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
             {
                 lb = gurobi.getObjectiveBound();
             }
+            else if ( gurobi.numericalFailure() )
+            {
+                // No bound is known, so keep the current one
+                lb = currentLb;
+            }
             else
             {
                 throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
@@ -232,12 +220,6 @@ void LPFormulator::optimizeBoundsWithIncrementalLpRelaxation( const Map<unsigned
 
 void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *> &layers )
 {
-    double lb = FloatUtils::negativeInfinity();
-    double ub = FloatUtils::infinity();
-
-    double currentLb;
-    double currentUb;
-
     unsigned tighterBoundCounter = 0;
     unsigned signChanges = 0;
     unsigned cutoffs = 0;
@@ -249,28 +231,90 @@ void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *>
 
     gurobiStart = TimeUtils::sampleMicro();
 
+    unsigned numberOfThreads = getNumberOfThreads();
+
     for ( const auto &currentLayer : layers )
     {
         Layer *layer = currentLayer.second;
 
+        Vector<unsigned> neurons;
         for ( unsigned i = 0; i < layer->getSize(); ++i )
         {
             if ( layer->neuronEliminated( i ) )
                 continue;
 
-            currentLb = layer->getLb( i );
-            currentUb = layer->getUb( i );
+            double currentLb = layer->getLb( i );
+            double currentUb = layer->getUb( i );
 
             if ( _cutoffInUse && ( currentLb > _cutoffValue || currentUb < _cutoffValue ) )
                 continue;
 
+            neurons.append( i );
+        }
+
+        if ( neurons.empty() )
+            continue;
+
+        /*
+          The LPs of the neurons in this layer only depend on the bounds
+          of this layer and the ones before it, so they can be solved in
+          parallel. The new bounds are merged into the layer only after
+          all the workers are done. Meanwhile, the workers pass them on
+          to each other. A single worker is a sequential sweep, in which
+          every LP sees the bounds of all the earlier neurons. With more
+          workers, an LP may start before the bounds of a neuron solved
+          concurrently are known, so the bounds depend on thread timing
+          and can be slightly looser.
+        */
+        Vector<double> newLbs( neurons.size(), FloatUtils::negativeInfinity() );
+        Vector<double> newUbs( neurons.size(), FloatUtils::infinity() );
+        std::unique_ptr<std::atomic_bool[]> solved( new std::atomic_bool[neurons.size()] );
+        for ( unsigned k = 0; k < neurons.size(); ++k )
+            solved[k] = false;
+        std::atomic_uint nextNeuron( 0 );
+
+        unsigned numberOfWorkers = std::min( numberOfThreads, neurons.size() );
+        Vector<std::exception_ptr> errors( numberOfWorkers );
+
+        if ( numberOfWorkers == 1 )
+        {
+            optimizeBoundsOfNeuronsWithLpRelaxation( layers, layer, neurons, nextNeuron,
+                                                     newLbs, newUbs, solved.get(), errors[0] );
+        }
+        else
+        {
+            std::list<std::thread> threads;
+            for ( unsigned i = 0; i < numberOfWorkers; ++i )
+                threads.push_back( std::thread( &LPFormulator::optimizeBoundsOfNeuronsWithLpRelaxation,
+                                               this,
+                                               std::cref( layers ),
+                                               layer,
+                                               std::cref( neurons ),
+                                               std::ref( nextNeuron ),
+                                               std::ref( newLbs ),
+                                               std::ref( newUbs ),
+                                               solved.get(),
+                                               std::ref( errors[i] ) ) );
+
+            for ( auto &thread : threads )
+                thread.join();
+        }
+
+        for ( const auto &error : errors )
+        {
+            if ( error )
+                std::rethrow_exception( error );
+        }
+
+        for ( unsigned k = 0; k < neurons.size(); ++k )
+        {
+            unsigned i = neurons[k];
             unsigned variable = layer->neuronToVariable( i );
-            Stringf variableName( "x%u", variable );
 
-            ub = solveLPRelaxation( layers,
-                                    MinOrMax::MAX,
-                                    variableName,
-                                    layer->getLayerIndex() );
+            double currentLb = layer->getLb( i );
+            double currentUb = layer->getUb( i );
+            double ub = newUbs[k];
+            double lb = newLbs[k];
 
             // Store the new bound if it is tighter
             if ( ub < currentUb )
@@ -292,11 +336,6 @@ void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *>
                 }
             }
 
-            lb = solveLPRelaxation( layers,
-                                    MinOrMax::MIN,
-                                    variableName,
-                                    layer->getLayerIndex() );
-
             // Store the new bound if it is tighter
             if ( lb > currentLb )
             {
@@ -326,6 +365,133 @@ void LPFormulator::optimizeBoundsWithLpRelaxation( const Map<unsigned, Layer *>
     LPFormulator_LOG( Stringf( "Seconds spent Gurobiing: %llu\n", TimeUtils::timePassed( gurobiStart, gurobiEnd ) / 1000000 ).ascii() );
 }
 
+void LPFormulator::optimizeBoundsOfNeuronsWithLpRelaxation( const Map<unsigned, Layer *> &layers,
+                                                            const Layer *layer,
+                                                            const Vector<unsigned> &neurons,
+                                                            std::atomic_uint &nextNeuron,
+                                                            Vector<double> &newLbs,
+                                                            Vector<double> &newUbs,
+                                                            std::atomic_bool *solved,
+                                                            std::exception_ptr &error )
+{
+    try
+    {
+        // Encode the network up to this layer once, and only change
+        // the objective between queries
+        GurobiWrapper gurobi;
+        gurobi.setTimeLimit( GlobalConfiguration::MILPSolverTimeoutValueInSeconds );
+        createLPRelaxation( layers, gurobi, layer->getLayerIndex() );
+
+        Vector<char> applied( neurons.size(), false );
+
+        unsigned k;
+        while ( ( k = nextNeuron++ ) < neurons.size() )
+        {
+            // Add the bounds found so far for other neurons of the layer
+            for ( unsigned other = 0; other < neurons.size(); ++other )
+            {
+                if ( applied[other] || !solved[other] )
+                    continue;
+
+                applied[other] = true;
+                unsigned otherNeuron = neurons.get( other );
+                Stringf otherName( "x%u", layer->neuronToVariable( otherNeuron ) );
+                if ( newUbs[other] < layer->getUb( otherNeuron ) )
+                    gurobi.setUpperBound( otherName, newUbs[other] );
+                if ( newLbs[other] > layer->getLb( otherNeuron ) )
+                    gurobi.setLowerBound( otherName, newLbs[other] );
+            }
+
+            unsigned variable = layer->neuronToVariable( neurons.get( k ) );
+            Stringf variableName( "x%u", variable );
+
+            double ub = optimizeVariable( gurobi, MinOrMax::MAX, variableName );
+            newUbs[k] = ub;
+
+            // No need to minimize once the cutoff value is crossed
+            if ( !_cutoffInUse || ub >= _cutoffValue )
+            {
+                // As in a sequential sweep, the minimization sees the
+                // new upper bound
+                if ( ub < layer->getUb( neurons.get( k ) ) )
+                    gurobi.setUpperBound( variableName, ub );
+
+                newLbs[k] = optimizeVariable( gurobi, MinOrMax::MIN, variableName );
+            }
+
+            solved[k] = true;
+        }
+    }
+    catch ( ... )
+    {
+        error = std::current_exception();
+
+        // Let the other workers finish early
+        nextNeuron = neurons.size();
+    }
+}
+
+double LPFormulator::optimizeVariable( GurobiWrapper &gurobi,
+                                       MinOrMax minOrMax,
+                                       const String &variableName )
+{
+    List<GurobiWrapper::Term> terms;
+    terms.append( GurobiWrapper::Term( 1, variableName ) );
+
+    gurobi.reset();
+    if ( minOrMax == MAX )
+        gurobi.setObjective( terms );
+    else
+        gurobi.setCost( terms );
+
+    gurobi.solve();
+
+    if ( gurobi.infeasbile() )
+        throw InfeasibleQueryException();
+
+    if ( gurobi.cutoffOccurred() )
+        return _cutoffValue;
+
+    if ( gurobi.optimal() )
+    {
+        Map<String, double> dontCare;
+        double result = 0;
+        gurobi.extractSolution( dontCare, result );
+        return result;
+    }
+    else if ( gurobi.timeout() )
+    {
+        return gurobi.getObjectiveBound();
+    }
+    else if ( gurobi.numericalFailure() )
+    {
+        // No bound is known
+        return minOrMax == MAX ? FloatUtils::infinity() : FloatUtils::negativeInfinity();
+    }
+
+    throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
+}
+
+unsigned LPFormulator::getNumberOfThreads() const
+{
+    unsigned numberOfThreads = GlobalConfiguration::MILP_SOLVER_BOUND_TIGHTENING_NUMBER_OF_THREADS;
+    if ( numberOfThreads == 0 )
+    {
+        numberOfThreads = std::thread::hardware_concurrency();
+
+        // In DnC mode, every worker runs its own LP relaxations, so the
+        // hardware threads are split among the workers
+        if ( Options::get()->getBool( Options::DNC_MODE ) )
+        {
+            int numberOfWorkers = Options::get()->getInt( Options::NUM_WORKERS );
+            if ( numberOfWorkers > 1 )
+                numberOfThreads /= numberOfWorkers;
+        }
+    }
+
+    return numberOfThreads > 0 ? numberOfThreads : 1;
+}
+
 void LPFormulator::createLPRelaxation( const Map<unsigned, Layer *> &layers,
                                        GurobiWrapper &gurobi,
                                        unsigned lastLayer )
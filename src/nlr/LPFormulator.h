@@ -18,7 +18,11 @@
 
 #include "GurobiWrapper.h"
 #include "LayerOwner.h"
+#include "Vector.h"
+
+#include <atomic>
 #include <climits>
+#include <exception>
 
 namespace NLR {
 
@@ -73,6 +77,34 @@ private:
     bool _cutoffInUse;
     double _cutoffValue;
 
+    /*
+      Optimize the bounds of a layer's neurons, taking neurons from a
+      shared counter until none are left. Several workers can run this
+      in parallel, each with its own model of the network up to the
+      layer. New bounds are written to newLbs and newUbs, after which
+      the neuron is marked as solved; they are not applied to the
+      layer. Before each LP, a worker adds to its model the bounds
+      that have been found for the other neurons so far. An exception
+      thrown by the worker is stored in error.
+    */
+    void optimizeBoundsOfNeuronsWithLpRelaxation( const Map<unsigned, Layer *> &layers,
+                                                  const Layer *layer,
+                                                  const Vector<unsigned> &neurons,
+                                                  std::atomic_uint &nextNeuron,
+                                                  Vector<double> &newLbs,
+                                                  Vector<double> &newUbs,
+                                                  std::atomic_bool *solved,
+                                                  std::exception_ptr &error );
+
+    /*
+      Minimize or maximize a single variable over an existing model
+    */
+    double optimizeVariable( GurobiWrapper &gurobi,
+                             MinOrMax minOrMax,
+                             const String &variableName );
+
+    unsigned getNumberOfThreads() const;
+
     void addInputLayerToLpRelaxation( GurobiWrapper &gurobi,
                                       const Layer *layer );
 
@@ -14,6 +14,7 @@
  **/
 
 #include "Layer.h"
+#include "SymbolicBoundKernels.h"
 
 namespace NLR {
 
@@ -34,8 +35,12 @@ Layer::Layer( unsigned index, Type type, unsigned size, LayerOwner *layerOwner )
     , _layerOwner( layerOwner )
     , _bias( NULL )
     , _assignment( NULL )
+    , _batchAssignment( NULL )
+    , _batchCapacity( 0 )
     , _lb( NULL )
     , _ub( NULL )
+    , _boundChanged( NULL )
+    , _hasChangedBounds( true )
     , _inputLayerSize( 0 )
     , _symbolicLb( NULL )
     , _symbolicUb( NULL )
@@ -45,6 +50,12 @@ Layer::Layer( unsigned index, Type type, unsigned size, LayerOwner *layerOwner )
     , _symbolicUbOfLb( NULL )
     , _symbolicLbOfUb( NULL )
     , _symbolicUbOfUb( NULL )
+    , _inputLayerLb( NULL )
+    , _inputLayerUb( NULL )
+    , _symbolicLbMultipliers( NULL )
+    , _symbolicLbDivisors( NULL )
+    , _symbolicUbMultipliers( NULL )
+    , _symbolicUbDivisors( NULL )
 {
     allocateMemory();
 }
@@ -63,6 +74,10 @@ void Layer::allocateMemory()
     std::fill_n( _lb, _size, 0 );
     std::fill_n( _ub, _size, 0 );
 
+    _boundChanged = new bool[_size];
+    std::fill_n( _boundChanged, _size, true );
+    _hasChangedBounds = true;
+
     _assignment = new double[_size];
 
     _inputLayerSize = ( _type == INPUT ) ? _size : _layerOwner->getLayer( 0 )->getSize();
@@ -89,6 +104,14 @@ void Layer::allocateMemory()
         std::fill_n( _symbolicUbOfLb, _size, 0 );
         std::fill_n( _symbolicLbOfUb, _size, 0 );
         std::fill_n( _symbolicUbOfUb, _size, 0 );
+
+        _inputLayerLb = new double[_inputLayerSize];
+        _inputLayerUb = new double[_inputLayerSize];
+
+        _symbolicLbMultipliers = new double[_size];
+        _symbolicLbDivisors = new double[_size];
+        _symbolicUbMultipliers = new double[_size];
+        _symbolicUbDivisors = new double[_size];
     }
 }
 
@@ -192,6 +215,136 @@ void Layer::computeAssignment()
         _assignment[eliminated.first] = eliminated.second;
 }
 
+void Layer::allocateBatchMemoryIfNeeded( unsigned batchSize )
+{
+    if ( batchSize <= _batchCapacity )
+        return;
+
+    if ( _batchAssignment )
+        delete[] _batchAssignment;
+
+    _batchAssignment = new double[batchSize * _size];
+    _batchCapacity = batchSize;
+}
+
+void Layer::setBatchAssignment( const double *values, unsigned batchSize )
+{
+    ASSERT( _eliminatedNeurons.empty() );
+
+    allocateBatchMemoryIfNeeded( batchSize );
+    memcpy( _batchAssignment, values, batchSize * _size * sizeof(double) );
+}
+
+const double *Layer::getBatchAssignment() const
+{
+    return _batchAssignment;
+}
+
+void Layer::computeBatchAssignment( unsigned batchSize )
+{
+    ASSERT( _type != INPUT );
+
+    allocateBatchMemoryIfNeeded( batchSize );
+
+    if ( _type == WEIGHTED_SUM )
+    {
+        // Initialize every point to the bias
+        for ( unsigned point = 0; point < batchSize; ++point )
+            memcpy( _batchAssignment + point * _size, _bias, sizeof(double) * _size );
+
+        // Each source layer adds its batch assignment times its weights
+        for ( auto &sourceLayerEntry : _sourceLayers )
+        {
+            const Layer *sourceLayer = _layerOwner->getLayer( sourceLayerEntry.first );
+            matrixMultiplication( sourceLayer->getBatchAssignment(),
+                                  _layerToWeights[sourceLayerEntry.first],
+                                  _batchAssignment,
+                                  batchSize,
+                                  sourceLayerEntry.second,
+                                  _size );
+        }
+    }
+
+    else if ( _type == RELU )
+    {
+        for ( unsigned i = 0; i < _size; ++i )
+        {
+            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
+            const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+            const double *source = sourceLayer->getBatchAssignment() + sourceIndex._neuron;
+            unsigned sourceSize = sourceLayer->getSize();
+
+            for ( unsigned point = 0; point < batchSize; ++point )
+                _batchAssignment[point * _size + i] =
+                    FloatUtils::max( source[point * sourceSize], 0 );
+        }
+    }
+
+    else if ( _type == ABSOLUTE_VALUE )
+    {
+        for ( unsigned i = 0; i < _size; ++i )
+        {
+            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
+            const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+            const double *source = sourceLayer->getBatchAssignment() + sourceIndex._neuron;
+            unsigned sourceSize = sourceLayer->getSize();
+
+            for ( unsigned point = 0; point < batchSize; ++point )
+                _batchAssignment[point * _size + i] =
+                    FloatUtils::abs( source[point * sourceSize] );
+        }
+    }
+
+    else if ( _type == MAX )
+    {
+        for ( unsigned i = 0; i < _size; ++i )
+        {
+            for ( unsigned point = 0; point < batchSize; ++point )
+                _batchAssignment[point * _size + i] = FloatUtils::negativeInfinity();
+
+            for ( const auto &input : _neuronToActivationSources[i] )
+            {
+                const Layer *sourceLayer = _layerOwner->getLayer( input._layer );
+                const double *source = sourceLayer->getBatchAssignment() + input._neuron;
+                unsigned sourceSize = sourceLayer->getSize();
+
+                for ( unsigned point = 0; point < batchSize; ++point )
+                {
+                    double value = source[point * sourceSize];
+                    if ( value > _batchAssignment[point * _size + i] )
+                        _batchAssignment[point * _size + i] = value;
+                }
+            }
+        }
+    }
+
+    else if ( _type == SIGMOID )
+    {
+        for ( unsigned i = 0; i < _size; ++i )
+        {
+            NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
+            const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
+            const double *source = sourceLayer->getBatchAssignment() + sourceIndex._neuron;
+            unsigned sourceSize = sourceLayer->getSize();
+
+            for ( unsigned point = 0; point < batchSize; ++point )
+                _batchAssignment[point * _size + i] =
+                    FloatUtils::sigmoid( source[point * sourceSize] );
+        }
+    }
+
+    else
+    {
+        printf( "Error! Neuron type %u unsupported\n", _type );
+        throw MarabouError( MarabouError::NETWORK_LEVEL_REASONER_ACTIVATION_NOT_SUPPORTED );
+    }
+
+    // As in computeAssignment(), eliminated variables prevail
+    for ( const auto &eliminated : _eliminatedNeurons )
+        for ( unsigned point = 0; point < batchSize; ++point )
+            _batchAssignment[point * _size + eliminated.first] = eliminated.second;
+}
+
 void Layer::addSourceLayer( unsigned layerNumber, unsigned layerSize )
 {
     ASSERT( _type != INPUT );
@@ -295,17 +448,27 @@ void Layer::obtainCurrentBounds()
 {
     for ( unsigned i = 0; i < _size; ++i )
     {
+        double lb;
+        double ub;
+
         if ( _neuronToVariable.exists( i ) )
         {
             unsigned variable = _neuronToVariable[i];
-            _lb[i] = _layerOwner->getTableau()->getLowerBound( variable );
-            _ub[i] = _layerOwner->getTableau()->getUpperBound( variable );
+            lb = _layerOwner->getTableau()->getLowerBound( variable );
+            ub = _layerOwner->getTableau()->getUpperBound( variable );
         }
         else
         {
             ASSERT( _eliminatedNeurons.exists( i ) );
-            _lb[i] = _eliminatedNeurons[i];
-            _ub[i] = _eliminatedNeurons[i];
+            lb = _eliminatedNeurons[i];
+            ub = _eliminatedNeurons[i];
+        }
+
+        if ( lb != _lb[i] || ub != _ub[i] )
+        {
+            _lb[i] = lb;
+            _ub[i] = ub;
+            markBoundChanged( i );
         }
     }
 }
@@ -329,15 +492,50 @@ double Layer::getUb( unsigned neuron ) const
 void Layer::setLb( unsigned neuron, double bound )
 {
     ASSERT( !_eliminatedNeurons.exists( neuron ) );
+    if ( _lb[neuron] != bound )
+        markBoundChanged( neuron );
     _lb[neuron] = bound;
 }
 
 void Layer::setUb( unsigned neuron, double bound )
 {
     ASSERT( !_eliminatedNeurons.exists( neuron ) );
+    if ( _ub[neuron] != bound )
+        markBoundChanged( neuron );
     _ub[neuron] = bound;
 }
 
+bool Layer::boundChanged( unsigned neuron ) const
+{
+    return _boundChanged[neuron];
+}
+
+bool Layer::hasChangedBounds() const
+{
+    return _hasChangedBounds;
+}
+
+void Layer::markBoundChanged( unsigned neuron )
+{
+    _boundChanged[neuron] = true;
+    _hasChangedBounds = true;
+}
+
+void Layer::markAllBoundsChanged()
+{
+    std::fill_n( _boundChanged, _size, true );
+    _hasChangedBounds = true;
+}
+
+void Layer::clearBoundChanges()
+{
+    if ( !_hasChangedBounds )
+        return;
+
+    std::fill_n( _boundChanged, _size, false );
+    _hasChangedBounds = false;
+}
+
 void Layer::computeIntervalArithmeticBounds()
 {
     ASSERT( _type != INPUT );
@@ -371,6 +569,19 @@ void Layer::computeIntervalArithmeticBounds()
 
 void Layer::computeIntervalArithmeticBoundsForWeightedSum()
 {
+    // If a source neuron has changed, every neuron needs to be
+    // recomputed. Otherwise, only the neurons whose own bounds have
+    // changed need to be.
+    bool sourcesChanged = false;
+    for ( const auto &sourceLayerEntry : _sourceLayers )
+    {
+        if ( _layerOwner->getLayer( sourceLayerEntry.first )->hasChangedBounds() )
+            sourcesChanged = true;
+    }
+
+    if ( !sourcesChanged && !_hasChangedBounds )
+        return;
+
     double *newLb = new double[_size];
     double *newUb = new double[_size];
 
@@ -389,6 +600,9 @@ void Layer::computeIntervalArithmeticBoundsForWeightedSum()
 
         for ( unsigned i = 0; i < _size; ++i )
         {
+            if ( !sourcesChanged && !_boundChanged[i] )
+                continue;
+
             for ( unsigned j = 0; j < sourceLayerSize; ++j )
             {
                 double previousLb = sourceLayer->getLb( j );
@@ -414,15 +628,20 @@ void Layer::computeIntervalArithmeticBoundsForWeightedSum()
         if ( _eliminatedNeurons.exists( i ) )
             continue;
 
+        if ( !sourcesChanged && !_boundChanged[i] )
+            continue;
+
         if ( newLb[i] > _lb[i] )
         {
             _lb[i] = newLb[i];
             _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+            markBoundChanged( i );
         }
         if ( newUb[i] < _ub[i] )
         {
             _ub[i] = newUb[i];
             _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+            markBoundChanged( i );
         }
     }
 
@@ -440,6 +659,11 @@ void Layer::computeIntervalArithmeticBoundsForRelu()
         NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
         const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
 
+        // Nothing to do if neither the neuron nor its source has
+        // changed since the last propagation
+        if ( !_boundChanged[i] && !sourceLayer->boundChanged( sourceIndex._neuron ) )
+            continue;
+
         double lb = sourceLayer->getLb( sourceIndex._neuron );
         double ub = sourceLayer->getUb( sourceIndex._neuron );
 
@@ -450,11 +674,13 @@ void Layer::computeIntervalArithmeticBoundsForRelu()
         {
             _lb[i] = lb;
             _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+            markBoundChanged( i );
         }
         if ( ub < _ub[i] )
         {
             _ub[i] = ub;
             _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+            markBoundChanged( i );
         }
     }
 }
@@ -469,6 +695,11 @@ void Layer::computeIntervalArithmeticBoundsForAbs()
         NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
         const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
 
+        // Nothing to do if neither the neuron nor its source has
+        // changed since the last propagation
+        if ( !_boundChanged[i] && !sourceLayer->boundChanged( sourceIndex._neuron ) )
+            continue;
+
         double lb = sourceLayer->getLb( sourceIndex._neuron );
         double ub = sourceLayer->getUb( sourceIndex._neuron );
 
@@ -478,11 +709,13 @@ void Layer::computeIntervalArithmeticBoundsForAbs()
             {
                 _lb[i] = lb;
                 _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+                markBoundChanged( i );
             }
             if ( ub < _ub[i] )
             {
                 _ub[i] = ub;
                 _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+                markBoundChanged( i );
             }
         }
         else if ( ub < 0 )
@@ -491,11 +724,13 @@ void Layer::computeIntervalArithmeticBoundsForAbs()
             {
                 _lb[i] = -ub;
                 _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+                markBoundChanged( i );
             }
             if ( -lb < _ub[i] )
             {
                 _ub[i] = -lb;
                 _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+                markBoundChanged( i );
             }
         }
         else
@@ -505,12 +740,14 @@ void Layer::computeIntervalArithmeticBoundsForAbs()
             {
                 _lb[i] = 0;
                 _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+                markBoundChanged( i );
             }
 
             if ( FloatUtils::max( ub, -lb ) < _ub[i] )
             {
                 _ub[i] = FloatUtils::max( ub, -lb );
                 _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+                markBoundChanged( i );
             }
         }
     }
@@ -527,6 +764,11 @@ void Layer::computeIntervalArithmeticBoundsForSigmoid()
         NeuronIndex sourceIndex = *_neuronToActivationSources[i].begin();
         const Layer *sourceLayer = _layerOwner->getLayer( sourceIndex._layer );
 
+        // Nothing to do if neither the neuron nor its source has
+        // changed since the last propagation
+        if ( !_boundChanged[i] && !sourceLayer->boundChanged( sourceIndex._neuron ) )
+            continue;
+
         double lb = sourceLayer->getLb( sourceIndex._neuron );
         double ub = sourceLayer->getUb( sourceIndex._neuron );
 
@@ -535,12 +777,14 @@ void Layer::computeIntervalArithmeticBoundsForSigmoid()
         {
             _lb[i] = sigmoidLb;
             _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _lb[i], Tightening::LB ) );
+            markBoundChanged( i );
         }
         double sigmoidUb = FloatUtils::sigmoid(ub);
         if (sigmoidUb < _ub[i] )
         {
             _ub[i] = sigmoidUb;
             _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
+            markBoundChanged( i );
         }
     }
 }
@@ -626,6 +870,12 @@ void Layer::computeSymbolicBoundsForRelu()
 
     for ( unsigned i = 0; i < _size; ++i )
     {
+        // By default, the inherited symbolic bounds are kept as they are
+        _symbolicLbMultipliers[i] = 1;
+        _symbolicLbDivisors[i] = 1;
+        _symbolicUbMultipliers[i] = 1;
+        _symbolicUbDivisors[i] = 1;
+
         if ( _eliminatedNeurons.exists( i ) )
             continue;
 
@@ -693,9 +943,8 @@ void Layer::computeSymbolicBoundsForRelu()
             {
                 // lbOfUb[i] < 0 < ubOfUb[i]
                 // Concretize the upper bound using the Ehler's-like approximation
-                for ( unsigned j = 0; j < _inputLayerSize; ++j )
-                    _symbolicUb[j * _size + i] =
-                        _symbolicUb[j * _size + i] * _symbolicUbOfUb[i] / ( _symbolicUbOfUb[i] - _symbolicLbOfUb[i] );
+                _symbolicUbMultipliers[i] = _symbolicUbOfUb[i];
+                _symbolicUbDivisors[i] = _symbolicUbOfUb[i] - _symbolicLbOfUb[i];
 
                 // Do the same for the bias, and then adjust
                 _symbolicUpperBias[i] = _symbolicUpperBias[i] * _symbolicUbOfUb[i] / ( _symbolicUbOfUb[i] - _symbolicLbOfUb[i] );
@@ -705,16 +954,13 @@ void Layer::computeSymbolicBoundsForRelu()
             // Lower bound
             if ( _symbolicUbOfLb[i] <= 0 )
             {
-                for ( unsigned j = 0; j < _inputLayerSize; ++j )
-                    _symbolicLb[j * _size + i] = 0;
-
+                _symbolicLbMultipliers[i] = 0;
                 _symbolicLowerBias[i] = 0;
             }
             else
             {
-                for ( unsigned j = 0; j < _inputLayerSize; ++j )
-                    _symbolicLb[j * _size + i] =
-                        _symbolicLb[j * _size + i] * _symbolicUbOfLb[i] / ( _symbolicUbOfLb[i] - _symbolicLbOfLb[i] );
+                _symbolicLbMultipliers[i] = _symbolicUbOfLb[i];
+                _symbolicLbDivisors[i] = _symbolicUbOfLb[i] - _symbolicLbOfLb[i];
 
                 _symbolicLowerBias[i] = _symbolicLowerBias[i] * _symbolicUbOfLb[i] / ( _symbolicUbOfLb[i] - _symbolicLbOfLb[i] );
             }
@@ -736,11 +982,8 @@ void Layer::computeSymbolicBoundsForRelu()
                 _symbolicLbOfUb[i] = 0;
                 _symbolicUbOfUb[i] = 0;
 
-                for ( unsigned j = 0; j < _inputLayerSize; ++j )
-                {
-                    _symbolicUb[j * _size + i] = 0;
-                    _symbolicLb[j * _size + i] = 0;
-                }
+                _symbolicLbMultipliers[i] = 0;
+                _symbolicUbMultipliers[i] = 0;
 
                 _symbolicLowerBias[i] = 0;
                 _symbolicUpperBias[i] = 0;
@@ -767,6 +1010,12 @@ void Layer::computeSymbolicBoundsForRelu()
             _layerOwner->receiveTighterBound( Tightening( _neuronToVariable[i], _ub[i], Tightening::UB ) );
         }
     }
+
+    // Apply the relaxation to the symbolic bounds of all neurons at once
+    rescaleSymbolicBounds( _symbolicLb, _symbolicLbMultipliers, _symbolicLbDivisors,
+                           _inputLayerSize, _size );
+    rescaleSymbolicBounds( _symbolicUb, _symbolicUbMultipliers, _symbolicUbDivisors,
+                           _inputLayerSize, _size );
 }
 
 void Layer::computeSymbolicBoundsForAbsoluteValue()
@@ -960,28 +1209,21 @@ void Layer::computeSymbolicBoundsForWeightedSum()
         */
         for ( unsigned j = 0; j < _size; ++j )
         {
-            if ( _eliminatedNeurons.exists( j ) )
-                continue;
-
             _symbolicLowerBias[j] = _bias[j];
             _symbolicUpperBias[j] = _bias[j];
+        }
 
-            // Add the weighted bias from the source layer
-            for ( unsigned k = 0; k < sourceLayerSize; ++k )
-            {
-                double weight = _layerToWeights[sourceLayerIndex][k * _size + j];
+        // Add the weighted bias from the source layer
+        accumulateSymbolicBiases( _layerToWeights[sourceLayerIndex],
+                                  sourceLayer->getSymbolicLowerBias(),
+                                  sourceLayer->getSymbolicUpperBias(),
+                                  sourceLayerSize, _size,
+                                  _symbolicLowerBias, _symbolicUpperBias );
 
-                if ( weight > 0 )
-                {
-                    _symbolicLowerBias[j] += sourceLayer->getSymbolicLowerBias()[k] * weight;
-                    _symbolicUpperBias[j] += sourceLayer->getSymbolicUpperBias()[k] * weight;
-                }
-                else
-                {
-                    _symbolicLowerBias[j] += sourceLayer->getSymbolicUpperBias()[k] * weight;
-                    _symbolicUpperBias[j] += sourceLayer->getSymbolicLowerBias()[k] * weight;
-                }
-            }
+        for ( const auto &eliminated : _eliminatedNeurons )
+        {
+            _symbolicLowerBias[eliminated.first] = eliminated.second;
+            _symbolicUpperBias[eliminated.first] = eliminated.second;
         }
 
         /*
@@ -990,46 +1232,33 @@ void Layer::computeSymbolicBoundsForWeightedSum()
           it. For each of these bounds, we compute an upper bound and
           a lower bound.
         */
-        for ( unsigned i = 0; i < _size; ++i )
+        const Layer *inputLayer = _layerOwner->getLayer( 0 );
+        for ( unsigned j = 0; j < _inputLayerSize; ++j )
         {
-            if ( _eliminatedNeurons.exists( i ) )
-                continue;
-
-            _symbolicLbOfLb[i] = _symbolicLowerBias[i];
-            _symbolicUbOfLb[i] = _symbolicLowerBias[i];
-            _symbolicLbOfUb[i] = _symbolicUpperBias[i];
-            _symbolicUbOfUb[i] = _symbolicUpperBias[i];
-
-            for ( unsigned j = 0; j < _inputLayerSize; ++j )
-            {
-                double inputLb = _layerOwner->getLayer( 0 )->getLb( j );
-                double inputUb = _layerOwner->getLayer( 0 )->getUb( j );
-
-                double entry = _symbolicLb[j * _size + i];
+            _inputLayerLb[j] = inputLayer->getLb( j );
+            _inputLayerUb[j] = inputLayer->getUb( j );
+        }
 
-                if ( entry >= 0 )
-                {
-                    _symbolicLbOfLb[i] += ( entry * inputLb );
-                    _symbolicUbOfLb[i] += ( entry * inputUb );
-                }
-                else
-                {
-                    _symbolicLbOfLb[i] += ( entry * inputUb );
-                    _symbolicUbOfLb[i] += ( entry * inputLb );
-                }
+        memcpy( _symbolicLbOfLb, _symbolicLowerBias, sizeof(double) * _size );
+        memcpy( _symbolicUbOfLb, _symbolicLowerBias, sizeof(double) * _size );
+        memcpy( _symbolicLbOfUb, _symbolicUpperBias, sizeof(double) * _size );
+        memcpy( _symbolicUbOfUb, _symbolicUpperBias, sizeof(double) * _size );
 
-                entry = _symbolicUb[j * _size + i];
+        concretizeSymbolicBounds( _symbolicLb, _symbolicUb,
+                                  _inputLayerLb, _inputLayerUb,
+                                  _inputLayerSize, _size,
+                                  _symbolicLbOfLb, _symbolicUbOfLb,
+                                  _symbolicLbOfUb, _symbolicUbOfUb );
 
-                if ( entry >= 0 )
-                {
-                    _symbolicLbOfUb[i] += ( entry * inputLb );
-                    _symbolicUbOfUb[i] += ( entry * inputUb );
-                }
-                else
-                {
-                    _symbolicLbOfUb[i] += ( entry * inputUb );
-                    _symbolicUbOfUb[i] += ( entry * inputLb );
-                }
+        for ( unsigned i = 0; i < _size; ++i )
+        {
+            if ( _eliminatedNeurons.exists( i ) )
+            {
+                _symbolicLbOfLb[i] = _eliminatedNeurons[i];
+                _symbolicUbOfLb[i] = _eliminatedNeurons[i];
+                _symbolicLbOfUb[i] = _eliminatedNeurons[i];
+                _symbolicUbOfUb[i] = _eliminatedNeurons[i];
+                continue;
             }
 
             /*
@@ -1063,6 +1292,7 @@ void Layer::eliminateVariable( unsigned variable, double value )
     _eliminatedNeurons[neuron] = value;
     _lb[neuron] = value;
     _ub[neuron] = value;
+    markBoundChanged( neuron );
     _neuronToVariable.erase( _variableToNeuron[variable] );
     _variableToNeuron.erase( variable );
 }
@@ -1121,8 +1351,12 @@ unsigned Layer::getLayerIndex() const
 Layer::Layer( const Layer *other )
     : _bias( NULL )
     , _assignment( NULL )
+    , _batchAssignment( NULL )
+    , _batchCapacity( 0 )
     , _lb( NULL )
     , _ub( NULL )
+    , _boundChanged( NULL )
+    , _hasChangedBounds( true )
     , _inputLayerSize( 0 )
     , _symbolicLb( NULL )
     , _symbolicUb( NULL )
@@ -1132,6 +1366,12 @@ Layer::Layer( const Layer *other )
     , _symbolicUbOfLb( NULL )
     , _symbolicLbOfUb( NULL )
     , _symbolicUbOfUb( NULL )
+    , _inputLayerLb( NULL )
+    , _inputLayerUb( NULL )
+    , _symbolicLbMultipliers( NULL )
+    , _symbolicLbDivisors( NULL )
+    , _symbolicUbMultipliers( NULL )
+    , _symbolicUbDivisors( NULL )
 {
     _layerIndex = other->_layerIndex;
     _type = other->_type;
@@ -1238,6 +1478,13 @@ void Layer::freeMemoryIfNeeded()
         _assignment = NULL;
     }
 
+    if ( _batchAssignment )
+    {
+        delete[] _batchAssignment;
+        _batchAssignment = NULL;
+    }
+    _batchCapacity = 0;
+
     if ( _lb )
     {
         delete[] _lb;
@@ -1250,6 +1497,12 @@ void Layer::freeMemoryIfNeeded()
         _ub = NULL;
     }
 
+    if ( _boundChanged )
+    {
+        delete[] _boundChanged;
+        _boundChanged = NULL;
+    }
+
     if ( _symbolicLb )
     {
         delete[] _symbolicLb;
@@ -1297,6 +1550,42 @@ void Layer::freeMemoryIfNeeded()
         delete[] _symbolicUbOfUb;
         _symbolicUbOfUb = NULL;
     }
+
+    if ( _inputLayerLb )
+    {
+        delete[] _inputLayerLb;
+        _inputLayerLb = NULL;
+    }
+
+    if ( _inputLayerUb )
+    {
+        delete[] _inputLayerUb;
+        _inputLayerUb = NULL;
+    }
+
+    if ( _symbolicLbMultipliers )
+    {
+        delete[] _symbolicLbMultipliers;
+        _symbolicLbMultipliers = NULL;
+    }
+
+    if ( _symbolicLbDivisors )
+    {
+        delete[] _symbolicLbDivisors;
+        _symbolicLbDivisors = NULL;
+    }
+
+    if ( _symbolicUbMultipliers )
+    {
+        delete[] _symbolicUbMultipliers;
+        _symbolicUbMultipliers = NULL;
+    }
+
+    if ( _symbolicUbDivisors )
+    {
+        delete[] _symbolicUbDivisors;
+        _symbolicUbDivisors = NULL;
+    }
 }
 
 String Layer::typeToString( Type type )
@@ -87,6 +87,16 @@ public:
     double getAssignment( unsigned neuron ) const;
     void computeAssignment();
 
+    /*
+      Batched counterparts of the above: the assignment of a batch of
+      points is a batchSize x size matrix, one point per row. Weighted
+      sums are computed with a single matrix multiplication for the
+      entire batch.
+    */
+    void setBatchAssignment( const double *values, unsigned batchSize );
+    const double *getBatchAssignment() const;
+    void computeBatchAssignment( unsigned batchSize );
+
     /*
       Bound related functionality: grab the current bounds from the
       Tableau, or compute bounds from source layers
@@ -100,6 +110,19 @@ public:
     void computeSymbolicBounds();
     void computeIntervalArithmeticBounds();
 
+    /*
+      Change tracking for incremental propagation: a neuron is marked
+      when its bounds change, whether they are obtained from the
+      tableau, set externally or tightened by interval arithmetic.
+      Interval arithmetic only recomputes the neurons that are marked
+      or have marked sources. The marks are cleared by the network
+      level reasoner after each propagation pass.
+    */
+    bool boundChanged( unsigned neuron ) const;
+    bool hasChangedBounds() const;
+    void markAllBoundsChanged();
+    void clearBoundChanges();
+
     /*
       Preprocessing functionality: variable elimination and reindexing
     */
@@ -131,9 +154,15 @@ private:
 
     double *_assignment;
 
+    double *_batchAssignment;
+    unsigned _batchCapacity;
+
     double *_lb;
     double *_ub;
 
+    bool *_boundChanged;
+    bool _hasChangedBounds;
+
     Map<unsigned, List<NeuronIndex>> _neuronToActivationSources;
 
     Map<unsigned, unsigned> _neuronToVariable;
@@ -150,9 +179,28 @@ private:
     double *_symbolicLbOfUb;
     double *_symbolicUbOfUb;
 
+    /*
+      Work memory for the symbolic bound kernels: the bounds of the
+      input layer, and the per-neuron factors by which the ReLU
+      relaxation rescales the symbolic bounds.
+    */
+    double *_inputLayerLb;
+    double *_inputLayerUb;
+    double *_symbolicLbMultipliers;
+    double *_symbolicLbDivisors;
+    double *_symbolicUbMultipliers;
+    double *_symbolicUbDivisors;
+
     void allocateMemory();
     void freeMemoryIfNeeded();
 
+    void markBoundChanged( unsigned neuron );
+
+    /*
+      Make sure the batch assignment has room for batchSize points
+    */
+    void allocateBatchMemoryIfNeeded( unsigned batchSize );
+
     /*
       Helper functions for symbolic bound tightening
     */
@@ -370,6 +370,11 @@ double MILPFormulator::solveMILPEncoding( const Map<unsigned, Layer *> &layers,
     {
         return gurobi.getObjectiveBound();
     }
+    else if ( gurobi.numericalFailure() )
+    {
+        // No bound is known
+        return minOrMax == MAX ? FloatUtils::infinity() : FloatUtils::negativeInfinity();
+    }
 
     throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
 }
@@ -445,6 +450,11 @@ bool MILPFormulator::tightenUpperBound( GurobiWrapper &gurobi,
     {
         newUb = gurobi.getObjectiveBound();
     }
+    else if ( gurobi.numericalFailure() )
+    {
+        // No bound is known, so keep the current one
+        return false;
+    }
     else
     {
         throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
@@ -512,6 +522,11 @@ bool MILPFormulator::tightenLowerBound( GurobiWrapper &gurobi,
     {
         newLb = gurobi.getObjectiveBound();
     }
+    else if ( gurobi.numericalFailure() )
+    {
+        // No bound is known, so keep the current one
+        return false;
+    }
     else
     {
         throw NLRError( NLRError::UNEXPECTED_RETURN_STATUS_FROM_GUROBI );
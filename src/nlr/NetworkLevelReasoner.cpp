@@ -16,6 +16,7 @@
 #include "AbsoluteValueConstraint.h"
 #include "Debug.h"
 #include "FloatUtils.h"
+#include "GlobalConfiguration.h"
 #include "LPFormulator.h"
 #include "MILPFormulator.h"
 #include "MStringf.h"
@@ -29,6 +30,7 @@ namespace NLR {
 
 NetworkLevelReasoner::NetworkLevelReasoner()
     : _tableau( NULL )
+    , _lastPropagation( NO_PROPAGATION )
 {
 }
 
@@ -53,12 +55,14 @@ bool NetworkLevelReasoner::functionTypeSupported( PiecewiseLinearFunctionType ty
 
 void NetworkLevelReasoner::addLayer( unsigned layerIndex, Layer::Type type, unsigned layerSize )
 {
+    _lastPropagation = NO_PROPAGATION;
     Layer *layer = new Layer( layerIndex, type, layerSize, this );
     _layerIndexToLayer[layerIndex] = layer;
 }
 
 void NetworkLevelReasoner::addLayerDependency( unsigned sourceLayer, unsigned targetLayer )
 {
+    _lastPropagation = NO_PROPAGATION;
     _layerIndexToLayer[targetLayer]->addSourceLayer( sourceLayer, _layerIndexToLayer[sourceLayer]->getSize() );
 }
 
@@ -68,12 +72,14 @@ void NetworkLevelReasoner::setWeight( unsigned sourceLayer,
                                       unsigned targetNeuron,
                                       double weight )
 {
+    _lastPropagation = NO_PROPAGATION;
     _layerIndexToLayer[targetLayer]->setWeight
         ( sourceLayer, sourceNeuron, targetNeuron, weight );
 }
 
 void NetworkLevelReasoner::setBias( unsigned layer, unsigned neuron, double bias )
 {
+    _lastPropagation = NO_PROPAGATION;
     _layerIndexToLayer[layer]->setBias( neuron, bias );
 }
 
@@ -82,6 +88,7 @@ void NetworkLevelReasoner::addActivationSource( unsigned sourceLayer,
                                                 unsigned targetLeyer,
                                                 unsigned targetNeuron )
 {
+    _lastPropagation = NO_PROPAGATION;
     _layerIndexToLayer[targetLeyer]->addActivationSource( sourceLayer, sourceNeuron, targetNeuron );
 }
 
@@ -102,6 +109,28 @@ void NetworkLevelReasoner::evaluate( double *input, double *output )
             sizeof(double) * outputLayer->getSize() );
 }
 
+void NetworkLevelReasoner::evaluateBatch( const double *input, double *output, unsigned batchSize )
+{
+    Layer *inputLayer = _layerIndexToLayer[0];
+    const Layer *outputLayer = _layerIndexToLayer[_layerIndexToLayer.size() - 1];
+    unsigned inputSize = inputLayer->getSize();
+    unsigned outputSize = outputLayer->getSize();
+    unsigned blockSize = GlobalConfiguration::NETWORK_LEVEL_REASONER_EVALUATION_BLOCK_SIZE;
+
+    for ( unsigned first = 0; first < batchSize; first += blockSize )
+    {
+        unsigned numPoints = std::min( blockSize, batchSize - first );
+
+        inputLayer->setBatchAssignment( input + first * inputSize, numPoints );
+        for ( unsigned i = 1; i < _layerIndexToLayer.size(); ++i )
+            _layerIndexToLayer[i]->computeBatchAssignment( numPoints );
+
+        memcpy( output + first * outputSize,
+                outputLayer->getBatchAssignment(),
+                sizeof(double) * numPoints * outputSize );
+    }
+}
+
 void NetworkLevelReasoner::setNeuronVariable( NeuronIndex index, unsigned variable )
 {
     _layerIndexToLayer[index._layer]->setNeuronVariable( index._neuron, variable );
@@ -120,8 +149,20 @@ void NetworkLevelReasoner::getConstraintTightenings( List<Tightening> &tightenin
 
 void NetworkLevelReasoner::symbolicBoundPropagation()
 {
-    for ( unsigned i = 0; i < _layerIndexToLayer.size(); ++i )
+    startPropagation( SYMBOLIC_PROPAGATION );
+
+    // The symbolic bounds of a layer depend on the bounds of all the
+    // layers before it. Layers before the first one with changed
+    // bounds would come out the same, so start from that layer.
+    unsigned firstChangedLayer = 0;
+    while ( firstChangedLayer < _layerIndexToLayer.size() &&
+            !_layerIndexToLayer[firstChangedLayer]->hasChangedBounds() )
+        ++firstChangedLayer;
+
+    for ( unsigned i = firstChangedLayer; i < _layerIndexToLayer.size(); ++i )
         _layerIndexToLayer[i]->computeSymbolicBounds();
+
+    finishPropagation( SYMBOLIC_PROPAGATION );
 }
 
 void NetworkLevelReasoner::lpRelaxationPropagation()
@@ -152,8 +193,29 @@ void NetworkLevelReasoner::MILPPropagation()
 
 void NetworkLevelReasoner::intervalArithmeticBoundPropagation()
 {
+    startPropagation( INTERVAL_ARITHMETIC_PROPAGATION );
+
     for ( unsigned i = 1; i < _layerIndexToLayer.size(); ++i )
         _layerIndexToLayer[i]->computeIntervalArithmeticBounds();
+
+    finishPropagation( INTERVAL_ARITHMETIC_PROPAGATION );
+}
+
+void NetworkLevelReasoner::startPropagation( PropagationType type )
+{
+    if ( _lastPropagation == type )
+        return;
+
+    for ( const auto &layer : _layerIndexToLayer )
+        layer.second->markAllBoundsChanged();
+}
+
+void NetworkLevelReasoner::finishPropagation( PropagationType type )
+{
+    for ( const auto &layer : _layerIndexToLayer )
+        layer.second->clearBoundChanges();
+
+    _lastPropagation = type;
 }
 
 void NetworkLevelReasoner::freeMemoryIfNeeded()
@@ -194,6 +256,7 @@ void NetworkLevelReasoner::obtainCurrentBounds()
 
 void NetworkLevelReasoner::setTableau( const ITableau *tableau )
 {
+    _lastPropagation = NO_PROPAGATION;
     _tableau = tableau;
 }
 
@@ -68,6 +68,15 @@ public:
     */
     void evaluate( double *input , double *output );
 
+    /*
+      Evaluate the network for a batch of inputs at once. The input
+      is a batchSize x inputSize matrix and the output a batchSize x
+      outputSize matrix, one point per row. The points are pushed
+      through the network in blocks, each layer processing a whole
+      block at a time.
+    */
+    void evaluateBatch( const double *input, double *output, unsigned batchSize );
+
     /*
       Bound propagation methods:
 
@@ -143,8 +152,29 @@ private:
     // Tightenings discovered by the various layers
     List<Tightening> _boundTightenings;
 
+    /*
+      Propagation is incremental: a pass only redoes the work affected
+      by the bounds that changed since the previous pass. This is only
+      valid if the previous pass was of the same kind, and the network
+      has not been modified since.
+    */
+    enum PropagationType {
+        NO_PROPAGATION = 0,
+        INTERVAL_ARITHMETIC_PROPAGATION,
+        SYMBOLIC_PROPAGATION,
+    };
+
+    PropagationType _lastPropagation;
+
     void freeMemoryIfNeeded();
 
+    /*
+      Prepare for a propagation pass of the given type, forgetting
+      the results of previous passes if they cannot be reused.
+    */
+    void startPropagation( PropagationType type );
+    void finishPropagation( PropagationType type );
+
     List<PiecewiseLinearConstraint *> _constraintsInTopologicalOrder;
 };
 
@@ -0,0 +1,108 @@
+/*********************                                                        */
+/*! \file SymbolicBoundKernels.cpp
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** [[ Add lengthier description here ]]
+
+ **/
+
+#include "SymbolicBoundKernels.h"
+#include "VectorizedKernel.h"
+
+namespace NLR {
+
+VECTORIZED_KERNEL
+void concretizeSymbolicBounds( const double *symbolicLb, const double *symbolicUb,
+                               const double *inputLb, const double *inputUb,
+                               unsigned inputLayerSize, unsigned size,
+                               double *lbOfLb, double *ubOfLb,
+                               double *lbOfUb, double *ubOfUb )
+{
+    // The lower and upper symbolic bounds are swept separately, so that
+    // each inner loop only updates two arrays
+    for ( unsigned j = 0; j < inputLayerSize; ++j )
+    {
+        double lb = inputLb[j];
+        double ub = inputUb[j];
+        const double *row = symbolicLb + j * size;
+
+        for ( unsigned i = 0; i < size; ++i )
+        {
+            double entry = row[i];
+            double withLb = entry * lb;
+            double withUb = entry * ub;
+            lbOfLb[i] += ( entry >= 0 ) ? withLb : withUb;
+            ubOfLb[i] += ( entry >= 0 ) ? withUb : withLb;
+        }
+    }
+
+    for ( unsigned j = 0; j < inputLayerSize; ++j )
+    {
+        double lb = inputLb[j];
+        double ub = inputUb[j];
+        const double *row = symbolicUb + j * size;
+
+        for ( unsigned i = 0; i < size; ++i )
+        {
+            double entry = row[i];
+            double withLb = entry * lb;
+            double withUb = entry * ub;
+            lbOfUb[i] += ( entry >= 0 ) ? withLb : withUb;
+            ubOfUb[i] += ( entry >= 0 ) ? withUb : withLb;
+        }
+    }
+}
+
+VECTORIZED_KERNEL
+void rescaleSymbolicBounds( double *symbolicBounds,
+                            const double *multipliers, const double *divisors,
+                            unsigned inputLayerSize, unsigned size )
+{
+    for ( unsigned j = 0; j < inputLayerSize; ++j )
+    {
+        double *row = symbolicBounds + j * size;
+        for ( unsigned i = 0; i < size; ++i )
+            row[i] = row[i] * multipliers[i] / divisors[i];
+    }
+}
+
+VECTORIZED_KERNEL
+void accumulateSymbolicBiases( const double *weights,
+                               const double *sourceLowerBias,
+                               const double *sourceUpperBias,
+                               unsigned sourceSize, unsigned size,
+                               double *lowerBias, double *upperBias )
+{
+    for ( unsigned k = 0; k < sourceSize; ++k )
+    {
+        double sourceLb = sourceLowerBias[k];
+        double sourceUb = sourceUpperBias[k];
+        const double *row = weights + k * size;
+
+        for ( unsigned j = 0; j < size; ++j )
+        {
+            double weight = row[j];
+            double withLb = sourceLb * weight;
+            double withUb = sourceUb * weight;
+            lowerBias[j] += ( weight > 0 ) ? withLb : withUb;
+            upperBias[j] += ( weight > 0 ) ? withUb : withLb;
+        }
+    }
+}
+
+} // namespace NLR
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,67 @@
+/*********************                                                        */
+/*! \file SymbolicBoundKernels.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** Vectorized kernels for the hot loops of symbolic bound tightening.
+ ** Symbolic bounds are stored as inputLayerSize x size matrices, row j
+ ** holding the coefficients of input neuron j, so the kernels sweep
+ ** over rows and update all neurons of a layer at once. Each neuron
+ ** accumulates its terms in the same order as a neuron-by-neuron
+ ** computation would, so the results are identical.
+
+ **/
+
+#ifndef __SymbolicBoundKernels_h__
+#define __SymbolicBoundKernels_h__
+
+namespace NLR {
+
+/*
+  Concretize symbolic lower and upper bounds over the box given by
+  inputLb and inputUb. The concrete bounds are added to lbOfLb, ubOfLb,
+  lbOfUb and ubOfUb, which should be initialized to the symbolic
+  biases.
+*/
+void concretizeSymbolicBounds( const double *symbolicLb, const double *symbolicUb,
+                               const double *inputLb, const double *inputUb,
+                               unsigned inputLayerSize, unsigned size,
+                               double *lbOfLb, double *ubOfLb,
+                               double *lbOfUb, double *ubOfUb );
+
+/*
+  Multiply column i of a symbolic bound matrix by
+  multipliers[i] / divisors[i].
+*/
+void rescaleSymbolicBounds( double *symbolicBounds,
+                            const double *multipliers, const double *divisors,
+                            unsigned inputLayerSize, unsigned size );
+
+/*
+  Add the symbolic biases of a source layer, propagated through the
+  given weights (sourceSize x size), to lowerBias and upperBias.
+  Negative weights swap the roles of the lower and upper biases.
+*/
+void accumulateSymbolicBiases( const double *weights,
+                               const double *sourceLowerBias,
+                               const double *sourceUpperBias,
+                               unsigned sourceSize, unsigned size,
+                               double *lowerBias, double *upperBias );
+
+} // namespace NLR
+
+#endif // __SymbolicBoundKernels_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -275,6 +275,106 @@ public:
         TS_ASSERT( FloatUtils::areEqual( output[1], 4 ) );
     }
 
+    void test_evaluate_batch()
+    {
+        NLR::NetworkLevelReasoner nlr;
+
+        populateNetwork( nlr );
+
+        // The points of test_evaluate_relus, one per row
+        double input[6] = { 0, 0,
+                            1, 1,
+                            1, 2 };
+        double output[6];
+
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluateBatch( input, output, 3 ) );
+
+        TS_ASSERT( FloatUtils::areEqual( output[0], 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[1], 4 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[2], 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[3], 1 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[4], 0 ) );
+        TS_ASSERT( FloatUtils::areEqual( output[5], 0 ) );
+
+        // A batch spanning several blocks agrees with point-by-point
+        // evaluation
+        unsigned batchSize = 2 * GlobalConfiguration::NETWORK_LEVEL_REASONER_EVALUATION_BLOCK_SIZE + 3;
+        double *batchInput = new double[batchSize * 2];
+        double *batchOutput = new double[batchSize * 2];
+
+        for ( unsigned i = 0; i < batchSize * 2; ++i )
+            batchInput[i] = ( (double)( ( i * 37 ) % 101 ) ) / 10 - 5;
+
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluateBatch( batchInput, batchOutput, batchSize ) );
+
+        for ( unsigned point = 0; point < batchSize; ++point )
+        {
+            TS_ASSERT_THROWS_NOTHING( nlr.evaluate( batchInput + point * 2, output ) );
+            TS_ASSERT( FloatUtils::areEqual( batchOutput[point * 2], output[0] ) );
+            TS_ASSERT( FloatUtils::areEqual( batchOutput[point * 2 + 1], output[1] ) );
+        }
+
+        delete[] batchOutput;
+        delete[] batchInput;
+    }
+
+    void test_evaluate_batch_non_consecutive_layers_and_abs()
+    {
+        NLR::NetworkLevelReasoner nlr;
+
+        nlr.addLayer( 0, NLR::Layer::INPUT, 2 );
+        nlr.addLayer( 1, NLR::Layer::WEIGHTED_SUM, 3 );
+        nlr.addLayer( 2, NLR::Layer::ABSOLUTE_VALUE, 3 );
+        nlr.addLayer( 3, NLR::Layer::WEIGHTED_SUM, 2 );
+        nlr.addLayer( 4, NLR::Layer::MAX, 1 );
+
+        nlr.addLayerDependency( 0, 1 );
+        nlr.addLayerDependency( 1, 2 );
+        nlr.addLayerDependency( 2, 3 );
+        nlr.addLayerDependency( 0, 3 );
+        nlr.addLayerDependency( 3, 4 );
+        nlr.addLayerDependency( 0, 4 );
+
+        nlr.setWeight( 0, 0, 1, 0, 1 );
+        nlr.setWeight( 0, 0, 1, 1, 2 );
+        nlr.setWeight( 0, 1, 1, 1, -3 );
+        nlr.setWeight( 0, 1, 1, 2, 1 );
+
+        nlr.addActivationSource( 1, 0, 2, 0 );
+        nlr.addActivationSource( 1, 1, 2, 1 );
+        nlr.addActivationSource( 1, 2, 2, 2 );
+
+        nlr.setWeight( 2, 0, 3, 0, 1 );
+        nlr.setWeight( 2, 1, 3, 0, -2 );
+        nlr.setWeight( 2, 2, 3, 1, -1 );
+        nlr.setWeight( 0, 1, 3, 1, 1 );
+        nlr.setBias( 3, 0, 1 );
+
+        nlr.addActivationSource( 3, 0, 4, 0 );
+        nlr.addActivationSource( 3, 1, 4, 0 );
+        nlr.addActivationSource( 0, 0, 4, 0 );
+
+        double input[8] = { 1, 1,
+                            -1, 2,
+                            0, 0,
+                            3, -2 };
+        double output[4];
+        double expected;
+
+        TS_ASSERT_THROWS_NOTHING( nlr.evaluateBatch( input, output, 4 ) );
+
+        for ( unsigned point = 0; point < 4; ++point )
+        {
+            TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input + point * 2, &expected ) );
+            TS_ASSERT( FloatUtils::areEqual( output[point], expected ) );
+        }
+
+        // x = 1, y = 1: abs layer is ( 1, 1, 1 ), max( 1 - 2 + 1, -1 + 1, 1 )
+        TS_ASSERT( FloatUtils::areEqual( output[0], 1 ) );
+        // x = 3, y = -2: abs layer is ( 3, 12, 2 ), max( 3 - 24 + 1, -2 - 2, 3 )
+        TS_ASSERT( FloatUtils::areEqual( output[3], 3 ) );
+    }
+
     void test_store_into_other()
     {
         NLR::NetworkLevelReasoner nlr;
@@ -460,6 +560,221 @@ public:
             TS_ASSERT( bounds.exists( bound ) );
     }
 
+    void applyTightenings( MockTableau &tableau, const List<Tightening> &tightenings )
+    {
+        for ( const auto &tightening : tightenings )
+        {
+            if ( tightening._type == Tightening::LB )
+                tableau.setLowerBound( tightening._variable, tightening._value );
+            else
+                tableau.setUpperBound( tightening._variable, tightening._value );
+        }
+    }
+
+    void test_interval_arithmetic_bound_propagation_incremental()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        populateNetwork( nlr );
+
+        MockTableau tableau;
+
+        tableau.setLowerBound( 0, -1 );
+        tableau.setUpperBound( 0, 1 );
+        tableau.setLowerBound( 1, -1 );
+        tableau.setUpperBound( 1, 1 );
+
+        double large = 1000;
+        for ( unsigned i = 2; i <= 13; ++i )
+        {
+            tableau.setLowerBound( i, -large );
+            tableau.setUpperBound( i, large );
+        }
+
+        nlr.setTableau( &tableau );
+
+        // A full pass, whose results are fed back into the tableau
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.intervalArithmeticBoundPropagation() );
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT_EQUALS( bounds.size(), 24U );
+        applyTightenings( tableau, bounds );
+
+        // The layers already hold the tightened bounds, so nothing
+        // changed and there is nothing to propagate
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        for ( unsigned i = 0; i < nlr.getNumberOfLayers(); ++i )
+            TS_ASSERT( !nlr.getLayer( i )->hasChangedBounds() );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.intervalArithmeticBoundPropagation() );
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT( bounds.empty() );
+
+        // Tighten a neuron in layer 3: only its descendants change
+        tableau.setUpperBound( 8, 3 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT( !nlr.getLayer( 2 )->hasChangedBounds() );
+        TS_ASSERT( nlr.getLayer( 3 )->boundChanged( 0 ) );
+        TS_ASSERT( !nlr.getLayer( 3 )->boundChanged( 1 ) );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.intervalArithmeticBoundPropagation() );
+
+        List<Tightening> expectedBounds({
+                Tightening( 9, 3, Tightening::UB ),
+                Tightening( 12, 3, Tightening::UB ),
+                Tightening( 13, 24, Tightening::UB ),
+            });
+
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT_EQUALS( expectedBounds.size(), bounds.size() );
+        for ( const auto &bound : expectedBounds )
+            TS_ASSERT( bounds.exists( bound ) );
+
+        // A fresh reasoner, propagating from scratch, agrees
+        NLR::NetworkLevelReasoner fresh;
+        populateNetwork( fresh );
+        fresh.setTableau( &tableau );
+
+        List<Tightening> freshBounds;
+        TS_ASSERT_THROWS_NOTHING( fresh.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( fresh.intervalArithmeticBoundPropagation() );
+        TS_ASSERT_THROWS_NOTHING( fresh.getConstraintTightenings( freshBounds ) );
+        TS_ASSERT_EQUALS( freshBounds, bounds );
+
+        // Loosening a bound (e.g., after a backtrack) is propagated too
+        applyTightenings( tableau, bounds );
+        tableau.setUpperBound( 8, 7 );
+        tableau.setUpperBound( 9, 7 );
+
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.intervalArithmeticBoundPropagation() );
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        TS_ASSERT( bounds.empty() );
+    }
+
+    void test_lp_relaxation_bound_propagation()
+    {
+        NLR::NetworkLevelReasoner nlr;
+        populateNetwork( nlr );
+
+        MockTableau tableau;
+
+        tableau.setLowerBound( 0, -1 );
+        tableau.setUpperBound( 0, 1 );
+        tableau.setLowerBound( 1, -1 );
+        tableau.setUpperBound( 1, 1 );
+
+        double large = 1000;
+        for ( unsigned i = 2; i <= 13; ++i )
+        {
+            tableau.setLowerBound( i, -large );
+            tableau.setUpperBound( i, large );
+        }
+
+        nlr.setTableau( &tableau );
+
+        // Start from the interval arithmetic bounds
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.intervalArithmeticBoundPropagation() );
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        applyTightenings( tableau, bounds );
+
+        double intervalLbs[14];
+        double intervalUbs[14];
+        for ( unsigned i = 0; i <= 13; ++i )
+        {
+            intervalLbs[i] = tableau.getLowerBound( i );
+            intervalUbs[i] = tableau.getUpperBound( i );
+        }
+
+        // Tighten the bounds with the per-neuron LPs of each layer
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.lpRelaxationPropagation() );
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        applyTightenings( tableau, bounds );
+
+        // The LP relaxation is at least as tight as interval arithmetic
+        for ( unsigned i = 0; i <= 13; ++i )
+        {
+            TS_ASSERT( FloatUtils::gte( tableau.getLowerBound( i ), intervalLbs[i] ) );
+            TS_ASSERT( FloatUtils::lte( tableau.getUpperBound( i ), intervalUbs[i] ) );
+        }
+
+        // ... and strictly tighter for the second output
+        TS_ASSERT( FloatUtils::lt( tableau.getUpperBound( 13 ), intervalUbs[13] ) );
+
+        // The bounds are sound
+        double input[2];
+        double output[2];
+        for ( int x = -4; x <= 4; ++x )
+        {
+            for ( int y = -4; y <= 4; ++y )
+            {
+                input[0] = x / 4.0;
+                input[1] = y / 4.0;
+                TS_ASSERT_THROWS_NOTHING( nlr.evaluate( input, output ) );
+
+                TS_ASSERT( FloatUtils::gte( output[0], tableau.getLowerBound( 12 ) ) );
+                TS_ASSERT( FloatUtils::lte( output[0], tableau.getUpperBound( 12 ) ) );
+                TS_ASSERT( FloatUtils::gte( output[1], tableau.getLowerBound( 13 ) ) );
+                TS_ASSERT( FloatUtils::lte( output[1], tableau.getUpperBound( 13 ) ) );
+            }
+        }
+    }
+
+    void runLpRelaxationPropagation( double *lbs, double *ubs )
+    {
+        NLR::NetworkLevelReasoner nlr;
+        populateNetwork( nlr );
+
+        MockTableau tableau;
+
+        tableau.setLowerBound( 0, -1 );
+        tableau.setUpperBound( 0, 1 );
+        tableau.setLowerBound( 1, -1 );
+        tableau.setUpperBound( 1, 1 );
+
+        double large = 1000;
+        for ( unsigned i = 2; i <= 13; ++i )
+        {
+            tableau.setLowerBound( i, -large );
+            tableau.setUpperBound( i, large );
+        }
+
+        nlr.setTableau( &tableau );
+
+        List<Tightening> bounds;
+        TS_ASSERT_THROWS_NOTHING( nlr.obtainCurrentBounds() );
+        TS_ASSERT_THROWS_NOTHING( nlr.lpRelaxationPropagation() );
+        TS_ASSERT_THROWS_NOTHING( nlr.getConstraintTightenings( bounds ) );
+        applyTightenings( tableau, bounds );
+
+        for ( unsigned i = 0; i <= 13; ++i )
+        {
+            lbs[i] = tableau.getLowerBound( i );
+            ubs[i] = tableau.getUpperBound( i );
+        }
+    }
+
+    void test_lp_relaxation_bound_propagation_is_deterministic()
+    {
+        double firstLbs[14];
+        double firstUbs[14];
+        double secondLbs[14];
+        double secondUbs[14];
+
+        // By default the LPs of a layer are solved in a sequential
+        // sweep, so two runs find exactly the same bounds
+        runLpRelaxationPropagation( firstLbs, firstUbs );
+        runLpRelaxationPropagation( secondLbs, secondUbs );
+
+        TS_ASSERT_SAME_DATA( firstLbs, secondLbs, sizeof(firstLbs) );
+        TS_ASSERT_SAME_DATA( firstUbs, secondUbs, sizeof(firstUbs) );
+    }
+
     void test_interval_arithmetic_bound_propagation_abs_constraints()
     {
         NLR::NetworkLevelReasoner nlr;
@@ -0,0 +1,191 @@
+/*********************                                                        */
+/*! \file Test_SymbolicBoundKernels.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** The kernels are run through their load-time dispatch, so each host
+ ** checks the clone selected for its CPU against a scalar reference.
+ ** The inputs are chosen so that every accumulated sum cancels to 0
+ ** when products are rounded before being added, and would not if they
+ ** were contracted into fused multiply-adds.
+
+**/
+
+#include <cxxtest/TestSuite.h>
+
+#include "SymbolicBoundKernels.h"
+
+class SymbolicBoundKernelsTestSuite : public CxxTest::TestSuite
+{
+public:
+    enum {
+        // Large enough to exercise both the vector loop and its remainder
+        INPUT_SIZE = 5,
+        SIZE = 37,
+    };
+
+    // a * b rounds to 1, but a * b - 1 is not 0 when computed exactly
+    static double a() { return 1.0 + 1.0 / ( 1 << 30 ); }
+    static double b() { return 1.0 - 1.0 / ( 1 << 30 ); }
+
+    // The product is stored before the addition, so that the reference
+    // can never be contracted into a fused multiply-add
+    static double multiply( double x, double y )
+    {
+        volatile double product = x * y;
+        return product;
+    }
+
+    // The first row alternates between a and -a, the others are 0
+    void fill( double *array, unsigned rows, unsigned columns )
+    {
+        for ( unsigned i = 0; i < rows * columns; ++i )
+            array[i] = ( i >= columns ) ? 0 : ( i % 2 ) ? -a() : a();
+    }
+
+    void assert_identical( const double *first, const double *second, unsigned size )
+    {
+        TS_ASSERT_SAME_DATA( first, second, size * sizeof(double) );
+    }
+
+    void test_concretize_symbolic_bounds()
+    {
+        double symbolicLb[INPUT_SIZE * SIZE];
+        double symbolicUb[INPUT_SIZE * SIZE];
+        double inputLb[INPUT_SIZE];
+        double inputUb[INPUT_SIZE];
+
+        fill( symbolicLb, INPUT_SIZE, SIZE );
+        fill( symbolicUb, INPUT_SIZE, SIZE );
+        for ( unsigned j = 0; j < INPUT_SIZE; ++j )
+        {
+            inputLb[j] = -b();
+            inputUb[j] = b();
+        }
+
+        // Lower bounds gain -a * b and upper bounds gain a * b
+        double bounds[4][SIZE];
+        double expected[4][SIZE];
+        for ( unsigned i = 0; i < SIZE; ++i )
+            for ( unsigned k = 0; k < 4; ++k )
+                bounds[k][i] = expected[k][i] = ( k % 2 ) ? -1 : 1;
+
+        NLR::concretizeSymbolicBounds( symbolicLb, symbolicUb, inputLb, inputUb,
+                                       INPUT_SIZE, SIZE,
+                                       bounds[0], bounds[1], bounds[2], bounds[3] );
+
+        for ( unsigned i = 0; i < SIZE; ++i )
+        {
+            for ( unsigned j = 0; j < INPUT_SIZE; ++j )
+            {
+                double lbEntry = symbolicLb[j * SIZE + i];
+                double withLb = multiply( lbEntry, inputLb[j] );
+                double withUb = multiply( lbEntry, inputUb[j] );
+                expected[0][i] += ( lbEntry >= 0 ) ? withLb : withUb;
+                expected[1][i] += ( lbEntry >= 0 ) ? withUb : withLb;
+            }
+
+            for ( unsigned j = 0; j < INPUT_SIZE; ++j )
+            {
+                double ubEntry = symbolicUb[j * SIZE + i];
+                double withLb = multiply( ubEntry, inputLb[j] );
+                double withUb = multiply( ubEntry, inputUb[j] );
+                expected[2][i] += ( ubEntry >= 0 ) ? withLb : withUb;
+                expected[3][i] += ( ubEntry >= 0 ) ? withUb : withLb;
+            }
+        }
+
+        for ( unsigned k = 0; k < 4; ++k )
+        {
+            assert_identical( bounds[k], expected[k], SIZE );
+            for ( unsigned i = 0; i < SIZE; ++i )
+                TS_ASSERT( bounds[k][i] == 0 );
+        }
+    }
+
+    void test_rescale_symbolic_bounds()
+    {
+        double symbolicBounds[INPUT_SIZE * SIZE];
+        double expected[INPUT_SIZE * SIZE];
+        double multipliers[SIZE];
+        double divisors[SIZE];
+
+        fill( symbolicBounds, INPUT_SIZE, SIZE );
+        for ( unsigned i = 0; i < SIZE; ++i )
+        {
+            multipliers[i] = ( i % 3 ) ? b() : -b() * i;
+            divisors[i] = 3 + i;
+        }
+
+        for ( unsigned j = 0; j < INPUT_SIZE; ++j )
+            for ( unsigned i = 0; i < SIZE; ++i )
+                expected[j * SIZE + i] =
+                    multiply( symbolicBounds[j * SIZE + i], multipliers[i] ) / divisors[i];
+
+        NLR::rescaleSymbolicBounds( symbolicBounds, multipliers, divisors, INPUT_SIZE, SIZE );
+
+        assert_identical( symbolicBounds, expected, INPUT_SIZE * SIZE );
+    }
+
+    void test_accumulate_symbolic_biases()
+    {
+        double weights[INPUT_SIZE * SIZE];
+        double sourceLowerBias[INPUT_SIZE];
+        double sourceUpperBias[INPUT_SIZE];
+
+        fill( weights, INPUT_SIZE, SIZE );
+        for ( unsigned k = 0; k < INPUT_SIZE; ++k )
+        {
+            sourceLowerBias[k] = -b();
+            sourceUpperBias[k] = b();
+        }
+
+        double lowerBias[SIZE];
+        double upperBias[SIZE];
+        double expectedLower[SIZE];
+        double expectedUpper[SIZE];
+        // Lower biases gain -a * b and upper biases gain a * b
+        for ( unsigned j = 0; j < SIZE; ++j )
+        {
+            lowerBias[j] = expectedLower[j] = 1;
+            upperBias[j] = expectedUpper[j] = -1;
+        }
+
+        NLR::accumulateSymbolicBiases( weights, sourceLowerBias, sourceUpperBias,
+                                       INPUT_SIZE, SIZE, lowerBias, upperBias );
+
+        for ( unsigned j = 0; j < SIZE; ++j )
+        {
+            for ( unsigned k = 0; k < INPUT_SIZE; ++k )
+            {
+                double weight = weights[k * SIZE + j];
+                double withLb = multiply( sourceLowerBias[k], weight );
+                double withUb = multiply( sourceUpperBias[k], weight );
+                expectedLower[j] += ( weight > 0 ) ? withLb : withUb;
+                expectedUpper[j] += ( weight > 0 ) ? withUb : withLb;
+            }
+        }
+
+        assert_identical( lowerBias, expectedLower, SIZE );
+        assert_identical( upperBias, expectedUpper, SIZE );
+        for ( unsigned j = 0; j < SIZE; ++j )
+        {
+            TS_ASSERT( lowerBias[j] == 0 );
+            TS_ASSERT( upperBias[j] == 0 );
+        }
+    }
+};
+
+//
+// Local Variables:
+// compile-command: "make -C ../../.. "
+// tags-file-name: "../../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -0,0 +1,86 @@
+/*********************                                                        */
+/*! \file BinaryQueryFormat.h
+ ** \verbatim
+ ** Top contributors (to current version):
+ **   Guy Katz
+ ** This file is part of the Marabou project.
+ ** Copyright (c) 2017-2019 by the authors listed in the file AUTHORS
+ ** in the top-level source directory) and their institutional affiliations.
+ ** All rights reserved. See the file COPYING in the top-level source
+ ** directory for licensing information.\endverbatim
+ **
+ ** \brief Layout of the binary serialization of an InputQuery
+ **
+ ** A binary query is a fixed header followed by flat arrays, written in
+ ** the native byte order:
+ **
+ **   input variables        unsigned[numberOfInputVariables]
+ **   output variables       unsigned[numberOfOutputVariables]
+ **   lower bound variables  unsigned[numberOfLowerBounds]
+ **   lower bound values     double[numberOfLowerBounds]
+ **   upper bound variables  unsigned[numberOfUpperBounds]
+ **   upper bound values     double[numberOfUpperBounds]
+ **   equation types         unsigned[numberOfEquations]
+ **   equation scalars       double[numberOfEquations]
+ **   equation first addend  unsigned[numberOfEquations + 1]
+ **   addend variables       unsigned[numberOfAddends]
+ **   addend coefficients    double[numberOfAddends]
+ **   constraint types       unsigned[numberOfConstraints]
+ **   constraint first var   unsigned[numberOfConstraints + 1]
+ **   constraint variables   unsigned[numberOfConstraintVariables]
+ **
+ ** Every array is padded to a multiple of 8 bytes, so that a file that
+ ** is mapped into memory can be read in place. Input and output variables
+ ** are listed by their index. The variables of a constraint are its
+ ** participating variables: b, f (and aux) for ReLUs and sigmoids, and
+ ** the elements followed by f for max constraints.
+ **/
+
+#ifndef __BinaryQueryFormat_h__
+#define __BinaryQueryFormat_h__
+
+class BinaryQueryFormat
+{
+public:
+    enum {
+        VERSION = 1,
+        ALIGNMENT = 8,
+        MAGIC_SIZE = 8,
+    };
+
+    static constexpr const char *MAGIC = "MARABOUQ";
+
+    struct Header
+    {
+        char _magic[MAGIC_SIZE];
+        unsigned _version;
+        unsigned _numberOfVariables;
+        unsigned _numberOfInputVariables;
+        unsigned _numberOfOutputVariables;
+        unsigned _numberOfLowerBounds;
+        unsigned _numberOfUpperBounds;
+        unsigned _numberOfEquations;
+        unsigned _numberOfAddends;
+        unsigned _numberOfConstraints;
+        unsigned _numberOfConstraintVariables;
+    };
+
+    /*
+      The number of bytes an array of the given size takes in the file,
+      including its padding
+    */
+    static unsigned long long paddedSize( unsigned long long size )
+    {
+        return ( ( size + ALIGNMENT - 1 ) / ALIGNMENT ) * ALIGNMENT;
+    }
+};
+
+#endif // __BinaryQueryFormat_h__
+
+//
+// Local Variables:
+// compile-command: "make -C ../.. "
+// tags-file-name: "../../TAGS"
+// c-basic-offset: 4
+// End:
+//
@@ -15,8 +15,11 @@
  **/
 
 #include "AutoFile.h"
+#include "BinaryQueryFormat.h"
+#include "CommonError.h"
 #include "Debug.h"
 #include "Equation.h"
+#include "File.h"
 #include "GlobalConfiguration.h"
 #include "InputQuery.h"
 #include "MStringf.h"
@@ -25,6 +28,14 @@
 #include "QueryLoader.h"
 #include "ReluConstraint.h"
 #include "SigmoidConstraint.h"
+#include "T/sys/stat.h"
+#include "T/unistd.h"
+
+#include <cstring>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
 
 InputQuery QueryLoader::loadQuery( const String &fileName )
 {
@@ -227,6 +238,252 @@ InputQuery QueryLoader::loadQuery( const String &fileName )
     return inputQuery;
 }
 
+InputQuery QueryLoader::loadBinary( const String &fileName )
+{
+    if ( !IFile::exists( fileName ) )
+    {
+        throw MarabouError( MarabouError::FILE_DOES_NOT_EXIST, Stringf( "File %s not found.\n", fileName.ascii() ).ascii() );
+    }
+
+    unsigned size = File::getSize( fileName );
+    if ( size < sizeof(BinaryQueryFormat::Header) )
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY, Stringf( "File %s is too short\n", fileName.ascii() ).ascii() );
+
+    int descriptor = T::open( fileName.ascii(), O_RDONLY, (mode_t)NULL );
+    if ( descriptor == -1 )
+        throw CommonError( CommonError::OPEN_FAILED, fileName.ascii() );
+
+#ifdef _WIN32
+    char *data = new char[size];
+    unsigned bytesRead = 0;
+    while ( bytesRead < size )
+    {
+        int n = T::read( descriptor, data + bytesRead, size - bytesRead );
+        if ( n <= 0 )
+        {
+            delete[] data;
+            T::close( descriptor );
+            throw CommonError( CommonError::READ_FAILED );
+        }
+        bytesRead += n;
+    }
+    T::close( descriptor );
+
+    InputQuery inputQuery;
+    try
+    {
+        parseBinary( data, size, inputQuery );
+    }
+    catch ( ... )
+    {
+        delete[] data;
+        throw;
+    }
+
+    delete[] data;
+    return inputQuery;
+#else
+    void *data = mmap( NULL, size, PROT_READ, MAP_PRIVATE, descriptor, 0 );
+    // The mapping remains valid after the descriptor is closed
+    T::close( descriptor );
+    if ( data == MAP_FAILED )
+        throw CommonError( CommonError::READ_FAILED, fileName.ascii() );
+
+    InputQuery inputQuery;
+    try
+    {
+        parseBinary( (const char *)data, size, inputQuery );
+    }
+    catch ( ... )
+    {
+        munmap( data, size );
+        throw;
+    }
+
+    munmap( data, size );
+    return inputQuery;
+#endif
+}
+
+InputQuery QueryLoader::loadBinary( const char *data, unsigned long long size )
+{
+    InputQuery inputQuery;
+    parseBinary( data, size, inputQuery );
+    return inputQuery;
+}
+
+void QueryLoader::parseBinary( const char *data, unsigned long long size, InputQuery &inputQuery )
+{
+    if ( size < sizeof(BinaryQueryFormat::Header) )
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY, "Binary query is too short\n" );
+
+    BinaryQueryFormat::Header header;
+    memcpy( &header, data, sizeof(header) );
+
+    if ( memcmp( header._magic, BinaryQueryFormat::MAGIC, BinaryQueryFormat::MAGIC_SIZE ) != 0 )
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY, "Not a binary query\n" );
+
+    if ( header._version != BinaryQueryFormat::VERSION )
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY,
+                            Stringf( "Unsupported binary query version: %u\n", header._version ).ascii() );
+
+    QL_LOG( Stringf( "Number of variables: %u\n", header._numberOfVariables ).ascii() );
+    QL_LOG( Stringf( "Number of lower bounds: %u\n", header._numberOfLowerBounds ).ascii() );
+    QL_LOG( Stringf( "Number of upper bounds: %u\n", header._numberOfUpperBounds ).ascii() );
+    QL_LOG( Stringf( "Number of equations: %u\n", header._numberOfEquations ).ascii() );
+    QL_LOG( Stringf( "Number of constraints: %u\n", header._numberOfConstraints ).ascii() );
+
+    // Locate the sections, in the order in which they are written
+    unsigned long long offset = BinaryQueryFormat::paddedSize( sizeof(header) );
+    unsigned long long numberOfEquations = header._numberOfEquations;
+    unsigned long long numberOfConstraints = header._numberOfConstraints;
+
+    const unsigned *inputVariables = (const unsigned *)
+        getBinaryArray( data, size, offset, header._numberOfInputVariables * sizeof(unsigned) );
+    const unsigned *outputVariables = (const unsigned *)
+        getBinaryArray( data, size, offset, header._numberOfOutputVariables * sizeof(unsigned) );
+    const unsigned *lowerBoundVariables = (const unsigned *)
+        getBinaryArray( data, size, offset, header._numberOfLowerBounds * sizeof(unsigned) );
+    const double *lowerBoundValues = (const double *)
+        getBinaryArray( data, size, offset, header._numberOfLowerBounds * sizeof(double) );
+    const unsigned *upperBoundVariables = (const unsigned *)
+        getBinaryArray( data, size, offset, header._numberOfUpperBounds * sizeof(unsigned) );
+    const double *upperBoundValues = (const double *)
+        getBinaryArray( data, size, offset, header._numberOfUpperBounds * sizeof(double) );
+    const unsigned *equationTypes = (const unsigned *)
+        getBinaryArray( data, size, offset, numberOfEquations * sizeof(unsigned) );
+    const double *equationScalars = (const double *)
+        getBinaryArray( data, size, offset, numberOfEquations * sizeof(double) );
+    const unsigned *equationFirstAddend = (const unsigned *)
+        getBinaryArray( data, size, offset, ( numberOfEquations + 1 ) * sizeof(unsigned) );
+    const unsigned *addendVariables = (const unsigned *)
+        getBinaryArray( data, size, offset, header._numberOfAddends * sizeof(unsigned) );
+    const double *addendCoefficients = (const double *)
+        getBinaryArray( data, size, offset, header._numberOfAddends * sizeof(double) );
+    const unsigned *constraintTypes = (const unsigned *)
+        getBinaryArray( data, size, offset, numberOfConstraints * sizeof(unsigned) );
+    const unsigned *constraintFirstVariable = (const unsigned *)
+        getBinaryArray( data, size, offset, ( numberOfConstraints + 1 ) * sizeof(unsigned) );
+    const unsigned *constraintVariables = (const unsigned *)
+        getBinaryArray( data, size, offset, header._numberOfConstraintVariables * sizeof(unsigned) );
+
+    if ( offset != size )
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY, "Binary query has trailing data\n" );
+
+    checkBinaryOffsets( equationFirstAddend, header._numberOfEquations, header._numberOfAddends );
+    checkBinaryOffsets( constraintFirstVariable, header._numberOfConstraints, header._numberOfConstraintVariables );
+
+    inputQuery.setNumberOfVariables( header._numberOfVariables );
+
+    // Input and output variables
+    for ( unsigned i = 0; i < header._numberOfInputVariables; ++i )
+        inputQuery.markInputVariable( inputVariables[i], i );
+
+    for ( unsigned i = 0; i < header._numberOfOutputVariables; ++i )
+        inputQuery.markOutputVariable( outputVariables[i], i );
+
+    // Bounds
+    for ( unsigned i = 0; i < header._numberOfLowerBounds; ++i )
+        inputQuery.setLowerBound( lowerBoundVariables[i], lowerBoundValues[i] );
+
+    for ( unsigned i = 0; i < header._numberOfUpperBounds; ++i )
+        inputQuery.setUpperBound( upperBoundVariables[i], upperBoundValues[i] );
+
+    // Equations, built in place to avoid copying their addends
+    List<Equation> &equations = inputQuery.getEquations();
+    for ( unsigned i = 0; i < header._numberOfEquations; ++i )
+    {
+        if ( equationTypes[i] > Equation::LE )
+            throw MarabouError( MarabouError::INVALID_EQUATION_TYPE, Stringf( "Invalid Equation Type\n" ).ascii() );
+
+        equations.append( Equation( (Equation::EquationType)equationTypes[i] ) );
+        Equation &equation = equations.back();
+        equation.setScalar( equationScalars[i] );
+
+        for ( unsigned j = equationFirstAddend[i]; j < equationFirstAddend[i + 1]; ++j )
+            equation.addAddend( addendCoefficients[j], addendVariables[j] );
+    }
+
+    // Constraints
+    for ( unsigned i = 0; i < header._numberOfConstraints; ++i )
+    {
+        const unsigned *variables = constraintVariables + constraintFirstVariable[i];
+        unsigned numberOfVariables = constraintFirstVariable[i + 1] - constraintFirstVariable[i];
+
+        PiecewiseLinearConstraint *constraint = NULL;
+        if ( constraintTypes[i] == RELU && numberOfVariables == 2 )
+        {
+            constraint = new ReluConstraint( variables[0], variables[1] );
+        }
+        else if ( constraintTypes[i] == RELU && numberOfVariables == 3 )
+        {
+            // There is no constructor that takes the aux variable
+            constraint = new ReluConstraint( Stringf( "relu,%u,%u,%u", variables[1], variables[0], variables[2] ) );
+        }
+        else if ( constraintTypes[i] == MAX && numberOfVariables >= 2 )
+        {
+            Set<unsigned> elements;
+            for ( unsigned j = 0; j < numberOfVariables - 1; ++j )
+                elements.insert( variables[j] );
+            constraint = new MaxConstraint( variables[numberOfVariables - 1], elements );
+        }
+        else if ( constraintTypes[i] == SIGMOID && numberOfVariables == 2 )
+        {
+            constraint = new SigmoidConstraint( variables[0], variables[1] );
+        }
+        else
+        {
+            throw MarabouError( MarabouError::UNSUPPORTED_PIECEWISE_CONSTRAINT,
+                                Stringf( "Unsupported piecewise constraint: type %u with %u variables\n",
+                                         constraintTypes[i], numberOfVariables ).ascii() );
+        }
+
+        inputQuery.addPiecewiseLinearConstraint( constraint );
+    }
+}
+
+bool QueryLoader::isBinaryQuery( const String &fileName )
+{
+    int descriptor = T::open( fileName.ascii(), O_RDONLY, (mode_t)NULL );
+    if ( descriptor == -1 )
+        return false;
+
+    char magic[BinaryQueryFormat::MAGIC_SIZE];
+    int n = T::read( descriptor, magic, BinaryQueryFormat::MAGIC_SIZE );
+    T::close( descriptor );
+
+    return n == BinaryQueryFormat::MAGIC_SIZE &&
+        memcmp( magic, BinaryQueryFormat::MAGIC, BinaryQueryFormat::MAGIC_SIZE ) == 0;
+}
+
+const void *QueryLoader::getBinaryArray( const char *data,
+                                         unsigned long long size,
+                                         unsigned long long &offset,
+                                         unsigned long long arraySize )
+{
+    unsigned long long paddedSize = BinaryQueryFormat::paddedSize( arraySize );
+    if ( paddedSize > size - offset )
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY, "Binary query is truncated\n" );
+
+    const void *array = data + offset;
+    offset += paddedSize;
+    return array;
+}
+
+void QueryLoader::checkBinaryOffsets( const unsigned *firstEntry,
+                                      unsigned numberOfRows,
+                                      unsigned numberOfEntries )
+{
+    if ( firstEntry[0] != 0 || firstEntry[numberOfRows] != numberOfEntries )
+        throw MarabouError( MarabouError::INVALID_BINARY_QUERY, "Binary query has invalid offsets\n" );
+
+    for ( unsigned i = 0; i < numberOfRows; ++i )
+    {
+        if ( firstEntry[i] > firstEntry[i + 1] )
+            throw MarabouError( MarabouError::INVALID_BINARY_QUERY, "Binary query has invalid offsets\n" );
+    }
+}
+
 
 //
 // Local Variables:
@@ -32,6 +32,42 @@ public:
       Parse a serialized query and return it in InputQuery form
     */
     static InputQuery loadQuery( const String &fileName );
+
+    /*
+      Parse a query stored in the binary format of BinaryQueryFormat.h.
+      The file is mapped into memory and read in place.
+    */
+    static InputQuery loadBinary( const String &fileName );
+    static InputQuery loadBinary( const char *data, unsigned long long size );
+
+    /*
+      Check whether a file holds a query in the binary format
+    */
+    static bool isBinaryQuery( const String &fileName );
+
+private:
+    /*
+      Parse a binary query that has been read into memory into the given
+      (empty) query
+    */
+    static void parseBinary( const char *data, unsigned long long size, InputQuery &inputQuery );
+
+    /*
+      Return the array of the given size that starts at the given offset
+      of a binary query, and advance the offset past its padding.
+    */
+    static const void *getBinaryArray( const char *data,
+                                       unsigned long long size,
+                                       unsigned long long &offset,
+                                       unsigned long long arraySize );
+
+    /*
+      Check that the offsets of a compressed row array are monotone and
+      end at the number of entries.
+    */
+    static void checkBinaryOffsets( const unsigned *firstEntry,
+                                    unsigned numberOfRows,
+                                    unsigned numberOfEntries );
 };
 
 #endif // __QueryLoader_h__
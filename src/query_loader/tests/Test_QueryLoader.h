@@ -18,6 +18,9 @@
 #include "AutoFile.h"
 #include "Equation.h"
 #include "InputQuery.h"
+#include "MarabouError.h"
+#include "MaxConstraint.h"
+#include "MockErrno.h"
 #include "MockFileFactory.h"
 #include "QueryLoader.h"
 #include "ReluConstraint.h"
@@ -27,6 +30,7 @@ const String QUERY_TEST_FILE( "QueryTest.txt" );
 
 class MockForQueryLoader
     : public MockFileFactory
+    , public MockErrno
     , public T::Base_stat
 {
 public:
@@ -129,6 +133,123 @@ public:
         // Constraints unchanged
         TS_ASSERT( inputQuery.getPiecewiseLinearConstraints() == inputQuery.getPiecewiseLinearConstraints() );
     }
+
+    void buildQuery( InputQuery &inputQuery )
+    {
+        inputQuery.setNumberOfVariables( 8 );
+
+        inputQuery.markInputVariable( 0, 0 );
+        inputQuery.setLowerBound( 0, -0.25 );
+        inputQuery.setUpperBound( 0, 1.0 );
+
+        inputQuery.setLowerBound( 3, 0.0 );
+        inputQuery.setLowerBound( 4, 0.0 );
+
+        inputQuery.markOutputVariable( 7, 0 );
+        inputQuery.setUpperBound( 7, 3.5 );
+
+        Equation equation0;
+        equation0.addAddend( -1.0, 1 );
+        equation0.addAddend( 1.5, 0 );
+        equation0.setScalar( 0.5 );
+        inputQuery.addEquation( equation0 );
+
+        Equation equation1( Equation::GE );
+        equation1.addAddend( -1.0, 2 );
+        equation1.addAddend( -1.0, 0 );
+        equation1.setScalar( -0.5 );
+        inputQuery.addEquation( equation1 );
+
+        Equation equation2( Equation::LE );
+        equation2.addAddend( -1.0, 5 );
+        equation2.addAddend( -1.0, 3 );
+        equation2.addAddend( 2.0, 4 );
+        equation2.setScalar( 0.125 );
+        inputQuery.addEquation( equation2 );
+
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 1, 3 ) );
+        inputQuery.addPiecewiseLinearConstraint( new ReluConstraint( 2, 4 ) );
+        inputQuery.addPiecewiseLinearConstraint( new MaxConstraint( 7, Set<unsigned>( { 5, 6 } ) ) );
+    }
+
+    List<String> serializeConstraints( const InputQuery &inputQuery )
+    {
+        List<String> result;
+        for ( const auto &constraint : inputQuery.getPiecewiseLinearConstraints() )
+            result.append( constraint->serializeToString() );
+        return result;
+    }
+
+    void test_load_binary_query()
+    {
+        InputQuery inputQuery;
+        buildQuery( inputQuery );
+
+        inputQuery.saveBinary( QUERY_TEST_FILE );
+        String binary = mock->mockFile.writtenLines;
+
+        InputQuery inputQuery2;
+        TS_ASSERT_THROWS_NOTHING( inputQuery2 = QueryLoader::loadBinary( binary.ascii(), binary.length() ) );
+
+        TS_ASSERT_EQUALS( inputQuery.getNumberOfVariables(), inputQuery2.getNumberOfVariables() );
+        TS_ASSERT( inputQuery.getInputVariables() == inputQuery2.getInputVariables() );
+        TS_ASSERT( inputQuery.getOutputVariables() == inputQuery2.getOutputVariables() );
+        TS_ASSERT( inputQuery.getLowerBounds() == inputQuery2.getLowerBounds() );
+        TS_ASSERT( inputQuery.getUpperBounds() == inputQuery2.getUpperBounds() );
+        TS_ASSERT( inputQuery.getEquations() == inputQuery2.getEquations() );
+        TS_ASSERT( serializeConstraints( inputQuery ) == serializeConstraints( inputQuery2 ) );
+    }
+
+    void test_binary_query_round_trips_with_text_format()
+    {
+        InputQuery inputQuery;
+        buildQuery( inputQuery );
+
+        // Text, then binary, then text again
+        inputQuery.saveQuery( QUERY_TEST_FILE );
+        String text = mock->mockFile.writtenLines;
+
+        mock->mockFile.wasCreated = false;
+        mock->mockFile.wasDiscarded = false;
+        InputQuery fromText = QueryLoader::loadQuery( QUERY_TEST_FILE );
+
+        mock->mockFile.wasCreated = false;
+        mock->mockFile.wasDiscarded = false;
+        mock->mockFile.writtenLines = "";
+        fromText.saveBinary( QUERY_TEST_FILE );
+        String binary = mock->mockFile.writtenLines;
+
+        InputQuery fromBinary = QueryLoader::loadBinary( binary.ascii(), binary.length() );
+
+        mock->mockFile.wasCreated = false;
+        mock->mockFile.wasDiscarded = false;
+        mock->mockFile.writtenLines = "";
+        fromBinary.saveQuery( QUERY_TEST_FILE );
+
+        TS_ASSERT_EQUALS( text, mock->mockFile.writtenLines );
+    }
+
+    void test_load_invalid_binary_query()
+    {
+        InputQuery inputQuery;
+        buildQuery( inputQuery );
+
+        inputQuery.saveBinary( QUERY_TEST_FILE );
+        String binary = mock->mockFile.writtenLines;
+
+        // Truncated
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadBinary( binary.ascii(), binary.length() - 8 ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_BINARY_QUERY );
+
+        // Not a binary query
+        String text( "8\n5\n2\n3\n3\n1\n0,0\n1\n0,7\n0,0.000000" );
+        TS_ASSERT_THROWS_EQUALS( QueryLoader::loadBinary( text.ascii(), text.length() ),
+                                 const MarabouError &e,
+                                 e.getCode(),
+                                 MarabouError::INVALID_BINARY_QUERY );
+    }
 };
 
 //